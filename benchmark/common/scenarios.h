@@ -0,0 +1,70 @@
+#pragma once
+
+#include <april/april.hpp>
+
+// Shared benchmark scenarios. Both are dense cubes of particles in a reflective box; sizes are given as
+// particles per cube edge so that DirectSum and LinkedCells run the same systems.
+
+namespace bench {
+
+	inline constexpr double lj_spacing = 1.1225;  // close to the LJ minimum 2^(1/6) sigma
+	inline constexpr double lj_cutoff = 3.0;      // in units of sigma
+	inline constexpr double gravity_spacing = 1.5;
+	inline constexpr double gravity_cutoff = 4.5;
+
+	// thermal velocities make the particles drift so that LinkedCells actually rebuilds
+	inline april::vec3 thermal_velocity(const april::vec3&) {
+		return april::math::maxwell_boltzmann_velocity(0.5, 3);
+	}
+
+	// edge^3 Lennard-Jones particles (single type, epsilon = sigma = 1, cutoff 3 sigma)
+	inline auto lj_cube(const unsigned edge) {
+		using namespace april;
+		const double length = edge * lj_spacing;
+
+		auto cube = ParticleCuboid()
+			.at({lj_cutoff, lj_cutoff, lj_cutoff})
+			.count({edge, edge, edge})
+			.spacing(lj_spacing)
+			.mass(1.0)
+			.type(0)
+			.thermal(thermal_velocity);
+
+		return Environment(forces<LennardJones>, boundaries<ReflectiveBoundary>)
+			.with_particles(cube)
+			.with_extent(length + 2 * lj_cutoff, length + 2 * lj_cutoff, length + 2 * lj_cutoff)
+			.with_interaction(LennardJones(1.0, 1.0, lj_cutoff), to_type(0))
+			.with_boundaries(ReflectiveBoundary(), all_faces);
+	}
+
+	// edge^3 gravitating particles with a finite cutoff, so the same system runs on every container
+	inline auto gravity_cube(const unsigned edge) {
+		using namespace april;
+		const double length = edge * gravity_spacing;
+
+		auto cube = ParticleCuboid()
+			.at({gravity_cutoff, gravity_cutoff, gravity_cutoff})
+			.count({edge, edge, edge})
+			.spacing(gravity_spacing)
+			.mass(1.0)
+			.type(0)
+			.thermal(thermal_velocity);
+
+		return Environment(forces<Gravity>, boundaries<ReflectiveBoundary>)
+			.with_particles(cube)
+			.with_extent(length + 2 * gravity_cutoff, length + 2 * gravity_cutoff, length + 2 * gravity_cutoff)
+			.with_interaction(Gravity(1e-3, gravity_cutoff), to_type(0))
+			.with_boundaries(ReflectiveBoundary(), all_faces);
+	}
+
+	// name of the compiled SIMD backend
+	inline constexpr const char* simd_backend_name() {
+	#if defined(APRIL_SIMD_BACKEND_XSIMD)
+		return "backend_xsimd";
+	#elif defined(APRIL_SIMD_BACKEND_STD_SIMD)
+		return "backend_std_simd";
+	#else
+		return "backend_scalar";
+	#endif
+	}
+}
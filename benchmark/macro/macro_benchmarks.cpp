@@ -0,0 +1,180 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "april/monitors/benchmark_report.hpp"
+
+#include "scenarios.h"
+
+#if defined(APRIL_EXECUTOR_BACKEND_OMP)
+	#include "april/exec/threading/backends/omp_executor.hpp"
+#endif
+
+using namespace april;
+
+
+/*
+ * End-to-end runs of the benchmark scenarios over every container x layout x executor combination.
+ * One CSV row per run goes to stdout (or --output), the Benchmark reports are suppressed. --json additionally
+ * writes all runs with their per-step timings, for comparison with april_compare_benchmarks.
+ *
+ *   april_macro_benchmarks [--steps N] [--size EDGE] [--threads N] [--dt DT] [--filter TEXT] [--output FILE]
+ *                          [--json FILE]
+ *
+ * --filter keeps the runs whose "scenario/container/layout/executor" name contains TEXT.
+ */
+
+namespace {
+	struct Options {
+		size_t steps = 100;
+		unsigned edge = 16;
+		size_t threads = exec::default_thread_count;
+		double dt = 0.0005;
+		std::string filter;
+		std::string output;
+		std::string json;
+	};
+
+	struct SerialConfig : RuntimeConfig<exec::SequentialExecutor>, CompileTimeConfig<ParallelPolicy::Serial> {};
+	struct SpinConfig : RuntimeConfig<exec::NativeSpinExecutor>, CompileTimeConfig<> {};
+	struct BarrierConfig : RuntimeConfig<exec::NativeBarrierExecutor>, CompileTimeConfig<> {};
+#if defined(APRIL_EXECUTOR_BACKEND_OMP)
+	struct OmpConfig : RuntimeConfig<exec::OmpExecutor>, CompileTimeConfig<> {};
+#endif
+
+	template<typename L> constexpr std::string_view layout_name() {
+		if constexpr (std::is_same_v<L, Layout::AoS>) return "AoS";
+		else if constexpr (std::is_same_v<L, Layout::SoA>) return "SoA";
+		else return "AoSoA";
+	}
+
+	template<typename Config> constexpr std::string_view executor_name() {
+		if constexpr (std::is_same_v<Config, SerialConfig>) return "sequential";
+		else if constexpr (std::is_same_v<Config, SpinConfig>) return "native_spin";
+		else if constexpr (std::is_same_v<Config, BarrierConfig>) return "native_barrier";
+		else return "omp";
+	}
+
+	class Runner {
+	public:
+		explicit Runner(Options opts) : options(std::move(opts)) {
+			if (!options.output.empty()) {
+				file.open(options.output);
+				if (!file) throw std::runtime_error("cannot open " + options.output);
+			}
+			write_benchmark_csv_header(out());
+		}
+
+		template<typename Config, typename Env, typename Container>
+		void run(const std::string_view scenario, const std::string_view container_name,
+				 const std::string_view layout, const Env& env, const Container& container) {
+			std::ostringstream name;
+			name << scenario << "/" << container_name << "/" << layout << "/" << executor_name<Config>();
+			if (!options.filter.empty() && name.str().find(options.filter) == std::string::npos) return;
+
+			Config config;
+			if constexpr (requires { config.executor_config.n_threads; }) {
+				config.executor_config.n_threads = options.threads;
+			}
+			const size_t threads = std::is_same_v<Config, SerialConfig> ? 1 : options.threads;
+
+			std::cerr << "running " << name.str() << " ..." << std::endl;
+			auto system = build_system(env, container, config);
+			Benchmark::BenchmarkResult res;
+
+			// the monitor prints its report on finalize; keep stdout for the CSV rows
+			std::ostringstream discard;
+			auto* previous = std::cout.rdbuf(discard.rdbuf());
+			VelocityVerlet(system, monitors<Benchmark>)
+				.with_monitor(Benchmark(&res))
+				.run_for_steps(options.dt, options.steps);
+			std::cout.rdbuf(previous);
+
+			BenchmarkRecord record{BenchmarkInfo::current(name.str()), std::move(res)};
+			record.info.container = container_name;
+			record.info.layout = layout;
+			record.info.executor = executor_name<Config>();
+			record.info.threads = threads;
+
+			write_benchmark_csv_row(out(), record);
+			out().flush();
+			records.push_back(std::move(record));
+		}
+
+		// writes the result file requested with --json
+		void save() const {
+			if (!options.json.empty()) save_benchmark_json(options.json, records);
+		}
+
+		[[nodiscard]] const Options& opts() const noexcept { return options; }
+
+	private:
+		Options options;
+		std::ofstream file;
+		std::vector<BenchmarkRecord> records;
+
+		std::ostream& out() { return file.is_open() ? static_cast<std::ostream&>(file) : std::cout; }
+	};
+
+	template<typename Config, typename Env>
+	void run_containers(Runner& runner, const std::string_view scenario, const Env& env) {
+		auto layouts = [&]<typename... Layouts>() {
+			(runner.run<Config>(scenario, "DirectSum", layout_name<Layouts>(), env, DirectSum<Layouts>()), ...);
+			(runner.run<Config>(scenario, "LinkedCells", layout_name<Layouts>(), env, LinkedCells<Layouts>()), ...);
+		};
+		layouts.template operator()<Layout::AoS, Layout::SoA, Layout::AoSoA<>>();
+	}
+
+	template<typename Env>
+	void run_executors(Runner& runner, const std::string_view scenario, const Env& env) {
+		run_containers<SerialConfig>(runner, scenario, env);
+		run_containers<SpinConfig>(runner, scenario, env);
+		run_containers<BarrierConfig>(runner, scenario, env);
+	#if defined(APRIL_EXECUTOR_BACKEND_OMP)
+		run_containers<OmpConfig>(runner, scenario, env);
+	#endif
+	}
+
+	Options parse(const int argc, char** argv) {
+		Options options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			auto value = [&]() -> std::string {
+				if (i + 1 >= argc) throw std::invalid_argument("missing value for " + std::string(arg));
+				return argv[++i];
+			};
+
+			if (arg == "--steps") options.steps = std::stoul(value());
+			else if (arg == "--size") options.edge = static_cast<unsigned>(std::stoul(value()));
+			else if (arg == "--threads") options.threads = std::stoul(value());
+			else if (arg == "--dt") options.dt = std::stod(value());
+			else if (arg == "--filter") options.filter = value();
+			else if (arg == "--output") options.output = value();
+			else if (arg == "--json") options.json = value();
+			else throw std::invalid_argument("unknown option " + std::string(arg));
+		}
+		return options;
+	}
+}
+
+
+int main(const int argc, char** argv) {
+	try {
+		Runner runner(parse(argc, argv));
+		const unsigned edge = runner.opts().edge;
+
+		run_executors(runner, "lj_cube", bench::lj_cube(edge));
+		run_executors(runner, "gravity_cube", bench::gravity_cube(edge));
+		runner.save();
+	} catch (const std::exception& e) {
+		std::cerr << "april_macro_benchmarks: " << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
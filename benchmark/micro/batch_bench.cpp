@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include "scenarios.h"
+
+using namespace april;
+
+
+// Pair sweeps of the batching layer. DirectSum with AoSoA storage runs every chunk pair through
+// interact_block_vs_block (the SIMD rotation sweep); SoA and AoS run the same pairs as reference.
+
+namespace {
+	struct SerialConfig : RuntimeConfig<exec::SequentialExecutor>, CompileTimeConfig<ParallelPolicy::Serial> {};
+
+	template<typename Layout>
+	void BM_DirectSumPairSweep(benchmark::State& state) {
+		const auto edge = static_cast<unsigned>(state.range(0));
+		auto system = build_system(bench::lj_cube(edge), DirectSum<Layout>(), SerialConfig());
+
+		for (auto _ : state) {
+			system.update_forces();
+		}
+
+		const auto n = static_cast<int64_t>(system.size());
+		state.SetItemsProcessed(state.iterations() * n * (n - 1) / 2); // pairs
+		state.counters["particles"] = static_cast<double>(n);
+		state.SetLabel(bench::simd_backend_name());
+	}
+}
+
+BENCHMARK(BM_DirectSumPairSweep<Layout::AoSoA<>>)->Name("interact_block_vs_block/AoSoA")->Arg(4)->Arg(8)->Arg(12);
+BENCHMARK(BM_DirectSumPairSweep<Layout::SoA>)->Name("interact_block_vs_block/SoA")->Arg(4)->Arg(8)->Arg(12);
+BENCHMARK(BM_DirectSumPairSweep<Layout::AoS>)->Name("interact_block_vs_block/AoS")->Arg(4)->Arg(8)->Arg(12);
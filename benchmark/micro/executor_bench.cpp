@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+
+#include "april/exec/threading/backends/sequential_executor.hpp"
+#include "april/exec/threading/backends/native_spin_executor.hpp"
+#include "april/exec/threading/backends/native_barrier_executor.hpp"
+#if defined(APRIL_EXECUTOR_BACKEND_OMP)
+	#include "april/exec/threading/backends/omp_executor.hpp"
+#endif
+
+using namespace april;
+
+
+// Round trip latency of execute(): wake the workers, hand out the tasks, wait for completion.
+// range(0) is the thread count, range(1) the number of (empty) tasks per dispatch.
+
+namespace {
+	template<typename Executor>
+	typename Executor::Config make_config(const size_t n_threads) {
+		typename Executor::Config config{};
+		if constexpr (requires { config.n_threads; }) config.n_threads = n_threads;
+		if constexpr (requires { config.pin_threads; }) config.pin_threads = false;
+		return config;
+	}
+
+	template<typename Executor>
+	void BM_ExecuteLatency(benchmark::State& state) {
+		const Executor executor(make_config<Executor>(static_cast<size_t>(state.range(0))));
+		const auto tasks = static_cast<size_t>(state.range(1));
+		std::atomic<size_t> sink{0};
+
+		for (auto _ : state) {
+			executor.template execute<ParallelPolicy::Threaded>(tasks, [&](const size_t i) {
+				if (i == 0) sink.fetch_add(1, std::memory_order_relaxed);
+			});
+		}
+
+		benchmark::DoNotOptimize(sink.load());
+		state.SetItemsProcessed(state.iterations()); // dispatches
+	}
+}
+
+BENCHMARK(BM_ExecuteLatency<exec::SequentialExecutor>)->Name("execute/sequential")->Args({1, 1})->Args({1, 1024});
+BENCHMARK(BM_ExecuteLatency<exec::NativeSpinExecutor>)->Name("execute/native_spin")
+	->ArgsProduct({{2, 4, 8, 16}, {1, 1024}})->UseRealTime();
+BENCHMARK(BM_ExecuteLatency<exec::NativeBarrierExecutor>)->Name("execute/native_barrier")
+	->ArgsProduct({{2, 4, 8, 16}, {1, 1024}})->UseRealTime();
+#if defined(APRIL_EXECUTOR_BACKEND_OMP)
+BENCHMARK(BM_ExecuteLatency<exec::OmpExecutor>)->Name("execute/omp")
+	->ArgsProduct({{2, 4, 8, 16}, {1, 1024}})->UseRealTime();
+#endif
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include "scenarios.h"
+
+using namespace april;
+
+
+// reorder_storage of the linked cells layouts: a zero skin forces a full rebuild (count, map, gather)
+// on every rebuild_structure call once the particles have moved.
+
+namespace {
+	struct ThreadedConfig : RuntimeConfig<>, CompileTimeConfig<> {};
+
+	template<typename Layout>
+	void BM_ReorderStorage(benchmark::State& state) {
+		const auto edge = static_cast<unsigned>(state.range(0));
+		auto system = build_system(bench::lj_cube(edge), LinkedCells<Layout>().with_skin_factor(0.0), ThreadedConfig());
+
+		double shift = 1e-3;
+		for (auto _ : state) {
+			state.PauseTiming();
+			shift = -shift; // tiny moves back and forth keep the cell assignment but defeat the skin check
+			system.template for_each_particle<ParallelPolicy::Serial>(
+				scalar_kernel<ParticleField::position, ParticleField::position>([&](auto&& p) {
+					p.position.x += shift;
+				})
+			);
+			state.ResumeTiming();
+
+			system.rebuild_structure();
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(system.size()));
+	}
+}
+
+BENCHMARK(BM_ReorderStorage<Layout::AoS>)->Name("reorder_storage/AoS")->Arg(16)->Arg(32)->UseRealTime();
+BENCHMARK(BM_ReorderStorage<Layout::SoA>)->Name("reorder_storage/SoA")->Arg(16)->Arg(32)->UseRealTime();
+BENCHMARK(BM_ReorderStorage<Layout::AoSoA<>>)->Name("reorder_storage/AoSoA")->Arg(16)->Arg(32)->UseRealTime();
@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "april/exec/threading/scheduling.hpp"
+
+using namespace april;
+
+
+// Partitioning heuristics that run on every dispatch over a particle range.
+
+namespace {
+	void BM_MakeLinearSchedule(benchmark::State& state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const exec::BlockConfig config(static_cast<size_t>(state.range(1)));
+		std::vector<math::Range> blocks;
+
+		for (auto _ : state) {
+			exec::make_linear_schedule(math::Range{0, n}, config, blocks);
+			benchmark::DoNotOptimize(blocks.data());
+		}
+		state.counters["blocks"] = static_cast<double>(blocks.size());
+	}
+
+	void BM_MakeSymmetricSchedule(benchmark::State& state) {
+		const auto n = static_cast<size_t>(state.range(0));
+		const exec::BlockConfig config(static_cast<size_t>(state.range(1)));
+
+		for (auto _ : state) {
+			auto schedule = exec::make_symmetric_schedule(math::Range{0, n}, config);
+			benchmark::DoNotOptimize(schedule.diagonals.data());
+		}
+	}
+}
+
+BENCHMARK(BM_MakeLinearSchedule)->ArgsProduct({{1'000, 100'000, 10'000'000}, {1, 8, 64}});
+BENCHMARK(BM_MakeSymmetricSchedule)->ArgsProduct({{1'000, 100'000}, {1, 8, 64}});
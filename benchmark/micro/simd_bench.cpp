@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "april/simd/packed.hpp"
+#include "april/simd/backends/backend_scalar.hpp"
+
+#include "scenarios.h"
+
+using namespace april;
+
+
+// Raw packed arithmetic of the compiled SIMD backend, with the scalar backend as reference.
+// The backend is selected at configure time (APRIL_SIMD_BACKEND), its name is attached as label.
+
+namespace {
+	template<typename P>
+	void BM_PackedFma(benchmark::State& state) {
+		using T = typename P::value_type;
+		const size_t n = static_cast<size_t>(state.range(0));
+		std::vector<T> a(n, T(1.0001)), b(n, T(0.9999)), c(n, T(0.5));
+
+		for (auto _ : state) {
+			for (size_t i = 0; i + P::size() <= n; i += P::size()) {
+				const P r = P::fma(P::load(&a[i]), P::load(&b[i]), P::load(&c[i]));
+				r.store(&c[i]);
+			}
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+		state.SetLabel(bench::simd_backend_name());
+	}
+
+	// the force magnitude of Lennard-Jones (12-6) over a stream of squared distances
+	template<typename P>
+	void BM_PackedLennardJones(benchmark::State& state) {
+		using T = typename P::value_type;
+		const size_t n = static_cast<size_t>(state.range(0));
+		std::vector<T> r2(n), out(n);
+		for (size_t i = 0; i < n; ++i) r2[i] = T(1.0) + T(i % 64) / T(32);
+
+		const P sigma2(1.0), epsilon24(24.0), two(2.0);
+		for (auto _ : state) {
+			for (size_t i = 0; i + P::size() <= n; i += P::size()) {
+				const P inv_r2 = P(1.0) / P::load(&r2[i]);
+				const P s2 = sigma2 * inv_r2;
+				const P s6 = s2 * s2 * s2;
+				const P f = epsilon24 * inv_r2 * s6 * (two * s6 - P(1.0));
+				f.store(&out[i]);
+			}
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+		state.SetLabel(bench::simd_backend_name());
+	}
+
+	template<typename P>
+	void BM_PackedRsqrt(benchmark::State& state) {
+		using T = typename P::value_type;
+		const size_t n = static_cast<size_t>(state.range(0));
+		std::vector<T> x(n, T(2.0)), out(n);
+
+		for (auto _ : state) {
+			for (size_t i = 0; i + P::size() <= n; i += P::size()) {
+				P::rsqrt(P::load(&x[i])).store(&out[i]);
+			}
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+		state.SetLabel(bench::simd_backend_name());
+	}
+
+	using PackedDouble = simd::Packed<double>;
+	using PackedFloat = simd::Packed<float, simd::float_width>;
+	using ScalarDouble = simd::internal::scalar::Packed<double>;
+}
+
+BENCHMARK(BM_PackedFma<PackedDouble>)->Arg(4096);
+BENCHMARK(BM_PackedFma<PackedFloat>)->Arg(4096);
+BENCHMARK(BM_PackedFma<ScalarDouble>)->Arg(4096);
+
+BENCHMARK(BM_PackedLennardJones<PackedDouble>)->Arg(4096);
+BENCHMARK(BM_PackedLennardJones<PackedFloat>)->Arg(4096);
+BENCHMARK(BM_PackedLennardJones<ScalarDouble>)->Arg(4096);
+
+BENCHMARK(BM_PackedRsqrt<PackedDouble>)->Arg(4096);
+BENCHMARK(BM_PackedRsqrt<ScalarDouble>)->Arg(4096);
@@ -0,0 +1,92 @@
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "april/monitors/benchmark_report.hpp"
+
+using namespace april;
+
+
+/*
+ * Compares two benchmark result files (written by save_benchmark_json, e.g. april_macro_benchmarks --json)
+ * and flags runs whose step times got significantly slower.
+ *
+ *   april_compare_benchmarks BASELINE.json CANDIDATE.json [--alpha A] [--threshold T] [--warmup N]
+ *
+ * Exit codes: 0 no regression, 1 at least one regression, 2 usage or input error.
+ */
+
+namespace {
+	void print_usage() {
+		std::cerr << "usage: april_compare_benchmarks BASELINE.json CANDIDATE.json "
+					 "[--alpha A] [--threshold T] [--warmup N]\n"
+					 "  --alpha      significance level of the rank test (default 0.01)\n"
+					 "  --threshold  smallest relative change of the median step time to report (default 0.05)\n"
+					 "  --warmup     leading steps ignored in both runs (default 0)\n";
+	}
+}
+
+
+int main(const int argc, char** argv) {
+	try {
+		std::vector<std::string> files;
+		ComparisonOptions options;
+
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			auto value = [&]() -> std::string {
+				if (i + 1 >= argc) throw std::invalid_argument("missing value for " + std::string(arg));
+				return argv[++i];
+			};
+
+			if (arg == "--alpha") options.alpha = std::stod(value());
+			else if (arg == "--threshold") options.threshold = std::stod(value());
+			else if (arg == "--warmup") options.warmup_steps = std::stoul(value());
+			else if (arg == "-h" || arg == "--help") { print_usage(); return EXIT_SUCCESS; }
+			else if (arg.starts_with("--")) throw std::invalid_argument("unknown option " + std::string(arg));
+			else files.emplace_back(arg);
+		}
+
+		if (files.size() != 2) {
+			print_usage();
+			return 2;
+		}
+
+		const auto baseline = load_benchmark_json(files[0]);
+		const auto candidate = load_benchmark_json(files[1]);
+		const auto comparisons = compare_benchmarks(baseline, candidate, options);
+
+		if (!baseline.empty() && !candidate.empty() && baseline.front().info.host.cpu_model != candidate.front().info.host.cpu_model) {
+			std::cerr << "warning: results come from different CPUs (" << baseline.front().info.host.cpu_model
+					  << " vs " << candidate.front().info.host.cpu_model << ")\n";
+		}
+
+		size_t regressions = 0;
+		std::cout << std::left << std::setw(48) << "run" << std::right
+				  << std::setw(14) << "base [s]" << std::setw(14) << "cand [s]"
+				  << std::setw(10) << "change" << std::setw(11) << "p" << "  verdict\n";
+
+		for (const auto& c : comparisons) {
+			const double p = c.change >= 0 ? c.p_slower : c.p_faster;
+			std::cout << std::left << std::setw(48) << c.name << std::right
+					  << std::scientific << std::setprecision(4)
+					  << std::setw(14) << c.baseline_median << std::setw(14) << c.candidate_median
+					  << std::fixed << std::setprecision(1) << std::showpos
+					  << std::setw(9) << 100 * c.change << "%" << std::noshowpos
+					  << std::scientific << std::setprecision(2) << std::setw(11) << p
+					  << "  " << verdict_name(c.verdict) << "\n";
+			if (c.verdict == Verdict::Regression) ++regressions;
+		}
+
+		std::cout << "\n" << regressions << " regression(s) in " << comparisons.size() << " run(s)\n";
+		return regressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+
+	} catch (const std::exception& e) {
+		std::cerr << "april_compare_benchmarks: " << e.what() << "\n";
+		return 2;
+	}
+}
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "april/utility/telemetry_buffer.hpp"
+
+using namespace april::utility;
+
+
+/*
+ * Follows the telemetry segment of a running simulation (see the Telemetry monitor) and prints one line per
+ * published sample until the run finishes or its process is gone.
+ *
+ *   april_telemetry_reader NAME [--interval MS] [--csv] [--latest]
+ *
+ * --latest prints only the most recent sample and exits. Exit codes: 0 run finished (or --latest),
+ * 1 the writing process died before finishing, 2 usage or input error.
+ */
+
+namespace {
+	void print_usage() {
+		std::cerr << "usage: april_telemetry_reader NAME [--interval MS] [--csv] [--latest]\n"
+					 "  NAME        shared memory segment of the run, e.g. /april_telemetry_1234\n"
+					 "  --interval  polling interval in milliseconds (default 500)\n"
+					 "  --csv       print comma separated values instead of a table\n"
+					 "  --latest    print the most recent sample and exit\n";
+	}
+
+	// share of the step time in the table view
+	struct ShownStage {
+		Stage stage;
+		const char* label;
+	};
+	constexpr ShownStage shown_stages[] = {
+		{Stage::Drift, "% drift"}, {Stage::RebuildStructure, "% rebuild"}, {Stage::UpdateForces, "% forces"}, {Stage::Kick, "% kick"}
+	};
+
+	void print_header(const bool csv) {
+		if (csv) {
+			std::cout << "step,time,wall_time_sec,steps_per_sec,mups,step_time_sec";
+			for (size_t s = 0; s < telemetry_stage_slots; ++s) {
+				std::string name(stage_name(static_cast<Stage>(s)));
+				for (char& c : name) if (c == ' ') c = '_';
+				std::cout << "," << name << "_sec";
+			}
+			std::cout << ",alive,passive,stationary,dead,rebuilds,rebuild_frequency,kinetic_energy,temperature\n";
+			return;
+		}
+
+		std::cout << std::setw(10) << "step" << std::setw(12) << "steps/s" << std::setw(10) << "MUPS";
+		for (const auto& s : shown_stages) std::cout << std::setw(12) << s.label;
+		std::cout << std::setw(10) << "alive" << std::setw(12) << "rebuilds/st" << std::setw(14) << "E_kin"
+				  << std::setw(12) << "T" << "\n";
+	}
+
+	void print_sample(const TelemetrySample& s, const bool csv) {
+		if (csv) {
+			std::cout << s.step << "," << s.time << "," << s.wall_time_sec << "," << s.steps_per_sec << ","
+					  << s.mups << "," << s.step_time_sec;
+			for (const double t : s.stage_sec) std::cout << "," << t;
+			for (const uint64_t n : s.particles) std::cout << "," << n;
+			std::cout << "," << s.rebuilds << "," << s.rebuild_frequency() << "," << s.kinetic_energy << ","
+					  << s.temperature << "\n";
+			return;
+		}
+
+		std::cout << std::fixed << std::setw(10) << s.step << std::setprecision(1) << std::setw(12) << s.steps_per_sec
+				  << std::setprecision(2) << std::setw(10) << s.mups;
+		for (const auto& shown : shown_stages) {
+			const double share = s.step_time_sec > 0 ? 100 * s.stage_time(shown.stage) / s.step_time_sec : 0.0;
+			std::cout << std::setprecision(1) << std::setw(12) << share;
+		}
+		std::cout << std::setw(10) << s.count(TelemetryCount::Alive) << std::setprecision(3) << std::setw(12)
+				  << s.rebuild_frequency() << std::scientific << std::setprecision(4) << std::setw(14)
+				  << s.kinetic_energy << std::setw(12) << s.temperature << std::defaultfloat << "\n";
+	}
+}
+
+
+int main(const int argc, char** argv) {
+	try {
+		std::string name;
+		int interval_ms = 500;
+		bool csv = false;
+		bool latest_only = false;
+
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			if (arg == "--interval") {
+				if (i + 1 >= argc) throw std::invalid_argument("missing value for --interval");
+				interval_ms = std::stoi(argv[++i]);
+			}
+			else if (arg == "--csv") csv = true;
+			else if (arg == "--latest") latest_only = true;
+			else if (arg == "-h" || arg == "--help") { print_usage(); return EXIT_SUCCESS; }
+			else if (arg.starts_with("--")) throw std::invalid_argument("unknown option " + std::string(arg));
+			else name = arg;
+		}
+
+		if (name.empty()) {
+			print_usage();
+			return 2;
+		}
+
+		const TelemetryReader reader(name);
+		std::cerr << "run " << reader.run_name() << " (pid " << reader.writer_pid() << ")\n";
+		print_header(csv);
+
+		if (latest_only) {
+			if (const auto sample = reader.latest()) print_sample(*sample, csv);
+			return EXIT_SUCCESS;
+		}
+
+		uint64_t cursor = 0;
+		uint64_t lost = 0;
+		while (true) {
+			// read the status first: samples published before Finished are still picked up below
+			const TelemetryStatus status = reader.status();
+			for (const auto& sample : reader.poll(cursor, &lost)) print_sample(sample, csv);
+			std::cout.flush();
+
+			if (status == TelemetryStatus::Finished) break;
+			if (!reader.writer_alive()) {
+				std::cerr << "april_telemetry_reader: writer process exited before finishing the run\n";
+				return EXIT_FAILURE;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+		}
+
+		if (lost) std::cerr << lost << " samples were overwritten before they could be read\n";
+	} catch (const std::exception& e) {
+		std::cerr << "april_telemetry_reader: " << e.what() << "\n";
+		return 2;
+	}
+	return EXIT_SUCCESS;
+}
@@ -111,11 +111,14 @@ int main() {
     auto container = DirectSum<Layout::AoS>();
     auto system = build_system(env, container, cfg);
 
-    // 6. Run the Simulation with Yoshida4
-    auto integrator = Yoshida4(system, monitors<ProgressBar, BinaryOutput>)
-        .with_monitor(BinaryOutput(Trigger::every(10), dir_path.string()))
-        .with_monitor(ProgressBar(Trigger::every(10)))
-        .run_for_duration(0.005, 20); // Small timestep, 2000 steps
+    // 6. Run the Simulation with block time steps: stars near the core use steps down to
+    // 0.16 / 2^5 = 0.005 while the outer disk advances with the full 0.16
+    auto integrator = BlockTimestep(system, monitors<ProgressBar, BinaryOutput>)
+        .with_max_level(5)
+        .with_length_scale(0.1)
+        .with_monitor(BinaryOutput(Trigger::every(1), dir_path.string()))
+        .with_monitor(ProgressBar(Trigger::every(1)))
+        .run_for_duration(0.16, 20); // 125 outer steps
 
     return 0;
 }
\ No newline at end of file
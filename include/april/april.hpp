@@ -13,6 +13,9 @@
 #include "april/interactions/lennard_jones.hpp"
 #include "april/interactions/no_force.hpp"
 #include "april/interactions/coulomb.hpp"
+#include "april/interactions/harmonic_angle.hpp"
+#include "april/interactions/cosine_dihedral.hpp"
+#include "april/interactions/sutton_chen.hpp"
 
 // Controllers & Fields
 #include "april/controllers/thermostat.hpp"
@@ -29,6 +32,8 @@
 // Integration
 #include "april/integrators/velocity_verlet.hpp"
 #include "april/integrators/yoshida4.hpp"
+#include "april/integrators/respa.hpp"
+#include "april/integrators/block_timestep.hpp"
 
 // Core
 #include "april/core/environment.hpp"
@@ -39,6 +44,11 @@
 #include "april/monitors/binary_output.hpp"
 #include "april/monitors/progressbar.hpp"
 #include "april/monitors/benchmark.hpp"
+#include "april/monitors/benchmark_report.hpp"
+#include "april/monitors/stage_timer.hpp"
+#include "april/monitors/interaction_diagnostics.hpp"
+#include "april/monitors/telemetry.hpp"
+#include "april/monitors/skin_tuning_report.hpp"
 
 // common math functions
 #include "april/math/math.hpp"
@@ -47,9 +57,11 @@
  * Available in the april:: namespace:
  * Boundaries:   Absorb, Open, Periodic, Reflective, Repulsive
  * Forces:       LennardJones, Gravity, Harmonic, Coulomb, NoForce
+ * Bonded:       HarmonicAngle, CosineDihedral
+ * Many-body:    SuttonChen
  * Containers:   LinkedCells, DirectSum, Layout::[AoS, SoA, AoSoA]
- * Integrators:  VelocityVerlet, Yoshida4
- * Monitors:     TerminalOutput, BinaryOutput, ProgressBar, Benchmark
+ * Integrators:  VelocityVerlet, Yoshida4, Respa, BlockTimestep
+ * Monitors:     TerminalOutput, BinaryOutput, ProgressBar, Benchmark, StageTimer, Telemetry, SkinTuningReport
  */
 
 
@@ -56,8 +56,8 @@ namespace april::container::batching {
 			// Must declare its arity.
 			{ B::arity } -> std::convertible_to<std::size_t>;
 
-			// Must expose one ParticleType per argument.
-			{ batch.representatives } -> std::convertible_to<const std::array<ParticleType, B::arity>&>;
+			// Must expose the ParticleIDs of a representative interaction.
+			{ batch.ids } -> std::convertible_to<const std::array<ParticleID, B::arity>&>;
 			{ batch.interactions } -> std::convertible_to<const std::vector<std::array<ParticleID, B::arity>>&>;
 
 			// Must implement at least the first declared execution path.
@@ -12,6 +12,8 @@
 
 #include "april/base/macros.hpp"
 #include "april/containers/batching/batch.hpp"
+#include "april/containers/batching/write_back.hpp"
+#include "april/containers/batching/sorted_sweep.hpp"
 #include "april/math/range.hpp"
 
 #include "april/exec/policy.hpp"
@@ -25,10 +27,12 @@ namespace april::container::batching {
         /**
          * 360-degree SIMD rotation sweep for distinct blocks (N^2 within the blocks).
          * Pairs every lane in b1 with every lane in acc2 (accumulator) via cyclic rotation.
-         * Reciprocal forces are accumulated into acc2 memory at the end.
+         * Reciprocal forces are accumulated into acc2 memory at the end (unless write_back2 is false).
          */
         template <typename Buffer1, typename PackedAccessor, typename Kernel>
-        APRIL_FORCE_INLINE inline void interact_block_vs_block(Buffer1& b1, PackedAccessor&& acc2, Kernel& f) {
+        APRIL_FORCE_INLINE inline void interact_block_vs_block(
+            Buffer1& b1, PackedAccessor&& acc2, Kernel& f, const bool write_back2 = true
+        ) {
             auto b2 = acc2.load_buffer();
 
             // interact all pairs {p1, p2} with p1 in b1, p2 in b2
@@ -38,7 +42,7 @@ namespace april::container::batching {
                 b2.rotate_right();
             }
 
-            b2.update_into(acc2); // Flush accumulated forces back to memory
+            if (write_back2) b2.update_into(acc2); // Flush accumulated forces back to memory
         }
 
 
@@ -108,6 +112,8 @@ namespace april::container::batching {
                 }
             }
 
+            SortedSweep sweep; // skips pairs out of reach if the ranges are sorted (keys by flat index)
+
         protected:
             Container& container;
             ChunkPtr* APRIL_RESTRICT const chunks;
@@ -115,6 +121,22 @@ namespace april::container::batching {
             static constexpr size_t packed_size = packed::size(); // power of 2
             static constexpr size_t iter_chunks = chunk_size / packed_size; // how many packed units in a chunk
             alignas(64) packed::value_type idx_arr[packed_size]{};
+
+            // flat range of the valid particles of a chunk range (tail 0 = full last chunk)
+            [[nodiscard]] static math::Range flat_range(const math::Range& range_chunks, const size_t tail) noexcept {
+                const size_t n = range_chunks.size() * chunk_size - (tail == 0 ? 0 : chunk_size - tail);
+                return {range_chunks.start * chunk_size, range_chunks.start * chunk_size + n};
+            }
+
+            // true if the n1 particles from (c1, i) and the n2 particles from (c2, j) are out of reach of each other
+            [[nodiscard]] APRIL_FORCE_INLINE bool apart(
+                const size_t c1, const size_t i, const size_t n1, const size_t c2, const size_t j, const size_t n2
+            ) const noexcept {
+                if (!sweep.active()) return false;
+                const size_t a = c1 * chunk_size + i;
+                const size_t b = c2 * chunk_size + j;
+                return sweep.apart(a, a + n1 - 1, b, b + n2 - 1);
+            }
         };
     }
 
@@ -129,6 +151,7 @@ namespace april::container::batching {
     struct AsymmetricChunkedBatch : internal::ChunkedBatchBase<Container, ChunkPtr> {
         using Base = internal::ChunkedBatchBase<Container, ChunkPtr>;
         using Base::Base, Base::container, Base::chunks, Base::chunk_size, Base::packed_size, Base::iter_chunks, Base::idx_arr;
+        using Base::sweep, Base::flat_range, Base::apart;
         friend Base;
 
         [[nodiscard]] bool empty() const noexcept{
@@ -140,9 +163,20 @@ namespace april::container::batching {
         math::Range range2_chunks;
         size_t range1_tail{}; // Number of valid items in the last chunk of range1 (0 = Full)
         size_t range2_tail{};
+        PairWriteBack writes = PairWriteBack::Both;
 
     private:
 
+        // visits every valid (chunk, index) of a chunk range, honouring the partially filled last chunk
+        template <typename F>
+        APRIL_FORCE_INLINE void for_each_index(const math::Range& range_chunks, const size_t tail, F&& fn) const {
+            const size_t limit_tail = (tail == 0) ? chunk_size : tail;
+            for (size_t c = range_chunks.start; c < range_chunks.stop; ++c) {
+                const size_t n = (c + 1 == range_chunks.stop) ? limit_tail : chunk_size;
+                for (size_t i = 0; i < n; ++i) fn(c, i);
+            }
+        }
+
         //------------
         // SCALAR PATH
         //------------
@@ -154,6 +188,38 @@ namespace april::container::batching {
         void for_each_pair_scalar(Kernel && f) const {
             internal::BatchContext ctx(container, f);
 
+            if (sweep.active()) {
+                for_each_pair_sorted(ctx, f);
+                return;
+            }
+
+            // owner-only batches: the read-only side becomes the outer loop and is copied once per particle
+            if (writes != PairWriteBack::Both) {
+                using K = std::remove_cvref_t<Kernel>;
+                using Shadow = ShadowParticle<K::Read, K::Write, typename Container::ParticleAttributes>;
+
+                if (writes == PairWriteBack::First) {
+                    for_each_index(range2_chunks, range2_tail, [&](const size_t c2, const size_t j) {
+                        Shadow shadow(ctx.scalar(c2, j));
+                        auto p2 = shadow.ref();
+                        for_each_index(range1_chunks, range1_tail, [&](const size_t c1, const size_t i) {
+                            auto p1 = ctx.scalar(c1, i);
+                            f(p1, p2);
+                        });
+                    });
+                } else {
+                    for_each_index(range1_chunks, range1_tail, [&](const size_t c1, const size_t i) {
+                        Shadow shadow(ctx.scalar(c1, i));
+                        auto p1 = shadow.ref();
+                        for_each_index(range2_chunks, range2_tail, [&](const size_t c2, const size_t j) {
+                            auto p2 = ctx.scalar(c2, j);
+                            f(p1, p2);
+                        });
+                    });
+                }
+                return;
+            }
+
             // peel of last chunk (i.e. the tail)
             const size_t c1_body_end = range1_chunks.stop - 1;
             const size_t c2_body_end = range2_chunks.stop - 1;
@@ -213,6 +279,54 @@ namespace april::container::batching {
             }
         }
 
+        /**
+         * Scalar path over sorted ranges. The valid particles of both ranges are contiguous in flat index
+         * space, every particle only meets the window of the other range within reach.
+         */
+        template <typename Context, typename Kernel>
+        void for_each_pair_sorted(const Context& ctx, Kernel& f) const {
+            using K = std::remove_cvref_t<Kernel>;
+            using Shadow = ShadowParticle<K::Read, K::Write, typename Container::ParticleAttributes>;
+
+            auto at = [&](const size_t idx) { return ctx.scalar(idx / chunk_size, idx % chunk_size); };
+            const math::Range flat1 = flat_range(range1_chunks, range1_tail);
+            const math::Range flat2 = flat_range(range2_chunks, range2_tail);
+
+            if (writes == PairWriteBack::First) {
+                sweep.for_each_window(flat2, flat1, [&](const size_t j, const math::Range& window) {
+                    if (window.empty()) return;
+                    Shadow shadow(at(j));
+                    auto p2 = shadow.ref();
+                    for (const size_t i : window) {
+                        auto p1 = at(i);
+                        f(p1, p2);
+                    }
+                });
+                return;
+            }
+            if (writes == PairWriteBack::Second) {
+                sweep.for_each_window(flat1, flat2, [&](const size_t i, const math::Range& window) {
+                    if (window.empty()) return;
+                    Shadow shadow(at(i));
+                    auto p1 = shadow.ref();
+                    for (const size_t j : window) {
+                        auto p2 = at(j);
+                        f(p1, p2);
+                    }
+                });
+                return;
+            }
+
+            sweep.for_each_window(flat1, flat2, [&](const size_t i, const math::Range& window) {
+                if (window.empty()) return;
+                auto p1 = at(i);
+                for (const size_t j : window) {
+                    auto p2 = at(j);
+                    f(p1, p2);
+                }
+            });
+        }
+
 
         //----------
         // SIMD PATH
@@ -266,6 +380,10 @@ namespace april::container::batching {
             using namespace internal;
             BatchContext ctx(container, f);
 
+            // the read-only side of an owner-only batch is still loaded (its force included) but never stored back
+            const bool write1 = writes_first(writes);
+            const bool write2 = writes_second(writes);
+
             // 1. full SIMD blocks in range 1 (Chunks) vs full SIMD blocks in range 2 (Chunks + Tail)
             for (size_t c1 : full_chunks1) {
                 ctx.prefetch( c1 + 1);
@@ -279,16 +397,18 @@ namespace april::container::batching {
                         ctx.prefetch_nta( c2 + 1);
                         APRIL_UNROLL_LOOP_N(iter_chunks)
                         for (size_t j = 0; j < chunk_size; j += packed_size) {
-                            interact_block_vs_block(buffer1, ctx.packed(c2, j), f);
+                            if (apart(c1, i, packed_size, c2, j, packed_size)) continue;
+                            interact_block_vs_block(buffer1, ctx.packed(c2, j), f, write2);
                         }
                     }
 
                     // b. sweep buffer1 across SIMD-aligned blocks within the Range 2 tail chunk [F2]
                     for (size_t t2 : full_tail2) {
-                        interact_block_vs_block(buffer1, ctx.packed(full_chunks2.stop, t2), f);
+                        if (apart(c1, i, packed_size, full_chunks2.stop, t2, packed_size)) continue;
+                        interact_block_vs_block(buffer1, ctx.packed(full_chunks2.stop, t2), f, write2);
                     }
 
-                    buffer1.update_into(packed1); // final register flush for buffer1
+                    if (write1) buffer1.update_into(packed1); // final register flush for buffer1
                 }
             }
 
@@ -302,15 +422,17 @@ namespace april::container::batching {
                     ctx.prefetch_nta( c2 + 1);
                     APRIL_UNROLL_LOOP_N(iter_chunks)
                     for (size_t j = 0; j < chunk_size; j += packed_size) {
-                        interact_block_vs_block(buffer1, ctx.packed(c2, j), f);
+                        if (apart(full_chunks1.stop, t1, packed_size, c2, j, packed_size)) continue;
+                        interact_block_vs_block(buffer1, ctx.packed(c2, j), f, write2);
                     }
                 }
 
                 // b. Interaction with SIMD-aligned blocks within the Range 2 tail chunk [F2]
                 for (size_t t2 : full_tail2) {
-                    interact_block_vs_block(buffer1, ctx.packed(full_chunks2.stop, t2), f);
+                    if (apart(full_chunks1.stop, t1, packed_size, full_chunks2.stop, t2, packed_size)) continue;
+                    interact_block_vs_block(buffer1, ctx.packed(full_chunks2.stop, t2), f, write2);
                 }
-                buffer1.update_into(packed1);
+                if (write1) buffer1.update_into(packed1);
             }
         }
 
@@ -320,7 +442,7 @@ namespace april::container::batching {
         APRIL_FORCE_INLINE void interact_block1_vs_scalar2(PackedAccessor&& p1_block, BufferScalar& p2_scalar, Kernel& f) const {
             auto b_block = p1_block.load_buffer();
             f(b_block.to_view(), p2_scalar.to_view()); // P1 first, P2 second
-            b_block.update_into(p1_block);
+            if (writes_first(writes)) b_block.update_into(p1_block);
         }
 
 
@@ -329,7 +451,7 @@ namespace april::container::batching {
         APRIL_FORCE_INLINE void interact_scalar1_vs_block2(BufferScalar& p1_scalar, PackedAccessor&& p2_block, Kernel& f) const {
             auto b_block = p2_block.load_buffer();
             f(p1_scalar.to_view(), b_block.to_view()); // P1 first, P2 second
-            b_block.update_into(p2_block);
+            if (writes_second(writes)) b_block.update_into(p2_block);
         }
 
 
@@ -352,15 +474,19 @@ namespace april::container::batching {
                 for (size_t c1 : full_chunks1) {
                     ctx.prefetch_nta(c1 + 1);
                     APRIL_UNROLL_LOOP_N(iter_chunks)
-                    for (size_t j = 0; j < chunk_size; j += packed_size)
+                    for (size_t j = 0; j < chunk_size; j += packed_size) {
+                        if (apart(c1, j, packed_size, full_chunks2.stop, i, 1)) continue;
                         interact_block1_vs_scalar2(ctx.packed(c1, j), buffer2, f);
+                    }
                 }
 
                 // b. Interaction with SIMD-aligned blocks in Range 1 tail chunk
-                for (size_t t1 : full_tail1)
+                for (size_t t1 : full_tail1) {
+                    if (apart(full_chunks1.stop, t1, packed_size, full_chunks2.stop, i, 1)) continue;
                     interact_block1_vs_scalar2(ctx.packed(full_chunks1.stop, t1), buffer2, f);
+                }
 
-                buffer2.reduce_into(p2);
+                if (writes_second(writes)) buffer2.reduce_into(p2);
             }
 
             // Partial Tail 1 vs Full Range 2 (chunks + full tail)
@@ -372,15 +498,19 @@ namespace april::container::batching {
                 for (size_t c2 : full_chunks2) {
                     ctx.prefetch_nta( c2 + 1);
                     APRIL_UNROLL_LOOP_N(iter_chunks)
-                    for (size_t j = 0; j < chunk_size; j += packed_size)
+                    for (size_t j = 0; j < chunk_size; j += packed_size) {
+                        if (apart(full_chunks1.stop, i, 1, c2, j, packed_size)) continue;
                         interact_scalar1_vs_block2(buffer1, ctx.packed(c2, j), f);
+                    }
                 }
 
                 // b. Interaction with SIMD-aligned blocks in Range 2 tail chunk
-                for (size_t t2 : full_tail2)
+                for (size_t t2 : full_tail2) {
+                    if (apart(full_chunks1.stop, i, 1, full_chunks2.stop, t2, packed_size)) continue;
                     interact_scalar1_vs_block2(buffer1, ctx.packed(full_chunks2.stop, t2), f);
+                }
 
-                buffer1.reduce_into(p1);
+                if (writes_first(writes)) buffer1.reduce_into(p1);
             }
         }
 
@@ -413,11 +543,11 @@ namespace april::container::batching {
                     auto view2 = buffer2.to_view();
                     f(view1, view2);
 
-                    buffer2.reduce_into(p2, mask);
+                    if (writes_second(writes)) buffer2.reduce_into(p2, mask);
                 }
 
                 // write back valid lanes to memory for packed1
-                buffer1.update_into(packed1, mask);
+                if (writes_first(writes)) buffer1.update_into(packed1, mask);
             }
         }
     };
@@ -438,6 +568,7 @@ namespace april::container::batching {
     struct SymmetricChunkedBatch : internal::ChunkedBatchBase<Container, ChunkPtr> {
         using Base = internal::ChunkedBatchBase<Container, ChunkPtr>;
         using Base::Base, Base::container, Base::chunks, Base::chunk_size, Base::packed_size, Base::iter_chunks, Base::idx_arr;
+        using Base::sweep, Base::flat_range, Base::apart;
         friend Base;
 
         [[nodiscard]] bool empty() const noexcept{
@@ -456,6 +587,21 @@ namespace april::container::batching {
         void for_each_pair_scalar(Kernel && f) const {
             internal::BatchContext ctx(container, f);
 
+            // sorted range: every particle only meets the particles after it within reach
+            if (sweep.active()) {
+                auto at = [&](const size_t idx) { return ctx.scalar(idx / chunk_size, idx % chunk_size); };
+                const math::Range flat = flat_range(range_chunks, range_tail);
+                sweep.for_each_window(flat, flat, [&](const size_t i, const math::Range& window) {
+                    if (window.stop <= i + 1) return;
+                    auto p1 = at(i);
+                    for (size_t j = std::max(window.start, i + 1); j < window.stop; ++j) {
+                        auto p2 = at(j);
+                        f(p1, p2);
+                    }
+                });
+                return;
+            }
+
             const size_t c_body_end = range_chunks.stop - 1;
             // Note: Use chunk_size here for full chunks, not packed_size
             const size_t limit_tail = (range_tail == 0) ? chunk_size : range_tail;
@@ -602,6 +748,7 @@ namespace april::container::batching {
 
                     // b. intra-chunk interactions (Block i vs Blocks j where j > i inside c1)
                     for (size_t j = i + packed_size; j < chunk_size; j += packed_size) {
+                        if (apart(c1, i, packed_size, c1, j, packed_size)) continue;
                         interact_block_vs_block(buffer1, ctx.packed(c1, j), f);
                     }
 
@@ -610,17 +757,20 @@ namespace april::container::batching {
                         ctx.prefetch_nta( c2 + 1);
                         APRIL_UNROLL_LOOP_N(iter_chunks)
                         for (size_t j = 0; j < chunk_size; j += packed_size) {
+                            if (apart(c1, i, packed_size, c2, j, packed_size)) continue;
                             interact_block_vs_block(buffer1, ctx.packed(c2, j), f);
                         }
                     }
 
                     // d. interaction with SIMD-aligned blocks in the tail chunk [F]
                     for (size_t j : full_tail) {
+                        if (apart(c1, i, packed_size, full_chunks.stop, j, packed_size)) continue;
                         interact_block_vs_block(buffer1, ctx.packed(full_chunks.stop, j), f);
                     }
 
                     // e. interaction with partial particles in the tail chunk [P]
                     for (size_t j : partial_tail) {
+                        if (apart(c1, i, packed_size, full_chunks.stop, j, 1)) continue;
                         interact_block_vs_scalar(buffer1, ctx.scalar(full_chunks.stop, j), f);
                     }
 
@@ -651,11 +801,13 @@ namespace april::container::batching {
 
                 // b. intra-chunk interactions (Block i vs Blocks j where j > i inside full tail)
                 for (size_t j = i + packed_size; j < full_tail_end; j += packed_size) {
+                    if (apart(full_chunks.stop, i, packed_size, full_chunks.stop, j, packed_size)) continue;
                     interact_block_vs_block(buffer1, ctx.packed(full_chunks.stop, j), f);
                 }
 
                 // c interaction with partial particles in the tail chunk [P]
                 for (size_t j : partial_tail) {
+                    if (apart(full_chunks.stop, i, packed_size, full_chunks.stop, j, 1)) continue;
                     interact_block_vs_scalar(buffer1, ctx.scalar(full_chunks.stop, j), f);
                 }
 
@@ -2,6 +2,8 @@
 
 #include "april/base/macros.hpp"
 #include "april/containers/batching/batch.hpp"
+#include "april/containers/batching/write_back.hpp"
+#include "april/containers/batching/sorted_sweep.hpp"
 #include "april/math/range.hpp"
 
 #include "april/exec/policy.hpp"
@@ -34,6 +36,8 @@ namespace april::container::batching {
 
 		math::Range range1;
 		math::Range range2;
+		PairWriteBack writes = PairWriteBack::Both;
+		SortedSweep sweep; // skips pairs out of reach if both ranges are sorted
 	private:
 		Container & container;
 		static constexpr size_t packed_size = packed::size();
@@ -55,6 +59,13 @@ namespace april::container::batching {
 	    void for_each_pair_packed(Kernel&& f) const {
 			using K = std::remove_cvref_t<Kernel>;
 
+			// the read-only side of an owner-only batch is still loaded (its force included) but never stored back.
+			const bool write1 = writes_first(writes);
+			const bool write2 = writes_second(writes);
+
+			// sorted ranges: block pairs out of reach are skipped whole, the rotation sweep itself is unchanged
+			const bool prune = sweep.active();
+
 			// Calculate Alignment Boundaries for Range 1
 			const size_t r1_rem = range1.size() % packed_size;
 			const size_t tail1_start = range1.stop - r1_rem;
@@ -73,6 +84,8 @@ namespace april::container::batching {
 				auto buffer1 = packed1.load_buffer();
 
 				for (size_t j : body2) {
+					if (prune && sweep.apart(i, i + packed_size - 1, j, j + packed_size - 1)) continue;
+
 					auto packed2 = container.template at_packed<K::Read, K::Write>(j);
 					auto buffer2 = packed2.load_buffer();
 					APRIL_UNROLL_LOOP_N(packed_size)
@@ -82,9 +95,9 @@ namespace april::container::batching {
 						f(view1, view2);
 						buffer2.rotate_right();
 					}
-					buffer2.update_into(packed2);
+					if (write2) buffer2.update_into(packed2);
 				}
-				buffer1.update_into(packed1);
+				if (write1) buffer1.update_into(packed1);
 			}
 
 			// tail1 vs body2
@@ -93,6 +106,8 @@ namespace april::container::batching {
 				auto buffer1 = p1.broadcast();
 
 				for (size_t j : body2) {
+					if (prune && sweep.apart(i, i, j, j + packed_size - 1)) continue;
+
 					auto packed2 = container.template at_packed<K::Read, K::Write>(j);
 					auto buffer2 = packed2.load_buffer();
 
@@ -100,10 +115,10 @@ namespace april::container::batching {
 					auto view2 = buffer2.to_view();
 					f(view1, view2);
 
-					buffer2.update_into(packed2);
+					if (write2) buffer2.update_into(packed2);
 				}
 
-				buffer1.reduce_into(p1);
+				if (write1) buffer1.reduce_into(p1);
 			}
 
 			// tail2 vs body 2
@@ -112,6 +127,8 @@ namespace april::container::batching {
 				auto buffer2 = p2.broadcast();
 
 				for (size_t j : body1) {
+					if (prune && sweep.apart(j, j + packed_size - 1, i, i)) continue;
+
 					auto packed1 = container.template at_packed<K::Read, K::Write>(j);
 					auto buffer1 = packed1.load_buffer();
 
@@ -119,10 +136,10 @@ namespace april::container::batching {
 					auto view2 = buffer2.to_view();
 					f(view1, view2);
 
-					buffer1.update_into(packed1);
+					if (write1) buffer1.update_into(packed1);
 				}
 
-				buffer2.reduce_into(p2);
+				if (write2) buffer2.reduce_into(p2);
 			}
 
 			if (r1_rem > 0 && r2_rem > 0) {
@@ -140,10 +157,10 @@ namespace april::container::batching {
 					auto view2 = buffer2.to_view();
 					f(view1, view2);
 
-					buffer2.reduce_into(p2, mask);
+					if (write2) buffer2.reduce_into(p2, mask);
 				}
 
-				buffer1.update_into(packed1, mask);
+				if (write1) buffer1.update_into(packed1, mask);
 			}
 	    };
 
@@ -152,6 +169,37 @@ namespace april::container::batching {
 		template<exec::IsKernel Kernel>
 		void for_each_pair_scalar(Kernel&& f) const {
 			using K = std::remove_cvref_t<Kernel>;
+			using Shadow = ShadowParticle<K::Read, K::Write, typename Container::ParticleAttributes>;
+
+			if (sweep.active()) {
+				for_each_pair_sorted(std::forward<Kernel>(f));
+				return;
+			}
+
+			// owner-only batches: the read-only side becomes the outer loop and is copied once per particle
+			if (writes == PairWriteBack::First) {
+				for (size_t j = range2.start; j < range2.stop; ++j) {
+					Shadow shadow(container.template view<K::Read | K::Write>(j));
+					auto p2 = shadow.ref();
+					for (size_t i = range1.start; i < range1.stop; ++i) {
+						auto p1 = container.template at<K::Read, K::Write>(i);
+						f(p1, p2);
+					}
+				}
+				return;
+			}
+			if (writes == PairWriteBack::Second) {
+				for (size_t i = range1.start; i < range1.stop; ++i) {
+					Shadow shadow(container.template view<K::Read | K::Write>(i));
+					auto p1 = shadow.ref();
+					for (size_t j = range2.start; j < range2.stop; ++j) {
+						auto p2 = container.template at<K::Read, K::Write>(j);
+						f(p1, p2);
+					}
+				}
+				return;
+			}
+
 			for (size_t i = range1.start; i < range1.stop; ++i) {
 				auto p1 = container.template at<K::Read, K::Write>(i);
 				for (size_t j = range2.start; j < range2.stop; ++j) {
@@ -160,6 +208,47 @@ namespace april::container::batching {
 				}
 			}
 		}
+
+		// scalar path over sorted ranges: every particle only meets the window of the other range within reach
+		template<exec::IsKernel Kernel>
+		void for_each_pair_sorted(Kernel&& f) const {
+			using K = std::remove_cvref_t<Kernel>;
+			using Shadow = ShadowParticle<K::Read, K::Write, typename Container::ParticleAttributes>;
+
+			if (writes == PairWriteBack::First) {
+				sweep.for_each_window(range2, range1, [&](const size_t j, const math::Range& window) {
+					if (window.empty()) return;
+					Shadow shadow(container.template view<K::Read | K::Write>(j));
+					auto p2 = shadow.ref();
+					for (const size_t i : window) {
+						auto p1 = container.template at<K::Read, K::Write>(i);
+						f(p1, p2);
+					}
+				});
+				return;
+			}
+			if (writes == PairWriteBack::Second) {
+				sweep.for_each_window(range1, range2, [&](const size_t i, const math::Range& window) {
+					if (window.empty()) return;
+					Shadow shadow(container.template view<K::Read | K::Write>(i));
+					auto p1 = shadow.ref();
+					for (const size_t j : window) {
+						auto p2 = container.template at<K::Read, K::Write>(j);
+						f(p1, p2);
+					}
+				});
+				return;
+			}
+
+			sweep.for_each_window(range1, range2, [&](const size_t i, const math::Range& window) {
+				if (window.empty()) return;
+				auto p1 = container.template at<K::Read, K::Write>(i);
+				for (const size_t j : window) {
+					auto p2 = container.template at<K::Read, K::Write>(j);
+					f(p1, p2);
+				}
+			});
+		}
 	};
 
 
@@ -193,6 +282,7 @@ namespace april::container::batching {
 		}
 
 		math::Range range;
+		SortedSweep sweep; // skips pairs out of reach if the range is sorted
 	private:
 		Container & container;
 		static constexpr size_t packed_size = packed::size();
@@ -214,6 +304,8 @@ namespace april::container::batching {
 	    void for_each_pair_packed(Kernel&& f) const {
 	        using K = std::remove_cvref_t<Kernel>;
 
+	        const bool prune = sweep.active();
+
 	        // Calculate Alignment Boundaries
 	        const size_t rem = range.size() % packed_size;
 	        const size_t tail_start = range.stop - rem;
@@ -247,6 +339,8 @@ namespace april::container::batching {
 
 	            // block i vs block j (where j > i)
 	            for (size_t j = i + packed_size; j < tail_start; j += packed_size) {
+	                if (prune && sweep.apart(i, i + packed_size - 1, j, j + packed_size - 1)) continue;
+
 	                auto packed2 = container.template at_packed<K::Read, K::Write>(j);
 	                auto buffer2 = packed2.load_buffer();
 	                APRIL_UNROLL_LOOP_N(packed_size)
@@ -267,6 +361,7 @@ namespace april::container::batching {
 	            auto buffer1 = p1.broadcast();
 
 	            for (size_t j : body) {
+	                if (prune && sweep.apart(i, i, j, j + packed_size - 1)) continue;
 
 	                auto packed2 = container.template at_packed<K::Read, K::Write>(j);
 	                auto buffer2 = packed2.load_buffer();
@@ -312,6 +407,19 @@ namespace april::container::batching {
 		template<exec::IsKernel Kernel>
 		void for_each_pair_scalar(Kernel&& f) const {
 			using K = std::remove_cvref_t<Kernel>;
+
+			if (sweep.active()) {
+				sweep.for_each_window(range, range, [&](const size_t i, const math::Range& window) {
+					if (window.stop <= i + 1) return;
+					auto p1 = container.template at<K::Read, K::Write>(i);
+					for (size_t j = std::max(window.start, i + 1); j < window.stop; ++j) {
+						auto p2 = container.template at<K::Read, K::Write>(j);
+						f(p1, p2);
+					}
+				});
+				return;
+			}
+
 			for (size_t i = range.start; i < range.stop; ++i) {
 				auto p1 = container.template at<K::Read, K::Write>(i);
 				for (size_t j = i + 1; j < range.stop; ++j) {
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "april/base/macros.hpp"
+#include "april/math/range.hpp"
+
+
+namespace april::container::batching {
+
+	/**
+	 * @brief Sort-and-prune information of a pair batch.
+	 *
+	 * keys holds one sort key per container index (the position along the sort axis at the last reorder) and
+	 * is ascending within every range of the batch. Particles whose keys differ by more than reach can not
+	 * interact, so the pair loops skip them: scalar loops only visit the window of candidates around every
+	 * particle, packed loops drop whole blocks. A default constructed sweep prunes nothing.
+	 */
+	struct SortedSweep {
+		const double* keys = nullptr;
+		double reach = 0; // cutoff plus the distance particles may have moved since the keys were taken
+
+		[[nodiscard]] bool active() const noexcept { return keys != nullptr; }
+
+		// true if no particle of the sorted index block [first1, last1] is within reach of one in [first2, last2]
+		[[nodiscard]] APRIL_FORCE_INLINE bool apart(
+			const size_t first1, const size_t last1, const size_t first2, const size_t last2
+		) const noexcept {
+			return keys[first2] - keys[last1] > reach || keys[first1] - keys[last2] > reach;
+		}
+
+		// calls fn(o, window) for every index o of outer, window being the indices of inner within reach of o
+		template<typename Fn>
+		APRIL_FORCE_INLINE void for_each_window(const math::Range& outer, const math::Range& inner, Fn&& fn) const {
+			size_t lo = inner.start;
+			size_t hi = inner.start;
+			for (size_t o = outer.start; o < outer.stop; ++o) {
+				const double key = keys[o];
+				while (lo < inner.stop && keys[lo] < key - reach) ++lo;
+				hi = std::max(hi, lo);
+				while (hi < inner.stop && keys[hi] <= key + reach) ++hi;
+				fn(o, math::Range{lo, hi});
+			}
+		}
+	};
+}
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <vector>
 #include <utility>
 #include <numeric>
 
+#include "april/base/types.hpp"
 #include "april/exec/policy.hpp"
 #include "april/particle/properties.hpp"
 #include "april/utility/graph.hpp"
 #include "april/exec/kernel.hpp"
+#include "april/simd/locations.hpp"
+#include "april/particle/access/packed_access.hpp"
 
 namespace april::container::batching {
 
@@ -15,30 +22,117 @@ namespace april::container::batching {
     using ParticleSet = std::vector<ParticleID>;
 
 
+    // @Brief Reorders interactions such that the leading groups of `width` interactions each touch pairwise
+    // distinct particles. These groups can be gathered/scattered as SIMD lanes without write conflicts.
+    // Returns the number of full conflict-free groups. Interactions that could not be grouped are moved to the back.
+    template<std::size_t Arity, typename Node = ParticleID>
+    size_t build_conflict_free_lanes(std::vector<std::array<Node, Arity>> & interactions, const size_t width) {
+        if (width == 0 || interactions.size() < width) return 0;
+        if (width == 1) return interactions.size();
+
+        // bound the number of simultaneously open groups so that hub-like topologies
+        // (e.g. one particle bonded to many) do not degrade to quadratic run time
+        const size_t max_open_groups = 4 * width;
+
+        struct OpenGroup {
+            std::vector<size_t> members;
+            std::vector<Node> nodes;
+        };
+
+        std::vector<size_t> grouped;
+        std::vector<size_t> remainder;
+        std::vector<OpenGroup> open;
+        grouped.reserve(interactions.size());
+
+        auto conflicts = [&](const OpenGroup& group, const std::array<Node, Arity>& ids) {
+            for (const Node id : ids) {
+                if (std::ranges::find(group.nodes, id) != group.nodes.end()) return true;
+            }
+            return false;
+        };
+
+        for (size_t i = 0; i < interactions.size(); ++i) {
+            const auto& ids = interactions[i];
+
+            auto it = std::ranges::find_if(open, [&](const OpenGroup& group) { return !conflicts(group, ids); });
+            if (it == open.end()) {
+                if (open.size() >= max_open_groups) {
+                    remainder.push_back(i);
+                    continue;
+                }
+                open.emplace_back();
+                open.back().members.reserve(width);
+                open.back().nodes.reserve(width * Arity);
+                it = std::prev(open.end());
+            }
+
+            it->members.push_back(i);
+            it->nodes.insert(it->nodes.end(), ids.begin(), ids.end());
+
+            // group is complete -> emit it
+            if (it->members.size() == width) {
+                grouped.insert(grouped.end(), it->members.begin(), it->members.end());
+                *it = std::move(open.back());
+                open.pop_back();
+            }
+        }
+
+        // incomplete groups are handled by the remainder path
+        for (const auto& group : open) {
+            remainder.insert(remainder.end(), group.members.begin(), group.members.end());
+        }
+
+        std::vector<std::array<Node, Arity>> reordered;
+        reordered.reserve(interactions.size());
+        for (const size_t i : grouped) reordered.push_back(interactions[i]);
+        for (const size_t i : remainder) reordered.push_back(interactions[i]);
+        interactions = std::move(reordered);
+
+        return grouped.size() / width;
+    }
+
+
     template<std::size_t Arity, typename Container>
     struct TopologyBatch {
         static constexpr std::size_t arity = Arity;
 
-        using execution_paths = exec::ExecutionPaths<exec::ExecutionMode::Scalar>;
+        using execution_paths = exec::ExecutionPaths<exec::ExecutionMode::Packed, exec::ExecutionMode::Scalar>;
 
-        std::array<ParticleType, Arity> representatives{};
+        std::array<ParticleID, Arity> ids{}; // first tuple of the batch, identifies the interaction
         std::vector<std::array<ParticleID, Arity>> interactions;
         Container* container_ptr = nullptr;
 
+        // bonded batches (Arity > 2) only: index into InteractionMap::bonded_interactions
+        size_t descriptor = 0;
+
+        // the first lane_groups * packed::size() interactions form conflict-free SIMD lane groups
+        size_t lane_groups = 0;
+
+        // Reorders the interactions into conflict-free SIMD lane groups. Must be called once interactions are set.
+        void build_lane_groups() {
+            lane_groups = build_conflict_free_lanes(interactions, packed::size());
+        }
+
         template<exec::ExecutionMode Mode, exec::IsKernel Kernel>
         void for_each(Kernel&& kernel) const {
-            static_assert(Mode == exec::ExecutionMode::Scalar, "TopologyBatch only supports scalar execution.");
-
-            for (const auto& ids : interactions) {
-                invoke(
-                    ids,
-                    std::forward<Kernel>(kernel),
-                    std::make_index_sequence<Arity>{}
-                );
+            if constexpr (Mode == exec::ExecutionMode::Packed) {
+                for_each_packed(std::forward<Kernel>(kernel));
+            } else if constexpr (Mode == exec::ExecutionMode::Scalar) {
+                for (const auto& ids : interactions) {
+                    invoke(
+                        ids,
+                        std::forward<Kernel>(kernel),
+                        std::make_index_sequence<Arity>{}
+                    );
+                }
+            } else {
+                static_assert(false, "TopologyBatch only implements scalar and packed paths.");
             }
         }
 
     private:
+        static constexpr size_t width = packed::size();
+
         template<exec::IsKernel Kernel, std::size_t... I>
         void invoke(
             const std::array<ParticleID, Arity>& ids,
@@ -54,17 +148,116 @@ namespace april::container::batching {
                 >(ids[I])...
             );
         }
+
+        template<exec::IsKernel Kernel>
+        void for_each_packed(Kernel&& kernel) const {
+            using K = std::remove_cvref_t<Kernel>;
+
+            // 1. conflict-free lane groups: gather -> evaluate -> scatter
+            for (size_t g = 0; g < lane_groups; ++g) {
+                const auto* group = interactions.data() + g * width;
+
+                // recursively load one buffer per slot so that buffers are constructed in place
+                auto process = [&](this const auto& self, auto&... buffers) APRIL_FORCE_INLINE {
+                    constexpr size_t slot = sizeof...(buffers);
+                    if constexpr (slot == Arity) {
+                        kernel(buffers.to_view()...);
+                    } else {
+                        auto ref = gather<K::Read, K::Write>(group, slot);
+                        auto buffer = ref.load_buffer();
+                        self(buffers..., buffer);
+                        buffer.update_into(ref);
+                    }
+                };
+                process();
+            }
+
+            // 2. remainder: broadcast each particle and only reduce the first lane
+            const size_t n_grouped = lane_groups * width;
+            if (n_grouped == interactions.size()) return;
+
+            std::array<double, width> lane_indices{};
+            for (size_t k = 0; k < width; ++k) lane_indices[k] = static_cast<double>(k);
+            const auto first_lane = packed::load_unaligned(lane_indices.data()) < 1.0;
+
+            for (size_t i = n_grouped; i < interactions.size(); ++i) {
+                const auto& ids = interactions[i];
+
+                auto process = [&](this const auto& self, auto&... buffers) APRIL_FORCE_INLINE {
+                    constexpr size_t slot = sizeof...(buffers);
+                    if constexpr (slot == Arity) {
+                        kernel(buffers.to_view()...);
+                    } else {
+                        auto p = container_ptr->template at_id<K::Read, K::Write>(ids[slot]);
+                        auto buffer = p.broadcast();
+                        self(buffers..., buffer);
+                        buffer.reduce_into(p, first_lane);
+                    }
+                };
+                process();
+            }
+        }
+
+        template<ParticleField F>
+        static decltype(auto) field_of(const auto& p) noexcept {
+            if constexpr (F == ParticleField::force) return (p.force);
+            else if constexpr (F == ParticleField::position) return (p.position);
+            else if constexpr (F == ParticleField::velocity) return (p.velocity);
+            else if constexpr (F == ParticleField::old_position) return (p.old_position);
+            else if constexpr (F == ParticleField::mass) return (p.mass);
+            else if constexpr (F == ParticleField::state) return (p.state);
+            else if constexpr (F == ParticleField::type) return (p.type);
+            else if constexpr (F == ParticleField::id) return (p.id);
+            else if constexpr (F == ParticleField::attributes) return (p.attributes);
+            else if constexpr (F == ParticleField::scratch) return (p.scratch);
+        }
+
+        // builds a packed reference whose lanes point to the particles at position `slot` of each interaction in the group
+        template<ParticleField Read, ParticleField Write>
+        auto gather(const std::array<ParticleID, Arity>* group, const size_t slot) const {
+            const auto lanes = [&]<size_t... L>(std::index_sequence<L...>) {
+                return std::array{ container_ptr->template at_id<Read, Write>(group[L][slot])... };
+            }(std::make_index_sequence<width>{});
+
+            auto lane_ptrs = [&](auto&& select) {
+                return [&]<size_t... L>(std::index_sequence<L...>) {
+                    return std::array{ std::addressof(select(lanes[L]))... };
+                }(std::make_index_sequence<width>{});
+            };
+
+            auto get_field = [&]<ParticleField F>() {
+                if constexpr (F == ParticleField::attributes) {
+                    return lane_ptrs([](const auto& p) -> auto& { return p.attributes; });
+                } else if constexpr (
+                    F == ParticleField::force || F == ParticleField::position ||
+                    F == ParticleField::velocity || F == ParticleField::old_position
+                ) {
+                    return math::Vec3Location {
+                        simd::make_gather_location(lane_ptrs([](const auto& p) -> auto& { return field_of<F>(p).x; })),
+                        simd::make_gather_location(lane_ptrs([](const auto& p) -> auto& { return field_of<F>(p).y; })),
+                        simd::make_gather_location(lane_ptrs([](const auto& p) -> auto& { return field_of<F>(p).z; }))
+                    };
+                } else {
+                    return simd::make_gather_location(lane_ptrs([](const auto& p) -> auto& { return field_of<F>(p); }));
+                }
+            };
+
+            return particle::internal::make_packed_particle_ref<typename Container::ParticleAttributes>(
+                particle::internal::make_particle_source<Read, Write>(get_field)
+            );
+        }
     };
 
 
-    // @Brief Builds phases of independent/non-conflicting Topological Batches (collection of id-id interactions)
-    template <typename Node = ParticleID>
-    std::vector<std::vector<utility::graph::EdgeList<Node>>> build_concurrent_phases(
-        const std::vector<utility::graph::EdgeList<Node>> & input_topologies,
+    // @Brief Builds phases of independent/non-conflicting Topological Batches (collection of id-id interactions).
+    // Topology is either an edge list (pair interactions) or a tuple list (bonded interactions)
+    template <typename Node = ParticleID, typename Topology = utility::graph::EdgeList<Node>>
+    std::vector<std::vector<Topology>> build_concurrent_phases(
+        const std::vector<Topology> & input_topologies,
         const size_t max_partition_size,
         const size_t min_batches_threshold
     ) {
-        using Pairs = utility::graph::EdgeList<Node>;
+        using Pairs = Topology;
         using Set = std::vector<Node>;
 
         // find all connected components (atomics) for all input topologies
@@ -159,4 +352,58 @@ namespace april::container::batching {
 
         return final_phases;
     }
+
+
+    // @Brief Builds phases of bonded topology batches of a given arity from the bonded interaction descriptors.
+    // Every descriptor is scheduled on its own so that each batch maps to exactly one bonded force.
+    template <std::size_t Arity, typename Container, typename Descriptor>
+    std::vector<std::vector<TopologyBatch<Arity, Container>>> build_bonded_phases(
+        Container* container,
+        const std::vector<Descriptor> & descriptors,
+        const size_t max_partition_size,
+        const size_t min_batches_threshold
+    ) {
+        using Tuples = utility::graph::TupleList<ParticleID, Arity>;
+
+        std::vector<std::vector<TopologyBatch<Arity, Container>>> phases;
+
+        for (size_t d = 0; d < descriptors.size(); ++d) {
+            const auto& prop = descriptors[d];
+            if (prop.arity != Arity || !prop.is_active || prop.used_by_tuples.empty()) continue;
+
+            // unflatten the id tuples
+            Tuples tuples(prop.used_by_tuples.size() / Arity);
+            for (size_t t = 0; t < tuples.size(); ++t) {
+                std::copy_n(prop.used_by_tuples.begin() + static_cast<std::ptrdiff_t>(t * Arity), Arity, tuples[t].begin());
+            }
+
+            auto scheduled_phases = build_concurrent_phases<ParticleID, Tuples>(
+                std::vector<Tuples>{std::move(tuples)},
+                max_partition_size,
+                min_batches_threshold
+            );
+
+            for (auto& phase : scheduled_phases) {
+                std::vector<TopologyBatch<Arity, Container>> current_phase_batches;
+                current_phase_batches.reserve(phase.size());
+
+                for (auto& batch_tuples : phase) {
+                    if (batch_tuples.empty()) continue;
+
+                    TopologyBatch<Arity, Container> batch;
+                    batch.container_ptr = container;
+                    batch.descriptor = d;
+                    batch.ids = batch_tuples.front();
+                    batch.interactions = std::move(batch_tuples);
+                    batch.build_lane_groups();
+
+                    current_phase_batches.push_back(std::move(batch));
+                }
+
+                phases.push_back(std::move(current_phase_batches));
+            }
+        }
+
+        return phases;
+    }
 }
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "april/base/types.hpp"
+#include "april/particle/properties.hpp"
+#include "april/particle/attributes.hpp"
+#include "april/particle/access/source.hpp"
+#include "april/particle/access/scalar_access.hpp"
+
+
+namespace april::container::batching {
+
+	/**
+	 * @brief Which side of a pair batch receives the kernel's writes.
+	 *
+	 * Owner-computes traversals evaluate every cross-cell pair twice, once from each cell, and only keep the
+	 * writes to the particles of the cell that is being processed. This removes all write conflicts between
+	 * tasks at the cost of twice the pair evaluations.
+	 */
+	enum class PairWriteBack : uint8_t {
+		Both,   ///< Regular (Newton 3) batch: writes go to both ranges.
+		First,  ///< Only range1 is written. Writes to range2 particles are discarded.
+		Second  ///< Only range2 is written. Writes to range1 particles are discarded.
+	};
+
+	constexpr bool writes_first(const PairWriteBack w) noexcept { return w != PairWriteBack::Second; }
+	constexpr bool writes_second(const PairWriteBack w) noexcept { return w != PairWriteBack::First; }
+
+
+	/**
+	 * @brief Thread-local copy of a particle that is read but must not be written.
+	 *
+	 * ref() hands out a ScalarParticleRef with the same masks as a container reference, so kernels cannot tell
+	 * the difference. Everything the kernel writes lands in the copy and is dropped with it. Fields the kernel
+	 * reads are copied, write-only fields (accumulators such as force, or scratch in the density pass) start
+	 * at zero.
+	 */
+	template<ParticleField Read, ParticleField Write, particle::IsParticleAttributes Attributes>
+	class ShadowParticle {
+		static constexpr ParticleField Fields = Read | Write;
+
+		template<ParticleField F>
+		static constexpr bool has = particle::internal::has_field_v<Fields, F>;
+
+		template<ParticleField F>
+		static constexpr bool reads = particle::internal::has_field_v<Read, F>;
+
+	public:
+		explicit ShadowParticle(const auto& p) {
+			if constexpr (reads<ParticleField::force>) force = p.force;
+			if constexpr (reads<ParticleField::scratch>) scratch = p.scratch; // e.g. F'(rho) in the many-body force pass
+			if constexpr (has<ParticleField::position>) position = p.position;
+			if constexpr (has<ParticleField::velocity>) velocity = p.velocity;
+			if constexpr (has<ParticleField::old_position>) old_position = p.old_position;
+			if constexpr (has<ParticleField::mass>) mass = p.mass;
+			if constexpr (has<ParticleField::state>) state = p.state;
+			if constexpr (has<ParticleField::type>) type = p.type;
+			if constexpr (has<ParticleField::id>) id = p.id;
+			if constexpr (has<ParticleField::attributes>) attributes = p.attributes;
+		}
+
+		ShadowParticle(const ShadowParticle&) = delete;
+		ShadowParticle& operator=(const ShadowParticle&) = delete;
+
+		[[nodiscard]] auto ref() noexcept {
+			auto get_field = [&]<ParticleField F>() {
+				auto* ptr = std::addressof(field<F>());
+				if constexpr (particle::internal::has_field_v<Write, F>) {
+					return ptr;
+				} else {
+					return static_cast<const std::remove_pointer_t<decltype(ptr)>*>(ptr);
+				}
+			};
+
+			return particle::internal::ScalarParticleRef<Read, Write, Attributes>(
+				particle::internal::make_particle_source<Read, Write>(get_field)
+			);
+		}
+
+	private:
+		vec3 force{};
+		vec3 position{};
+		vec3 velocity{};
+		vec3 old_position{};
+		double mass{};
+		ParticleState state{};
+		ParticleType type{};
+		ParticleID id{};
+		Attributes attributes{};
+		double scratch{};
+
+		template<ParticleField F>
+		auto& field() noexcept {
+			if constexpr (F == ParticleField::force) return force;
+			else if constexpr (F == ParticleField::position) return position;
+			else if constexpr (F == ParticleField::velocity) return velocity;
+			else if constexpr (F == ParticleField::old_position) return old_position;
+			else if constexpr (F == ParticleField::mass) return mass;
+			else if constexpr (F == ParticleField::state) return state;
+			else if constexpr (F == ParticleField::type) return type;
+			else if constexpr (F == ParticleField::id) return id;
+			else if constexpr (F == ParticleField::attributes) return attributes;
+			else if constexpr (F == ParticleField::scratch) return scratch;
+		}
+	};
+}
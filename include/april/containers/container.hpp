@@ -15,6 +15,10 @@
 #include "april/particle/access/scalar_access.hpp"
 #include "april/particle/access/policy.hpp"
 
+#include "april/containers/layout/internal/memory.hpp"
+#include "april/containers/internal/region_query.hpp"
+#include "april/containers/skin_tuning.hpp"
+
 
 namespace april::container {
 	struct ContainerFlags {
@@ -27,8 +31,9 @@ namespace april::container {
 	};
 
 	struct ContainerHints {
-		// TODO add regions that will be queried in the future so the container can keep track of particles better
 		std::vector<ParticleID> interacting_particles;
+		// regions that will be queried repeatedly (boundary regions and user registered regions).
+		// containers may precompute lookup structures for them, queries of other regions must still work
 		std::vector<core::Box> query_regions;
 	};
 
@@ -258,6 +263,24 @@ namespace april::container {
 		}
 
 
+		// ------------------
+		// TARGETED ITERATION
+		// ------------------
+		// invokes func(source_index) for every stored index that may lie within `radius` of the target
+		// (the target itself included). Containers without spatial structure visit every valid index.
+		// Periodic images are not considered.
+		template<typename Func>
+		void invoke_for_each_source_of(this const auto& self, const size_t target, const double radius, Func&& func) {
+			if constexpr (requires { self.for_each_source_of(target, radius, func); }) {
+				self.for_each_source_of(target, radius, func);
+			} else {
+				for (size_t i = 0; i < self.capacity(); ++i) {
+					if (self.index_is_valid(i)) func(i);
+				}
+			}
+		}
+
+
 		// -----------------
 		// STRUCTURE UPDATES
 		// -----------------
@@ -314,24 +337,27 @@ namespace april::container {
 			return self.particle_count();
 		}
 		[[nodiscard]] std::vector<size_t> invoke_collect_indices_in_region(this const auto& self, const core::Box & region) {
-			// TODO add tests for collect_indices_in_region
-			if constexpr (requires { self.collect_indices_in_region(region); }) {
-				return self.collect_indices_in_region(region);
+			std::vector<size_t> buffer;
+			self.collect_indices_in_region(region, buffer);
+			return buffer;
+		}
+		// replaces the contents of buffer with the indices in region. Allocation free once buffer and the
+		// container's query scratch have grown to the query size. Not reentrant (see RegionQueryScratch)
+		void invoke_collect_indices_in_region(this const auto& self, const core::Box & region, std::vector<size_t> & buffer) {
+			self.collect_indices_in_region(region, buffer);
+		}
+		// decision history of an adaptive skin, nullptr if the container has none (or it is disabled)
+		[[nodiscard]] const SkinTuningLog* invoke_skin_tuning(this const auto& self) {
+			if constexpr (requires { self.skin_tuning(); }) {
+				return self.skin_tuning();
 			} else {
-				std::vector<size_t> buffer;
-				self.collect_indices_in_region(region, buffer);
-				return buffer;
+				return nullptr;
 			}
 		}
 		[[nodiscard]] auto simulation_domain() const noexcept {
 			return domain;
 		}
 
-		// TODO implement on containers, use this instead of non buffer version in system
-		void invoke_collect_indices_in_region(this const auto& self, const core::Box & region, std::vector<size_t> & buffer) {
-			return self.collect_indices_in_region(region, buffer);
-		}
-
 		void bind_executor(ThreadExecutor* raw_executor_ptr) {
 			thread_executor.bind(raw_executor_ptr);
 		}
@@ -344,6 +370,18 @@ namespace april::container {
 		const core::Box domain; // Note: in the future this may be adjustable during run time
 		exec::ThreadExecutorRef<ThreadExecutor> thread_executor;
 
+		// reused by collect_indices_in_region so that steady-state queries do not allocate
+		mutable internal::RegionQueryScratch region_query_scratch;
+
+		// allocation settings of the container config (defaults if the config has none)
+		[[nodiscard]] AllocatorConfig allocator_config() const {
+			if constexpr (requires (const Config& c) { { c.allocator } -> std::convertible_to<AllocatorConfig>; }) {
+				return config.allocator;
+			} else {
+				return {};
+			}
+		}
+
 
 		template<ParallelPolicy P, VectorPolicy V, bool is_const, MaskPolicy MP, exec::IsKernel Kernel>
 		void invoke_iterate_range(this auto&& self, Kernel && func, size_t start, size_t end);
@@ -371,6 +409,7 @@ namespace april::container {
 	    ParticleID id,
 	    size_t index,
 	    const core::Box& region,
+	    std::vector<size_t>& indices,
 	    const particle::ParticleRecord<typename C::ParticleAttributes>& p,
 	    const std::vector<particle::ParticleRecord<typename C::ParticleAttributes>>& particles
 	) {
@@ -387,7 +426,7 @@ namespace april::container {
 		{ cc.contains_id(id) } -> std::convertible_to<bool>;
 		{ cc.index_is_valid(id) } -> std::convertible_to<bool>;
 
-	    { c.collect_indices_in_region(region) } -> std::convertible_to<std::vector<size_t>>;
+	    { cc.collect_indices_in_region(region, indices) };
 
 	    { c.template for_each_interaction_batch<ParallelPolicy::Serial>([](auto&&){}) };
 		{ c.template for_each_topology_batch<ParallelPolicy::Serial>([](auto&&){}) };
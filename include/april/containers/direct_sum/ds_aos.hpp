@@ -45,6 +45,13 @@ namespace april::container::internal {
 
 namespace april::container {
     struct DirectSumAoS {
+        AllocatorConfig allocator;
+
+        auto&& with_allocator(this auto&& self, const AllocatorConfig& allocator) {
+            self.allocator = allocator;
+            return self;
+        }
+
         template<class Config>
         using impl = internal::DirectSumAoSImpl<Config>;
     };
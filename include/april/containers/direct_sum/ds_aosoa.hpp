@@ -59,6 +59,12 @@ namespace april::container::internal {
 namespace april::container {
     template <size_t ChunkSize>
     struct DirectSumAoSoA {
+        AllocatorConfig allocator;
+
+        auto&& with_allocator(this auto&& self, const AllocatorConfig& allocator) {
+            self.allocator = allocator;
+            return self;
+        }
 
         template <class Config>
         using impl = internal::DirectSumAoSoAImpl<Config, ChunkSize>;
@@ -31,11 +31,17 @@ namespace april::container::internal {
 
 		template<ParallelPolicy P, typename Func>
 		void for_each_topology_batch(this auto&& self, Func && f) {
-			for (const auto& phase : self.topology_phases) {
-				self.thread_executor.template execute<P>(phase.size(), [&](size_t i) {
-					f(phase[i]);
-				});
-			}
+			auto run_phases = [&](const auto& phases) {
+				for (const auto& phase : phases) {
+					self.thread_executor.template execute<P>(phase.size(), [&](size_t i) {
+						f(phase[i]);
+					});
+				}
+			};
+
+			run_phases(self.topology_phases);
+			run_phases(self.angle_phases);
+			run_phases(self.dihedral_phases);
 		}
 
 		template<ParallelPolicy P, typename F>
@@ -95,33 +101,32 @@ namespace april::container::internal {
 			}
 		}
 
-		[[nodiscard]] std::vector<size_t> collect_indices_in_region(this const auto& self, const core::Box & region) {
-			std::vector<size_t> ret;
+		// replaces the contents of indices with the indices of alive particles inside region
+		void collect_indices_in_region(this const auto& self, const core::Box & region, std::vector<size_t> & indices) {
+			auto& scratch = self.region_query_scratch;
 			const double domain_vol = self.domain.volume();
 			const auto intersection = self.domain.intersection(region);
 
 			// partition the entire particle range into independent blocks/tasks
-			auto blocks = exec::make_linear_schedule(math::Range{0, self.capacity()}, self.linear_schedule_config);
+			exec::make_linear_schedule(math::Range{0, self.capacity()}, self.linear_schedule_config, scratch.blocks);
+			const auto& blocks = scratch.blocks;
 			const size_t num_tasks = blocks.size();
 
-			// allocate buffers for each task
-			std::vector<std::vector<size_t>> local_results(self.thread_executor.num_threads());
-
 			// preallocate storage with heuristic (assumes uniform distribution)
+			size_t est_per_task = 0;
 			if (domain_vol > 1e-9 && intersection.has_value()) {
 				const double ratio = intersection->volume() / domain_vol;
 				const auto est_total = static_cast<size_t>(self.particle_count() * ratio);
-				const size_t est_per_task = (est_total / num_tasks) + 1;
-
-				for (auto& loc : local_results) {
-					loc.reserve(est_per_task);
-				}
+				est_per_task = (est_total / num_tasks) + 1;
 			}
 
+			// reuse the persistent per-thread buffers
+			scratch.prepare(self.thread_executor.num_threads(), est_per_task);
+
 			// process all tasks in parallel
 			self.thread_executor.template execute<parallel_policy>(num_tasks, [&](const size_t t_idx) {
 				const auto& block = blocks[t_idx];
-				auto& local_ret = local_results[exec::thread_index()];
+				auto& local_ret = scratch.local(exec::thread_index());
 
 				// kernel checks if a particle is alive and inside the region
 				auto kernel = april::universal_kernel<ParticleField::position | ParticleField::state> (
@@ -153,27 +158,16 @@ namespace april::container::internal {
 				self.for_each_particle(block.start, block.stop, kernel);
 			});
 
-			// allocate storage for indices buffer
-			size_t total_found = 0;
-			for (const auto& loc : local_results) {
-				total_found += loc.size();
-			}
-
-			std::vector<size_t> indices;
-			ret.reserve(total_found);
-
 			// merge all local buffers into indices buffer
-			for (const auto& loc : local_results) {
-				ret.insert(ret.end(), loc.begin(), loc.end());
-			}
-
-			return ret;
+			scratch.gather(indices);
 		}
 
 		void rebuild_structure() { /*NoOp: nothing to rebuild for direct sum*/ }
 
 	private:
 		std::vector<std::vector<batching::TopologyBatch<2, DirectSumCore>>> topology_phases;
+		std::vector<std::vector<batching::TopologyBatch<3, DirectSumCore>>> angle_phases;
+		std::vector<std::vector<batching::TopologyBatch<4, DirectSumCore>>> dihedral_phases;
 
 		void build_topology_batches() {
 			// collect all interaction topologies into a single vector
@@ -209,21 +203,25 @@ namespace april::container::internal {
 
 					batching::TopologyBatch<2, ContainerType> batch;
 					batch.container_ptr = this;
-					batch.representatives = {
-						static_cast<ParticleType>(representative1),
-						static_cast<ParticleType>(representative2)
-					};
+					batch.ids = {representative1, representative2};
 
 					batch.interactions.reserve(batch_pairs.size());
 					for (const auto& [id1, id2] : batch_pairs) {
 						batch.interactions.push_back({id1, id2});
 					}
+					batch.build_lane_groups();
 
 					current_phase_batches.push_back(std::move(batch));
 				}
 
 				topology_phases.push_back(std::move(current_phase_batches));
 			}
+
+			// bonded (3- and 4-body) interactions are scheduled per force
+			angle_phases = batching::build_bonded_phases<3>(
+				this, this->interaction_map.bonded_interactions, max_partition_size, min_batches_threshold);
+			dihedral_phases = batching::build_bonded_phases<4>(
+				this, this->interaction_map.bonded_interactions, max_partition_size, min_batches_threshold);
 		}
 
 
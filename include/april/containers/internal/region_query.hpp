@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "april/base/types.hpp"
+#include "april/math/range.hpp"
+#include "april/exec/hardware.hpp"
+
+
+namespace april::container::internal {
+
+	/**
+	 * @brief Persistent scratch storage of region queries.
+	 *
+	 * Holds one cache line padded index buffer per thread, the task blocks and (for cell based containers) the
+	 * visited cells of the current query. Buffers are only cleared, never shrunk, so once they have seen the
+	 * largest query a container performs, further queries do not allocate.
+	 *
+	 * A container owns a single instance, region queries on the same container are therefore not reentrant.
+	 */
+	class RegionQueryScratch {
+	public:
+		RegionQueryScratch() = default;
+
+		// scratch contents are not part of the container's value, copies start empty
+		RegionQueryScratch(const RegionQueryScratch&) {}
+		RegionQueryScratch& operator=(const RegionQueryScratch&) { return *this; }
+		RegionQueryScratch(RegionQueryScratch&&) noexcept = default;
+		RegionQueryScratch& operator=(RegionQueryScratch&&) noexcept = default;
+
+		std::vector<math::Range> blocks;
+		std::vector<uint32_t> cells;
+
+		// clears the thread buffers and makes sure every thread has one with room for expected_per_thread indices
+		void prepare(const size_t n_threads, const size_t expected_per_thread) {
+			if (thread_buffers.size() < n_threads) {
+				thread_buffers.resize(n_threads);
+			}
+			for (auto& b : thread_buffers) {
+				b.indices.clear();
+				b.indices.reserve(expected_per_thread);
+			}
+		}
+
+		[[nodiscard]] std::vector<size_t>& local(const size_t thread) noexcept {
+			return thread_buffers[thread].indices;
+		}
+
+		// concatenates the thread buffers (in thread order) into out, replacing its contents
+		void gather(std::vector<size_t>& out) const {
+			size_t total = 0;
+			for (const auto& b : thread_buffers) {
+				total += b.indices.size();
+			}
+
+			out.clear();
+			out.reserve(total);
+			for (const auto& b : thread_buffers) {
+				out.insert(out.end(), b.indices.begin(), b.indices.end());
+			}
+		}
+
+	private:
+		struct alignas(exec::assumed_cache_line_size) PaddedIndexBuffer {
+			std::vector<size_t> indices;
+		};
+
+		std::vector<PaddedIndexBuffer> thread_buffers;
+	};
+
+}
@@ -13,6 +13,10 @@
 
 
 #include "april/containers/layout/internal/soa_chunk.hpp"
+#include "april/containers/layout/internal/first_touch_buffer.hpp"
+#include "april/containers/layout/internal/memory.hpp"
+#include "april/containers/layout/internal/bin_sort.hpp"
+#include "april/utility/stage_profile.hpp"
 
 namespace april::container::layout {
 
@@ -37,6 +41,11 @@ namespace april::container::layout {
 
         explicit AoSoA(const ContainerConfig & config): Base(config) {
             for (size_t k = 0; k < packed::size(); ++k) idx_arr[k] = static_cast<double>(k);
+
+            const AllocatorConfig allocator = this->allocator_config();
+            data.set_allocator(allocator);
+            tmp.set_allocator(allocator);
+            reorder_arena.set_config(allocator);
         }
 
         void bind_executor(Base::ThreadExecutor* raw_executor_ptr) {
@@ -213,10 +222,11 @@ namespace april::container::layout {
 
         size_t particle_capacity{};
         size_t n_particles{};
-        std::vector<ChunkT> data;
-        std::vector<ChunkT> tmp;
+        FirstTouchBuffer<ChunkT> data; // placed by first touch under linear_schedule_config
+        FirstTouchBuffer<ChunkT> tmp;
         std::vector<size_t> bin_starts; // first chunk index of each bin
         std::vector<size_t> bin_sizes; // number of particles in each bin
+        std::vector<double> sort_keys; // key of every flat index, ascending within each bin (empty if the bins are unsorted)
         std::vector<uint32_t> id_to_index_map;
 
         exec::BlockConfig pair_schedule_config;
@@ -232,13 +242,14 @@ namespace april::container::layout {
             const size_t n_chunks = (n_particles + chunk_size - 1) / chunk_size;
             particle_capacity = n_chunks * chunk_size;
 
-            data.resize(n_chunks);
+            data.resize(n_chunks, thread_executor, linear_schedule_config);
             id_to_index_map.resize(n_particles);
 
             bin_sizes.resize(1);
             bin_starts.resize(1);
             bin_sizes[0] = particles.size();
             bin_starts[0] = 0;
+            sort_keys.clear();
 
             update_cache();
 
@@ -269,15 +280,13 @@ namespace april::container::layout {
         }
 
 
-        std::vector<size_t> bin_counts;
-        std::vector<size_t> cached_bins;
-        std::vector<size_t> bin_counts_tls_buffers;
-        std::vector<size_t> bin_particles;
+        ScratchArena reorder_arena; // backs the per-rebuild scratch arrays of reorder_storage
 
-        template <typename HashFunc>
+        // sort_key (optional) orders the particles within each bin, see sort_keys
+        template <typename HashFunc, typename KeyFunc = NoSortKey>
         requires std::invocable<HashFunc, size_t> &&
-            std::unsigned_integral<std::invoke_result_t<HashFunc, size_t>>
-        void reorder_storage(const size_t n_bins, HashFunc&& calc_bin) {
+            std::unsigned_integral<std::invoke_result_t<HashFunc, size_t>> && IsSortKey<KeyFunc>
+        void reorder_storage(const size_t n_bins, HashFunc&& calc_bin, KeyFunc&& sort_key = {}) {
             const size_t n_threads = this->thread_executor.num_threads();
             const size_t old_capacity = this->particle_capacity;
 
@@ -286,14 +295,21 @@ namespace april::container::layout {
             // resize buffers
             bin_starts.resize(n_bins);
             bin_sizes.resize(n_bins);
-            bin_counts.resize(n_bins);
-            cached_bins.resize(old_capacity);
-            bin_counts_tls_buffers.assign(n_bins * n_threads, 0);
+
+            // scratch arrays come from the reusable arena (no allocations once the peak size has been seen)
+            reorder_arena.reset();
+            const auto bin_counts = reorder_arena.take<size_t>(n_bins);
+            const auto cached_bins = reorder_arena.take<size_t>(old_capacity);
+            const auto bin_counts_tls_buffers = reorder_arena.take<size_t>(n_bins * n_threads);
+            const auto cached_keys = reorder_arena.take<double>(has_sort_key<KeyFunc> ? old_capacity : 0);
+            std::ranges::fill(bin_counts_tls_buffers, 0);
 
             // schedule over the capacity (including holes)
             auto capacity_blocks = exec::make_linear_schedule(math::Range{0, old_capacity}, this->linear_schedule_config);
             auto bin_blocks = exec::make_linear_schedule(math::Range{0, n_bins}, this->linear_schedule_config);
 
+            utility::StageScope stage(utility::Stage::ReorderCount);
+
             // each thread counts the number of particles per bin in its assigned particle blocks
             this->thread_executor.execute(capacity_blocks.size(), [&](const size_t t_idx) {
                 APRIL_ASSERT(exec::thread_index() < this->thread_executor.num_threads(),
@@ -311,6 +327,7 @@ namespace april::container::layout {
                     const size_t bin = calc_bin(i);
                     cached_bins[i] = bin;
                     ++bin_counts_tls[bin];
+                    if constexpr (has_sort_key<KeyFunc>) cached_keys[i] = static_cast<double>(sort_key(i));
                 }
             });
 
@@ -327,6 +344,8 @@ namespace april::container::layout {
                 }
             });
 
+            stage.next(utility::Stage::ReorderMap);
+
             // compute chunk aligned offsets (prefix sum) (serial)
             size_t current_chunk_offset = 0;
             size_t total_chunks = 0;
@@ -346,8 +365,9 @@ namespace april::container::layout {
 
             // calcualte new capacity and update buffers
             const size_t new_capacity = total_chunks * chunk_size;
-            tmp.resize(total_chunks);
-            bin_particles.assign(new_capacity, std::numeric_limits<size_t>::max());
+            tmp.resize(total_chunks, this->thread_executor, this->linear_schedule_config);
+            const auto bin_particles = reorder_arena.take<size_t>(new_capacity);
+            std::ranges::fill(bin_particles, std::numeric_limits<size_t>::max());
 
             // Build the mapping: destination_idx -> source_idx (serial)
             for (size_t i = 0; i < old_capacity; ++i) {
@@ -359,6 +379,20 @@ namespace april::container::layout {
                 bin_particles[dest_idx] = i;
             }
 
+            // order the valid particles of every bin by their keys (parallel over bins)
+            if constexpr (has_sort_key<KeyFunc>) {
+                this->thread_executor.execute(bin_blocks.size(), [&](const size_t t_idx) {
+                    for (const size_t bin : bin_blocks[t_idx]) {
+                        internal::sort_bin_by_key(bin_particles.subspan(bin_starts[bin], bin_sizes[bin]), cached_keys);
+                    }
+                });
+                sort_keys.resize(new_capacity);
+            } else {
+                sort_keys.clear();
+            }
+
+            stage.next(utility::Stage::ReorderGather);
+
             // gather copy into ping pong buffer (chunk by chunk)
             auto chunk_blocks = exec::make_linear_schedule(math::Range{0, total_chunks}, this->linear_schedule_config);
 
@@ -383,10 +417,12 @@ namespace april::container::layout {
                              dst_chunk.id[dst_l]    = std::numeric_limits<ParticleID>::max();
                              dst_chunk.type[dst_l]  = std::numeric_limits<ParticleType>::max();
                              dst_chunk.mass[dst_l]  = 1.0;
+                             if constexpr (has_sort_key<KeyFunc>) sort_keys[dest_idx] = std::numeric_limits<double>::max();
                          } else {
                              // Gather Valid Particle
                              const auto [src_c, src_l] = locate(src_idx);
                              dst_chunk.copy_from(dst_l, src_l, data[src_c]);
+                             if constexpr (has_sort_key<KeyFunc>) sort_keys[dest_idx] = cached_keys[src_idx];
 
                              // Update ID map
                              const auto id = static_cast<size_t>(dst_chunk.id[dst_l]);
@@ -452,6 +488,7 @@ namespace april::container::layout {
             else if constexpr (F == ParticleField::type) return &chunk.type[lane_idx];
             else if constexpr (F == ParticleField::id) return &chunk.id[lane_idx];
             else if constexpr (F == ParticleField::attributes) return &chunk.attributes[lane_idx];
+            else if constexpr (F == ParticleField::scratch) return &chunk.scratch[lane_idx];
         }
 
         template<ParticleField F>
@@ -506,6 +543,9 @@ namespace april::container::layout {
             else if constexpr (F == ParticleField::attributes) {
                 return &chunk.attributes[lane_idx];
             }
+            else if constexpr (F == ParticleField::scratch) {
+                return simd::aligned_location(&chunk.scratch[lane_idx]);
+            }
         }
 
     private:
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+
+namespace april::container::layout {
+
+    // default sort key of reorder_storage: particles keep their storage order within each bin
+    struct NoSortKey {};
+
+    template<typename KeyFunc>
+    concept IsSortKey = std::same_as<std::remove_cvref_t<KeyFunc>, NoSortKey> ||
+        (std::invocable<KeyFunc, size_t> && std::convertible_to<std::invoke_result_t<KeyFunc, size_t>, double>);
+
+    template<typename KeyFunc>
+    inline constexpr bool has_sort_key = !std::same_as<std::remove_cvref_t<KeyFunc>, NoSortKey>;
+}
+
+
+namespace april::container::layout::internal {
+
+    /**
+     * Sorts one bin of the destination -> source mapping of reorder_storage by the keys of its sources.
+     * The mapping keeps the previous storage order, so a bin that was sorted at the last reorder is nearly
+     * sorted again and insertion sort runs in close to linear time. Large bins fall back to std::sort.
+     */
+    inline void sort_bin_by_key(const std::span<size_t> bin, const std::span<const double> source_keys) {
+        constexpr size_t insertion_limit = 256;
+
+        if (bin.size() > insertion_limit) {
+            std::ranges::sort(bin, {}, [&](const size_t src) { return source_keys[src]; });
+            return;
+        }
+
+        for (size_t k = 1; k < bin.size(); ++k) {
+            const size_t src = bin[k];
+            const double key = source_keys[src];
+
+            size_t m = k;
+            for (; m > 0 && source_keys[bin[m - 1]] > key; --m) bin[m] = bin[m - 1];
+            bin[m] = src;
+        }
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "april/math/range.hpp"
+#include "april/exec/threading/scheduling.hpp"
+#include "april/containers/layout/internal/memory.hpp"
+
+
+namespace april::container::layout {
+
+    /**
+     * @brief Contiguous buffer whose elements are constructed by the threads that later process them.
+     *
+     * Operating systems place a page on the NUMA node of the thread that first writes to it. std::vector
+     * value-initialises all elements on the calling thread, which puts the whole buffer on a single node.
+     * FirstTouchBuffer instead constructs (and relocates) its elements in parallel, partitioned with the
+     * same linear schedule the layout uses for its sweeps, so that each block lands close to its consumer.
+     * The memory itself comes from allocate_bytes, i.e. it honours the container's AllocatorConfig.
+     */
+    template<typename T>
+    class FirstTouchBuffer {
+    public:
+        FirstTouchBuffer() = default;
+
+        FirstTouchBuffer(const FirstTouchBuffer&) = delete;
+        FirstTouchBuffer& operator=(const FirstTouchBuffer&) = delete;
+
+        FirstTouchBuffer(FirstTouchBuffer&& other) noexcept { swap(other); }
+
+        FirstTouchBuffer& operator=(FirstTouchBuffer&& other) noexcept {
+            if (this != &other) {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~FirstTouchBuffer() { release(); }
+
+        void swap(FirstTouchBuffer& other) noexcept {
+            std::swap(allocator, other.allocator);
+            std::swap(ptr, other.ptr);
+            std::swap(count, other.count);
+            std::swap(cap, other.cap);
+        }
+
+        friend void swap(FirstTouchBuffer& a, FirstTouchBuffer& b) noexcept { a.swap(b); }
+
+        // drops all elements; subsequent allocations use the new settings
+        void set_allocator(const AllocatorConfig& config) {
+            release();
+            allocator = config;
+        }
+
+        /**
+         * @brief Resizes to n elements. New elements are value-initialised, existing ones are relocated
+         * if the buffer grows beyond its capacity. Both happen in parallel over make_linear_schedule({0, n}, config).
+         */
+        template<typename Executor>
+        void resize(const size_t n, const Executor& executor, const exec::BlockConfig& config) {
+            if (n <= cap) {
+                if (n > count) {
+                    const auto blocks = exec::make_linear_schedule(math::Range{count, n}, config);
+                    executor.execute(blocks.size(), [&](const size_t b) {
+                        for (size_t i = blocks[b].start; i < blocks[b].stop; ++i) {
+                            ::new (static_cast<void*>(ptr + i)) T{};
+                        }
+                    });
+                } else {
+                    std::destroy(ptr + n, ptr + count);
+                }
+                count = n;
+                return;
+            }
+
+            T* fresh = static_cast<T*>(internal::allocate_bytes(n * sizeof(T), alignof(T), allocator));
+
+            const auto blocks = exec::make_linear_schedule(math::Range{0, n}, config);
+            executor.execute(blocks.size(), [&](const size_t b) {
+                for (size_t i = blocks[b].start; i < blocks[b].stop; ++i) {
+                    if (i < count) {
+                        ::new (static_cast<void*>(fresh + i)) T(std::move(ptr[i]));
+                    } else {
+                        ::new (static_cast<void*>(fresh + i)) T{};
+                    }
+                }
+            });
+
+            release();
+            ptr = fresh;
+            count = cap = n;
+        }
+
+        [[nodiscard]] T* data() noexcept { return ptr; }
+        [[nodiscard]] const T* data() const noexcept { return ptr; }
+        [[nodiscard]] size_t size() const noexcept { return count; }
+        [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+        [[nodiscard]] T& operator[](const size_t i) noexcept { return ptr[i]; }
+        [[nodiscard]] const T& operator[](const size_t i) const noexcept { return ptr[i]; }
+
+    private:
+        AllocatorConfig allocator;
+        T* ptr = nullptr;
+        size_t count = 0;
+        size_t cap = 0;
+
+        void release() noexcept {
+            if (!ptr) return;
+            std::destroy(ptr, ptr + count);
+            internal::deallocate_bytes(ptr, cap * sizeof(T), alignof(T), allocator);
+            ptr = nullptr;
+            count = cap = 0;
+        }
+    };
+
+} // namespace april::container::layout
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace april::container {
+
+    enum class HugePages : uint8_t {
+        None,        // plain aligned heap allocations
+        Transparent, // large buffers are 2 MiB aligned mappings advised with MADV_HUGEPAGE
+        Explicit     // large buffers are MAP_HUGETLB mappings (falls back to Transparent if none are reserved)
+    };
+
+    /**
+     * @brief Allocation settings for particle storage and scratch buffers.
+     *
+     * Only buffers of at least huge_page_threshold bytes are mapped with huge pages, smaller ones stay on the heap.
+     * Huge pages are a Linux feature; elsewhere every mode behaves like HugePages::None.
+     */
+    struct AllocatorConfig {
+        size_t alignment = 64;
+        HugePages huge_pages = HugePages::Transparent;
+        size_t huge_page_threshold = size_t{2} << 20;
+
+        friend bool operator==(const AllocatorConfig&, const AllocatorConfig&) = default;
+    };
+}
+
+
+namespace april::container::layout {
+
+    namespace internal {
+        inline constexpr size_t huge_page_size = size_t{2} << 20;
+
+        [[nodiscard]] constexpr size_t round_up(const size_t n, const size_t multiple) noexcept {
+            return (n + multiple - 1) / multiple * multiple;
+        }
+
+        [[nodiscard]] inline bool uses_mapping(const size_t bytes, const AllocatorConfig& config) noexcept {
+        #if defined(__linux__)
+            return config.huge_pages != HugePages::None && bytes >= config.huge_page_threshold;
+        #else
+            (void)bytes; (void)config;
+            return false;
+        #endif
+        }
+
+    #if defined(__linux__)
+        // maps length bytes (a multiple of huge_page_size) at a huge_page_size aligned address
+        [[nodiscard]] inline void* map_huge_aligned(const size_t length, const HugePages mode) noexcept {
+            if (mode == HugePages::Explicit) {
+                void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) return p;
+            }
+
+            // over-map by one huge page and trim the misaligned head and the tail
+            const size_t padded = length + huge_page_size;
+            void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) return nullptr;
+
+            const auto begin = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = round_up(begin, huge_page_size);
+            if (aligned > begin) munmap(raw, aligned - begin);
+            if (const size_t tail = begin + padded - (aligned + length); tail > 0) {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+
+            void* p = reinterpret_cast<void*>(aligned);
+            madvise(p, length, MADV_HUGEPAGE); // a hint, failure only means regular pages
+            return p;
+        }
+    #endif
+
+        // allocates bytes aligned to at least max(alignment, config.alignment)
+        [[nodiscard]] inline void* allocate_bytes(const size_t bytes, const size_t alignment, const AllocatorConfig& config) {
+        #if defined(__linux__)
+            if (uses_mapping(bytes, config)) {
+                if (void* p = map_huge_aligned(round_up(bytes, huge_page_size), config.huge_pages)) return p;
+                throw std::bad_alloc();
+            }
+        #endif
+            return ::operator new(bytes, std::align_val_t{std::max(alignment, config.alignment)});
+        }
+
+        // bytes, alignment and config must match the allocate_bytes call
+        inline void deallocate_bytes(void* p, const size_t bytes, const size_t alignment, const AllocatorConfig& config) noexcept {
+            if (!p) return;
+        #if defined(__linux__)
+            if (uses_mapping(bytes, config)) {
+                munmap(p, round_up(bytes, huge_page_size));
+                return;
+            }
+        #endif
+            ::operator delete(p, std::align_val_t{std::max(alignment, config.alignment)});
+        }
+    }
+
+
+    /**
+     * @brief Standard allocator on top of AllocatorConfig (alignment and huge page backing).
+     *
+     * The allocator is stateful and propagates on move assignment and swap, so ping-pong buffers can be swapped
+     * and storages can be re-seated with a new configuration by move assigning a freshly constructed container.
+     */
+    template<typename T>
+    class PageAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        PageAllocator() = default;
+        explicit PageAllocator(const AllocatorConfig& config) noexcept : config(config) {}
+
+        template<typename U>
+        PageAllocator(const PageAllocator<U>& other) noexcept : config(other.settings()) {} // NOLINT (rebind)
+
+        [[nodiscard]] T* allocate(const size_t n) {
+            return static_cast<T*>(internal::allocate_bytes(n * sizeof(T), alignof(T), config));
+        }
+
+        void deallocate(T* p, const size_t n) noexcept {
+            internal::deallocate_bytes(p, n * sizeof(T), alignof(T), config);
+        }
+
+        [[nodiscard]] const AllocatorConfig& settings() const noexcept { return config; }
+
+        template<typename U>
+        bool operator==(const PageAllocator<U>& other) const noexcept { return config == other.settings(); }
+
+    private:
+        AllocatorConfig config;
+    };
+
+    template<typename T>
+    using PageVector = std::vector<T, PageAllocator<T>>;
+
+    // replaces v by an empty vector using the given allocation settings
+    template<typename T>
+    void rebind_allocator(PageVector<T>& v, const AllocatorConfig& config) {
+        v = PageVector<T>(PageAllocator<T>(config));
+    }
+
+
+    /**
+     * @brief Reusable bump allocator for per-rebuild scratch arrays.
+     *
+     * take() hands out uninitialised, cache line aligned spans that stay valid until the next reset().
+     * Requests that do not fit are served from temporary overflow blocks; the next reset() then replaces
+     * everything by a single block large enough for the peak usage seen so far. After warm-up a rebuild
+     * therefore performs no allocations at all.
+     */
+    class ScratchArena {
+    public:
+        ScratchArena() = default;
+        explicit ScratchArena(const AllocatorConfig& config) : config(config) {}
+
+        // scratch contents are not part of the arena's value, copies start empty
+        ScratchArena(const ScratchArena& other) : config(other.config) {}
+        ScratchArena& operator=(const ScratchArena& other) {
+            if (this != &other) set_config(other.config);
+            return *this;
+        }
+
+        ScratchArena(ScratchArena&& other) noexcept { swap(other); }
+        ScratchArena& operator=(ScratchArena&& other) noexcept {
+            if (this != &other) {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~ScratchArena() { release(); }
+
+        void swap(ScratchArena& other) noexcept {
+            std::swap(config, other.config);
+            std::swap(block, other.block);
+            std::swap(overflow, other.overflow);
+            std::swap(offset, other.offset);
+            std::swap(used, other.used);
+            std::swap(peak, other.peak);
+        }
+
+        // frees all blocks and uses the new settings from the next take() on
+        void set_config(const AllocatorConfig& new_config) {
+            release();
+            config = new_config;
+        }
+
+        template<typename T>
+        requires std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>
+        [[nodiscard]] std::span<T> take(const size_t n) {
+            static_assert(alignof(T) <= alignment, "ScratchArena: over-aligned type");
+            const size_t bytes = internal::round_up(std::max<size_t>(n * sizeof(T), 1), alignment);
+            used += bytes;
+
+            if (offset + bytes <= block.size) {
+                T* p = reinterpret_cast<T*>(block.ptr + offset);
+                offset += bytes;
+                return {p, n};
+            }
+
+            auto* p = static_cast<std::byte*>(internal::allocate_bytes(bytes, alignment, config));
+            overflow.push_back({p, bytes});
+            return {reinterpret_cast<T*>(p), n};
+        }
+
+        // invalidates all spans handed out since the last reset
+        void reset() {
+            peak = std::max(peak, used);
+            if (!overflow.empty()) {
+                free_overflow();
+                if (block.size < peak) {
+                    internal::deallocate_bytes(block.ptr, block.size, alignment, config);
+                    block = {};
+                    block.ptr = static_cast<std::byte*>(internal::allocate_bytes(peak, alignment, config));
+                    block.size = peak;
+                }
+            }
+            offset = 0;
+            used = 0;
+        }
+
+        [[nodiscard]] size_t capacity() const noexcept { return block.size; }
+        [[nodiscard]] size_t peak_usage() const noexcept { return std::max(peak, used); }
+        [[nodiscard]] size_t overflow_blocks() const noexcept { return overflow.size(); }
+
+    private:
+        static constexpr size_t alignment = 64;
+
+        struct Block {
+            std::byte* ptr = nullptr;
+            size_t size = 0;
+        };
+
+        AllocatorConfig config;
+        Block block;
+        std::vector<Block> overflow;
+        size_t offset = 0;
+        size_t used = 0;
+        size_t peak = 0;
+
+        void free_overflow() noexcept {
+            for (const auto& b : overflow) internal::deallocate_bytes(b.ptr, b.size, alignment, config);
+            overflow.clear();
+        }
+
+        void release() noexcept {
+            free_overflow();
+            internal::deallocate_bytes(block.ptr, block.size, alignment, config);
+            block = {};
+            offset = used = peak = 0;
+        }
+    };
+
+} // namespace april::container::layout
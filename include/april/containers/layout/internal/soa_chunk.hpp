@@ -52,6 +52,9 @@ namespace april::container::layout {
         // Attributes
         alignas(64) std::array<Attributes, Size> attributes;
 
+        // Transient scratch (e.g. many-body densities). Not copied on reorder
+        alignas(64) std::array<double, Size> scratch{};
+
         void insert_particle(size_t l_idx, const particle::ParticleRecord<Attributes> & p) {
             pos_x[l_idx] = p.position.x;
             pos_y[l_idx] = p.position.y;
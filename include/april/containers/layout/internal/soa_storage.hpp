@@ -2,21 +2,23 @@
 #include <vector>
 
 #include "april/particle/record.hpp"
+#include "april/containers/layout/internal/memory.hpp"
 
 
 namespace april::container::layout {
     template<particle::IsParticleAttributes Attributes>
     struct SoAStorage {
-        alignas(64) std::vector<vec3::type> pos_x, pos_y, pos_z;
-        alignas(64) std::vector<vec3::type> vel_x, vel_y, vel_z;
-        alignas(64) std::vector<vec3::type> frc_x, frc_y, frc_z;
-        alignas(64) std::vector<vec3::type> old_x, old_y, old_z;
-
-        alignas(64) std::vector<double> mass;
-        alignas(64) std::vector<ParticleState> state;
-        alignas(64) std::vector<ParticleType> type;
-        alignas(64) std::vector<ParticleID> id;
-        alignas(64) std::vector<Attributes> attributes;
+        alignas(64) PageVector<vec3::type> pos_x, pos_y, pos_z;
+        alignas(64) PageVector<vec3::type> vel_x, vel_y, vel_z;
+        alignas(64) PageVector<vec3::type> frc_x, frc_y, frc_z;
+        alignas(64) PageVector<vec3::type> old_x, old_y, old_z;
+
+        alignas(64) PageVector<double> mass;
+        alignas(64) PageVector<ParticleState> state;
+        alignas(64) PageVector<ParticleType> type;
+        alignas(64) PageVector<ParticleID> id;
+        alignas(64) PageVector<Attributes> attributes;
+        alignas(64) PageVector<double> scratch; // transient, not copied on reorder
 
         vec3::type * APRIL_RESTRICT ptr_pos_x = nullptr;
         vec3::type * APRIL_RESTRICT ptr_pos_y = nullptr;
@@ -43,6 +45,7 @@ namespace april::container::layout {
         ParticleType  * APRIL_RESTRICT ptr_type  = nullptr;
         ParticleID    * APRIL_RESTRICT ptr_id    = nullptr;
         Attributes * APRIL_RESTRICT ptr_attributes = nullptr;
+        double * APRIL_RESTRICT ptr_scratch = nullptr;
 
         size_t capacity{};
         size_t size{};
@@ -58,6 +61,23 @@ namespace april::container::layout {
             ptr_type = type.data();
             ptr_id = id.data();
             ptr_attributes = attributes.data();
+            ptr_scratch = scratch.data();
+        }
+
+        // drops all data; call before the first resize
+        void set_allocator(const AllocatorConfig& config) {
+            for (auto* v : {&pos_x, &pos_y, &pos_z, &vel_x, &vel_y, &vel_z, &frc_x, &frc_y, &frc_z, &old_x, &old_y, &old_z}) {
+                rebind_allocator(*v, config);
+            }
+            rebind_allocator(mass, config);
+            rebind_allocator(state, config);
+            rebind_allocator(type, config);
+            rebind_allocator(id, config);
+            rebind_allocator(attributes, config);
+            rebind_allocator(scratch, config);
+
+            capacity = size = 0;
+            update_pointer_cache();
         }
 
         void insert_particle(size_t idx, const particle::ParticleRecord<Attributes> & p) {
@@ -100,6 +120,7 @@ namespace april::container::layout {
             type.resize(capacity);
             id.resize(capacity);
             attributes.resize(capacity);
+            scratch.resize(capacity);
 
             capacity -= packed::size();
             update_pointer_cache();
@@ -6,6 +6,9 @@
 #include "april/exec/policy.hpp"
 
 #include "april/containers/layout/internal/soa_storage.hpp"
+#include "april/containers/layout/internal/memory.hpp"
+#include "april/containers/layout/internal/bin_sort.hpp"
+#include "april/utility/stage_profile.hpp"
 // #include <chrono>
 // #include <iostream>
 
@@ -22,6 +25,11 @@ namespace april::container::layout {
 
         explicit SoA(const ContainerConfig & config): Base(config) {
             for (size_t k = 0; k < packed::size(); ++k) idx_arr[k] = static_cast<double>(k);
+
+            const AllocatorConfig allocator = this->allocator_config();
+            data.set_allocator(allocator);
+            tmp.set_allocator(allocator);
+            reorder_arena.set_config(allocator);
         }
 
         void bind_executor(Base::ThreadExecutor* raw_executor_ptr) {
@@ -61,6 +69,7 @@ namespace april::container::layout {
         SoAStorage<ParticleAttributes> data;
         std::vector<size_t> bin_starts; // first particle index of each bin
         std::vector<size_t> bin_sizes; // number of particles in each bin
+        std::vector<double> sort_keys; // key of every index, ascending within each bin (empty if the bins are unsorted)
         std::vector<uint32_t> id_to_index_map;
 
         exec::BlockConfig pair_schedule_config;
@@ -74,6 +83,7 @@ namespace april::container::layout {
 
             bin_starts.clear();
             bin_sizes.clear();
+            sort_keys.clear();
             bin_starts.push_back(0);
             bin_sizes.push_back(particles.size());
 
@@ -97,31 +107,36 @@ namespace april::container::layout {
             tmp.resize(n);
         }
 
-        std::vector<size_t> bin_counts_tls_buffers;
-        std::vector<size_t> bin_particles;
-        std::vector<size_t> bin_counts;
-        std::vector<size_t> cached_bins;
+        ScratchArena reorder_arena; // backs the per-rebuild scratch arrays of reorder_storage
 
 
-        template <typename HashFunc>
+        // sort_key (optional) orders the particles within each bin, see sort_keys
+        template <typename HashFunc, typename KeyFunc = NoSortKey>
         requires std::invocable<HashFunc, size_t> &&
-            std::unsigned_integral<std::invoke_result_t<HashFunc, size_t>>
-        void reorder_storage(const size_t n_bins, HashFunc&&calc_bin) {
+            std::unsigned_integral<std::invoke_result_t<HashFunc, size_t>> && IsSortKey<KeyFunc>
+        void reorder_storage(const size_t n_bins, HashFunc&& calc_bin, KeyFunc&& sort_key = {}) {
             const size_t n_particles = this->particle_count();
             const unsigned n_threads = this->thread_executor.num_threads();
 
             // resize buffers
             bin_starts.resize(n_bins);
             bin_sizes.resize(n_bins);
-            bin_counts.resize(n_bins);
-            cached_bins.resize(n_particles);
-            bin_particles.resize(n_particles);
-            bin_counts_tls_buffers.assign(n_bins * n_threads, 0);
+
+            // scratch arrays come from the reusable arena (no allocations once the peak size has been seen)
+            reorder_arena.reset();
+            const auto bin_counts = reorder_arena.take<size_t>(n_bins);
+            const auto cached_bins = reorder_arena.take<size_t>(n_particles);
+            const auto bin_particles = reorder_arena.take<size_t>(n_particles);
+            const auto bin_counts_tls_buffers = reorder_arena.take<size_t>(n_bins * n_threads);
+            const auto cached_keys = reorder_arena.take<double>(has_sort_key<KeyFunc> ? n_particles : 0);
+            std::ranges::fill(bin_counts_tls_buffers, 0);
 
             // schedule over particles
             auto particle_blocks = exec::make_linear_schedule(math::Range{0, n_particles}, this->linear_schedule_config);
             auto bin_blocks = exec::make_linear_schedule(math::Range{0, n_bins}, this->linear_schedule_config);
 
+            utility::StageScope stage(utility::Stage::ReorderCount);
+
             // each thread counts the number of particles per bin in its assigned particle blocks
             this->thread_executor.execute(particle_blocks.size(), [&](const size_t t_idx) {
                 APRIL_ASSERT(exec::thread_index() < this->thread_executor.num_threads(),
@@ -135,6 +150,7 @@ namespace april::container::layout {
                     const size_t bin = calc_bin(i);
                     cached_bins[i] = bin;
                   ++bin_counts_tls[bin];
+                    if constexpr (has_sort_key<KeyFunc>) cached_keys[i] = static_cast<double>(sort_key(i));
                 }
             });
 
@@ -151,6 +167,8 @@ namespace april::container::layout {
                 }
             });
 
+            stage.next(utility::Stage::ReorderMap);
+
             // compute offsets (prefix sum)
             size_t offset = 0;
             for (size_t i = 0; i < n_bins; i++) {
@@ -166,6 +184,20 @@ namespace april::container::layout {
                 bin_particles[dest_idx] = i;
             }
 
+            // order every bin by its keys (parallel over bins)
+            if constexpr (has_sort_key<KeyFunc>) {
+                this->thread_executor.execute(bin_blocks.size(), [&](const size_t t_idx) {
+                    for (const size_t bin : bin_blocks[t_idx]) {
+                        internal::sort_bin_by_key(bin_particles.subspan(bin_starts[bin], bin_sizes[bin]), cached_keys);
+                    }
+                });
+                sort_keys.resize(n_particles);
+            } else {
+                sort_keys.clear();
+            }
+
+            stage.next(utility::Stage::ReorderGather);
+
             // gather copy into ping pong buffer
             this->thread_executor.execute(particle_blocks.size(), [&](const size_t t_idx) {
                  const auto& block = particle_blocks[t_idx];
@@ -173,6 +205,7 @@ namespace april::container::layout {
                  for (size_t dest_idx : block) {
                      const size_t src_idx = bin_particles[dest_idx];
                      tmp.copy_from(dest_idx, data, src_idx);
+                     if constexpr (has_sort_key<KeyFunc>) sort_keys[dest_idx] = cached_keys[src_idx];
 
                      // Update ID map
                      const auto id = static_cast<size_t>(data.id[src_idx]);
@@ -207,6 +240,7 @@ namespace april::container::layout {
             else if constexpr (F == ParticleField::type)      return self.data.ptr_type + i;
             else if constexpr (F == ParticleField::id)        return self.data.ptr_id + i;
             else if constexpr (F == ParticleField::attributes) return self.data.ptr_attributes + i;
+            else if constexpr (F == ParticleField::scratch)   return self.data.ptr_scratch + i;
         }
 
 
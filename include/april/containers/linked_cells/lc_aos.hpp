@@ -29,56 +29,62 @@ namespace april::container::internal {
     			return math::Range {start, end};
     		};
 
-    		for (const auto & phase : self.phase_schedule) {
-
-    			self.thread_executor.template execute<P>(phase.size(), [&](size_t block_idx) {
-				    thread_local LinkedCellsBatch<AsymBatch, SymBatch> batch;
-
-					auto add_asym = [&](const math::Range & range1, const math::Range & range2) {
-						AsymBatch abatch (self);
-						abatch.range1 = range1;
-						abatch.range2 = range2;
-						batch.asym_chunks.push_back(abatch);
-					};
-
-					auto add_sym = [&](const math::Range & range) {
-						SymBatch sbatch (self);
-						sbatch.range = range;
-						batch.sym_chunks.push_back(sbatch);
-					};
-
-					self.for_each_type_pair([&](const size_t t1, const size_t t2) {
-						auto [bx, by, bz] = phase[block_idx];
-						// init batch
-						batch.clear();
-						batch.types = {static_cast<ParticleType>(t1), static_cast<ParticleType>(t2)};
-
-						// fill the block-batch
-						self.for_each_cell_in_block(bx, by, bz, [&](size_t x, size_t y, size_t z) {
-							self.process_cell_interactions(x, y, z, t1, t2, get_indices, add_sym, add_asym);
-						});
-
-						// dispatch if work exists
-						if (!batch.empty()) {
-							func(batch, batching::NoBatchBCP{});
-						}
+    		auto process_block = [&](const uint3& block) {
+			    thread_local LinkedCellsBatch<AsymBatch, SymBatch> batch;
+			    batching::SortedSweep sweep; // of the current type pair
+
+				auto add_asym = [&](const math::Range & range1, const math::Range & range2,
+					const batching::PairWriteBack writes = batching::PairWriteBack::Both) {
+					AsymBatch abatch (self);
+					abatch.range1 = range1;
+					abatch.range2 = range2;
+					abatch.writes = writes;
+					abatch.sweep = sweep;
+					batch.asym_chunks.push_back(abatch);
+				};
+
+				auto add_sym = [&](const math::Range & range) {
+					SymBatch sbatch (self);
+					sbatch.range = range;
+					sbatch.sweep = sweep;
+					batch.sym_chunks.push_back(sbatch);
+				};
+
+				self.for_each_type_pair([&](const size_t t1, const size_t t2) {
+					auto [bx, by, bz] = block;
+					// init batch
+					batch.clear();
+					batch.types = {static_cast<ParticleType>(t1), static_cast<ParticleType>(t2)};
+					sweep = self.sorted_sweep(t1, t2);
+
+					// fill the block-batch
+					self.for_each_cell_in_block(bx, by, bz, [&](size_t x, size_t y, size_t z) {
+						self.process_cell_interactions(x, y, z, t1, t2, get_indices, add_sym, add_asym);
 					});
-				});
 
-    		}
+					// dispatch if work exists
+					if (!batch.empty()) {
+						func(batch, batching::NoBatchBCP{});
+					}
+				});
+    		};
 
     		// handle wrapped cell pairs
-    		auto process_wrapped = [&](auto&& f, const math::Range& r1, const math::Range& r2, size_t t1, size_t t2, auto&& bcp) {
+    		auto process_wrapped = [&](auto&& f, const math::Range& r1, const math::Range& r2, size_t t1, size_t t2, auto&& bcp,
+    			const batching::PairWriteBack writes) {
     			AsymBatch wrapped_batch(self);
 
     			wrapped_batch.types = {static_cast<ParticleType>(t1), static_cast<ParticleType>(t2)};
     			wrapped_batch.range1 = r1;
     			wrapped_batch.range2 = r2;
+    			wrapped_batch.writes = writes;
 
     			f(wrapped_batch, bcp);
     		};
 
-    		self.template for_each_wrapped_interaction<P>(func, get_indices, process_wrapped);
+    		self.template for_each_scheduled_task<P>(process_block, [&](const auto& pair) {
+    			self.process_wrapped_interaction(pair, func, get_indices, process_wrapped);
+    		});
 		}
     };
 }
@@ -46,47 +46,52 @@ namespace april::container::internal {
 		        return BinRange {chunks, tail, size};
 		    };
 
-    		for (const auto & phase : self.phase_schedule) {
-    			self.thread_executor.template execute<P>(phase.size(), [&](size_t block_idx) {
-				    thread_local LinkedCellsBatch<AsymBatch, SymBatch> batch;
-
-    				auto add_asym = [&](const BinRange & range1, const BinRange & range2) {
-						AsymBatch ab (self, self.ptr_chunks);
-						ab.range1_chunks = range1.range_chunks;
-						ab.range2_chunks = range2.range_chunks;
-						ab.range1_tail = range1.tail;
-						ab.range2_tail = range2.tail;
-						batch.asym_chunks.push_back(ab);
-					};
-
-					auto add_sym = [&](const BinRange & range) {
-						SymBatch sb (self, self.ptr_chunks);
-						sb.range_chunks = range.range_chunks;
-						sb.range_tail = range.tail;
-						batch.sym_chunks.push_back(sb);
-					};
-
-					self.for_each_type_pair([&](const size_t t1, const size_t t2) {
-						auto [bx, by, bz] = phase[block_idx];
-						// init batch
-						batch.clear();
-						batch.types = {static_cast<ParticleType>(t1), static_cast<ParticleType>(t2)};
-
-						// fill the block-batch
-						self.for_each_cell_in_block(bx, by, bz, [&](size_t x, size_t y, size_t z) {
-							self.process_cell_interactions(x, y, z, t1, t2, get_indices, add_sym, add_asym);
-						});
-
-						// dispatch if work exists
-						if (!batch.empty()) {
-							func(batch, batching::NoBatchBCP{});
-						}
+    		auto process_block = [&](const uint3& block) {
+			    thread_local LinkedCellsBatch<AsymBatch, SymBatch> batch;
+			    batching::SortedSweep sweep; // of the current type pair
+
+				auto add_asym = [&](const BinRange & range1, const BinRange & range2,
+					const batching::PairWriteBack writes = batching::PairWriteBack::Both) {
+					AsymBatch ab (self, self.ptr_chunks);
+					ab.range1_chunks = range1.range_chunks;
+					ab.range2_chunks = range2.range_chunks;
+					ab.range1_tail = range1.tail;
+					ab.range2_tail = range2.tail;
+					ab.writes = writes;
+					ab.sweep = sweep;
+					batch.asym_chunks.push_back(ab);
+				};
+
+				auto add_sym = [&](const BinRange & range) {
+					SymBatch sb (self, self.ptr_chunks);
+					sb.range_chunks = range.range_chunks;
+					sb.range_tail = range.tail;
+					sb.sweep = sweep;
+					batch.sym_chunks.push_back(sb);
+				};
+
+				self.for_each_type_pair([&](const size_t t1, const size_t t2) {
+					auto [bx, by, bz] = block;
+					// init batch
+					batch.clear();
+					batch.types = {static_cast<ParticleType>(t1), static_cast<ParticleType>(t2)};
+					sweep = self.sorted_sweep(t1, t2);
+
+					// fill the block-batch
+					self.for_each_cell_in_block(bx, by, bz, [&](size_t x, size_t y, size_t z) {
+						self.process_cell_interactions(x, y, z, t1, t2, get_indices, add_sym, add_asym);
 					});
+
+					// dispatch if work exists
+					if (!batch.empty()) {
+						func(batch, batching::NoBatchBCP{});
+					}
 				});
-    		}
+    		};
 
 			// handle wrapped cell pairs
-    		auto process_wrapped = [&](auto&& f, const BinRange& r1, const BinRange& r2, size_t t1, size_t t2, auto&& bcp) {
+    		auto process_wrapped = [&](auto&& f, const BinRange& r1, const BinRange& r2, size_t t1, size_t t2, auto&& bcp,
+    			const batching::PairWriteBack writes) {
     			AsymBatch wrapped_batch(self, self.ptr_chunks);
 
     			wrapped_batch.types = {static_cast<ParticleType>(t1), static_cast<ParticleType>(t2)};
@@ -94,10 +99,13 @@ namespace april::container::internal {
     			wrapped_batch.range1_tail   = r1.tail;
     			wrapped_batch.range2_chunks = r2.range_chunks;
     			wrapped_batch.range2_tail   = r2.tail;
+    			wrapped_batch.writes = writes;
 
     			f(wrapped_batch, bcp);
     		};
-    		self.template for_each_wrapped_interaction<P>(func, get_indices, process_wrapped);
+    		self.template for_each_scheduled_task<P>(process_block, [&](const auto& pair) {
+    			self.process_wrapped_interaction(pair, func, get_indices, process_wrapped);
+    		});
     	}
     };
 }
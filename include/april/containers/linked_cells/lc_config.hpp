@@ -4,6 +4,8 @@
 
 #include "april/base/types.hpp"
 #include "lc_scheduling.hpp"
+#include "april/containers/layout/internal/memory.hpp"
+#include "april/containers/skin_tuning.hpp"
 
 namespace april::container {
 	enum class CellSize {
@@ -11,13 +13,30 @@ namespace april::container {
 		Half,       // 0.5 * rc
 		Third,      // 0.33 * rc
 		ManualAbs,  // Custom value (absolute)
-		ManualFac   // Custom value (factor * rc)
+		ManualFac,  // Custom value (factor * rc)
+		SmallestCutoff // 1.0 * smallest type pair cutoff (mixtures with very different cutoffs)
 	};
 
 	enum class SkinSize {
 		Factor,
 		Absolute
 	 };
+
+	enum class Traversal {
+		HalfShell, // Newton 3: every cell pair once, colored phases separated by barriers
+		FullShell  // owner computes: every cell pair twice, each block only writes its own cells (single phase)
+	};
+
+	enum class PeriodicHandling {
+		WrapPhases, // wrapped cell pairs run as extra conflict-free phases after the colored sweep
+		Halo        // periodic images are read-only ghost cells of the boundary cells, handled inside the colored sweep
+	};
+
+	enum class LoadBalancing {
+		Static,    // blocks of a phase are dispatched in grid order
+		PairCount, // blocks are dispatched by descending candidate pair count (recounted on every rebuild)
+		Timing     // blocks are dispatched by descending measured sweep time (smoothed over steps)
+	};
 }
 
 namespace april::container::internal {
@@ -31,11 +50,18 @@ namespace april::container::internal {
 
 		SkinSize skin_strategy = SkinSize::Factor;
 		double skin_value = 0.1;
+		std::optional<AdaptiveSkin> adaptive_skin; // skin_value is the initial skin if set
 
 		std::optional<std::function<std::vector<uint32_t>(uint3)>> cell_ordering_fn;
 		uint3 block_size = {2,2,2};
 
 		std::function<size_t(size_t, size_t, size_t, uint3)> schedule_phases = C08_schedule;
+		bool task_graph = false; // run the pair force phases as a dependency graph instead of one barrier per phase
+		Traversal traversal = Traversal::HalfShell;
+		PeriodicHandling periodic_handling = PeriodicHandling::WrapPhases;
+		LoadBalancing load_balancing = LoadBalancing::Static;
+		bool sorted_sweep = false; // sort every cell along one axis and prune pairs out of reach
+		AllocatorConfig allocator; // particle storage and rebuild scratch buffers
 
 		auto&& with_abs_cell_size(this auto&& self, const double cell_size) {
 			self.manual_cell_size = cell_size;
@@ -49,6 +75,9 @@ namespace april::container::internal {
 			return self;
 		}
 
+		// SmallestCutoff stencils reach several cells for the larger cutoffs: use Traversal::FullShell,
+		// task_graph or a scheduler whose coloring covers that reach. Threaded builds throw
+		// std::invalid_argument if blocks of the same color would write the same cells
 		auto&& with_cell_size(this auto&& self, const CellSize cell_size_strategy) {
 			self.cell_size_strategy = cell_size_strategy;
 			return self;
@@ -88,14 +117,69 @@ namespace april::container::internal {
 			return self;
 		}
 
+		// Retunes the skin (and with it the cell grid) during the run from the measured rebuild and traversal
+		// costs and the observed particle displacements. The configured skin is the starting point
+		auto&& with_adaptive_skin(this auto&& self, const AdaptiveSkin& settings = {}) {
+			self.adaptive_skin = settings;
+			return self;
+		}
+
 		auto&& with_scheduling(this auto&& self, std::function<size_t(size_t, size_t, size_t, uint3)> fn) {
 			self.schedule_phases = std::move(fn);
 			return self;
 		}
 
-		[[nodiscard]] double get_width(const double max_force_cutoff) const {
+		// Only covers the color and wrap phases of the pair force sweep. Topology batches, force fields and
+		// integrator sweeps still run as separate executor calls with a barrier each
+		auto&& with_task_graph(this auto&& self, const bool enabled = true) {
+			self.task_graph = enabled;
+			return self;
+		}
+
+		auto&& with_allocator(this auto&& self, const AllocatorConfig& allocator) {
+			self.allocator = allocator;
+			return self;
+		}
+
+		auto&& with_huge_pages(this auto&& self, const HugePages mode) {
+			self.allocator.huge_pages = mode;
+			return self;
+		}
+
+		// FullShell ignores the coloring (and task_graph): all blocks run in a single phase
+		auto&& with_traversal(this auto&& self, const Traversal traversal) {
+			self.traversal = traversal;
+			return self;
+		}
+
+		// Halo evaluates every wrapped cell pair from both sides and only keeps the writes to the in-domain cell.
+		// This doubles the (boundary layer only) wrapped pair work but removes all wrap phases and their barriers
+		auto&& with_periodic_handling(this auto&& self, const PeriodicHandling handling) {
+			self.periodic_handling = handling;
+			return self;
+		}
+
+		// Orders the blocks of every phase by cost, so the executor's dynamic chunking starts the most expensive
+		// blocks first (longest processing time first). Has no effect with task_graph, which already dispatches
+		// blocks as soon as their dependencies are done, or on serial execution
+		auto&& with_load_balancing(this auto&& self, const LoadBalancing balancing) {
+			self.load_balancing = balancing;
+			return self;
+		}
+
+		// Keeps the particles of every cell sorted along the last non-flat axis (z for 3D domains), updated on
+		// every rebuild. The pair loops then skip particles whose separation along that axis exceeds the pair
+		// cutoff plus the skin: scalar loops per particle, packed loops per SIMD block. Pays off for wide
+		// cells (CellSize::Cutoff) where most candidates of a cell pair are out of reach
+		auto&& with_sorted_sweep(this auto&& self, const bool enabled = true) {
+			self.sorted_sweep = enabled;
+			return self;
+		}
+
+		[[nodiscard]] double get_width(const double max_force_cutoff, const double min_force_cutoff) const {
 			switch (cell_size_strategy) {
 			case CellSize::Cutoff: return max_force_cutoff;
+			case CellSize::SmallestCutoff: return min_force_cutoff;
 			case CellSize::Half:   return max_force_cutoff / 2.0;
 			case CellSize::Third:  return max_force_cutoff / 3.0;
 			case CellSize::ManualAbs: return manual_cell_size.value();
@@ -1,23 +1,32 @@
 #pragma once
 
 #include <vector>
+#include <chrono>
 #include <cmath>
 #include <algorithm>
 #include <utility>
 #include <functional>
 #include <limits>
+#include <optional>
+#include <stdexcept>
 
 #include "april/base/types.hpp"
 #include "april/core/domain.hpp"
 
 #include "april/containers/linked_cells/lc_batching.hpp"
+#include "april/containers/linked_cells/lc_config.hpp"
+#include "april/containers/batching/write_back.hpp"
+#include "april/containers/batching/sorted_sweep.hpp"
+#include "april/containers/layout/internal/memory.hpp"
 #include "april/containers/batching/topology_batch.hpp"
 
 #include "april/exec/kernel.hpp"
 #include "april/exec/threading/scheduling.hpp"
+#include "april/exec/threading/task_graph.hpp"
 #include "april/exec/threading/threading_context.hpp"
 
 #include "april/particle/properties.hpp"
+#include "april/utility/stage_profile.hpp"
 
 namespace april::math {
 	struct Range;
@@ -45,6 +54,7 @@ namespace april::container::internal {
 			const cell_index_t c2 = {};
 			const CellWrapFlag force_wrap = {};
 			const vec3 shift = {};
+			const batching::PairWriteBack writes = batching::PairWriteBack::Both;
 		};
 
 	public:
@@ -58,14 +68,26 @@ namespace april::container::internal {
 			self.setup_topology_batches();
 			self.setup_cell_grid();
 			self.init_cell_order();
+			self.setup_hinted_regions();
 			self.create_neighbor_stencil();
 			self.compute_wrapped_cell_pairs();
 			self.build_storage(particles);
 			self.pre_allocate_assignment_bins();
+
+			const auto rebuild_start = std::chrono::steady_clock::now();
 			self.rebuild_structure_impl();
+			if (self.skin_tuner) {
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - rebuild_start;
+				self.skin_tuner->seed_rebuild_cost(elapsed.count());
+			}
+
 			self.schedule_phases();
+			self.rebalance_phases(true);
 
 			// TODO once we can use reflection automatically serialize add a vec3 last_rebuild_position member to particle attributes
+			for (auto* last : {&self.last_x, &self.last_y, &self.last_z}) {
+				layout::rebind_allocator(*last, self.allocator_config());
+			}
 			self.last_x.resize(particles.size());
 			self.last_y.resize(particles.size());
 			self.last_z.resize(particles.size());
@@ -84,11 +106,19 @@ namespace april::container::internal {
 
 		template<ParallelPolicy P, typename Func>
 		void for_each_topology_batch(this auto&& self, Func && f) {
-			for (const auto& phase : self.topology_phases) {
-				self.thread_executor.template execute<P>(phase.size(), [&](size_t i) {
-					f(phase[i]);
-				});
-			}
+			uint32_t phase_idx = 0;
+			auto run_phases = [&](const auto& phases) {
+				for (const auto& phase : phases) {
+					const utility::StageScope stage(utility::Stage::TopologyPhase, phase_idx++);
+					self.thread_executor.template execute<P>(phase.size(), [&](size_t i) {
+						f(phase[i]);
+					});
+				}
+			};
+
+			run_phases(self.topology_phases);
+			run_phases(self.angle_phases);
+			run_phases(self.dihedral_phases);
 		}
 
 
@@ -100,11 +130,16 @@ namespace april::container::internal {
 		// Persistent member variable
 		std::vector<PaddedThreadBuffer> thread_local_buffers;
 
-		std::vector<vec3::type> last_x;
-		std::vector<vec3::type> last_y;
-		std::vector<vec3::type> last_z;
+		layout::PageVector<vec3::type> last_x;
+		layout::PageVector<vec3::type> last_y;
+		layout::PageVector<vec3::type> last_z;
 
 		void rebuild_structure(this auto && self) {
+			if (self.skin_tuner) {
+				self.rebuild_structure_tuned();
+				return;
+			}
+
 			std::atomic rebuild = false;
 
 			// check if a particle has moved further than the  skin thickness
@@ -118,54 +153,217 @@ namespace april::container::internal {
 
 			if (rebuild) {
 				self.rebuild_structure_impl();
+				self.cache_rebuild_positions();
+			}
 
-				// cache current particles positions
-				self.template for_each_particle<parallel_policy>(
-					scalar_kernel<ParticleField::position | ParticleField::id>([&](auto && p) {
-						self.last_x[p.id] = p.position.x;
-						self.last_y[p.id] = p.position.y;
-						self.last_z[p.id] = p.position.z;
-					})
-				);
+			self.rebalance_phases(rebuild);
+		}
+
+		// rebuild_structure with an adaptive skin: additionally measures the largest displacement and the rebuild
+		// cost, and lets the tuner replace the cell grid every AdaptiveSkin::interval updates
+		void rebuild_structure_tuned(this auto && self) {
+			auto& tuner = *self.skin_tuner;
+
+			// largest per-axis displacement since the last rebuild, reduced over per-thread slots
+			self.thread_max_displacement.assign(self.thread_executor.num_threads(), {});
+			self.template for_each_particle<parallel_policy>(
+				scalar_kernel<ParticleField::position| ParticleField::id>([&](auto && p) {
+					double& max_displacement = self.thread_max_displacement[exec::thread_index()].value;
+					max_displacement = std::max({
+						max_displacement,
+						static_cast<double>(std::abs(self.last_x[p.id] - p.position.x)),
+						static_cast<double>(std::abs(self.last_y[p.id] - p.position.y)),
+						static_cast<double>(std::abs(self.last_z[p.id] - p.position.z))
+					});
+				})
+			);
+
+			double displacement = 0;
+			for (const auto& slot : self.thread_max_displacement) displacement = std::max(displacement, slot.value);
+			tuner.record_update(displacement, ++self.updates_since_rebuild);
+
+			// a regrid reorders the storage as well, so it replaces the rebuild of this update
+			if (tuner.decision_due() && tuner.decide()) {
+				self.regrid();
+				return;
+			}
+
+			const bool rebuild = displacement > self.verlet_skin / 2;
+			if (rebuild) {
+				const auto start = std::chrono::steady_clock::now();
+				self.rebuild_structure_impl();
+				self.cache_rebuild_positions();
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+				tuner.record_rebuild(elapsed.count());
+				self.updates_since_rebuild = 0;
 			}
+
+			self.rebalance_phases(rebuild);
+		}
+
+		// replaces the cell grid with the one for the tuner's target skin, the particles stay in place
+		void regrid(this auto && self) {
+			// these are only appended to during setup
+			self.neighbor_stencil.clear();
+			self.wrapped_cell_pairs.clear();
+			self.phase_schedule.clear();
+			self.wrapped_phase_schedule.clear();
+
+			self.setup_cell_grid();
+			self.init_cell_order();
+			self.setup_hinted_regions();
+			self.create_neighbor_stencil();
+			self.compute_wrapped_cell_pairs();
+			self.pre_allocate_assignment_bins();
+			self.rebuild_structure_impl();
+			self.schedule_phases();
+			self.rebalance_phases(true);
+			self.cache_rebuild_positions();
+			self.updates_since_rebuild = 0;
+		}
+
+		void cache_rebuild_positions(this auto && self) {
+			self.template for_each_particle<parallel_policy>(
+				scalar_kernel<ParticleField::position | ParticleField::id>([&](auto && p) {
+					self.last_x[p.id] = p.position.x;
+					self.last_y[p.id] = p.position.y;
+					self.last_z[p.id] = p.position.z;
+				})
+			);
+		}
+
+		// decision history of the adaptive skin, nullptr if the skin is fixed
+		[[nodiscard]] const SkinTuningLog* skin_tuning() const noexcept {
+			return skin_tuner ? &skin_tuner->history() : nullptr;
 		}
 
 		void rebuild_structure_impl(this auto&& self) {
-			self.reorder_storage(self.n_bins, [&](const size_t i) {
+			auto calc_bin = [&](const size_t i) {
 				const auto p = self.template view<ParticleField::position | ParticleField::type>(i);
 				const size_t cid = self.cell_index_from_position( p.position);
 				return self.bin_index(cid, p.type);
-			});
+			};
+
+			if (self.config.sorted_sweep) {
+				// the keys are the positions along the sort axis at this rebuild
+				self.reorder_storage(self.n_bins, calc_bin, [&](const size_t i) {
+					return self.template view<ParticleField::position>(i).position[self.sort_axis];
+				});
+			} else {
+				self.reorder_storage(self.n_bins, calc_bin);
+			}
+			self.update_hinted_regions();
 		}
 
-		[[nodiscard]] std::vector<size_t> collect_indices_in_region(this const auto& self, const core::Box & region) {
-		    const std::vector<cell_index_t> cells = self.get_cells_in_region(region);
+		// replaces the contents of indices with the indices of alive particles inside region
+		void collect_indices_in_region(this const auto& self, const core::Box & region, std::vector<size_t> & indices) {
+			// hinted regions keep their particle slices up to date on every rebuild, no geometry work needed
+			if (const HintedRegion* hinted = self.find_hinted_region(region)) {
+				const auto& slices = hinted->slices;
+				self.collect_alive_in_slices(region, slices.size(), hinted->candidates, indices, [&](const size_t s) {
+					return std::pair{slices[s].start, slices[s].stop};
+				});
+				return;
+			}
 
-		    if (cells.empty()) return {};
+		    auto& cells = self.region_query_scratch.cells;
+		    cells.clear();
+		    self.for_each_cell_in_region(region, [&](const cell_index_t cid) { cells.push_back(cid); });
 
-			// partition the entire particle range into independent blocks/tasks
-		    auto blocks = exec::make_linear_schedule(math::Range{0, cells.size()}, self.linear_schedule_config);
-		    const size_t num_tasks = blocks.size();
+			// heuristic for the number of particles (assumes uniform distribution)
+		    const size_t expected = self.particle_count() * cells.size() / self.n_cells;
+		    self.collect_alive_in_slices(region, cells.size(), expected, indices, [&](const size_t c) {
+		        return self.cell_index_range(cells[c]);
+		    });
+		}
+
+
+	protected:
+		// precomputed lookup structure of a region from ContainerHints::query_regions
+		struct HintedRegion {
+			core::Box box;
+			std::vector<cell_index_t> cells; // overlapping cells in storage order, fixed after build
+			std::vector<math::Range> slices; // merged particle index ranges of these cells, refreshed on rebuild
+			size_t candidates = 0; // number of particles in slices
+		};
+
+		std::vector<HintedRegion> hinted_regions;
+
+		void setup_hinted_regions(this auto && self) {
+			self.hinted_regions.clear();
+			for (const core::Box & box : self.hints.query_regions) {
+				HintedRegion& hinted = self.hinted_regions.emplace_back(HintedRegion{.box = box});
+				self.for_each_cell_in_region(box, [&](const cell_index_t cid) { hinted.cells.push_back(cid); });
+
+				// particles are sorted by cell, so sorted cells yield ascending (and mergeable) slices
+				std::ranges::sort(hinted.cells);
+				hinted.cells.erase(std::ranges::unique(hinted.cells).begin(), hinted.cells.end());
+				hinted.slices.reserve(hinted.cells.size());
+			}
+		}
 
-			// allocate buffers for each task
-		    std::vector<std::vector<size_t>> local_results(self.thread_executor.num_threads());
+		// called after every reorder_storage, O(cells in hinted regions)
+		void update_hinted_regions(this auto && self) {
+			for (HintedRegion& hinted : self.hinted_regions) {
+				hinted.slices.clear();
+				hinted.candidates = 0;
 
-			// preallocate storage with heuristic (assumes uniform distribution)
-		    const size_t est_count_per_task = (self.particle_count() * cells.size() / self.n_cells) / num_tasks + 1;
-		    for (auto& loc : local_results) {
-		        loc.reserve(est_count_per_task);
+				for (const cell_index_t cid : hinted.cells) {
+					const auto [start, end] = self.cell_index_range(cid);
+					if (start == end) continue;
+
+					if (!hinted.slices.empty() && hinted.slices.back().stop == start) {
+						hinted.slices.back().stop = end;
+					} else {
+						hinted.slices.emplace_back(start, end);
+					}
+					hinted.candidates += end - start;
+				}
+			}
+		}
+
+		[[nodiscard]] const HintedRegion* find_hinted_region(this const auto & self, const core::Box & region) noexcept {
+			for (const HintedRegion& hinted : self.hinted_regions) {
+				if (hinted.box == region) return &hinted;
+			}
+			return nullptr;
+		}
+
+		// filters the particle slices slice_of(0) ... slice_of(n_slices - 1) for alive particles inside region
+		template<typename SliceFn>
+		void collect_alive_in_slices(
+			this const auto& self,
+			const core::Box & region,
+			const size_t n_slices,
+			const size_t expected_count,
+			std::vector<size_t> & indices,
+			SliceFn && slice_of
+		) {
+		    if (n_slices == 0) {
+		        indices.clear();
+		        return;
 		    }
 
+		    auto& scratch = self.region_query_scratch;
+
+			// partition the slices into independent blocks/tasks
+		    exec::make_linear_schedule(math::Range{0, n_slices}, self.linear_schedule_config, scratch.blocks);
+		    const auto& blocks = scratch.blocks;
+		    const size_t num_tasks = blocks.size();
+
+			// reuse the persistent per-thread buffers
+		    scratch.prepare(self.thread_executor.num_threads(), expected_count / num_tasks + 1);
+
 			// process all tasks in parallel
 		    self.thread_executor.template execute<parallel_policy>(num_tasks, [&](const size_t t_idx) {
 		        const auto& block = blocks[t_idx];
-		        auto& local_ret = local_results[exec::thread_index()];
+		        auto& local_ret = scratch.local(exec::thread_index());
 
-		        // each task loops over its assigned chunk of cells
+		        // each task loops over its assigned chunk of slices
 		        for (size_t c = block.start; c < block.stop; ++c) {
 		        	// get the search range (slice of particle data)
-		            const size_t cid = cells[c];
-		            const auto [start_idx, end_idx] = self.cell_index_range(cid);
+		            const auto [start_idx, end_idx] = slice_of(c);
 
 		        	// skip empty ranges
 		            if (start_idx == end_idx) continue;
@@ -203,25 +401,10 @@ namespace april::container::internal {
 		        }
 		    });
 
-			// allocate storage for indices buffer
-		    size_t total_found = 0;
-		    for (const auto& loc : local_results) {
-		        total_found += loc.size();
-		    }
-
-		    std::vector<size_t> ret;
-		    ret.reserve(total_found);
-
 			// merge all local buffers into indices buffer
-		    for (const auto& loc : local_results) {
-		        ret.insert(ret.end(), loc.begin(), loc.end());
-		    }
-
-		    return ret;
+		    scratch.gather(indices);
 		}
 
-
-	protected:
 		size_t outside_cell_id {};
 		size_t n_grid_cells {};
 		size_t n_cells {}; // total cells = grid + outside
@@ -229,6 +412,7 @@ namespace april::container::internal {
 		size_t n_bins {}; // number of bins (cells * types)
 		double global_cutoff {}; // maximum force cutoff
 		double verlet_skin {};
+		int sort_axis = 2; // axis the cells are sorted along (sorted sweep), the last one with an extent
 
 		vec3d cell_size; // side lengths of each cell
 		vec3d inv_cell_size; // cache the inverse of each size component to avoid divisions
@@ -240,9 +424,28 @@ namespace april::container::internal {
 
 		// cell pair info
 		std::vector<int3> neighbor_stencil;
+		struct PairStencil {
+			bool active = false;       // the type pair has a force
+			std::vector<int3> offsets; // subset of neighbor_stencil
+			double reach = std::numeric_limits<double>::infinity(); // cutoff plus skin
+		};
+		std::vector<PairStencil> pair_stencils; // per type pair (t1 * n_types + t2)
 		std::vector<WrappedCellPair> wrapped_cell_pairs;
 		std::vector<std::vector<uint3>> phase_schedule; // for user defined coloring scheme
 		std::vector<std::vector<WrappedCellPair>> wrapped_phase_schedule;
+		exec::TaskGraph interaction_graph; // phase_schedule + wrapped_phase_schedule as one dependency graph (if enabled)
+		std::vector<std::vector<WrappedCellPair>> owned_wrapped_pairs; // per cell, owner-computes form (full shell or halo)
+		uint3 blocks_per_axis{};
+		mutable std::vector<double> block_costs; // per block_index, pair counts or smoothed sweep times (load balancing)
+
+		// adaptive skin (if enabled), mutable since the const pair sweeps report their time
+		mutable std::optional<SkinTuner> skin_tuner;
+		size_t updates_since_rebuild = 0;
+
+		struct alignas(64) PaddedDisplacement {
+			double value = 0;
+		};
+		std::vector<PaddedDisplacement> thread_max_displacement;
 
 
 		//------
@@ -282,21 +485,25 @@ namespace april::container::internal {
 
 					batching::TopologyBatch<2, ContainerType> batch;
 					batch.container_ptr = this;
-					batch.representatives = {
-						static_cast<ParticleType>(t1),
-						static_cast<ParticleType>(t2)
-					};
+					batch.ids = {t1, t2};
 
 					batch.interactions.reserve(batch_pairs.size());
 					for (auto& [id1, id2] : batch_pairs) {
 						batch.interactions.push_back({id1, id2});
 					}
+					batch.build_lane_groups();
 
 					current_phase_batches.push_back(std::move(batch));
 				}
 
 				topology_phases.push_back(std::move(current_phase_batches));
 			}
+
+			// bonded (3- and 4-body) interactions are scheduled per force
+			angle_phases = batching::build_bonded_phases<3>(
+				this, this->interaction_map.bonded_interactions, max_partition_size, min_batches_threshold);
+			dihedral_phases = batching::build_bonded_phases<4>(
+				this, this->interaction_map.bonded_interactions, max_partition_size, min_batches_threshold);
 		}
 
 		void setup_cell_grid(this auto&& self) {
@@ -320,13 +527,29 @@ namespace april::container::internal {
 				max_cutoff = min_dim / 2.0;
 			}
 
+			// smallest cutoff among the type pairs, for cells sized by it
+			double min_cutoff = max_cutoff;
+			for (const auto & interaction : self.interaction_map.interactions) {
+				if (interaction.is_active && !interaction.used_by_types.empty() && interaction.cutoff > 0) {
+					min_cutoff = std::min(min_cutoff, interaction.cutoff);
+				}
+			}
+
 			// set target cell size and verlet skin
-			double target_cell_size = self.config.get_width(max_cutoff);
+			double target_cell_size = self.config.get_width(max_cutoff, min_cutoff);
 			APRIL_ASSERT(target_cell_size > 0, "Calculated cell size must be > 0");
 
 			self.verlet_skin = self.config.get_skin(target_cell_size);
 			APRIL_ASSERT(target_cell_size >= 0, "Calculated cell size must be > 0");
 
+			// the configured skin only seeds the adaptive skin, afterward the tuner picks it
+			if (self.config.adaptive_skin) {
+				if (!self.skin_tuner) self.skin_tuner.emplace(*self.config.adaptive_skin, self.verlet_skin);
+				const vec3d extent = {self.domain.extent.x, self.domain.extent.y, self.domain.extent.z};
+				self.skin_tuner->set_geometry(extent, max_cutoff, target_cell_size);
+				self.verlet_skin = self.skin_tuner->target_skin();
+			}
+
 			target_cell_size += self.verlet_skin;
 
 			// compute number of cells along each axis
@@ -351,6 +574,13 @@ namespace april::container::internal {
 
 			self.cells_per_axis = uint3{num_x, num_y, num_z};
 			self.cell_per_axis_xy = self.cells_per_axis.x * self.cells_per_axis.y;
+			self.sort_axis = self.domain.extent.z > 0 ? 2 : self.domain.extent.y > 0 ? 1 : 0;
+
+			// the stretched cells usually leave room for a larger skin, which saves rebuilds at no traversal cost
+			if (self.skin_tuner) {
+				self.verlet_skin = self.skin_tuner->usable_skin(self.cell_size, self.verlet_skin);
+				self.skin_tuner->grid_changed(self.verlet_skin, self.cells_per_axis);
+			}
 
 			// set scalars
 			self.n_types = self.interaction_map.types.size();
@@ -404,6 +634,44 @@ namespace april::container::internal {
 					}
 				}
 			}
+
+			self.create_pair_stencils();
+		}
+
+		// Narrows the neighbor stencil down to every type pair's own cutoff. A pair keeps the offsets whose closest
+		// cell distance lies within its cutoff plus the skin (the global stencil still bounds it). Pairs without an
+		// active force get no stencil and are skipped altogether
+		void create_pair_stencils(this auto && self) {
+			const auto& map = self.interaction_map;
+			self.pair_stencils.assign(self.n_types * self.n_types, {});
+
+			for (size_t t1 = 0; t1 < self.n_types; ++t1) {
+				for (size_t t2 = 0; t2 < self.n_types; ++t2) {
+					const auto& interaction = map.interactions[map.type_interaction_matrix[t1 * map.types.size() + t2]];
+					PairStencil& stencil = self.pair_stencils[t1 * self.n_types + t2];
+
+					stencil.active = interaction.is_active;
+					if (!stencil.active) continue;
+
+					stencil.reach = interaction.cutoff + self.verlet_skin;
+
+					// cutoffs beyond the global one (e.g. no cutoff) keep the whole stencil
+					if (interaction.cutoff >= self.global_cutoff) {
+						stencil.offsets = self.neighbor_stencil;
+						continue;
+					}
+
+					const double reach = stencil.reach;
+					for (const int3 offset : self.neighbor_stencil) {
+						const vec3d dist_vec = {
+							std::abs(offset.x) > 1 ? (std::abs(offset.x) - 1) * self.cell_size.x : 0,
+							std::abs(offset.y) > 1 ? (std::abs(offset.y) - 1) * self.cell_size.y : 0,
+							std::abs(offset.z) > 1 ? (std::abs(offset.z) - 1) * self.cell_size.z : 0,
+						};
+						if (dist_vec.norm_squared() <= reach * reach) stencil.offsets.push_back(offset);
+					}
+				}
+			}
 		}
 
 		void compute_wrapped_cell_pairs(this auto && self) {
@@ -481,9 +749,35 @@ namespace april::container::internal {
 			}
 		}
 
+		[[nodiscard]] bool full_shell() const noexcept {
+			return this->config.traversal == Traversal::FullShell;
+		}
+
+		// wrapped pairs are handled by the blocks owning their cells instead of separate wrap phases
+		[[nodiscard]] bool owns_wrapped_pairs() const noexcept {
+			return full_shell() || this->config.periodic_handling == PeriodicHandling::Halo;
+		}
+
 		void schedule_phases() {
 			const auto& batch_dim = this->config.block_size;
 
+			blocks_per_axis = {
+				(cells_per_axis.x + batch_dim.x - 1) / batch_dim.x,
+				(cells_per_axis.y + batch_dim.y - 1) / batch_dim.y,
+				(cells_per_axis.z + batch_dim.z - 1) / batch_dim.z
+			};
+			block_costs.assign(static_cast<size_t>(blocks_per_axis.x) * blocks_per_axis.y * blocks_per_axis.z, 0.0);
+
+			// owner computes: blocks never write outside their own cells, so they are all independent
+			if (full_shell()) {
+				phase_schedule.assign(1, {});
+				for_each_block([&](size_t bx, size_t by, size_t bz) {
+					phase_schedule[0].emplace_back(bx, by, bz);
+				});
+				build_owned_wrapped_pairs();
+				return;
+			}
+
 			// schedule phases for neighboring cells according to user defined color scheme
 			for_each_block([&](size_t bx, size_t by, size_t bz) {
 				const size_t logical_x = bx / batch_dim.x;
@@ -498,6 +792,22 @@ namespace april::container::internal {
 				phase_schedule[color].emplace_back(bx, by, bz);
 			});
 
+			// the task graph orders blocks by the cells they actually write, so only the plain phases can race
+			if (this->config.cell_size_strategy == CellSize::SmallestCutoff &&
+				parallel_policy == ParallelPolicy::Threaded && !this->config.task_graph) {
+				check_coloring_covers_stencil();
+			}
+
+			// halo: the image side of a wrapped pair is only read, so the pairs fit into the blocks of their cells
+			if (owns_wrapped_pairs()) {
+				build_owned_wrapped_pairs();
+				wrapped_phase_schedule.clear();
+				if (this->config.task_graph) {
+					build_interaction_graph();
+				}
+				return;
+			}
+
 			// schedule wrapped neighbor cells (if force wrapping is enabled)
 			// create an edge list graph of interacting wrapped pairs
 			std::vector<std::vector<uint32_t>> touched_cells;
@@ -534,6 +844,184 @@ namespace april::container::internal {
 
 				wrapped_phase_schedule.push_back(std::move(phase_pairs));
 			}
+
+			if (this->config.task_graph) {
+				build_interaction_graph();
+			}
+		}
+
+		// Blocks of one phase run concurrently, so no two blocks of the same color may write a common cell.
+		// A block writes its own cells plus everything its half stencil reaches, hence two blocks conflict if
+		// their distance along every axis is at most the stencil extent on that axis.
+		void check_coloring_covers_stencil() const {
+			int3 reach_lo{0, 0, 0};
+			int3 reach_hi{0, 0, 0};
+			for (const auto& offset : neighbor_stencil) {
+				for (int a = 0; a < 3; ++a) {
+					reach_lo[a] = std::max(reach_lo[a], -offset[a]);
+					reach_hi[a] = std::max(reach_hi[a], offset[a]);
+				}
+			}
+
+			const auto& batch_dim = this->config.block_size;
+			int3 conflict_dist{};
+			for (int a = 0; a < 3; ++a) {
+				const int extent = reach_lo[a] + reach_hi[a];
+				const int block = static_cast<int>(batch_dim[a]);
+				conflict_dist[a] = extent == 0 ? 0 : (extent - 1) / block + 1;
+			}
+
+			const auto color_of = [&](const int x, const int y, const int z) {
+				return this->config.schedule_phases(
+					static_cast<size_t>(x), static_cast<size_t>(y), static_cast<size_t>(z), batch_dim
+				);
+			};
+
+			const int3 blocks = {
+				static_cast<int>(blocks_per_axis.x),
+				static_cast<int>(blocks_per_axis.y),
+				static_cast<int>(blocks_per_axis.z)
+			};
+
+			for (int z = 0; z < blocks.z; ++z)
+			for (int y = 0; y < blocks.y; ++y)
+			for (int x = 0; x < blocks.x; ++x) {
+				const size_t color = color_of(x, y, z);
+
+				// only compare against the blocks after this one, each conflicting pair is seen once
+				for (int dz = 0; dz <= conflict_dist.z && z + dz < blocks.z; ++dz)
+				for (int dy = -conflict_dist.y; dy <= conflict_dist.y; ++dy)
+				for (int dx = -conflict_dist.x; dx <= conflict_dist.x; ++dx) {
+					if (dz == 0 && (dy < 0 || (dy == 0 && dx <= 0))) continue;
+
+					const int nx = x + dx, ny = y + dy;
+					if (nx < 0 || ny < 0 || nx >= blocks.x || ny >= blocks.y) continue;
+
+					if (color_of(nx, ny, z + dz) == color) {
+						throw std::invalid_argument(
+							"[April] the neighbor stencil of CellSize::SmallestCutoff reaches further than the "
+							"phase coloring separates blocks of the same color. Use Traversal::FullShell, a larger "
+							"block_size or a scheduler with more colors."
+						);
+					}
+				}
+			}
+		}
+
+		// Splits every wrapped pair into one entry per cell that only writes that cell. The reverse entry
+		// sees the other image, hence the negated shift. Self-wrapping pairs stay regular (both sides are owned).
+		void build_owned_wrapped_pairs() {
+			using batching::PairWriteBack;
+			owned_wrapped_pairs.assign(n_grid_cells, {});
+
+			for (const auto& pair : wrapped_cell_pairs) {
+				if (pair.c1 == pair.c2) {
+					owned_wrapped_pairs[pair.c1].push_back(pair);
+					continue;
+				}
+
+				owned_wrapped_pairs[pair.c1].push_back({pair.c1, pair.c2, pair.force_wrap, pair.shift, PairWriteBack::First});
+				owned_wrapped_pairs[pair.c2].push_back({pair.c2, pair.c1, pair.force_wrap, -pair.shift, PairWriteBack::First});
+			}
+		}
+
+		// --------------
+		// LOAD BALANCING
+		// --------------
+		// the task graph pins blocks to task ids and already starts blocks as soon as their dependencies are done
+		[[nodiscard]] bool balances_blocks() const noexcept {
+			return this->config.load_balancing != LoadBalancing::Static && !(this->config.task_graph && !full_shell());
+		}
+
+		[[nodiscard]] size_t block_index(const uint3& block) const noexcept {
+			const auto& bdim = this->config.block_size;
+			return (static_cast<size_t>(block.z / bdim.z) * blocks_per_axis.y + block.y / bdim.y) * blocks_per_axis.x
+				+ block.x / bdim.x;
+		}
+
+		// Orders the blocks of every phase by descending cost. Blocks of one phase write disjoint cells, so the
+		// order does not change the result. Pair counts only change when particles changed cells.
+		void rebalance_phases(this auto&& self, const bool cells_changed) {
+			if (!self.balances_blocks()) return;
+
+			if (self.config.load_balancing == LoadBalancing::PairCount) {
+				if (!cells_changed) return;
+				self.count_block_pairs();
+			}
+
+			for (auto& phase : self.phase_schedule) {
+				std::ranges::sort(phase, [&](const uint3& a, const uint3& b) {
+					const size_t ia = self.block_index(a), ib = self.block_index(b);
+					const double ca = self.block_costs[ia], cb = self.block_costs[ib];
+					return ca != cb ? ca > cb : ia < ib;
+				});
+			}
+		}
+
+		// number of candidate particle pairs every block evaluates (including the wrapped pairs it owns)
+		void count_block_pairs(this auto&& self) {
+			auto count = [&](const size_t cid) {
+				const auto [start, end] = self.cell_index_range(static_cast<cell_index_t>(cid));
+				return static_cast<double>(end - start);
+			};
+
+			for (const auto& phase : self.phase_schedule) {
+				for (const uint3& block : phase) {
+					double pairs = 0;
+					self.for_each_cell_in_block(block.x, block.y, block.z, [&](size_t x, size_t y, size_t z) {
+						const size_t c = self.cell_pos_to_idx(x, y, z);
+						const double n = count(c);
+						if (n == 0) return;
+
+						pairs += n * (n - 1) / 2;
+						for (const auto offset : self.neighbor_stencil) {
+							const size_t c_n = self.get_neighbor_idx(x, y, z, offset);
+							if (c_n != self.outside_cell_id) pairs += n * count(c_n);
+						}
+						if (self.owns_wrapped_pairs()) {
+							for (const auto& pair : self.owned_wrapped_pairs[c]) pairs += n * count(pair.c2);
+						}
+					});
+
+					// full shell visits every neighbor pair from both sides
+					self.block_costs[self.block_index(block)] = self.full_shell() ? 2 * pairs : pairs;
+				}
+			}
+		}
+
+		// Every block task writes all cells its half stencil reaches and every wrapped pair writes both of its cells.
+		// The coloring then only determines the stage order, while blocks of consecutive colors (and wrapped pairs)
+		// start as soon as the tasks they actually overlap with have finished.
+		// The graph ends with the pair sweep: topology batches and force fields are not part of it.
+		void build_interaction_graph() {
+			interaction_graph.clear();
+
+			for (const auto& phase : phase_schedule) {
+				const size_t stage = interaction_graph.add_stage(phase.size());
+
+				for (size_t i = 0; i < phase.size(); ++i) {
+					const auto [bx, by, bz] = phase[i];
+					for_each_cell_in_block(bx, by, bz, [&](size_t x, size_t y, size_t z) {
+						interaction_graph.writes(stage, i, this->cell_pos_to_idx(x, y, z));
+
+						for (const auto offset : neighbor_stencil) {
+							const size_t c_n = get_neighbor_idx(x, y, z, offset);
+							if (c_n != this->outside_cell_id) interaction_graph.writes(stage, i, c_n);
+						}
+					});
+				}
+			}
+
+			for (const auto& phase : wrapped_phase_schedule) {
+				const size_t stage = interaction_graph.add_stage(phase.size());
+
+				for (size_t i = 0; i < phase.size(); ++i) {
+					interaction_graph.writes(stage, i, phase[i].c1);
+					interaction_graph.writes(stage, i, phase[i].c2);
+				}
+			}
+
+			interaction_graph.compile();
 		}
 
 
@@ -587,6 +1075,14 @@ namespace april::container::internal {
 			AddSym&& add_sym,
 			AddAsym&& add_asym
 		) const {
+			if (full_shell()) {
+				process_owned_cell_interactions(x, y, z, t1, t2, get_range, add_sym, add_asym);
+				return;
+			}
+
+			const PairStencil& stencil = pair_stencil(t1, t2);
+			if (!stencil.active) return;
+
 			const size_t c = this->cell_pos_to_idx(x, y, z);
 			auto range1 = get_range(c, t1);
 
@@ -605,7 +1101,7 @@ namespace april::container::internal {
 			if (range1.empty() && (t1 == t2)) return;
 
 			// inter-cell: process forces between particles of neighboring cells
-			for (auto offset : this->neighbor_stencil) {
+			for (auto offset : stencil.offsets) {
 				size_t c_n = this->get_neighbor_idx(x, y, z, offset);
 				if (c_n == this->outside_cell_id) continue;
 
@@ -628,35 +1124,156 @@ namespace april::container::internal {
 			}
 		}
 
-		template <ParallelPolicy P, typename Func, typename GetIndices, typename ProcessBatch>
-		APRIL_FORCE_INLINE void for_each_wrapped_interaction(
+		// Owner-computes variant of process_cell_interactions: walks the full stencil (both signs of every half stencil
+		// offset) and emits neighbor pairs via add_asym(range1, range2, writes) so that only the cell's own side is written.
+		template <typename GetRange, typename AddSym, typename AddAsym>
+		APRIL_FORCE_INLINE void process_owned_cell_interactions(
+			size_t x, size_t y, size_t z,
+			size_t t1, size_t t2,
+			GetRange&& get_range,
+			AddSym&& add_sym,
+			AddAsym&& add_asym
+		) const {
+			using batching::PairWriteBack;
+
+			const PairStencil& stencil = pair_stencil(t1, t2);
+			if (!stencil.active) return;
+
+			const size_t c = this->cell_pos_to_idx(x, y, z);
+			auto range1 = get_range(c, t1);
+			auto range2 = get_range(c, t2);
+
+			// intra-cell: both sides are owned
+			if (t1 == t2) {
+				if (range1.size() > 1) add_sym(range1);
+			} else if (!range1.empty() && !range2.empty()) {
+				add_asym(range1, range2, PairWriteBack::Both);
+			}
+
+			if (range1.empty() && (t1 == t2 || range2.empty())) return;
+
+			auto visit = [&](const int3 offset) {
+				const size_t c_n = this->get_neighbor_idx(x, y, z, offset);
+				if (c_n == this->outside_cell_id) return;
+
+				// Cell(T1) -> Neighbor(T2): only Cell(T1) is written
+				auto range_n2 = get_range(c_n, t2);
+				if (!range1.empty() && !range_n2.empty()) {
+					add_asym(range1, range_n2, PairWriteBack::First);
+				}
+
+				// Neighbor(T1) -> Cell(T2): only Cell(T2) is written
+				if (t1 != t2) {
+					auto range_n1 = get_range(c_n, t1);
+					if (!range2.empty() && !range_n1.empty()) {
+						add_asym(range_n1, range2, PairWriteBack::Second);
+					}
+				}
+			};
+
+			for (const auto offset : stencil.offsets) {
+				visit(offset);
+				visit(int3{-offset.x, -offset.y, -offset.z});
+			}
+		}
+
+		// Runs process_block(block) for every block of the phase schedule and process_wrapped(pair) for every
+		// wrapped cell pair. Either phase by phase (one barrier per phase) or through the interaction graph.
+		// If the blocks own the wrapped pairs (full shell, halo) each block also runs the pairs of its cells.
+		template <ParallelPolicy P, typename ProcessBlock, typename ProcessWrapped>
+		APRIL_FORCE_INLINE void for_each_scheduled_task(
 			this const auto& self,
-			Func&& func,
-			GetIndices&& get_indices,
-			ProcessBatch&& process_batch
+			ProcessBlock&& process_block,
+			ProcessWrapped&& process_wrapped
 		) {
-			if (self.wrapped_phase_schedule.empty()) return;
+			const SkinTuner::TraversalTimer traversal_timer(self.skin_tuner ? &*self.skin_tuner : nullptr);
 
-			// Iterate sequentially over the independent phases
-			for (const auto& phase : self.wrapped_phase_schedule) {
+			auto run_block_tasks = [&](const auto& block) {
+				process_block(block);
+				if (!self.owns_wrapped_pairs()) return;
 
-				// Execute the pairs within the phase in parallel
-				self.thread_executor.template execute<P>(phase.size(), [&](size_t phase_idx) {
-					const auto& pair = phase[phase_idx];
-					auto bcp = [&pair](const auto& diff) { return diff + pair.shift; };
+				const auto [bx, by, bz] = block;
+				self.for_each_cell_in_block(bx, by, bz, [&](size_t x, size_t y, size_t z) {
+					for (const auto& pair : self.owned_wrapped_pairs[self.cell_pos_to_idx(x, y, z)]) {
+						process_wrapped(pair);
+					}
+				});
+			};
 
-					for (size_t t1 = 0; t1 < self.n_types; ++t1) {
-						auto range1 = get_indices(pair.c1, t1);
-						if (range1.empty()) continue;
+			// every block runs exactly once per sweep, so the cost slots are written without conflicts
+			const bool timed = P == ParallelPolicy::Threaded && self.balances_blocks() &&
+				self.config.load_balancing == LoadBalancing::Timing;
 
-						for (size_t t2 = 0; t2 < self.n_types; ++t2) {
-							auto range2 = get_indices(pair.c2, t2);
-							if (range2.empty()) continue;
+			auto run_block = [&](const auto& block) {
+				if (!timed) {
+					run_block_tasks(block);
+					return;
+				}
 
-							process_batch(func, range1, range2, t1, t2, bcp);
-						}
+				const auto start = std::chrono::steady_clock::now();
+				run_block_tasks(block);
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+				double& cost = self.block_costs[self.block_index(block)];
+				cost = 0.5 * cost + 0.5 * elapsed.count();
+			};
+
+			// full shell runs a single phase without an interaction graph
+			if (self.config.task_graph && !self.full_shell()) {
+				const size_t n_block_stages = self.phase_schedule.size();
+
+				const utility::StageScope stage(utility::Stage::InteractionGraph);
+				self.interaction_graph.template run<P>(self.thread_executor, [&](const size_t stage, const size_t task) {
+					if (stage < n_block_stages) {
+						run_block(self.phase_schedule[stage][task]);
+					} else {
+						process_wrapped(self.wrapped_phase_schedule[stage - n_block_stages][task]);
 					}
 				});
+				return;
+			}
+
+			for (uint32_t color = 0; color < self.phase_schedule.size(); ++color) {
+				const auto& phase = self.phase_schedule[color];
+				const utility::StageScope stage(utility::Stage::PairPhase, color);
+				self.thread_executor.template execute<P>(phase.size(), [&](size_t block_idx) {
+					run_block(phase[block_idx]);
+				});
+			}
+
+			// Iterate sequentially over the independent phases (empty if the blocks own the wrapped pairs)
+			for (uint32_t wrap_idx = 0; wrap_idx < self.wrapped_phase_schedule.size(); ++wrap_idx) {
+				const auto& phase = self.wrapped_phase_schedule[wrap_idx];
+				const utility::StageScope stage(utility::Stage::WrapPhase, wrap_idx);
+
+				// Execute the pairs within the phase in parallel
+				self.thread_executor.template execute<P>(phase.size(), [&](size_t phase_idx) {
+					process_wrapped(phase[phase_idx]);
+				});
+			}
+		}
+
+		template <typename Func, typename GetIndices, typename ProcessBatch>
+		APRIL_FORCE_INLINE void process_wrapped_interaction(
+			const WrappedCellPair& pair,
+			Func&& func,
+			GetIndices&& get_indices,
+			ProcessBatch&& process_batch
+		) const {
+			auto bcp = [&pair](const auto& diff) { return diff + pair.shift; };
+
+			for (size_t t1 = 0; t1 < this->n_types; ++t1) {
+				auto range1 = get_indices(pair.c1, t1);
+				if (range1.empty()) continue;
+
+				for (size_t t2 = 0; t2 < this->n_types; ++t2) {
+					if (!pair_stencil(t1, t2).active) continue;
+
+					auto range2 = get_indices(pair.c2, t2);
+					if (range2.empty()) continue;
+
+					process_batch(func, range1, range2, t1, t2, bcp, pair.writes);
+				}
 			}
 		}
 
@@ -681,8 +1298,9 @@ namespace april::container::internal {
 			return this->cell_pos_to_idx(nx, ny, nz);
 		}
 
-		// gather all cell ids whose cells have an intersection with the box region
-		[[nodiscard]] std::vector<cell_index_t> get_cells_in_region(this const auto& self, const core::Box & box) {
+		// visit all cell ids whose cells have an intersection with the box region (without allocating)
+		template<typename Func>
+		void for_each_cell_in_region(this const auto& self, const core::Box & box, Func&& func) {
 			//  Convert world coords to cell coords (relative to domain origin)
 			const vec3d min = (box.min - self.domain.min) * self.inv_cell_size;
 			const vec3d max = (box.max - self.domain.min) * self.inv_cell_size;
@@ -714,25 +1332,54 @@ namespace april::container::internal {
 				static_cast<uint3::type>(max_clamped.z)
 			};
 
-			// add all cells in that region
-			const auto cell_counts = max_cell - min_cell;
-			std::vector<cell_index_t> cells;
-			cells.reserve(cell_counts.x * cell_counts.y * cell_counts.z);
+			// visit all cells in that region
 			for (size_t x = min_cell.x; x <= max_cell.x; ++x) {
 				for (size_t y = min_cell.y; y <= max_cell.y; ++y) {
 					for (size_t z = min_cell.z; z <= max_cell.z; ++z) {
-						cells.push_back(self.cell_pos_to_idx(x,y,z));
+						func(static_cast<cell_index_t>(self.cell_pos_to_idx(x,y,z)));
 					}
 				}
 			}
 
 			if (!(box.min>= self.domain.min && box.max <= self.domain.max)) {
-				cells.push_back(self.outside_cell_id);
+				func(static_cast<cell_index_t>(self.outside_cell_id));
 			}
+		}
 
+		// gather all cell ids whose cells have an intersection with the box region
+		[[nodiscard]] std::vector<cell_index_t> get_cells_in_region(this const auto& self, const core::Box & box) {
+			std::vector<cell_index_t> cells;
+			self.for_each_cell_in_region(box, [&](const cell_index_t cid) { cells.push_back(cid); });
 			return cells;
 		}
 
+		// visits every index stored in a cell overlapping the cube of half-width `radius` around the target
+		template<typename Func>
+		void for_each_source_of(this const auto& self, const size_t target, const double radius, Func&& func) {
+			const vec3 x = self.template view<ParticleField::position>(target).position;
+			const core::Box region(x - vec3(radius), x + vec3(radius));
+
+			self.for_each_cell_in_region(region, [&](const cell_index_t cid) {
+				const auto [start, end] = self.cell_index_range(cid);
+				for (size_t i = start; i < end; ++i) {
+					func(i);
+				}
+			});
+		}
+
+		[[nodiscard]] const PairStencil& pair_stencil(const size_t t1, const size_t t2) const noexcept {
+			return pair_stencils[t1 * n_types + t2];
+		}
+
+		// Pruning of the pair batches of a type pair (inactive unless the cells are sorted). Keys and reach stay
+		// valid until the next rebuild: particles move less than skin / 2 along every axis in between. Reaches
+		// beyond the domain (e.g. forces without cutoff) prune nothing and skip the checks
+		[[nodiscard]] batching::SortedSweep sorted_sweep(const size_t t1, const size_t t2) const noexcept {
+			const double reach = pair_stencil(t1, t2).reach;
+			if (this->sort_keys.empty() || reach >= this->domain.extent[sort_axis]) return {};
+			return {this->sort_keys.data(), reach};
+		}
+
 		[[nodiscard]] size_t bin_index(const size_t cell_id, const ParticleType type = 0) const {
 			return cell_id * n_types + static_cast<size_t>(type);
 		}
@@ -769,6 +1416,8 @@ namespace april::container::internal {
 		}
 	private:
 		std::vector<std::vector<batching::TopologyBatch<2, LinkedCellsCore>>> topology_phases;
+		std::vector<std::vector<batching::TopologyBatch<3, LinkedCellsCore>>> angle_phases;
+		std::vector<std::vector<batching::TopologyBatch<4, LinkedCellsCore>>> dihedral_phases;
 	};
 }
 
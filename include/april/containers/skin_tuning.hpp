@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "april/base/types.hpp"
+#include "april/utility/debug.hpp"
+
+/*
+ * Adaptive Verlet skin of cell based containers. A larger skin lets particles travel further before the
+ * storage has to be reordered, but widens the cells and with them the number of candidate pairs of every
+ * force evaluation. The tuner measures both sides (rebuild time, traversal time, particle displacement per
+ * step) and periodically picks the cell grid with the lowest expected cost per step.
+ */
+
+namespace april::container {
+
+	// settings of the adaptive skin, skins are given as factors of the cell width without skin
+	struct AdaptiveSkin {
+		size_t interval = 200;     // structure updates (steps) between two decisions
+		double min_factor = 0.02;  // smallest skin
+		double max_factor = 1.0;   // largest skin
+		double max_change = 2.0;   // largest factor the skin may grow or shrink by in one decision
+		double min_gain = 0.05;    // regrid only if it is predicted to save this share of the cost per step
+	};
+
+	struct SkinDecision {
+		size_t update = 0;            // structure updates since build when the decision was taken
+		double old_skin = 0;
+		double new_skin = 0;          // equals old_skin if the grid was kept
+		uint3 old_cells{};            // cells per axis
+		uint3 new_cells{};
+		double displacement_rate = 0; // largest per-axis displacement per step over the window
+		double rebuild_sec = 0;       // measured cost of one rebuild
+		double traversal_sec = 0;     // measured pair traversal cost per step
+		double rebuilds_per_step = 0; // observed over the window
+		double predicted_gain = 0;    // predicted share of the cost per step saved by the new grid
+		bool regridded = false;
+	};
+
+	// state and decision history of an adaptive skin, see System::skin_tuning()
+	struct SkinTuningLog {
+		double skin = 0;              // current skin
+		double base_cell_width = 0;   // cell width the skin is added to
+		uint3 cells_per_axis{};
+		size_t updates = 0;           // structure updates since build
+		size_t rebuilds = 0;          // of those that reordered the storage (regrids not included)
+		size_t regrids = 0;
+		std::vector<SkinDecision> decisions;
+	};
+}
+
+
+namespace april::container::internal {
+
+	/**
+	 * @brief Cost model and decision logic of the adaptive skin.
+	 *
+	 * The expected cost per step of a grid is T(grid) + C_rebuild * min(1, 2 v / skin): the traversal time scales
+	 * with the candidate volume every cell scans (its stencil extent cubed), and with particles moving at most v
+	 * per step along an axis the skin/2 rebuild threshold is crossed every skin / (2 v) steps. v is the largest
+	 * average speed since the last rebuild, which assumes ballistic motion and errs towards larger skins for
+	 * diffusive systems. Candidate grids use the largest skin their cells allow.
+	 */
+	class SkinTuner {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		SkinTuner(const AdaptiveSkin& settings, const double initial_skin):
+			cfg(settings),
+			target(initial_skin)
+		{
+			APRIL_ASSERT(cfg.interval > 0, "adaptive skin interval must be positive");
+			APRIL_ASSERT(cfg.min_factor > 0 && cfg.min_factor <= cfg.max_factor, "invalid adaptive skin bounds");
+			APRIL_ASSERT(cfg.max_change > 1, "adaptive skin max_change must be larger than 1");
+		}
+
+		// grid geometry the skin applies to; extents of 0 mark unused axes
+		void set_geometry(const vec3d& domain_extent, const double cutoff, const double base_width) {
+			extent = domain_extent;
+			rc = cutoff;
+			w0 = base_width;
+		}
+
+		// skin the next grid should be built for
+		[[nodiscard]] double target_skin() const noexcept { return target; }
+
+		// largest skin the cells of a grid allow (never below the target it was built for)
+		[[nodiscard]] double usable_skin(const vec3d& cell_size, const double built_for) const noexcept {
+			double width = std::numeric_limits<double>::max();
+			for (int a = 0; a < 3; ++a) {
+				if (extent[a] > 0) width = std::min(width, cell_size[a]);
+			}
+			return width == std::numeric_limits<double>::max() ? built_for : std::max(built_for, width - w0);
+		}
+
+		void grid_changed(const double skin, const uint3& cells) {
+			log.skin = skin;
+			log.base_cell_width = w0;
+			log.cells_per_axis = cells;
+		}
+
+		// once per structure update, with the largest per-axis displacement since the last rebuild
+		void record_update(const double max_displacement, const size_t steps_since_rebuild) {
+			log.updates++;
+			window_updates++;
+			if (steps_since_rebuild > 0) {
+				rate = std::max(rate, max_displacement / static_cast<double>(steps_since_rebuild));
+			}
+		}
+
+		void record_rebuild(const double seconds) {
+			log.rebuilds++;
+			window_rebuilds++;
+			rebuild_sec = rebuild_sec > 0 ? 0.5 * rebuild_sec + 0.5 * seconds : seconds;
+		}
+
+		// initial rebuild cost estimate (e.g. the first rebuild at build time), measured rebuilds replace it
+		void seed_rebuild_cost(const double seconds) noexcept {
+			if (rebuild_sec == 0) rebuild_sec = seconds;
+		}
+
+		void record_traversal(const double seconds) noexcept {
+			traversal_sec += seconds;
+		}
+
+		[[nodiscard]] bool decision_due() const noexcept {
+			return window_updates >= cfg.interval;
+		}
+
+		/**
+		 * @brief Decides on the grid for the coming window and starts a new one.
+		 *
+		 * Returns the skin to regrid for, or nothing if the current grid stays. Decisions are logged either way.
+		 */
+		std::optional<double> decide() {
+			const double traversal_per_step = traversal_sec / static_cast<double>(window_updates);
+
+			SkinDecision d;
+			d.update = log.updates;
+			d.old_skin = log.skin;
+			d.new_skin = log.skin;
+			d.old_cells = log.cells_per_axis;
+			d.new_cells = log.cells_per_axis;
+			d.displacement_rate = rate;
+			d.rebuild_sec = rebuild_sec;
+			d.traversal_sec = traversal_per_step;
+			d.rebuilds_per_step = static_cast<double>(window_rebuilds) / static_cast<double>(window_updates);
+
+			std::optional<double> result;
+			if (traversal_per_step > 0 && rebuild_sec > 0) {
+				const Candidate current = evaluate_grid(log.cells_per_axis);
+				const double current_cost = cost(current, traversal_per_step, current);
+
+				// sample target skins within the allowed change, log spaced
+				const double lo = std::max(cfg.min_factor * w0, log.skin / cfg.max_change);
+				const double hi = std::max(lo, std::min(cfg.max_factor * w0, log.skin * cfg.max_change));
+				constexpr int samples = 32;
+
+				Candidate best = current;
+				double best_cost = current_cost;
+				for (int i = 0; i < samples; ++i) {
+					const double skin = lo * std::pow(hi / lo, static_cast<double>(i) / (samples - 1));
+					const Candidate c = evaluate_grid(cells_for(skin));
+					const double c_cost = cost(c, traversal_per_step, current);
+					if (c_cost < best_cost) {
+						best = c;
+						best_cost = c_cost;
+					}
+				}
+
+				d.predicted_gain = current_cost > 0 ? 1.0 - best_cost / current_cost : 0.0;
+				if (!(best.cells == current.cells) && d.predicted_gain > cfg.min_gain) {
+					target = best.skin;
+					d.new_skin = best.skin;
+					d.new_cells = best.cells;
+					d.regridded = true;
+					log.regrids++;
+					result = target;
+				}
+			}
+
+			log.decisions.push_back(d);
+			window_updates = 0;
+			window_rebuilds = 0;
+			traversal_sec = 0;
+			rate = 0;
+			return result;
+		}
+
+		[[nodiscard]] const SkinTuningLog& history() const noexcept { return log; }
+
+		// times the enclosing pair traversal
+		class TraversalTimer {
+		public:
+			explicit TraversalTimer(SkinTuner* t) : tuner(t) {
+				if (tuner) start = Clock::now();
+			}
+
+			~TraversalTimer() {
+				if (tuner) tuner->record_traversal(std::chrono::duration<double>(Clock::now() - start).count());
+			}
+
+			TraversalTimer(const TraversalTimer&) = delete;
+			TraversalTimer& operator=(const TraversalTimer&) = delete;
+
+		private:
+			SkinTuner* tuner;
+			Clock::time_point start;
+		};
+
+	private:
+		struct Candidate {
+			uint3 cells{};
+			double skin = 0;   // largest skin the cells allow
+			double volume = 0; // candidate volume scanned per cell
+		};
+
+		AdaptiveSkin cfg;
+		double target;
+		vec3d extent{};
+		double rc = 0;
+		double w0 = 0;
+
+		double rate = 0;
+		double rebuild_sec = 0;
+		double traversal_sec = 0;
+		size_t window_updates = 0;
+		size_t window_rebuilds = 0;
+		SkinTuningLog log;
+
+		// mirrors the grid setup of LinkedCellsCore::setup_cell_grid. The skin does not change the cells of
+		// unused axes, they keep the count of the current grid so that candidates compare equal to it
+		[[nodiscard]] uint3 cells_for(const double skin) const {
+			const double width = w0 + skin;
+			uint3 cells;
+			for (int a = 0; a < 3; ++a) {
+				cells[a] = extent[a] > 0
+					? static_cast<uint32_t>(std::max(2.0, std::floor(extent[a] / width)))
+					: log.cells_per_axis[a];
+			}
+			return cells;
+		}
+
+		[[nodiscard]] Candidate evaluate_grid(const uint3& cells) const {
+			Candidate c{cells, std::numeric_limits<double>::max(), 1.0};
+			for (int a = 0; a < 3; ++a) {
+				if (extent[a] <= 0) continue;
+				const double width = extent[a] / cells[a];
+				const double reach = std::min<double>(2 * std::ceil(rc / width) + 1, cells[a]);
+				c.volume *= reach * width;
+				c.skin = std::min(c.skin, width - w0);
+			}
+			if (c.skin == std::numeric_limits<double>::max()) c.skin = target;
+			return c;
+		}
+
+		// expected cost per step of grid c, traversal scaled from the measurement on the current grid
+		[[nodiscard]] double cost(const Candidate& c, const double traversal_per_step, const Candidate& current) const {
+			const double traversal = traversal_per_step * c.volume / current.volume;
+			const double rebuilds = c.skin > 0 ? std::min(1.0, 2 * rate / c.skin) : 1.0;
+			return traversal + rebuild_sec * rebuilds;
+		}
+	};
+}
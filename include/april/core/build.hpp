@@ -39,6 +39,7 @@ namespace april {
         // explicit type for IDE code completion
         using EnvData = EnvironmentData<
             typename Env::traits::force_variant_t,
+            typename Env::traits::bonded_variant_t,
             typename Env::traits::boundary_variant_t,
             typename Env::traits::controller_storage_t,
             typename Env::traits::field_storage_t>;
@@ -64,12 +65,13 @@ namespace april {
             type_pairs,
             id_pairs
         );
+        validate_bonded_ids(env.user_particle_ids, env.bonded_interactions);
 
         // create particles
         auto particles = build_particles<ParticleAttributes>(env.particles, type_map, id_map);
 
         // create force table
-        ForceTable forces(env.type_interactions, env.id_interactions, type_map, id_map);
+        ForceTable forces(env.type_interactions, env.id_interactions, type_map, id_map, env.bonded_interactions);
 
         // if no boundary specified use a default (OpenBoundary)
         set_default_boundaries(env.boundaries);
@@ -91,7 +93,7 @@ namespace april {
             .exec = execution_config,
             .config = container_config,
             .flags = set_container_flags(topologies),
-            .hints = container::ContainerHints(),
+            .hints = make_container_hints(boundaries, env.query_regions),
             .interaction_map = forces.generate_interaction_map(),
             .domain = simulation_box
         };
@@ -5,6 +5,7 @@
 #include "april/exec/policy.hpp"
 #include "april/exec/kernel.hpp"
 #include "april/particle/properties.hpp"
+#include "april/utility/interaction_counters.hpp"
 
 namespace april::core {
 
@@ -80,6 +81,15 @@ namespace april::core {
 			return query_region(core::Box(region.min_corner().value(), region.max_corner().value()));
 		}
 
+		// allocation free variants, see System::query_region
+		void query_region(const core::Box & region, std::vector<size_t> & indices) const {
+			system.query_region(region, indices);
+		}
+
+		void query_region(const Domain & region, std::vector<size_t> & indices) const {
+			query_region(core::Box(region.min_corner().value(), region.max_corner().value()), indices);
+		}
+
 
 		// --------------
 		// FUNCTIONAL OPS
@@ -126,6 +136,19 @@ namespace april::core {
 			system.notify_moved_id(ids);
 		}
 
+
+		// -----------
+		// DIAGNOSTICS
+		// -----------
+		// diagnostic counters are switched on and off by monitors, which only see a const context
+		[[nodiscard]] utility::InteractionCounters & interaction_counters() const noexcept {
+			return system.interaction_counters();
+		}
+
+		[[nodiscard]] const container::SkinTuningLog * skin_tuning() const noexcept {
+			return system.skin_tuning();
+		}
+
 	private:
 		System& system;
 	};
@@ -114,6 +114,10 @@ namespace april {
 				return extent.x * extent.y * extent.z;
 			}
 
+			[[nodiscard]] bool operator==(const Box& other) const noexcept {
+				return min == other.min && max == other.max;
+			}
+
 			const vec3d min;
 			const vec3d max;
 			const vec3d extent;
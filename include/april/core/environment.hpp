@@ -14,6 +14,8 @@
 
 #include <any>
 #include <array>
+#include <concepts>
+#include <cstddef>
 #include <optional>
 #include <stdexcept>
 #include <type_traits>
@@ -25,6 +27,7 @@
 #include "april/core/internal/environment_traits.hpp"
 
 #include "april/interactions/force.hpp"
+#include "april/interactions/many_body.hpp"
 #include "april/boundaries/boundary.hpp"
 #include "april/controllers/controller.hpp"
 #include "april/fields/field.hpp"
@@ -80,6 +83,25 @@ namespace april {
         {}
     };
 
+    /**
+     * @brief Selects a bonded interaction between an ordered tuple of persistent particle identifiers.
+     *
+     * Used with bonded forces such as angles (i-j-k) or dihedrals (i-j-k-l). The ordering
+     * is significant: consecutive identifiers are treated as bonded neighbours.
+     */
+    template<std::size_t N>
+    struct among_ids {
+        std::array<ParticleID, N> ids;
+
+        template<std::convertible_to<ParticleID>... IDs> requires (sizeof...(IDs) == N)
+        constexpr explicit among_ids(const IDs... tuple_ids) noexcept
+            : ids{static_cast<ParticleID>(tuple_ids)...}
+        {}
+    };
+
+    template<std::convertible_to<ParticleID>... IDs>
+    among_ids(IDs...) -> among_ids<sizeof...(IDs)>;
+
 
     /**
       * @brief Collects a declarative APRIL simulation definition.
@@ -275,11 +297,12 @@ namespace april {
          * @tparam F Force type declared in this environment's force pack.
          * @param force Force instance to store.
          * @param scope Particle type to which the self-interaction applies.
+         * @param group Rate group of the force for multiple-time-step integrators.
          */
         template<interactions::IsForce F>
         requires traits::template is_valid_force_v<F>
-        void add_interaction(F && force, to_type scope) {
-            data.type_interactions.emplace_back(scope.type, scope.type, typename traits::force_variant_t{std::move(force)});
+        void add_interaction(F && force, to_type scope, const ForceGroup group = ForceGroup::slow) {
+            data.type_interactions.emplace_back(scope.type, scope.type, typename traits::force_variant_t{std::move(force)}, group);
         }
 
         /**
@@ -288,10 +311,11 @@ namespace april {
          * @tparam F Force type declared in this environment's force pack.
          * @param force Force instance to store.
          * @param scope Pair of particle types to which the force applies.
+         * @param group Rate group of the force for multiple-time-step integrators.
          */
         template<interactions::IsForce F> requires traits::template is_valid_force_v<F>
-        void add_interaction(F force, between_types scope) {
-            data.type_interactions.emplace_back(scope.t1, scope.t2, typename traits::force_variant_t{std::move(force)});
+        void add_interaction(F force, between_types scope, const ForceGroup group = ForceGroup::slow) {
+            data.type_interactions.emplace_back(scope.t1, scope.t2, typename traits::force_variant_t{std::move(force)}, group);
         }
 
         /**
@@ -303,10 +327,29 @@ namespace april {
          * @tparam F Force type declared in this environment's force pack.
          * @param force Force instance to store.
          * @param scope Persistent particle identifiers defining the interaction.
+         * @param group Rate group of the force for multiple-time-step integrators.
          */
         template<interactions::IsForce F> requires traits::template is_valid_force_v<F>
-        void add_interaction(F force, between_ids scope) {
-            data.id_interactions.emplace_back(scope.id1, scope.id2, typename traits::force_variant_t{std::move(force)});
+        void add_interaction(F force, between_ids scope, const ForceGroup group = ForceGroup::fast) {
+            static_assert(!interactions::IsManyBodyForce<F>,
+                "[APRIL] Environment: many-body forces can only act between particle types");
+            data.id_interactions.emplace_back(scope.id1, scope.id2, typename traits::force_variant_t{std::move(force)}, group);
+        }
+
+        /**
+         * @brief Registers a bonded force acting on an ordered tuple of particles.
+         *
+         * @tparam F Bonded force type declared in this environment's force pack.
+         * @param force Force instance to store.
+         * @param scope Ordered persistent particle identifiers, one per body of the force.
+         * @param group Rate group of the force for multiple-time-step integrators.
+         */
+        template<interactions::IsBondedForce F> requires traits::template is_valid_force_v<F>
+        void add_interaction(F force, among_ids<F::arity> scope, const ForceGroup group = ForceGroup::fast) {
+            data.bonded_interactions.emplace_back(
+                std::vector<ParticleID>(scope.ids.begin(), scope.ids.end()),
+                typename traits::bonded_variant_t{std::move(force)},
+                group);
         }
 
 
@@ -497,6 +540,23 @@ namespace april {
         }
 
 
+        //--------------
+        // QUERY REGIONS
+        //--------------
+        /**
+         * @brief Registers a region that will be queried repeatedly via query_region().
+         *
+         * Registered regions are passed to the container as hints. Containers may precompute lookup
+         * structures for them, which makes queries of exactly this region cheaper. Other regions can
+         * still be queried.
+         *
+         * @param region Fully specified region (origin and extent).
+         */
+        void add_query_region(const Domain& region) {
+            data.query_regions.push_back(region);
+        }
+
+
         // ------------------
         // CHAINING INTERFACE
         // ------------------
@@ -547,22 +607,30 @@ namespace april {
 
         template<interactions::IsForce F>
             requires traits::template is_valid_force_v<std::remove_cvref_t<F>>
-        auto&& with_interaction(this auto&& self, F&& force, to_type scope) {
-            self.add_interaction(std::forward<F>(force), scope);
+        auto&& with_interaction(this auto&& self, F&& force, to_type scope, const ForceGroup group = ForceGroup::slow) {
+            self.add_interaction(std::forward<F>(force), scope, group);
             return std::forward<decltype(self)>(self);
         }
 
         template<interactions::IsForce F>
             requires traits::template is_valid_force_v<std::remove_cvref_t<F>>
-        auto&& with_interaction(this auto&& self, F&& force, between_types scope) {
-            self.add_interaction(std::forward<F>(force), scope);
+        auto&& with_interaction(this auto&& self, F&& force, between_types scope, const ForceGroup group = ForceGroup::slow) {
+            self.add_interaction(std::forward<F>(force), scope, group);
             return std::forward<decltype(self)>(self);
         }
 
         template<interactions::IsForce F>
             requires traits::template is_valid_force_v<std::remove_cvref_t<F>>
-        auto&& with_interaction(this auto&& self, F&& force, between_ids scope) {
-            self.add_interaction(std::forward<F>(force), scope);
+        auto&& with_interaction(this auto&& self, F&& force, between_ids scope, const ForceGroup group = ForceGroup::fast) {
+            self.add_interaction(std::forward<F>(force), scope, group);
+            return std::forward<decltype(self)>(self);
+        }
+
+        template<class F, std::size_t N>
+            requires interactions::IsBondedForce<std::remove_cvref_t<F>> &&
+                traits::template is_valid_force_v<std::remove_cvref_t<F>>
+        auto&& with_interaction(this auto&& self, F&& force, among_ids<N> scope, const ForceGroup group = ForceGroup::fast) {
+            self.add_interaction(std::forward<F>(force), scope, group);
             return std::forward<decltype(self)>(self);
         }
 
@@ -660,6 +728,11 @@ namespace april {
             return std::forward<decltype(self)>(self);
         }
 
+        auto&& with_query_region(this auto&& self, const Domain& region) {
+            self.add_query_region(region);
+            return std::forward<decltype(self)>(self);
+        }
+
         /** @} */
     };
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
 
 #include "april/boundaries/boundary.hpp"
 #include "april/containers/container.hpp"
@@ -64,6 +66,27 @@ namespace april::core::internal {
 		}
 		return container_flags;
 	}
+
+
+	// Collects the regions queried every step (boundary regions of all faces and user registered regions)
+	// so the container can precompute its lookup structures for them
+	template<class BoundaryTable>
+	container::ContainerHints make_container_hints(const BoundaryTable & boundaries, const std::vector<Domain> & user_regions) {
+		container::ContainerHints hints;
+		auto add_region = [&](const core::Box & region) {
+			if (std::ranges::find(hints.query_regions, region) == hints.query_regions.end()) {
+				hints.query_regions.push_back(region);
+			}
+		};
+
+		for (const DomainFace face : all_faces) {
+			add_region(boundaries[face].boundary_region);
+		}
+		for (const Domain & region : user_regions) {
+			add_region(core::Box::from_domain(region));
+		}
+		return hints;
+	}
 }
 
 
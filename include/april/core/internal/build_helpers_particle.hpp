@@ -117,6 +117,30 @@ namespace april::core::internal {
 		}
 	}
 
+	// Ensures bonded interaction tuples reference existing and pairwise distinct IDs
+	template<interactions::internal::IsBondedVariant BV>
+	void validate_bonded_ids(
+		const std::unordered_set<ParticleID>& user_ids,
+		const std::vector<interactions::internal::BondedInteraction<BV>>& bonded_interactions
+	) {
+		for (const auto & interaction : bonded_interactions) {
+			const auto & ids = interaction.ids;
+
+			for (size_t i = 0; i < ids.size(); ++i) {
+				if (!user_ids.contains(ids[i])) {
+					throw std::invalid_argument(
+						"Specified bonded particle ID does not exist: " + std::to_string(ids[i]));
+				}
+				for (size_t j = i + 1; j < ids.size(); ++j) {
+					if (ids[i] == ids[j]) {
+						throw std::invalid_argument(
+							"Bonded interaction references particle ID more than once: " + std::to_string(ids[i]));
+					}
+				}
+			}
+		}
+	}
+
 	// Ensures all particles have physically valid (positive) mass and valid state
 	inline void validate_particles(const std::vector<Particle>& particles) {
 		for (auto & p : particles) {
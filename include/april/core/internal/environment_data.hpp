@@ -44,13 +44,16 @@ namespace april::core::internal {
         std::unordered_set<ParticleType> user_particle_types;
 
         std::vector<Particle> particles;
+
+        std::vector<Domain> query_regions; // regions the user intends to query repeatedly
     };
 
     // templated extension
-    template<class ForceVariant, class BoundaryVariant, class ControllerStorage, class FieldStorage>
+    template<class ForceVariant, class BondedVariant, class BoundaryVariant, class ControllerStorage, class FieldStorage>
     struct EnvironmentData final : EnvironmentCommonData{
         std::vector<interactions::internal::TypeInteraction<ForceVariant>> type_interactions {};
         std::vector<interactions::internal::IdInteraction<ForceVariant>> id_interactions {};
+        std::vector<interactions::internal::BondedInteraction<BondedVariant>> bonded_interactions {};
         std::array<BoundaryVariant, 6>  boundaries;
 
         ControllerStorage controllers;
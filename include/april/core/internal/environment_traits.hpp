@@ -23,7 +23,7 @@ namespace april::core::internal {
 	// this class holds relevant types derived from template parameter packs
 	// this significantly cleans up dependent type declarations in other classes
 	template<
-		interactions::IsForce... Fs,
+		interactions::internal::IsPackableForce... Fs,
 		boundary::IsBoundary... BCs,
 		controller::IsController... Cs,
 		field::IsField... FFs,
@@ -42,7 +42,8 @@ namespace april::core::internal {
 		using FFPack_t = field::internal::FieldPack<FFs...>;
 
 		// Derived Variants
-		using force_variant_t    = interactions::internal::VariantType_t<Fs...>;
+		using force_variant_t    = interactions::internal::PairVariantType_t<Fs...>;
+		using bonded_variant_t   = interactions::internal::BondedPackVariantType_t<Fs...>;
 		using boundary_variant_t = boundary::internal::VariantType_t<BCs...>;
 
 		// Derived Storage Types
@@ -51,7 +52,7 @@ namespace april::core::internal {
 
 		// Table Types
 		using boundary_table_t = boundary::internal::BoundaryTable<boundary_variant_t>;
-		using force_table_t    = interactions::internal::InteractionTable<force_variant_t>;
+		using force_table_t    = interactions::internal::InteractionTable<force_variant_t, bonded_variant_t>;
 
 		// particles
 		using particle_attributes_t = Attributes;
@@ -63,6 +64,7 @@ namespace april::core::internal {
 		// Environment Data type
 		using environment_data_t = EnvironmentData<
 			force_variant_t,
+			bonded_variant_t,
 			boundary_variant_t,
 			controller_storage_t,
 			field_storage_t>;
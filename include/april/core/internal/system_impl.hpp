@@ -1,9 +1,14 @@
 #pragma once
 
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include "april/boundaries/boundary.hpp"
 #include "april/exec/policy.hpp"
 #include "april/interactions/force.hpp"
+#include "april/interactions/bonded.hpp"
+#include "april/interactions/many_body.hpp"
 #include "april/exec/threading/scheduling.hpp"
 
 namespace april {
@@ -13,7 +18,8 @@ namespace april {
 	//--------------
 	// ToDO extract this method to a free convenience function that maps a kernel & policies to a batch for_each_pair call
 	template<class SystemConfig>
-	template<VectorPolicy V,container::batching::IsBatch Batch,exec::IsKernel Kernel>
+	template<VectorPolicy V, typename Batch, exec::IsKernel Kernel>
+		requires container::batching::IsBatch<Batch> || container::batching::IsTopologyBatch<Batch>
 	void System<SystemConfig>::execute_batch_kernel(const Batch& batch,Kernel&& kernel) {
 		using B = std::remove_cvref_t<Batch>;
 		using K = std::remove_cvref_t<Kernel>;
@@ -33,7 +39,8 @@ namespace april {
 	// UPDATE FORCES
 	//--------------
 	template <class SystemConfig>
-	void System<SystemConfig>::update_forces() {
+	void System<SystemConfig>::update_forces(const ForceGroup groups) {
+		const utility::StageScope stage(utility::Stage::UpdateForces);
 
 		// handle pair wise (type-type) interactions
 		auto update_forces_batch = [&]<container::batching::IsBatch Batch, container::batching::IsBCP BCP>(
@@ -41,6 +48,15 @@ namespace april {
 		) {
 			static_assert(Batch::arity == 2, "Pair-wise force interactions require a batch with arity 2.");
 
+			const auto [t1, t2] = batch.types;
+			if (!has_any_of(groups, force_table.type_group(t1, t2))) return;
+
+			// batches run on a single thread, so the counter slot is fixed for the whole batch
+			[[maybe_unused]] utility::InteractionCounts* counts = nullptr;
+			if constexpr (utility::interaction_counters_compiled_in) {
+				if (pair_counters.enabled()) counts = &pair_counters.local(exec::thread_index(), t1, t2);
+			}
+
 			auto apply_batch_update = [&]<interactions::IsForce ForceT>(const ForceT& force) APRIL_FORCE_INLINE {
 				constexpr ParticleField M = ForceT::fields | ParticleField::position;
 
@@ -57,6 +73,9 @@ namespace april {
 
 					if constexpr (is_packed) {
 						auto outside = r.norm_squared() > force.cutoff2();
+						if constexpr (utility::interaction_counters_compiled_in) {
+							if (counts) counts->add_packed(outside.to_bitmask(), std::decay_t<decltype(r.norm_squared())>::size());
+						}
 						if (all(outside)) return;
 
 						if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Nonsymmetric) {
@@ -91,7 +110,11 @@ namespace april {
 							}
 						}
 					} else {
-						if (r.norm_squared() > force.cutoff2()) {
+						const bool outside = r.norm_squared() > force.cutoff2();
+						if constexpr (utility::interaction_counters_compiled_in) {
+							if (counts) counts->add_scalar(!outside);
+						}
+						if (outside) {
 							return;
 						}
 
@@ -121,46 +144,154 @@ namespace april {
 				);
 			};
 
-			const auto [t1, t2] = batch.types;
 			force_table.dispatch(t1, t2, apply_batch_update);
 		};
 
+		// handle bonded (id tuple) interactions e.g. angles and dihedrals
+		auto update_forces_bonded_batch = [&]<container::batching::IsTopologyBatch B>(const B& batch) {
+			using Batch = std::remove_cvref_t<B>;
+			constexpr size_t arity = Batch::arity;
+
+			auto apply_batch_update = [&]<interactions::IsBondedForce ForceT>(const ForceT& force) {
+				constexpr auto Read = ParticleField::position;
+				constexpr auto Write = ParticleField::force;
+
+				auto kernel = [&]<bool is_packed>(auto&&... p) APRIL_FORCE_INLINE {
+					auto particles = std::forward_as_tuple(p...);
+
+					// consecutive bond vectors b_n = x_{n+1} - x_n along the tuple
+					const auto forces = [&]<size_t... I>(std::index_sequence<I...>) APRIL_FORCE_INLINE {
+						return force((std::get<I + 1>(particles).position - std::get<I>(particles).position)...);
+					}(std::make_index_sequence<arity - 1>{});
+
+					[&]<size_t... I>(std::index_sequence<I...>) APRIL_FORCE_INLINE {
+						((std::get<I>(particles).force += forces[I]), ...);
+					}(std::make_index_sequence<arity>{});
+				};
+
+				constexpr bool force_scalar =
+					ForceT::vector_mode == exec::ExecutionMode::Scalar ||
+					vector_policy == VectorPolicy::Scalar;
+				constexpr VectorPolicy vp = force_scalar ? VectorPolicy::Scalar : VectorPolicy::Auto;
+
+				execute_batch_kernel<vp>(
+					batch,
+					april::universal_kernel<Read, Write>(kernel)
+				);
+			};
+
+			if (!has_any_of(groups, force_table.bonded_group(batch.descriptor))) return;
+			force_table.template dispatch_bonded<arity>(batch.descriptor, apply_batch_update);
+		};
+
 		// handle id-id interactions
 		auto update_forces_topology_batch = [&]<container::batching::IsTopologyBatch B>(const B& batch) {
 			using Batch = std::remove_cvref_t<B>;
-			static_assert(Batch::arity == 2, "Pair-wise topology interactions require a batch with arity 2.");
 
-			auto apply_batch_update = [&]<interactions::IsForce ForceT>(const ForceT& force) {
-				constexpr auto Read = ForceT::fields | ParticleField::position;
-				constexpr auto Write = ParticleField::force;
+			if constexpr (Batch::arity > 2) {
+				update_forces_bonded_batch(batch);
+			} else {
+				auto apply_batch_update = [&]<interactions::IsForce ForceT>(const ForceT& force) {
+					constexpr auto Read = ForceT::fields | ParticleField::position;
+					constexpr auto Write = ParticleField::force;
+
+					auto kernel = [&]<bool is_packed>(auto&& p1, auto&& p2) APRIL_FORCE_INLINE {
+						const auto r = p2.position - p1.position;
+
+						// packed kernels receive read-only buffer views, scalar kernels receive mutable references
+						auto eval = [&](auto&& a, auto&& b, const auto& d) APRIL_FORCE_INLINE {
+							if constexpr (is_packed) {
+								return force(a, b, d);
+							} else {
+								return force(a.to_view(), b.to_view(), d);
+							}
+						};
 
-				auto kernel = [&](auto&& p1, auto&& p2) APRIL_FORCE_INLINE {
-					vec3 r = p2.position - p1.position;
-
-					if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Antisymmetric) {
-						vec3 f = force(p1.to_view(), p2.to_view(), r);
-						p1.force += f;
-						p2.force -= f;
-					} else if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Symmetric) {
-						vec3 f = force(p1.to_view(), p2.to_view(), r);
-						p1.force += f;
-						p2.force += f;
-					} else if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Nonsymmetric) {
-						p1.force += force(p1.to_view(), p2.to_view(), r);
-						p2.force += force(p2.to_view(), p1.to_view(), -r);
-					}
+						if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Antisymmetric) {
+							const auto f = eval(p1, p2, r);
+							p1.force += f;
+							p2.force -= f;
+						} else if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Symmetric) {
+							const auto f = eval(p1, p2, r);
+							p1.force += f;
+							p2.force += f;
+						} else if constexpr (ForceT::symmetry == interactions::ForceSymmetry::Nonsymmetric) {
+							p1.force += eval(p1, p2, r);
+							p2.force += eval(p2, p1, -r);
+						}
+					};
+
+					constexpr bool force_scalar =
+						ForceT::vector_mode == exec::ExecutionMode::Scalar ||
+						vector_policy == VectorPolicy::Scalar;
+					constexpr VectorPolicy vp = force_scalar ? VectorPolicy::Scalar : VectorPolicy::Auto;
+
+					execute_batch_kernel<vp>(
+						batch,
+						april::universal_kernel<Read, Write>(kernel)
+					);
 				};
 
-				batch.template for_each<exec::ExecutionMode::Scalar>(
-					april::scalar_kernel<Read, Write>(kernel)
+				if (!has_any_of(groups, force_table.id_group(batch.ids[0], batch.ids[1]))) return;
+				force_table.dispatch_id(
+					batch.ids[0],
+					batch.ids[1],
+					apply_batch_update
 				);
+			}
+		};
+
+		// accumulate the embedding density rho_i of many-body forces into the scratch field
+		auto update_density_batch = [&]<container::batching::IsBatch Batch, container::batching::IsBCP BCP>(
+			const Batch& batch, BCP&& apply_bcp
+		) {
+			auto apply_batch_update = [&]<interactions::IsForce ForceT>(const ForceT& force) APRIL_FORCE_INLINE {
+				if constexpr (interactions::IsManyBodyForce<ForceT>) {
+					auto kernel = [&]<bool is_packed>(auto&& p1, auto&& p2) APRIL_FORCE_INLINE {
+						auto diff = p2.position - p1.position;
+
+						const auto r = [&] {
+							if constexpr (std::is_same_v<std::decay_t<BCP>, container::batching::NoBatchBCP>) {
+								return diff;
+							} else {
+								return apply_bcp(diff);
+							}
+						}();
+
+						const auto dist2 = r.norm_squared();
+						if constexpr (is_packed) {
+							auto outside = dist2 > force.cutoff2();
+							if (all(outside)) return;
+
+							const auto rho = select(outside, packed(0), force.density(april::sqrt(dist2)));
+							p1.scratch += rho;
+							p2.scratch += rho;
+						} else {
+							if (dist2 > force.cutoff2()) {
+								return;
+							}
+
+							const double rho = force.density(std::sqrt(dist2));
+							p1.scratch += rho;
+							p2.scratch += rho;
+						}
+					};
+
+					constexpr bool force_scalar =
+						ForceT::vector_mode == exec::ExecutionMode::Scalar ||
+						vector_policy == VectorPolicy::Scalar;
+					constexpr VectorPolicy vp = force_scalar ? VectorPolicy::Scalar : VectorPolicy::Auto;
+
+					execute_batch_kernel<vp>(
+						batch,
+						april::universal_kernel<ParticleField::position, ParticleField::scratch>(kernel)
+					);
+				}
 			};
 
-			force_table.dispatch_id(
-				batch.representatives[0],
-				batch.representatives[1],
-				apply_batch_update
-			);
+			const auto [t1, t2] = batch.types;
+			if (!has_any_of(groups, force_table.type_group(t1, t2))) return;
+			force_table.dispatch(t1, t2, apply_batch_update);
 		};
 
 		for_each_particle<parallel_policy>(
@@ -169,8 +300,90 @@ namespace april {
 			)
 		);
 
-		particle_container.template invoke_for_each_interaction_batch<parallel_policy>(update_forces_batch);
-		particle_container.template invoke_for_each_topology_batch<parallel_policy>(update_forces_topology_batch);
+		// skip whole traversals if none of their interactions is selected
+		if (has_any_of(groups, force_table.used_type_groups())) {
+			if constexpr (InteractionTable::has_many_body_forces) {
+				// two-pass evaluation: rho_i first, then replace it by F'(rho_i) which the pair pass reads
+				for_each_particle<parallel_policy>(
+					april::universal_kernel<ParticleField::scratch, ParticleField::scratch>(
+						[](auto&& p) { p.scratch = 0; }
+					)
+				);
+
+				particle_container.template invoke_for_each_interaction_batch<parallel_policy>(update_density_batch);
+
+				for_each_particle<parallel_policy>(
+					april::scalar_kernel<ParticleField::type | ParticleField::scratch, ParticleField::scratch>(
+						[&](auto&& p) {
+							const double rho = p.scratch;
+							p.scratch = 0.0;
+							force_table.dispatch(p.type, p.type, [&]<interactions::IsForce ForceT>(const ForceT& force) {
+								if constexpr (interactions::IsManyBodyForce<ForceT>) {
+									p.scratch = force.embedding_derivative(rho);
+								}
+							});
+						}
+					)
+				);
+			}
+
+			particle_container.template invoke_for_each_interaction_batch<parallel_policy>(update_forces_batch);
+		}
+
+		if (has_any_of(groups, force_table.used_topology_groups())) {
+			particle_container.template invoke_for_each_topology_batch<parallel_policy>(update_forces_topology_batch);
+		}
+	}
+
+
+
+	template <class SystemConfig>
+	void System<SystemConfig>::update_forces_on(const std::vector<size_t>& targets, std::vector<math::Range>& schedule) {
+		static_assert(!InteractionTable::has_many_body_forces,
+			"[APRIL] System: targeted force updates do not support many-body forces");
+
+		const utility::StageScope stage(utility::Stage::UpdateForces);
+		if (force_table.has_topology_forces()) {
+			throw std::logic_error("[APRIL] System: targeted force updates only support type-pair interactions");
+		}
+		if (wraps_forces()) {
+			throw std::logic_error("[APRIL] System: targeted force updates do not support periodic boundaries");
+		}
+
+		const double radius = force_table.max_type_cutoff();
+
+		const exec::BlockConfig config(thread_executor.num_threads());
+		exec::make_linear_schedule(math::Range{0, targets.size()}, config, schedule);
+
+		thread_executor.execute(schedule.size(), [&](const size_t b_idx) {
+			const auto& block = schedule[b_idx];
+
+			for (size_t t = block.start; t < block.stop; ++t) {
+				const size_t i = targets[t];
+				auto p = at<ParticleField::all, ParticleField::force>(i);
+				const auto p_view = p.to_view();
+
+				vec3 f{};
+				particle_container.invoke_for_each_source_of(i, radius, [&](const size_t j) {
+					if (j == i) return;
+
+					const auto q = view<ParticleField::all>(j);
+					if (!has_any_of(q.state, ParticleState::EXERTING)) return;
+
+					const vec3 r = q.position - p.position;
+					force_table.dispatch(p.type, q.type, [&]<interactions::IsForce ForceT>(const ForceT& force) {
+						if (r.norm_squared() > force.cutoff2()) return;
+						f += force(p_view, q, r); // force acting on the target for every symmetry
+					});
+				});
+
+				p.force = f;
+
+				fields.for_each_item([&](auto& field) {
+					field.dispatch_apply(p);
+				});
+			}
+		});
 	}
 
 
@@ -180,6 +393,7 @@ namespace april {
 	//-----------------
 	template <class SystemConfig>
 	void System<SystemConfig>::apply_boundary_conditions() {
+		const utility::StageScope stage(utility::Stage::BoundaryConditions);
 	    particles_to_update_buffer.clear();
 	    const core::Box domain_box = this->box();
 
@@ -188,12 +402,14 @@ namespace april {
 	        const auto& compiled_boundary = boundary_table[face];
 
 	    	// fetch work
-	        std::vector<size_t> particle_ids = query_region(compiled_boundary.boundary_region);
+	        auto& particle_ids = boundary_particles_buffer;
+	        query_region(compiled_boundary.boundary_region, particle_ids);
 	        if (particle_ids.empty()) continue;
 
 	    	// partition it for parallelization
-	        exec::BlockConfig config(thread_executor.num_threads());
-	        auto blocks = exec::make_linear_schedule(math::Range{0, particle_ids.size()}, config);
+	        const exec::BlockConfig config(thread_executor.num_threads());
+	        auto& blocks = boundary_blocks_buffer;
+	        exec::make_linear_schedule(math::Range{0, particle_ids.size()}, config, blocks);
 
 	        // clear local buffers for this face pass
 	        for (size_t i = 0; i < thread_update_buffers.size(); ++i) {
@@ -294,6 +510,7 @@ namespace april {
 	//------------------
 	template <class SystemConfig>
 	void System<SystemConfig>::apply_controllers() {
+		const utility::StageScope stage(utility::Stage::Controllers);
 		controllers.for_each_item([this](auto & controller) {
 			if (controller.should_trigger(trig_context)) {
 				controller.dispatch_apply(system_context);
@@ -307,6 +524,7 @@ namespace april {
 	//-------------
 	template <class SystemConfig>
 	void System<SystemConfig>::apply_force_fields() {
+		const utility::StageScope stage(utility::Stage::ForceFields);
 		fields.for_each_item([&]<typename F>(F & field) {
 			for_each_particle<parallel_policy>(scalar_kernel<F::fields, ParticleField::force>(
 				[&](auto && p) {
@@ -322,6 +540,7 @@ namespace april {
 	//-------
 	template <class SystemConfig>
 	void System<SystemConfig>::update_all_components() {
+		const utility::StageScope stage(utility::Stage::UpdateComponents);
 		fields.for_each_item([this](auto & field) {
 			field.template dispatch_update<System>(system_context);
 		});
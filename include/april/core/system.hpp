@@ -18,11 +18,14 @@
 
 #include "april/core/environment.hpp"
 #include "april/core/domain.hpp"
+#include "april/interactions/force_group.hpp"
 #include "april/containers/container.hpp"
 #include "april/containers/batching/batch.hpp"
 #include "april/exec/policy.hpp"
 #include "april/exec/kernel.hpp"
 #include "april/core/context.hpp"
+#include "april/utility/interaction_counters.hpp"
+#include "april/utility/stage_profile.hpp"
 
 namespace april {
 	struct BuildInfo;
@@ -278,6 +281,16 @@ namespace april {
 			return particle_container.invoke_contains_id(id);
 		}
 
+		/**
+		 * @brief Checks whether any boundary wraps interactions across the domain (e.g. periodic boundaries).
+		 */
+		[[nodiscard]] bool wraps_forces() const noexcept {
+			for (const DomainFace face : all_faces) {
+				if (boundary_table[face].topology.force_wrap) return true;
+			}
+			return false;
+		}
+
 		/**
 		 * @brief Resolves a persistent particle identifier to its current storage index.
 		 *
@@ -337,6 +350,38 @@ namespace april {
 				)
 			);
 		}
+		/**
+		 * @brief Writes the current indices of particles inside a spatial region into a caller-provided buffer.
+		 *
+		 * Previous contents of indices are replaced. Once indices and the container's internal query buffers
+		 * have grown to the size of the query, repeated calls do not allocate.
+		 *
+		 * @param region Axis-aligned region to query.
+		 * @param indices Output buffer for the physical indices of particles contained in the region.
+		 *
+		 * @warning Returned indices may become invalid after structural updates.
+		 * @warning Queries share internal scratch memory and must not be issued concurrently on the same system.
+		 */
+		void query_region(const core::Box & region, std::vector<size_t> & indices) const {
+			particle_container.invoke_collect_indices_in_region(region, indices);
+		}
+		/**
+		 * @brief Writes the current indices of particles inside a domain into a caller-provided buffer.
+		 *
+		 * @param region Domain to query.
+		 * @param indices Output buffer for the physical indices of particles contained in the domain.
+		 *
+		 * @see query_region(const core::Box&, std::vector<size_t>&) const
+		 */
+		void query_region(const Domain & region, std::vector<size_t> & indices) const {
+			query_region(
+				core::Box(
+					region.min_corner().value(),
+					region.max_corner().value()
+				),
+				indices
+			);
+		}
 
 
 		// ---------------------
@@ -527,6 +572,7 @@ namespace april {
 		 * indices and index-based accessors.
 		 */
 		void rebuild_structure() {
+			const utility::StageScope stage(utility::Stage::RebuildStructure);
 			particle_container.invoke_rebuild_structure();
 		}
 
@@ -575,8 +621,33 @@ namespace april {
 		 *
 		 * Existing force accumulators are reset before registered interactions are
 		 * evaluated.
+		 *
+		 * @param groups Interaction groups to evaluate. Interactions outside the selected
+		 * groups do not contribute to the recomputed forces.
 		 */
-		void update_forces();
+		void update_forces(ForceGroup groups = ForceGroup::all);
+
+		/**
+		 * @brief Recomputes the forces acting on a subset of particles.
+		 *
+		 * Only the target particles receive new forces: their accumulators are reset and
+		 * all type-pair interactions and force fields acting on them are evaluated. Forces
+		 * of non-target particles are left untouched. Sources are enumerated through the
+		 * container, so the cost scales with the number of targets rather than the number
+		 * of particles.
+		 *
+		 * @param targets Current physical indices of the target particles.
+		 * @param schedule Buffer for the work partition, kept by callers that update forces every substep.
+		 *
+		 * @throws std::logic_error If ID-pair or bonded interactions are registered or a boundary wraps
+		 * forces across the domain (periodic images are not considered).
+		 */
+		void update_forces_on(const std::vector<size_t>& targets, std::vector<math::Range>& schedule);
+
+		void update_forces_on(const std::vector<size_t>& targets) {
+			std::vector<math::Range> schedule;
+			update_forces_on(targets, schedule);
+		}
 
 		/**
 		 * @brief Applies all configured boundary conditions to affected particles.
@@ -605,6 +676,34 @@ namespace april {
 		void update_all_components();
 
 
+		// -----------
+		// DIAGNOSTICS
+		// -----------
+		/**
+		 * @brief Returns the interaction-efficiency counters of the pairwise force kernel.
+		 *
+		 * Counters are recorded per executor thread and type pair while enabled. Recording is only
+		 * compiled in with APRIL_ENABLE_INTERACTION_COUNTERS=1.
+		 */
+		[[nodiscard]] utility::InteractionCounters & interaction_counters() noexcept {
+			return pair_counters;
+		}
+
+		[[nodiscard]] const utility::InteractionCounters & interaction_counters() const noexcept {
+			return pair_counters;
+		}
+
+		/**
+		 * @brief Returns the state and decision history of the container's adaptive Verlet skin.
+		 *
+		 * @return nullptr unless the container supports and enables an adaptive skin
+		 *         (e.g. LinkedCells configured with with_adaptive_skin()).
+		 */
+		[[nodiscard]] const container::SkinTuningLog * skin_tuning() const noexcept {
+			return particle_container.invoke_skin_tuning();
+		}
+
+
 		// --------
 		// CONTEXTS
 		// --------
@@ -664,6 +763,10 @@ namespace april {
 
 		std::vector<PaddedThreadBuffer> thread_update_buffers;
 		std::vector<size_t> particles_to_update_buffer;
+		std::vector<size_t> boundary_particles_buffer; // particles in the boundary region of the current face
+		std::vector<math::Range> boundary_blocks_buffer;
+
+		utility::InteractionCounters pair_counters; // see interaction_counters()
 
 		double time_ = 0;
 		size_t step_ = 0;
@@ -688,6 +791,7 @@ namespace april {
 			particle_container.invoke_build(config.particles);
 
 			thread_update_buffers.resize(thread_executor.num_threads());
+			pair_counters.resize(thread_executor.num_threads(), force_table.num_types());
 
 			controllers.for_each_item([&](auto& controller) {
 				controller.dispatch_init(context());
@@ -704,7 +808,8 @@ namespace april {
 	    friend auto build_system(const E&, const C&, const EC&, BuildInfo*);
 
 		/// @brief Maps generic kernels to the container's Scalar/Vector batch paths.
-		template<VectorPolicy V, container::batching::IsBatch Batch, exec::IsKernel Kernel>
+		template<VectorPolicy V, typename Batch, exec::IsKernel Kernel>
+			requires container::batching::IsBatch<Batch> || container::batching::IsTopologyBatch<Batch>
 		void execute_batch_kernel(const Batch& batch, Kernel&& kernel);
 	};
 
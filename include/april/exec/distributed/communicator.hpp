@@ -0,0 +1,78 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace april::exec {
+
+    /**
+     * @brief Message passing between the ranks of a distributed run.
+     *
+     * Messages from one rank to another are delivered in order. recv() blocks until the next message from src
+     * has arrived and requires its tag to match (a mismatch is a protocol error and throws). sendrecv() sends to
+     * dest while receiving from src and never deadlocks, even if every rank calls it at the same time.
+     * Collectives (barrier, allreduce_sum) must be called by all ranks in the same order.
+     *
+     * A communicator belongs to one rank and is used from a single thread. Backends are interchangeable:
+     * InProcessCommunicator (ranks are threads), SharedMemoryCommunicator (ranks are processes on one node).
+     */
+    template<typename C>
+    concept IsCommunicator = requires (
+        C& comm,
+        const C& const_comm,
+        int peer,
+        int tag,
+        std::span<const std::byte> data,
+        std::vector<std::byte>& buffer,
+        double value
+    ) {
+        { const_comm.rank() } -> std::convertible_to<int>;
+        { const_comm.size() } -> std::convertible_to<int>;
+
+        { comm.send(peer, tag, data) } -> std::same_as<void>;
+        { comm.recv(peer, tag, buffer) } -> std::same_as<void>;               // replaces the contents of buffer
+        { comm.sendrecv(peer, data, peer, buffer, tag) } -> std::same_as<void>; // (dest, data, src, buffer, tag)
+
+        { comm.barrier() } -> std::same_as<void>;
+        { comm.allreduce_sum(value) } -> std::convertible_to<double>;         // identical result on every rank
+    };
+
+
+    namespace internal {
+        [[noreturn]] inline void throw_tag_mismatch(const int src, const int expected, const int received) {
+            throw std::logic_error("[APRIL] Communicator: expected message with tag " + std::to_string(expected) +
+                " from rank " + std::to_string(src) + " but received tag " + std::to_string(received));
+        }
+    }
+
+
+    // byte view of trivially copyable values, as passed to send() and sendrecv()
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] std::span<const std::byte> as_message(const std::vector<T>& values) noexcept {
+        return std::as_bytes(std::span(values));
+    }
+
+    // appends the values contained in a received message
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    void append_message(const std::vector<std::byte>& message, std::vector<T>& values) {
+        if (message.size() % sizeof(T) != 0) {
+            throw std::logic_error("[APRIL] Communicator: message size is not a multiple of the element size");
+        }
+
+        const size_t offset = values.size();
+        values.resize(offset + message.size() / sizeof(T));
+        if (!message.empty()) {
+            std::memcpy(values.data() + offset, message.data(), message.size());
+        }
+    }
+
+} // namespace april::exec
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "april/base/types.hpp"
+#include "april/core/domain.hpp"
+#include "april/exec/distributed/communicator.hpp"
+
+
+namespace april::exec {
+
+    // particles that can be shipped between ranks: raw bytes with a position
+    template<typename T>
+    concept IsDistributable = std::is_trivially_copyable_v<T> && requires (T& t) {
+        { t.position.x } -> std::convertible_to<double>;
+        { t.position.y } -> std::convertible_to<double>;
+        { t.position.z } -> std::convertible_to<double>;
+    };
+
+
+    /**
+     * @brief Regular grid decomposition of a (possibly periodic) box into one subdomain per rank.
+     *
+     * Communication primitives only: the decomposition moves plain particle records between ranks and is not
+     * used by System, the containers or the integrators. System can not add or remove particles yet, so
+     * there is no per-rank step driver; a caller has to build a System from the records it holds. Ranks are
+     * laid out x fastest and every rank owns the particles whose position falls into its local box.
+     *   - migrate():       hands particles that left the local box to the neighbouring ranks
+     *   - exchange_halo(): collects copies of all remote particles within the halo width of the local box
+     *
+     * Halo copies are only sources of force. When added to a System they should be ParticleState::STATIONARY,
+     * so integrators neither drift nor kick them.
+     *
+     * Both exchanges go axis by axis through the face neighbours only; forwarding what was received on earlier
+     * axes delivers edge and corner data without diagonal messages. Particles crossing a periodic boundary are
+     * shifted by the global extent at the sender, so receivers always see positions consistent with their box.
+     * Only position (and old_position, if present) are shifted.
+     *
+     * Exchange buffers are kept between calls. A decomposition is used by one rank and is not thread safe.
+     */
+    class DomainDecomposition {
+    public:
+        DomainDecomposition(
+            const core::Box& global_box,
+            const int n_ranks,
+            const int rank,
+            const std::array<bool, 3> periodic = {true, true, true},
+            const std::optional<uint3> grid = std::nullopt
+        ):
+            global(global_box),
+            periodic(periodic),
+            rank_(rank),
+            grid_(grid.value_or(balanced_grid(n_ranks, global_box.extent))),
+            coords_(grid_coords(grid_, rank)),
+            local(slab_box(coords_))
+        {
+            if (static_cast<int64_t>(grid_.x) * grid_.y * grid_.z != n_ranks) {
+                throw std::invalid_argument("[APRIL] DomainDecomposition: grid does not match the number of ranks (" +
+                    std::to_string(n_ranks) + ")");
+            }
+            if (rank < 0 || rank >= n_ranks) {
+                throw std::out_of_range("[APRIL] DomainDecomposition: invalid rank " + std::to_string(rank));
+            }
+        }
+
+        // factorization of n_ranks that minimizes the surface (and thus the halo volume) of the subdomains
+        [[nodiscard]] static uint3 balanced_grid(const int n_ranks, const vec3d& extent) {
+            if (n_ranks < 1) throw std::invalid_argument("[APRIL] DomainDecomposition: at least one rank is required");
+
+            uint3 best{static_cast<uint32_t>(n_ranks), 1u, 1u};
+            double best_surface = std::numeric_limits<double>::max();
+
+            for (int gx = 1; gx <= n_ranks; ++gx) {
+                if (n_ranks % gx != 0) continue;
+                for (int gy = 1; gy <= n_ranks / gx; ++gy) {
+                    if (n_ranks / gx % gy != 0) continue;
+                    const int gz = n_ranks / gx / gy;
+
+                    const vec3d e = {extent.x / gx, extent.y / gy, extent.z / gz};
+                    const double surface = e.x * e.y + e.y * e.z + e.x * e.z;
+                    if (surface < best_surface) {
+                        best_surface = surface;
+                        best = {static_cast<uint32_t>(gx), static_cast<uint32_t>(gy), static_cast<uint32_t>(gz)};
+                    }
+                }
+            }
+            return best;
+        }
+
+        [[nodiscard]] int rank() const noexcept { return rank_; }
+        [[nodiscard]] const uint3& grid() const noexcept { return grid_; }
+        [[nodiscard]] const uint3& coords() const noexcept { return coords_; }
+        [[nodiscard]] const core::Box& global_box() const noexcept { return global; }
+        [[nodiscard]] const core::Box& local_box() const noexcept { return local; }
+        [[nodiscard]] bool is_periodic(const int axis) const noexcept { return periodic[axis]; }
+
+        // rank at the given grid coordinates (wrapped along periodic axes), -1 if there is none
+        [[nodiscard]] int rank_of(int3 c) const noexcept {
+            for (int a = 0; a < 3; ++a) {
+                const auto g = static_cast<int>(grid_[a]);
+                if (periodic[a]) c[a] = ((c[a] % g) + g) % g;
+                else if (c[a] < 0 || c[a] >= g) return -1;
+            }
+            return c.x + static_cast<int>(grid_.x) * (c.y + static_cast<int>(grid_.y) * c.z);
+        }
+
+        // face neighbour in direction dir (-1 or +1) along axis, -1 if there is none
+        [[nodiscard]] int neighbor(const int axis, const int dir) const noexcept {
+            int3 c = coords_;
+            c[axis] += dir;
+            return rank_of(c);
+        }
+
+        // rank owning a position; positions outside the global box count towards the closest subdomain
+        [[nodiscard]] int owner_of(const vec3d& position) const noexcept {
+            int3 c;
+            for (int a = 0; a < 3; ++a) {
+                c[a] = std::clamp(slab_of(a, position[a]), 0, static_cast<int>(grid_[a]) - 1);
+            }
+            return rank_of(c);
+        }
+
+
+        /**
+         * @brief Sends particles that left the local box to their new owners and receives the ones that entered.
+         *
+         * Collective: all ranks must call it. Particles may move at most one subdomain per axis between calls.
+         * Particles leaving through a non-periodic global boundary stay with their current owner.
+         */
+        template<IsCommunicator Comm, IsDistributable T>
+        void migrate(Comm& comm, std::vector<T>& particles) {
+            for (int axis = 0; axis < 3; ++axis) {
+                const int coord = static_cast<int>(coords_[axis]);
+                const int left = neighbor(axis, -1);
+                const int right = neighbor(axis, +1);
+
+                send_left.clear();
+                send_right.clear();
+
+                size_t kept = 0;
+                for (size_t i = 0; i < particles.size(); ++i) {
+                    T& p = particles[i];
+                    const int slab = slab_of(axis, p.position[axis]);
+                    const int dir = slab < coord ? -1 : slab > coord ? +1 : 0;
+                    const int dest = dir < 0 ? left : right;
+
+                    if (dir != 0 && dest >= 0) {
+                        if (crosses_periodic_boundary(axis, dir)) shift(p, axis, -dir);
+                        if (dest != rank_) {
+                            push_bytes(dir < 0 ? send_left : send_right, p);
+                            continue;
+                        }
+                    }
+                    particles[kept++] = p; // still local, or wrapped along an axis spanned by this rank alone
+                }
+                particles.resize(kept);
+
+                if (grid_[axis] > 1) exchange(comm, axis, tag_migrate, particles);
+            }
+        }
+
+
+        /**
+         * @brief Collects copies of all remote particles within width of the local box into ghosts.
+         *
+         * Collective: all ranks must call it. ghosts is replaced. Along periodic axes the images of the global
+         * box are included, also when a single rank spans the axis. width must not exceed the local extent.
+         */
+        template<IsCommunicator Comm, IsDistributable T>
+        void exchange_halo(Comm& comm, const std::vector<T>& owned, std::vector<T>& ghosts, const double width) {
+            for (int axis = 0; axis < 3; ++axis) {
+                if (width > local.extent[axis]) {
+                    throw std::invalid_argument("[APRIL] DomainDecomposition: halo width " + std::to_string(width) +
+                        " exceeds the local extent along axis " + std::to_string(axis));
+                }
+            }
+
+            ghosts.clear();
+            for (int axis = 0; axis < 3; ++axis) {
+                const int left = neighbor(axis, -1);
+                const int right = neighbor(axis, +1);
+                const size_t n_ghosts = ghosts.size(); // ghosts received on earlier axes are forwarded
+
+                send_left.clear();
+                send_right.clear();
+
+                // image of p as seen by the neighbour in direction dir
+                auto emit = [&](T p, const int dir, const int dest) {
+                    if (crosses_periodic_boundary(axis, dir)) shift(p, axis, -dir);
+                    if (dest == rank_) ghosts.push_back(p);
+                    else push_bytes(dir < 0 ? send_left : send_right, p);
+                };
+
+                auto select = [&](const T p) { // by value: emit() may reallocate ghosts
+                    const double x = p.position[axis];
+                    if (left >= 0 && x < local.min[axis] + width) emit(p, -1, left);
+                    if (right >= 0 && x >= local.max[axis] - width) emit(p, +1, right);
+                };
+
+                for (const T& p : owned) select(p);
+                for (size_t i = 0; i < n_ghosts; ++i) select(ghosts[i]);
+
+                if (grid_[axis] > 1) exchange(comm, axis, tag_halo, ghosts);
+            }
+        }
+
+    private:
+        static constexpr int tag_migrate = 0x100;
+        static constexpr int tag_halo = 0x200;
+
+        core::Box global;
+        std::array<bool, 3> periodic;
+        int rank_;
+        uint3 grid_;
+        uint3 coords_;
+        core::Box local;
+
+        std::vector<std::byte> send_left;
+        std::vector<std::byte> send_right;
+        std::vector<std::byte> received;
+
+        [[nodiscard]] static uint3 grid_coords(const uint3& grid, const int rank) noexcept {
+            const auto r = static_cast<uint32_t>(rank);
+            return {r % grid.x, r / grid.x % grid.y, r / (grid.x * grid.y)};
+        }
+
+        [[nodiscard]] core::Box slab_box(const uint3& c) const {
+            vec3d min, max;
+            for (int a = 0; a < 3; ++a) {
+                min[a] = boundary(a, c[a]);
+                max[a] = boundary(a, c[a] + 1);
+            }
+            return {min, max};
+        }
+
+        // lower boundary of slab i along axis; the last slab ends exactly at the global maximum
+        [[nodiscard]] double boundary(const int axis, const uint32_t i) const noexcept {
+            if (i == grid_[axis]) return global.max[axis];
+            return global.min[axis] + global.extent[axis] * i / grid_[axis];
+        }
+
+        // index of the slab containing x along axis (may lie outside [0, grid))
+        [[nodiscard]] int slab_of(const int axis, const double x) const noexcept {
+            const double rel = (x - global.min[axis]) / global.extent[axis] * grid_[axis];
+            return static_cast<int>(std::floor(rel));
+        }
+
+        // whether moving one subdomain in direction dir along axis leaves the global box
+        [[nodiscard]] bool crosses_periodic_boundary(const int axis, const int dir) const noexcept {
+            return dir < 0 ? coords_[axis] == 0 : coords_[axis] + 1 == grid_[axis];
+        }
+
+        template<typename T>
+        void shift(T& p, const int axis, const int dir) const noexcept {
+            p.position[axis] += dir * global.extent[axis];
+            if constexpr (requires { p.old_position[axis]; }) {
+                p.old_position[axis] += dir * global.extent[axis];
+            }
+        }
+
+        template<typename T>
+        static void push_bytes(std::vector<std::byte>& bytes, const T& p) {
+            const size_t offset = bytes.size();
+            bytes.resize(offset + sizeof(T));
+            std::memcpy(bytes.data() + offset, &p, sizeof(T));
+        }
+
+        // ships send_left / send_right to the neighbours along axis and appends what arrives to out
+        template<IsCommunicator Comm, typename T>
+        void exchange(Comm& comm, const int axis, const int tag, std::vector<T>& out) {
+            const int left = neighbor(axis, -1);
+            const int right = neighbor(axis, +1);
+            const int tag_right = tag + 2 * axis;     // messages travelling towards +axis
+            const int tag_left = tag + 2 * axis + 1;  // messages travelling towards -axis
+
+            // towards +axis: send to the right, receive from the left
+            if (right >= 0 && left >= 0) {
+                comm.sendrecv(right, send_right, left, received, tag_right);
+                append_message(received, out);
+            } else if (right >= 0) {
+                comm.send(right, tag_right, send_right);
+            } else if (left >= 0) {
+                comm.recv(left, tag_right, received);
+                append_message(received, out);
+            }
+
+            // towards -axis: send to the left, receive from the right
+            if (right >= 0 && left >= 0) {
+                comm.sendrecv(left, send_left, right, received, tag_left);
+                append_message(received, out);
+            } else if (left >= 0) {
+                comm.send(left, tag_left, send_left);
+            } else if (right >= 0) {
+                comm.recv(right, tag_left, received);
+                append_message(received, out);
+            }
+        }
+    };
+
+} // namespace april::exec
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <barrier>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "april/exec/distributed/communicator.hpp"
+
+
+namespace april::exec {
+
+    /**
+     * @brief Shared state of a group of in-process ranks.
+     *
+     * Every rank runs on its own thread (and usually drives its own thread executor, so subdomains map onto
+     * thread groups). Sends are buffered, message storage is recycled between messages.
+     */
+    class InProcessWorld {
+    public:
+        explicit InProcessWorld(const int n_ranks)
+            : n_ranks(checked(n_ranks)), // validated before any mailbox or barrier is built
+              mailboxes(std::make_unique<Mailbox[]>(static_cast<size_t>(n_ranks) * n_ranks)),
+              sync(n_ranks),
+              reduce_slots(n_ranks, 0.0)
+        {}
+
+        InProcessWorld(const InProcessWorld&) = delete;
+        InProcessWorld& operator=(const InProcessWorld&) = delete;
+
+        [[nodiscard]] int size() const noexcept { return n_ranks; }
+
+    private:
+        friend class InProcessCommunicator;
+
+        struct Message {
+            int tag;
+            std::vector<std::byte> data;
+        };
+
+        struct Mailbox {
+            std::mutex mutex;
+            std::condition_variable arrived;
+            std::deque<Message> queue;
+            std::vector<std::vector<std::byte>> spare; // recycled message storage
+        };
+
+        int n_ranks;
+        std::unique_ptr<Mailbox[]> mailboxes; // [src * n_ranks + dst]
+        std::barrier<> sync;
+        std::vector<double> reduce_slots;
+
+        static int checked(const int n_ranks) {
+            if (n_ranks < 1) throw std::invalid_argument("[APRIL] InProcessWorld: at least one rank is required");
+            return n_ranks;
+        }
+
+        [[nodiscard]] Mailbox& mailbox(const int src, const int dst) noexcept {
+            return mailboxes[static_cast<size_t>(src) * n_ranks + dst];
+        }
+    };
+
+
+    class InProcessCommunicator {
+    public:
+        InProcessCommunicator(InProcessWorld& world, const int rank) : world(&world), rank_(rank) {
+            if (rank < 0 || rank >= world.size()) throw std::out_of_range("[APRIL] InProcessCommunicator: invalid rank");
+        }
+
+        [[nodiscard]] int rank() const noexcept { return rank_; }
+        [[nodiscard]] int size() const noexcept { return world->size(); }
+
+        void send(const int dest, const int tag, const std::span<const std::byte> data) {
+            auto& box = world->mailbox(rank_, dest);
+            {
+                std::scoped_lock lock(box.mutex);
+                std::vector<std::byte> storage;
+                if (!box.spare.empty()) {
+                    storage = std::move(box.spare.back());
+                    box.spare.pop_back();
+                }
+                storage.assign(data.begin(), data.end());
+                box.queue.push_back({tag, std::move(storage)});
+            }
+            box.arrived.notify_one();
+        }
+
+        void recv(const int src, const int tag, std::vector<std::byte>& buffer) {
+            auto& box = world->mailbox(src, rank_);
+            std::unique_lock lock(box.mutex);
+            box.arrived.wait(lock, [&] { return !box.queue.empty(); });
+
+            InProcessWorld::Message& message = box.queue.front();
+            if (message.tag != tag) internal::throw_tag_mismatch(src, tag, message.tag);
+
+            // hand the message storage to the caller and recycle the caller's previous buffer
+            std::swap(buffer, message.data);
+            box.spare.push_back(std::move(message.data));
+            box.queue.pop_front();
+        }
+
+        // sends are buffered, so sending first cannot deadlock
+        void sendrecv(const int dest, const std::span<const std::byte> data, const int src, std::vector<std::byte>& buffer, const int tag) {
+            send(dest, tag, data);
+            recv(src, tag, buffer);
+        }
+
+        void barrier() {
+            world->sync.arrive_and_wait();
+        }
+
+        // sums in rank order, so every rank gets the bitwise identical result
+        [[nodiscard]] double allreduce_sum(const double value) {
+            world->reduce_slots[rank_] = value;
+            barrier();
+
+            double sum = 0;
+            for (const double v : world->reduce_slots) sum += v;
+
+            barrier(); // slots may be reused afterwards
+            return sum;
+        }
+
+    private:
+        InProcessWorld* world;
+        int rank_;
+    };
+
+    static_assert(IsCommunicator<InProcessCommunicator>);
+
+
+    /**
+     * @brief Runs fn(comm) for n_ranks ranks, each on its own thread, and waits for all of them.
+     *
+     * The first exception thrown by a rank is rethrown after all threads have joined. Ranks still waiting for a
+     * message from a failed rank do not return, so fn should only throw on unrecoverable errors.
+     */
+    template<typename F>
+    void run_in_process(const int n_ranks, F&& fn) {
+        InProcessWorld world(n_ranks);
+        std::vector<std::exception_ptr> errors(n_ranks);
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(n_ranks);
+            for (int r = 0; r < n_ranks; ++r) {
+                threads.emplace_back([&, r] {
+                    try {
+                        InProcessCommunicator comm(world, r);
+                        fn(comm);
+                    } catch (...) {
+                        errors[r] = std::current_exception();
+                    }
+                });
+            }
+        }
+
+        for (const auto& e : errors) {
+            if (e) std::rethrow_exception(e);
+        }
+    }
+
+} // namespace april::exec
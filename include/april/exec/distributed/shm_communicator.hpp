@@ -0,0 +1,483 @@
+#pragma once
+
+#if defined(__unix__)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "april/exec/hardware.hpp"
+#include "april/exec/distributed/communicator.hpp"
+
+
+namespace april::exec {
+
+    namespace internal::shm {
+        inline constexpr uint64_t magic = 0x4150'5249'4C53'484DULL; // "APRILSHM"
+        inline constexpr size_t line = assumed_cache_line_size;
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+            "shared memory communication requires address-free (lock-free) atomics");
+
+        [[nodiscard]] constexpr size_t round_up(const size_t n, const size_t multiple) noexcept {
+            return (n + multiple - 1) / multiple * multiple;
+        }
+
+        struct alignas(line) Header {
+            uint64_t magic;
+            uint64_t capacity;
+            int32_t n_ranks;
+            std::atomic<uint32_t> ready;
+            alignas(line) std::atomic<uint32_t> barrier_count;
+            alignas(line) std::atomic<uint32_t> barrier_generation;
+        };
+
+        // single producer single consumer byte stream; head and tail count bytes written and read so far
+        struct RingControl {
+            alignas(line) std::atomic<uint64_t> head;
+            alignas(line) std::atomic<uint64_t> tail;
+        };
+
+        struct MessageHeader {
+            int32_t tag;
+            int32_t padding;
+            uint64_t size;
+        };
+
+        struct Ring {
+            RingControl* control;
+            std::byte* data;
+            uint64_t capacity;
+
+            // writes as many of the n bytes as fit, returns the number written
+            size_t write_some(const std::byte* src, const size_t n) const noexcept {
+                const uint64_t head = control->head.load(std::memory_order_relaxed);
+                const uint64_t tail = control->tail.load(std::memory_order_acquire);
+                const size_t count = std::min<uint64_t>(n, capacity - (head - tail));
+                if (count == 0) return 0;
+
+                const size_t offset = head % capacity;
+                const size_t first = std::min<size_t>(count, capacity - offset);
+                std::memcpy(data + offset, src, first);
+                std::memcpy(data, src + first, count - first);
+
+                control->head.store(head + count, std::memory_order_release);
+                return count;
+            }
+
+            // reads up to n available bytes, returns the number read
+            size_t read_some(std::byte* dst, const size_t n) const noexcept {
+                const uint64_t tail = control->tail.load(std::memory_order_relaxed);
+                const uint64_t head = control->head.load(std::memory_order_acquire);
+                const size_t count = std::min<uint64_t>(n, head - tail);
+                if (count == 0) return 0;
+
+                const size_t offset = tail % capacity;
+                const size_t first = std::min<size_t>(count, capacity - offset);
+                std::memcpy(dst, data + offset, first);
+                std::memcpy(dst + first, data, count - first);
+
+                control->tail.store(tail + count, std::memory_order_release);
+                return count;
+            }
+        };
+    }
+
+
+    /**
+     * @brief Shared memory segment connecting the processes of a single node run.
+     *
+     * The segment holds one ring buffer for every ordered pair of ranks, a barrier and the allreduce slots.
+     * create() makes a new named segment (the creating object unlinks it on destruction), attach() maps an
+     * existing one from another process. Worlds that are inherited through fork() can be used directly.
+     */
+    class SharedMemoryWorld {
+    public:
+        static constexpr size_t default_ring_capacity = size_t{1} << 20;
+
+        // name follows shm_open rules, e.g. "/april_run"
+        [[nodiscard]] static SharedMemoryWorld create(const std::string& name, const int n_ranks, const size_t ring_capacity = default_ring_capacity) {
+            if (n_ranks < 1) throw std::invalid_argument("[APRIL] SharedMemoryWorld: at least one rank is required");
+            if (ring_capacity < sizeof(internal::shm::MessageHeader)) throw std::invalid_argument("[APRIL] SharedMemoryWorld: ring capacity too small");
+
+            const size_t capacity = internal::shm::round_up(ring_capacity, internal::shm::line);
+            const size_t bytes = segment_size(n_ranks, capacity);
+
+            const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) throw_errno("shm_open");
+            if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+                const int err = errno;
+                close(fd);
+                shm_unlink(name.c_str());
+                errno = err;
+                throw_errno("ftruncate");
+            }
+
+            SharedMemoryWorld world(name, map(fd, bytes, name, true), bytes, true);
+
+            auto* header = new (world.base) internal::shm::Header{};
+            header->magic = internal::shm::magic;
+            header->capacity = capacity;
+            header->n_ranks = n_ranks;
+            for (int i = 0; i < n_ranks * n_ranks; ++i) {
+                new (world.ring_control(i)) internal::shm::RingControl{};
+            }
+            header->ready.store(1, std::memory_order_release);
+
+            return world;
+        }
+
+        [[nodiscard]] static SharedMemoryWorld attach(const std::string& name) {
+            const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd < 0) throw_errno("shm_open");
+
+            struct stat info{};
+            if (fstat(fd, &info) != 0) {
+                close(fd);
+                throw_errno("fstat");
+            }
+            const auto bytes = static_cast<size_t>(info.st_size);
+            if (bytes < sizeof(internal::shm::Header)) {
+                close(fd);
+                throw std::runtime_error("[APRIL] SharedMemoryWorld: segment " + name + " is not initialized");
+            }
+
+            SharedMemoryWorld world(name, map(fd, bytes, name, false), bytes, false);
+            const auto& header = world.header();
+            if (header.magic != internal::shm::magic || header.ready.load(std::memory_order_acquire) != 1 ||
+                segment_size(header.n_ranks, header.capacity) != bytes) {
+                throw std::runtime_error("[APRIL] SharedMemoryWorld: segment " + name + " is not an april communicator");
+            }
+            return world;
+        }
+
+        SharedMemoryWorld(const SharedMemoryWorld&) = delete;
+        SharedMemoryWorld& operator=(const SharedMemoryWorld&) = delete;
+
+        SharedMemoryWorld(SharedMemoryWorld&& other) noexcept
+            : name(std::move(other.name)),
+              base(std::exchange(other.base, nullptr)),
+              bytes(std::exchange(other.bytes, 0)),
+              owner(std::exchange(other.owner, false))
+        {}
+
+        SharedMemoryWorld& operator=(SharedMemoryWorld&& other) noexcept {
+            if (this != &other) {
+                release();
+                name = std::move(other.name);
+                base = std::exchange(other.base, nullptr);
+                bytes = std::exchange(other.bytes, 0);
+                owner = std::exchange(other.owner, false);
+            }
+            return *this;
+        }
+
+        ~SharedMemoryWorld() { release(); }
+
+        [[nodiscard]] int size() const noexcept { return header().n_ranks; }
+        [[nodiscard]] size_t ring_capacity() const noexcept { return header().capacity; }
+
+    private:
+        friend class SharedMemoryCommunicator;
+
+        std::string name;
+        std::byte* base = nullptr;
+        size_t bytes = 0;
+        bool owner = false;
+
+        SharedMemoryWorld(std::string name, std::byte* base, const size_t bytes, const bool owner)
+            : name(std::move(name)), base(base), bytes(bytes), owner(owner) {}
+
+        [[noreturn]] static void throw_errno(const char* what) {
+            throw std::system_error(errno, std::generic_category(), std::string("[APRIL] SharedMemoryWorld: ") + what);
+        }
+
+        static std::byte* map(const int fd, const size_t bytes, const std::string& name, const bool unlink_on_error) {
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            const int err = errno;
+            close(fd); // the mapping keeps the segment alive
+            if (p == MAP_FAILED) {
+                if (unlink_on_error) shm_unlink(name.c_str());
+                errno = err;
+                throw_errno("mmap");
+            }
+            return static_cast<std::byte*>(p);
+        }
+
+        static constexpr size_t header_bytes() noexcept {
+            return internal::shm::round_up(sizeof(internal::shm::Header), internal::shm::line);
+        }
+
+        static constexpr size_t reduce_bytes(const size_t n_ranks) noexcept {
+            return internal::shm::round_up(n_ranks * sizeof(double), internal::shm::line);
+        }
+
+        static constexpr size_t ring_bytes(const size_t capacity) noexcept {
+            return sizeof(internal::shm::RingControl) + capacity;
+        }
+
+        static constexpr size_t segment_size(const size_t n_ranks, const size_t capacity) noexcept {
+            return header_bytes() + reduce_bytes(n_ranks) + n_ranks * n_ranks * ring_bytes(capacity);
+        }
+
+        [[nodiscard]] internal::shm::Header& header() const noexcept {
+            return *std::launder(reinterpret_cast<internal::shm::Header*>(base));
+        }
+
+        [[nodiscard]] double* reduce_slots() const noexcept {
+            return reinterpret_cast<double*>(base + header_bytes());
+        }
+
+        [[nodiscard]] std::byte* ring_base(const size_t i) const noexcept {
+            return base + header_bytes() + reduce_bytes(header().n_ranks) + i * ring_bytes(header().capacity);
+        }
+
+        [[nodiscard]] internal::shm::RingControl* ring_control(const size_t i) const noexcept {
+            return std::launder(reinterpret_cast<internal::shm::RingControl*>(ring_base(i)));
+        }
+
+        [[nodiscard]] internal::shm::Ring ring(const int src, const int dst) const noexcept {
+            const size_t i = static_cast<size_t>(src) * header().n_ranks + dst;
+            return {ring_control(i), ring_base(i) + sizeof(internal::shm::RingControl), header().capacity};
+        }
+
+        void release() noexcept {
+            if (base) munmap(base, bytes);
+            if (owner) shm_unlink(name.c_str());
+            base = nullptr;
+            owner = false;
+        }
+    };
+
+
+    /**
+     * @brief Communicator between processes that share a SharedMemoryWorld.
+     *
+     * Messages are streamed through fixed size rings, so they may be larger than the ring capacity. A sender
+     * blocks (spinning, with yields) only while the ring to its peer is full; sendrecv() interleaves writing and
+     * reading and therefore cannot deadlock on full rings.
+     */
+    class SharedMemoryCommunicator {
+    public:
+        SharedMemoryCommunicator(const SharedMemoryWorld& world, const int rank) : world(&world), rank_(rank) {
+            if (rank < 0 || rank >= world.size()) throw std::out_of_range("[APRIL] SharedMemoryCommunicator: invalid rank");
+        }
+
+        [[nodiscard]] int rank() const noexcept { return rank_; }
+        [[nodiscard]] int size() const noexcept { return world->size(); }
+
+        void send(const int dest, const int tag, const std::span<const std::byte> data) {
+            Outgoing out(world->ring(rank_, dest), tag, data);
+            while (!out.done()) {
+                if (!out.progress()) std::this_thread::yield();
+            }
+        }
+
+        void recv(const int src, const int tag, std::vector<std::byte>& buffer) {
+            Incoming in(world->ring(src, rank_), src, tag, buffer);
+            while (!in.done()) {
+                if (!in.progress()) std::this_thread::yield();
+            }
+        }
+
+        void sendrecv(const int dest, const std::span<const std::byte> data, const int src, std::vector<std::byte>& buffer, const int tag) {
+            Outgoing out(world->ring(rank_, dest), tag, data);
+            Incoming in(world->ring(src, rank_), src, tag, buffer);
+            while (!out.done() || !in.done()) {
+                const bool moved = out.progress() | in.progress();
+                if (!moved) std::this_thread::yield();
+            }
+        }
+
+        // sense reversing barrier
+        void barrier() {
+            auto& header = world->header();
+            const uint32_t generation = header.barrier_generation.load(std::memory_order_acquire);
+
+            if (header.barrier_count.fetch_add(1, std::memory_order_acq_rel) + 1 == static_cast<uint32_t>(size())) {
+                header.barrier_count.store(0, std::memory_order_relaxed);
+                header.barrier_generation.fetch_add(1, std::memory_order_acq_rel);
+                return;
+            }
+
+            while (header.barrier_generation.load(std::memory_order_acquire) == generation) {
+                std::this_thread::yield();
+            }
+        }
+
+        // sums in rank order, so every rank gets the bitwise identical result
+        [[nodiscard]] double allreduce_sum(const double value) {
+            double* slots = world->reduce_slots();
+            slots[rank_] = value;
+            barrier();
+
+            double sum = 0;
+            for (int r = 0; r < size(); ++r) sum += slots[r];
+
+            barrier(); // slots may be reused afterwards
+            return sum;
+        }
+
+    private:
+        const SharedMemoryWorld* world;
+        int rank_;
+
+        class Outgoing {
+        public:
+            Outgoing(const internal::shm::Ring ring, const int tag, const std::span<const std::byte> data)
+                : ring(ring), payload(data)
+            {
+                const internal::shm::MessageHeader h{tag, 0, data.size()};
+                std::memcpy(header.data(), &h, sizeof(h));
+            }
+
+            [[nodiscard]] bool done() const noexcept { return written == header.size() + payload.size(); }
+
+            // returns whether any byte was written
+            bool progress() noexcept {
+                const size_t before = written;
+                if (written < header.size()) {
+                    written += ring.write_some(header.data() + written, header.size() - written);
+                }
+                if (written >= header.size() && !done()) {
+                    const size_t offset = written - header.size();
+                    written += ring.write_some(payload.data() + offset, payload.size() - offset);
+                }
+                return written != before;
+            }
+
+        private:
+            internal::shm::Ring ring;
+            std::span<const std::byte> payload;
+            std::array<std::byte, sizeof(internal::shm::MessageHeader)> header{};
+            size_t written = 0;
+        };
+
+        class Incoming {
+        public:
+            Incoming(const internal::shm::Ring ring, const int src, const int tag, std::vector<std::byte>& buffer)
+                : ring(ring), src(src), tag(tag), buffer(buffer) {}
+
+            [[nodiscard]] bool done() const noexcept { return has_header && received == buffer.size(); }
+
+            // returns whether any byte was read
+            bool progress() {
+                bool moved = false;
+                if (!has_header) {
+                    const size_t n = ring.read_some(header.data() + header_received, header.size() - header_received);
+                    header_received += n;
+                    moved = n > 0;
+                    if (header_received < header.size()) return moved;
+
+                    internal::shm::MessageHeader h{};
+                    std::memcpy(&h, header.data(), sizeof(h));
+                    if (h.tag != tag) internal::throw_tag_mismatch(src, tag, h.tag);
+                    buffer.resize(h.size);
+                    has_header = true;
+                }
+                if (received < buffer.size()) {
+                    const size_t n = ring.read_some(buffer.data() + received, buffer.size() - received);
+                    received += n;
+                    moved |= n > 0;
+                }
+                return moved;
+            }
+
+        private:
+            internal::shm::Ring ring;
+            int src;
+            int tag;
+            std::vector<std::byte>& buffer;
+            std::array<std::byte, sizeof(internal::shm::MessageHeader)> header{};
+            size_t header_received = 0;
+            size_t received = 0;
+            bool has_header = false;
+        };
+    };
+
+    static_assert(IsCommunicator<SharedMemoryCommunicator>);
+
+
+    /**
+     * @brief Runs fn(comm) on world.size() processes: the caller is rank 0, the other ranks are forked children.
+     *
+     * A child exits with EXIT_SUCCESS if fn returns normally (or returns true, if fn returns bool) and with
+     * EXIT_FAILURE otherwise. Children exit without unwinding the parent's state (std::_Exit). Returns whether all
+     * ranks succeeded; if rank 0 throws, the children are killed and the exception is rethrown.
+     *
+     * fork() only duplicates the calling thread, so thread pools of the parent must not be used by the children.
+     */
+    template<typename F>
+    bool run_forked(const SharedMemoryWorld& world, F&& fn) {
+        auto run_rank = [&](const int rank) -> bool {
+            SharedMemoryCommunicator comm(world, rank);
+            if constexpr (std::is_same_v<decltype(fn(comm)), bool>) {
+                return fn(comm);
+            } else {
+                fn(comm);
+                return true;
+            }
+        };
+
+        std::vector<pid_t> children;
+        children.reserve(world.size() - 1);
+
+        auto kill_children = [&] {
+            for (const pid_t pid : children) kill(pid, SIGKILL);
+            for (const pid_t pid : children) waitpid(pid, nullptr, 0);
+        };
+
+        for (int r = 1; r < world.size(); ++r) {
+            const pid_t pid = fork();
+            if (pid < 0) {
+                kill_children();
+                throw std::system_error(errno, std::generic_category(), "[APRIL] run_forked: fork");
+            }
+            if (pid == 0) {
+                bool ok = false;
+                try { ok = run_rank(r); } catch (...) {}
+                std::_Exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+            }
+            children.push_back(pid);
+        }
+
+        bool ok;
+        try {
+            ok = run_rank(0);
+        } catch (...) {
+            kill_children();
+            throw;
+        }
+
+        for (const pid_t pid : children) {
+            int status = 0;
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+            ok &= WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+        }
+        return ok;
+    }
+
+} // namespace april::exec
+
+#endif // defined(__unix__)
@@ -6,7 +6,9 @@
 #include <type_traits>
 
 #include "april/exec/hardware.hpp"
+#include "april/exec/topology.hpp"
 #include "april/exec/threading/executor_concepts.hpp"
+#include "april/exec/threading/trace.hpp"
 
 
 // platform specific includes for thread pinning
@@ -126,18 +128,36 @@ namespace april::exec::internal {
     public:
         [[nodiscard]] size_t num_threads() const noexcept { return threads.size() + 1; }
 
+        // logical cpu the given executor thread is pinned to (-1 if threads are not pinned)
+        [[nodiscard]] int pinned_cpu(const size_t thread_idx) const noexcept {
+            return thread_idx < thread_cpus.size() ? thread_cpus[thread_idx] : -1;
+        }
+
     protected:
         std::vector<worker_thread> threads;
+        std::vector<int> thread_cpus; // logical cpu per thread index (empty if unpinned)
         std::atomic<bool> terminate{false};
 
         // Mutable read-only state for current task
         mutable size_t total_tasks{0};
         mutable size_t chunk_size{1};
         mutable TaskWrapper active_task{};
+        mutable trace::Label active_label{}; // label of the dispatch, attached to the chunk events
 
         // Mutable contended state (Isolated in its own cache line)
         alignas(assumed_cache_line_size) mutable std::atomic<size_t> current_idx{0};
 
+        // Pins the calling thread (index 0) and all workers according to the policy. Call after the workers are spawned.
+        void pin_threads(const PinningPolicy policy) {
+            thread_cpus = make_pinning_plan(CpuTopology::system(), policy, num_threads());
+            if (thread_cpus.empty()) return;
+
+            pin_current_thread(thread_cpus[0]);
+            for (size_t t = 1; t < thread_cpus.size(); ++t) {
+                pin_thread_to_core(threads[t - 1].native_handle(), thread_cpus[t]);
+            }
+        }
+
         // Sets up the type-erased lambda and calculates chunk sizes
         template <IsIndexedWork F>
         void prepare_task(const size_t batch_count, F&& task) const {
@@ -147,6 +167,8 @@ namespace april::exec::internal {
                 (*static_cast<std::remove_reference_t<F>*>(ctx))(task_idx);
             };
 
+            if constexpr (trace::compiled_in) active_label = trace::current_label();
+
             total_tasks = batch_count;
             current_idx.store(0, std::memory_order_relaxed);
 
@@ -163,6 +185,7 @@ namespace april::exec::internal {
 
                 // process fetched work
                 const size_t end = std::min(start + chunk_size, total_tasks);
+                const trace::ExecutorSpan span(trace::EventKind::Chunk, active_label, start, end);
                 for (size_t i = start; i < end; ++i) {
                     active_task.invoke(active_task.callable, i);
                 }
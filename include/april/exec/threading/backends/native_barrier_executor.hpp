@@ -5,8 +5,10 @@
 #include <vector>
 
 #include "april/exec/hardware.hpp"
+#include "april/exec/topology.hpp"
 #include "april/exec/threading/threading_context.hpp"
 #include "april/exec/threading/executor_concepts.hpp"
+#include "april/exec/threading/trace.hpp"
 #include "april/exec/threading/backends/internal/native_executor_base.hpp"
 #include "april/exec/policy.hpp"
 
@@ -17,6 +19,7 @@ namespace april::exec {
         struct Config {
             size_t n_threads = default_thread_count;
             bool pin_threads = true;
+            PinningPolicy pinning = PinningPolicy::SkipSMT; // thread to cpu mapping if pin_threads is set
         };
 
         explicit NativeBarrierExecutor(const Config & config)
@@ -26,13 +29,13 @@ namespace april::exec {
                 throw std::invalid_argument("Executor thread count must be greater than zero.");
             }
 
-            if (config.pin_threads) internal::pin_current_thread(0);
             threads.reserve(config.n_threads - 1);
 
             for (unsigned int i = 0; i < config.n_threads - 1; ++i) {
                 threads.emplace_back(&NativeBarrierExecutor::worker_loop, this, i+1);   // +1 because main thread is 0
-                if (config.pin_threads) internal::pin_thread_to_core(threads.back().native_handle(), i + 1);
             }
+
+            if (config.pin_threads) pin_threads(config.pinning);
         }
 
         ~NativeBarrierExecutor() {
@@ -51,9 +54,10 @@ namespace april::exec {
             } else {
                 internal::ScopedThreadContext ctx(0);
                 prepare_task(batch_count, std::forward<F>(task));
+                const trace::ExecutorSpan span(trace::EventKind::Execute, active_label, batch_count);
                 start_sync.arrive_and_wait(); // Wake workers
                 process_tasks();    // Main thread works as well
-                end_sync.arrive_and_wait();   // Sync at phase end
+                wait_for_phase_end();
             }
         }
 
@@ -68,10 +72,14 @@ namespace april::exec {
                 if (terminate.load(std::memory_order_relaxed)) return;
 
                 process_tasks();
-
-                end_sync.arrive_and_wait();
+                wait_for_phase_end();
             }
         }
+
+        void wait_for_phase_end() const {
+            const trace::ExecutorSpan wait(trace::EventKind::Wait, active_label);
+            end_sync.arrive_and_wait();
+        }
     };
 } // namespace april::exec
 
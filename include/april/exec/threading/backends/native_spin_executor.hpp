@@ -1,12 +1,16 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <vector>
 #include <stdexcept>
 
 #include "april/exec/threading/threading_context.hpp"
 #include "april/exec/hardware.hpp"
+#include "april/exec/topology.hpp"
 #include "april/exec/threading/executor_concepts.hpp"
+#include "april/exec/threading/trace.hpp"
 #include "internal/native_executor_base.hpp"
 #include "april/exec/policy.hpp"
 
@@ -17,6 +21,11 @@ namespace april::exec {
         struct Config {
             size_t n_threads = default_thread_count;
             bool pin_threads = true;
+            PinningPolicy pinning = PinningPolicy::SkipSMT; // thread to cpu mapping if pin_threads is set
+
+            // idle workers spin for this many pause iterations before parking (0 = calibrate from spin_time)
+            size_t spin_iterations = 0;
+            std::chrono::microseconds spin_time{100}; // target spin duration used by the calibration
         };
 
         explicit NativeSpinExecutor(const Config & config) {
@@ -24,21 +33,30 @@ namespace april::exec {
                 throw std::invalid_argument("Executor thread count must be greater than zero.");
             }
 
-            if (config.pin_threads) internal::pin_current_thread(0);
+            spin_limit = config.spin_iterations > 0 ? config.spin_iterations : calibrate_spin_iterations(config.spin_time);
+
             threads.reserve(config.n_threads - 1);
 
             for (unsigned thread_idx = 1; thread_idx < config.n_threads; ++thread_idx) {
                 threads.emplace_back(&NativeSpinExecutor::worker_loop, this, thread_idx);
-                if (config.pin_threads) internal::pin_thread_to_core(threads.back().native_handle(), thread_idx);
             }
+
+            if (config.pin_threads) pin_threads(config.pinning);
         }
 
         ~NativeSpinExecutor() {
             // set termination flag and drop the spin-lock barrier so sleeping threads wake up and see the flag
             terminate.store(true, std::memory_order_relaxed);
-            run_signal.fetch_add(1, std::memory_order_release);
+            run_signal.fetch_add(1, std::memory_order_seq_cst);
+            run_signal.notify_all();
         }
 
+        // number of pause iterations an idle worker spins before parking
+        [[nodiscard]] size_t spin_iterations() const noexcept { return spin_limit; }
+
+        // number of workers currently parked (sleeping in the kernel)
+        [[nodiscard]] size_t parked_threads() const noexcept { return parked.load(std::memory_order_relaxed); }
+
         template <ParallelPolicy P = ParallelPolicy::Threaded, IsIndexedWork F>
         void execute(const size_t batch_count, F&& task) const {
             if (batch_count == 0) return;
@@ -52,12 +70,17 @@ namespace april::exec {
 
                 // reset completion counter, wake up threads and start processing
                 threads_finished.store(0, std::memory_order_relaxed);
-                run_signal.fetch_add(1, std::memory_order_release);
+                run_signal.fetch_add(1, std::memory_order_seq_cst);
+
+                // only pay for the wake-up syscall if someone is asleep (seq_cst pairs with the parking sequence)
+                if (parked.load(std::memory_order_seq_cst) > 0) run_signal.notify_all();
 
                 internal::ScopedThreadContext ctx(0);
+                const trace::ExecutorSpan span(trace::EventKind::Execute, active_label, batch_count);
                 process_tasks();
 
                 // spin until all threads have finished
+                const trace::ExecutorSpan wait(trace::EventKind::Wait, active_label);
                 const uint32_t target = static_cast<uint32_t>(threads.size());
                 while (threads_finished.load(std::memory_order_acquire) != target) {
                     internal::cpu_pause();
@@ -66,21 +89,52 @@ namespace april::exec {
         }
 
     private:
+        size_t spin_limit = 1;
+
         // synchronization signals
         alignas(assumed_cache_line_size) mutable std::atomic<uint32_t> run_signal{0}; // increment to wake up threads
         alignas(assumed_cache_line_size) mutable std::atomic<uint32_t> threads_finished{0}; // if == #threads we are done
+        alignas(assumed_cache_line_size) mutable std::atomic<uint32_t> parked{0}; // workers blocked in run_signal.wait
+
+        // converts a spin duration into pause iterations by timing the pause instruction once per process
+        static size_t calibrate_spin_iterations(const std::chrono::microseconds spin_time) {
+            static const double ns_per_pause = [] {
+                constexpr size_t samples = 4096;
+                const auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < samples; ++i) internal::cpu_pause();
+                const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                return std::max(elapsed.count() / samples, 0.1);
+            }();
+
+            const double iterations = static_cast<double>(std::chrono::nanoseconds(spin_time).count()) / ns_per_pause;
+            return std::clamp<size_t>(static_cast<size_t>(iterations), 16, size_t{1} << 24);
+        }
+
+        // spin for a bounded number of iterations (low wake-up latency), then park on the signal
+        uint32_t await_signal(const uint32_t local_signal) const {
+            for (size_t i = 0; i < spin_limit; ++i) {
+                const uint32_t signal = run_signal.load(std::memory_order_acquire);
+                if (signal != local_signal) return signal;
+                internal::cpu_pause();
+            }
+
+            parked.fetch_add(1, std::memory_order_seq_cst);
+            uint32_t signal;
+            while ((signal = run_signal.load(std::memory_order_seq_cst)) == local_signal) {
+                run_signal.wait(local_signal, std::memory_order_seq_cst);
+            }
+            parked.fetch_sub(1, std::memory_order_relaxed);
+            return signal;
+        }
 
         void worker_loop(const int thread_idx) {
             internal::ScopedThreadContext ctx(thread_idx);
             uint32_t local_signal = 0; // used to compare to atomic (global) run signal. Only if they differ we run
 
             while (true) {
-                // spin until signaled to start work again. If terminate signal received exit thread
-                while (run_signal.load(std::memory_order_acquire) == local_signal) {
-                    if (terminate.load(std::memory_order_relaxed)) return;
-                    internal::cpu_pause();
-                }
-                local_signal = run_signal.load(std::memory_order_relaxed);
+                // wait until signaled to start work again. If terminate signal received exit thread
+                local_signal = await_signal(local_signal);
+                if (terminate.load(std::memory_order_relaxed)) return;
 
                 // process tasks until queue empty. then signal completion.
                 process_tasks();
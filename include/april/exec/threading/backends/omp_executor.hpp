@@ -6,6 +6,7 @@
 #include "april/exec/policy.hpp"
 #include "april/exec/threading/executor_concepts.hpp"
 #include "april/exec/threading/threading_context.hpp"
+#include "april/exec/threading/trace.hpp"
 
 namespace april::exec {
     struct OmpExecutor {
@@ -28,6 +29,13 @@ namespace april::exec {
                     task(i);
                 }
             } else {
+                if constexpr (trace::compiled_in) {
+                    if (trace::enabled()) {
+                        execute_traced(batch_count, task);
+                        return;
+                    }
+                }
+
                 #pragma omp parallel num_threads(n_threads)
                 {
                     internal::ScopedThreadContext ctx(omp_get_thread_num());
@@ -46,5 +54,47 @@ namespace april::exec {
 
     private:
         unsigned n_threads;
+
+        // guided scheduling hides its chunks, so runs of consecutive indices on a thread are recorded as chunks
+        template<IsIndexedWork F>
+        void execute_traced(const size_t batch_count, F& task) const {
+            const trace::Label label = trace::current_label();
+            const uint64_t execute_begin = trace::now_ns();
+
+            #pragma omp parallel num_threads(n_threads)
+            {
+                internal::ScopedThreadContext ctx(omp_get_thread_num());
+                trace::Event chunk{.label = label, .kind = trace::EventKind::Chunk};
+                bool open = false;
+
+                #pragma omp for schedule(guided) nowait
+                for (int i = 0; i < static_cast<int>(batch_count); ++i) {
+                    if (!open || chunk.last != static_cast<uint32_t>(i)) {
+                        if (open) {
+                            chunk.end_ns = trace::now_ns();
+                            trace::record(chunk);
+                        }
+                        chunk.first = static_cast<uint32_t>(i);
+                        chunk.begin_ns = trace::now_ns();
+                        open = true;
+                    }
+                    task(i);
+                    chunk.last = static_cast<uint32_t>(i) + 1;
+                }
+
+                if (open) {
+                    chunk.end_ns = trace::now_ns();
+                    trace::record(chunk);
+                }
+
+                const trace::ExecutorSpan wait(trace::EventKind::Wait, label);
+                #pragma omp barrier
+            }
+
+            trace::record({
+                .begin_ns = execute_begin, .end_ns = trace::now_ns(), .label = label,
+                .first = static_cast<uint32_t>(batch_count), .kind = trace::EventKind::Execute
+            });
+        }
     };
 }
\ No newline at end of file
@@ -56,14 +56,16 @@ namespace april::exec {
     };
 
 
-    // partition a linear index range into an exact number of blocks
-    [[nodiscard]] inline std::vector<math::Range> make_linear_schedule(
+    // partition a linear index range into an exact number of blocks, written into a reusable buffer
+    inline void make_linear_schedule(
         const math::Range& range,
         const size_t B,
-        const size_t alignment)
+        const size_t alignment,
+        std::vector<math::Range>& blocks)
     {
         if (range.empty() || B == 0) {
-            return std::vector<math::Range>(std::max<size_t>(1, B), {range.start, range.start});
+            blocks.assign(std::max<size_t>(1, B), {range.start, range.start});
+            return;
         }
 
         const size_t total_elements = range.size();
@@ -72,7 +74,7 @@ namespace april::exec {
         const size_t vectors_per_block = total_packed / B;
         const size_t remainder_vectors = total_packed % B;
 
-        std::vector<math::Range> blocks(B);
+        blocks.resize(B);
         size_t current = range.start;
 
         for (size_t i = 0; i < B; ++i) {
@@ -87,27 +89,49 @@ namespace april::exec {
             blocks[i] = {current, current + size};
             current += size;
         }
-
-        return blocks;
     }
 
-    // partition a linear index range using block configuration heuristics
-    [[nodiscard]] std::vector<math::Range> make_linear_schedule(
+    // partition a linear index range using block configuration heuristics, written into a reusable buffer
+    void make_linear_schedule(
         const math::Range& range,
-        IsBlockConfig auto const& config)
+        IsBlockConfig auto const& config,
+        std::vector<math::Range>& blocks)
     {
         const size_t total_elements = range.size();
         if (total_elements == 0) {
-            return {{range.start, range.start}};
+            blocks.assign(1, {range.start, range.start});
+            return;
         }
 
         const size_t B = config.calculate_num_blocks(total_elements);
 
         if (B <= 1) {
-            return {range};
+            blocks.assign(1, range);
+            return;
         }
 
-        return make_linear_schedule(range, B, config.alignment);
+        make_linear_schedule(range, B, config.alignment, blocks);
+    }
+
+    // partition a linear index range into an exact number of blocks
+    [[nodiscard]] inline std::vector<math::Range> make_linear_schedule(
+        const math::Range& range,
+        const size_t B,
+        const size_t alignment)
+    {
+        std::vector<math::Range> blocks;
+        make_linear_schedule(range, B, alignment, blocks);
+        return blocks;
+    }
+
+    // partition a linear index range using block configuration heuristics
+    [[nodiscard]] std::vector<math::Range> make_linear_schedule(
+        const math::Range& range,
+        IsBlockConfig auto const& config)
+    {
+        std::vector<math::Range> blocks;
+        make_linear_schedule(range, config, blocks);
+        return blocks;
     }
 
 
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "april/exec/hardware.hpp"
+#include "april/exec/policy.hpp"
+#include "april/exec/threading/backends/internal/native_executor_base.hpp"
+#include "april/utility/debug.hpp"
+
+
+namespace april::exec {
+
+    enum class Access : uint8_t {
+        Read,
+        Write
+    };
+
+    /**
+     * @brief Dependency-driven schedule of parallel tasks.
+     *
+     * Tasks are grouped into stages and declare the resources (e.g. cells) they read and write.
+     * compile() derives a dependency DAG from these declarations with sequential semantics: a task only
+     * waits for earlier tasks (in stage, then task order) it conflicts with (write-write, read-write or
+     * write-read on the same resource). run() executes the whole graph inside a single executor region,
+     * so independent tasks of consecutive stages overlap instead of being separated by a barrier.
+     *
+     * The structure is meant to be built once and run many times. run() must not be called concurrently
+     * on the same graph. Currently only the pair force phases of LinkedCells are run through a graph.
+     */
+    class TaskGraph {
+    public:
+        using ResourceKey = uint64_t;
+
+        void clear() {
+            stage_offsets.assign(1, 0);
+            task_stage.clear();
+            accesses.clear();
+            successor_offsets.clear();
+            successors.clear();
+            in_degree.clear();
+            roots.clear();
+            compiled = false;
+        }
+
+        // appends a stage of n independent tasks and returns its index
+        size_t add_stage(const size_t n_tasks) {
+            const size_t stage = num_stages();
+            const size_t first = stage_offsets.back();
+
+            stage_offsets.push_back(first + n_tasks);
+            task_stage.resize(first + n_tasks, static_cast<uint32_t>(stage));
+            accesses.resize(first + n_tasks);
+            compiled = false;
+            return stage;
+        }
+
+        void access(const size_t stage, const size_t task, const ResourceKey key, const Access mode) {
+            APRIL_ASSERT(stage < num_stages() && task < stage_offsets[stage + 1] - stage_offsets[stage],
+                "[APRIL] TaskGraph: task out of range");
+            accesses[stage_offsets[stage] + task].emplace_back(key, mode);
+            compiled = false;
+        }
+
+        void reads(const size_t stage, const size_t task, const ResourceKey key) { access(stage, task, key, Access::Read); }
+        void writes(const size_t stage, const size_t task, const ResourceKey key) { access(stage, task, key, Access::Write); }
+
+        // derive the dependency edges from the declared accesses
+        void compile() {
+            constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+            struct ResourceState {
+                uint32_t last_writer = none;
+                std::vector<uint32_t> readers; // readers since the last write
+            };
+
+            const size_t n = num_tasks();
+            std::unordered_map<ResourceKey, ResourceState> resources;
+            std::vector<std::vector<uint32_t>> predecessors(n);
+
+            for (uint32_t t = 0; t < n; ++t) {
+                auto& preds = predecessors[t];
+
+                for (const auto& [key, mode] : accesses[t]) {
+                    auto& res = resources[key];
+
+                    if (res.last_writer != none && res.last_writer != t) {
+                        preds.push_back(res.last_writer);
+                    }
+
+                    if (mode == Access::Read) {
+                        res.readers.push_back(t);
+                    } else {
+                        for (const uint32_t r : res.readers) {
+                            if (r != t) preds.push_back(r);
+                        }
+                        res.readers.clear();
+                        res.last_writer = t;
+                    }
+                }
+
+                std::ranges::sort(preds);
+                preds.erase(std::ranges::unique(preds).begin(), preds.end());
+            }
+
+            // invert into a CSR successor list
+            successor_offsets.assign(n + 1, 0);
+            in_degree.assign(n, 0);
+            for (uint32_t t = 0; t < n; ++t) {
+                in_degree[t] = static_cast<uint32_t>(predecessors[t].size());
+                for (const uint32_t p : predecessors[t]) successor_offsets[p + 1]++;
+            }
+            for (size_t t = 0; t < n; ++t) successor_offsets[t + 1] += successor_offsets[t];
+
+            successors.resize(successor_offsets[n]);
+            std::vector<uint32_t> fill(successor_offsets.begin(), successor_offsets.end() - 1);
+            for (uint32_t t = 0; t < n; ++t) {
+                for (const uint32_t p : predecessors[t]) successors[fill[p]++] = t;
+            }
+
+            roots.clear();
+            for (uint32_t t = 0; t < n; ++t) {
+                if (in_degree[t] == 0) roots.push_back(t);
+            }
+
+            compiled = true;
+        }
+
+        [[nodiscard]] size_t num_stages() const noexcept { return stage_offsets.size() - 1; }
+        [[nodiscard]] size_t num_tasks() const noexcept { return stage_offsets.back(); }
+        [[nodiscard]] size_t num_edges() const noexcept { return successors.size(); }
+        [[nodiscard]] bool empty() const noexcept { return num_tasks() == 0; }
+
+        /**
+         * @brief Executes every task as body(stage, task) once all of its dependencies have finished.
+         *
+         * With ParallelPolicy::Serial the tasks run in declaration order, which is a valid topological order.
+         */
+        template<ParallelPolicy P = ParallelPolicy::Threaded, typename Executor, typename F>
+        void run(const Executor& executor, F&& body) const {
+            if (!compiled) {
+                throw std::logic_error("[APRIL] TaskGraph: run() called before compile()");
+            }
+
+            const size_t n = num_tasks();
+            if (n == 0) return;
+
+            if constexpr (P == ParallelPolicy::Serial) {
+                for (size_t t = 0; t < n; ++t) {
+                    const uint32_t stage = task_stage[t];
+                    body(static_cast<size_t>(stage), t - stage_offsets[stage]);
+                }
+            } else {
+                auto& rt = runtime.get(n);
+
+                for (size_t t = 0; t < n; ++t) {
+                    rt.pending[t].store(in_degree[t], std::memory_order_relaxed);
+                    rt.ready[t].store(empty_slot, std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < roots.size(); ++i) {
+                    rt.ready[i].store(roots[i], std::memory_order_relaxed);
+                }
+                rt.head.store(0, std::memory_order_relaxed);
+                rt.tail.store(roots.size(), std::memory_order_relaxed);
+
+                // every participating thread claims ready tasks until all tasks are claimed
+                executor.template execute<P>(executor.num_threads(), [&](size_t) {
+                    while (true) {
+                        size_t h = rt.head.load(std::memory_order_acquire);
+                        if (h >= n) return;
+
+                        if (h >= rt.tail.load(std::memory_order_acquire)) {
+                            internal::cpu_pause(); // nothing ready yet, wait for a predecessor to finish
+                            continue;
+                        }
+                        if (!rt.head.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel)) continue;
+
+                        // the slot is reserved before it is published
+                        uint32_t t;
+                        while ((t = rt.ready[h].load(std::memory_order_acquire)) == empty_slot) {
+                            internal::cpu_pause();
+                        }
+
+                        const uint32_t stage = task_stage[t];
+                        body(static_cast<size_t>(stage), t - stage_offsets[stage]);
+
+                        for (uint32_t s = successor_offsets[t]; s < successor_offsets[t + 1]; ++s) {
+                            const uint32_t succ = successors[s];
+                            if (rt.pending[succ].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                                const size_t slot = rt.tail.fetch_add(1, std::memory_order_acq_rel);
+                                rt.ready[slot].store(succ, std::memory_order_release);
+                            }
+                        }
+                    }
+                });
+            }
+        }
+
+    private:
+        static constexpr uint32_t empty_slot = std::numeric_limits<uint32_t>::max();
+
+        struct RuntimeState {
+            size_t capacity = 0;
+            std::unique_ptr<std::atomic<uint32_t>[]> pending;
+            std::unique_ptr<std::atomic<uint32_t>[]> ready; // task ids in the order they became ready
+            alignas(assumed_cache_line_size) std::atomic<size_t> head{0}; // next ready slot to claim
+            alignas(assumed_cache_line_size) std::atomic<size_t> tail{0}; // next ready slot to publish
+        };
+
+        // per-run scratch state; not part of the graph's value (copies start with fresh state)
+        struct Runtime {
+            std::unique_ptr<RuntimeState> state;
+
+            Runtime() = default;
+            Runtime(const Runtime&) {}
+            Runtime& operator=(const Runtime&) { return *this; }
+            Runtime(Runtime&&) noexcept = default;
+            Runtime& operator=(Runtime&&) noexcept = default;
+
+            RuntimeState& get(const size_t n) {
+                if (!state) state = std::make_unique<RuntimeState>();
+                if (state->capacity < n) {
+                    state->pending = std::make_unique<std::atomic<uint32_t>[]>(n);
+                    state->ready = std::make_unique<std::atomic<uint32_t>[]>(n);
+                    state->capacity = n;
+                }
+                return *state;
+            }
+        };
+
+        std::vector<size_t> stage_offsets{0};  // first task of every stage (plus end sentinel)
+        std::vector<uint32_t> task_stage;      // stage of every task
+        std::vector<std::vector<std::pair<ResourceKey, Access>>> accesses;
+
+        std::vector<uint32_t> successor_offsets;
+        std::vector<uint32_t> successors;
+        std::vector<uint32_t> in_degree;
+        std::vector<uint32_t> roots;
+        bool compiled = false;
+
+        mutable Runtime runtime;
+    };
+
+} // namespace april::exec
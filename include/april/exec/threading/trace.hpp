@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "april/exec/hardware.hpp"
+#include "april/exec/threading/threading_context.hpp"
+
+/*
+ * Executor timeline tracing. Every thread appends begin/end timestamps to its own ring buffer (single writer,
+ * no locks on the recording path) and the rings are exported as Chrome trace-event JSON, viewable in
+ * chrome://tracing or Perfetto. The executor hooks (execute, fetched chunks, barrier waits) are only compiled
+ * in with APRIL_ENABLE_EXECUTOR_TRACE=1; tracing additionally has to be switched on at runtime with enable().
+ */
+
+#ifndef APRIL_ENABLE_EXECUTOR_TRACE
+    #define APRIL_ENABLE_EXECUTOR_TRACE 0
+#endif
+
+namespace april::exec::trace {
+
+    inline constexpr bool compiled_in = APRIL_ENABLE_EXECUTOR_TRACE;
+
+    // caller attached name of a dispatch, e.g. {"pair phase", 3}. name must outlive the trace (string literal)
+    struct Label {
+        static constexpr uint32_t no_index = UINT32_MAX;
+
+        const char* name = nullptr;
+        uint32_t index = no_index;
+    };
+
+    enum class EventKind : uint8_t {
+        Execute, // one execute() call, recorded by the dispatching thread
+        Chunk,   // one fetched range of tasks [first, last)
+        Wait     // time spent waiting for the other threads at the end of a dispatch
+    };
+
+    struct Event {
+        uint64_t begin_ns = 0;
+        uint64_t end_ns = 0;
+        Label label;
+        uint32_t first = 0; // chunk: first task, execute: number of tasks
+        uint32_t last = 0;  // chunk: one past the last task
+        EventKind kind = EventKind::Execute;
+    };
+
+
+    /**
+     * @brief Fixed size event ring owned by one thread.
+     *
+     * Only the owning thread pushes; once full the oldest events are overwritten. Snapshots are meant to be
+     * taken while the executors are idle (e.g. after a run), the ring does not guard against a concurrent writer.
+     */
+    class ThreadRing {
+    public:
+        ThreadRing(const size_t capacity, const int thread_idx)
+            : events(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(events.size() - 1), thread_idx(thread_idx) {}
+
+        void push(const Event& event) noexcept {
+            const uint64_t h = head.load(std::memory_order_relaxed);
+            events[h & mask] = event;
+            head.store(h + 1, std::memory_order_release);
+        }
+
+        // appends the retained events, oldest first
+        void snapshot(std::vector<Event>& out) const {
+            const uint64_t h = head.load(std::memory_order_acquire);
+            const uint64_t n = std::min<uint64_t>(h, events.size());
+            for (uint64_t i = h - n; i < h; ++i) out.push_back(events[i & mask]);
+        }
+
+        // events lost to overwriting since the last clear
+        [[nodiscard]] uint64_t dropped() const noexcept {
+            const uint64_t h = head.load(std::memory_order_acquire);
+            return h > events.size() ? h - events.size() : 0;
+        }
+
+        void clear() noexcept { head.store(0, std::memory_order_release); }
+
+        // executor thread index at the first recorded event (-1 outside of an executor)
+        [[nodiscard]] int thread_index() const noexcept { return thread_idx; }
+
+    private:
+        std::vector<Event> events;
+        uint64_t mask;
+        int thread_idx;
+        alignas(assumed_cache_line_size) std::atomic<uint64_t> head{0};
+    };
+
+
+    namespace internal {
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadRing>> rings; // kept alive after their threads exit
+            std::atomic<bool> active{false};
+            size_t capacity = size_t{1} << 16;
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        inline Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        inline thread_local Label current_label;
+
+        // registers the calling thread's ring on first use (the only locking on the recording path)
+        inline ThreadRing& local_ring() {
+            thread_local std::shared_ptr<ThreadRing> ring = [] {
+                Registry& r = registry();
+                std::scoped_lock lock(r.mutex);
+                auto created = std::make_shared<ThreadRing>(r.capacity, thread_index_direct());
+                r.rings.push_back(created);
+                return created;
+            }();
+            return *ring;
+        }
+
+        // trace-event timestamps are microseconds; printed with fixed ns resolution
+        inline std::string microseconds(const uint64_t ns) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+            return buffer;
+        }
+
+        inline void write_json_string(std::ostream& os, const std::string_view s) {
+            os << '"';
+            for (const char c : s) {
+                if (c == '"' || c == '\\') os << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20) os << ' ';
+                else os << c;
+            }
+            os << '"';
+        }
+    } // namespace internal
+
+
+    // switches recording on or off. events_per_thread applies to threads that record for the first time
+    inline void enable(const bool on = true, const size_t events_per_thread = size_t{1} << 16) {
+        internal::Registry& r = internal::registry();
+        {
+            std::scoped_lock lock(r.mutex);
+            r.capacity = events_per_thread;
+        }
+        r.active.store(on, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] inline bool enabled() noexcept {
+        return internal::registry().active.load(std::memory_order_relaxed);
+    }
+
+    // nanoseconds since the trace epoch (first use of the tracer in this process)
+    [[nodiscard]] inline uint64_t now_ns() noexcept {
+        const auto elapsed = std::chrono::steady_clock::now() - internal::registry().epoch;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    // label attached by the calling thread to the dispatches it starts
+    [[nodiscard]] inline Label current_label() noexcept {
+        return internal::current_label;
+    }
+
+    // replaces the calling thread's label and returns the previous one
+    inline Label exchange_label(const Label label) noexcept {
+        const Label previous = internal::current_label;
+        internal::current_label = label;
+        return previous;
+    }
+
+    inline void record(const Event& event) {
+        if (!enabled()) return;
+        internal::local_ring().push(event);
+    }
+
+    // drops all recorded events and the rings of threads that have exited (live rings keep their capacity)
+    inline void clear() {
+        internal::Registry& r = internal::registry();
+        std::scoped_lock lock(r.mutex);
+        std::erase_if(r.rings, [](const auto& ring) { return ring.use_count() == 1; });
+        for (const auto& ring : r.rings) ring->clear();
+    }
+
+    // number of events lost because a ring overflowed
+    [[nodiscard]] inline uint64_t dropped_events() {
+        internal::Registry& r = internal::registry();
+        std::scoped_lock lock(r.mutex);
+        uint64_t dropped = 0;
+        for (const auto& ring : r.rings) dropped += ring->dropped();
+        return dropped;
+    }
+
+
+    /**
+     * @brief Writes all rings as Chrome trace-event JSON (complete "X" events, one track per recording thread).
+     *
+     * Call while no executor is running.
+     */
+    inline void write_chrome_json(std::ostream& os) {
+        internal::Registry& r = internal::registry();
+        std::scoped_lock lock(r.mutex);
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first_event = true;
+        auto separator = [&] {
+            if (!first_event) os << ",";
+            os << "\n";
+            first_event = false;
+        };
+
+        std::vector<Event> events;
+        for (size_t tid = 0; tid < r.rings.size(); ++tid) {
+            const ThreadRing& ring = *r.rings[tid];
+            const int thread_idx = ring.thread_index();
+
+            separator();
+            os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid << ",\"args\":{\"name\":";
+            internal::write_json_string(os, thread_idx < 0 ? "thread (no executor)" : "executor thread " + std::to_string(thread_idx));
+            os << "}}";
+
+            separator();
+            os << "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+               << ",\"args\":{\"sort_index\":" << (thread_idx < 0 ? 0 : thread_idx + 1) << "}}";
+
+            events.clear();
+            ring.snapshot(events);
+
+            for (const Event& e : events) {
+                std::string name;
+                if (e.label.name) {
+                    name = e.label.name;
+                    if (e.label.index != Label::no_index) name += " " + std::to_string(e.label.index);
+                } else {
+                    name = e.kind == EventKind::Execute ? "execute" : "tasks";
+                }
+                if (e.kind == EventKind::Wait) name = "wait: " + name;
+
+                constexpr const char* categories[] = {"execute", "chunk", "wait"};
+
+                separator();
+                os << "{\"name\":";
+                internal::write_json_string(os, name);
+                os << ",\"cat\":\"" << categories[static_cast<size_t>(e.kind)] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+                   << ",\"ts\":" << internal::microseconds(e.begin_ns)
+                   << ",\"dur\":" << internal::microseconds(e.end_ns - e.begin_ns);
+
+                if (e.kind == EventKind::Execute) os << ",\"args\":{\"tasks\":" << e.first << "}";
+                if (e.kind == EventKind::Chunk) os << ",\"args\":{\"first\":" << e.first << ",\"last\":" << e.last << "}";
+                os << "}";
+            }
+        }
+        os << "\n]}\n";
+    }
+
+    inline void save_chrome_json(const std::string& path) {
+        std::ofstream file(path);
+        if (!file) throw std::runtime_error("[APRIL] Could not open trace file " + path);
+        write_chrome_json(file);
+    }
+
+
+    // records one event spanning the scope if tracing is enabled. The first span of a thread registers its ring,
+    // which allocates (and may throw), so the constructor is not noexcept; later spans do not allocate.
+    class Span {
+    public:
+        Span(const EventKind kind, const Label label, const size_t first = 0, const size_t last = 0) {
+            if (!enabled()) return;
+            ring = &internal::local_ring(); // resolved before the begin timestamp, registration stays out of the span
+            event.kind = kind;
+            event.label = label;
+            event.first = static_cast<uint32_t>(first);
+            event.last = static_cast<uint32_t>(last);
+            event.begin_ns = now_ns();
+        }
+
+        ~Span() {
+            if (!ring) return;
+            event.end_ns = now_ns();
+            ring->push(event);
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        Event event;
+        ThreadRing* ring = nullptr; // null while tracing is off
+    };
+
+    // attaches a label to the dispatches started by this thread within the scope
+    class ScopedLabel {
+    public:
+        explicit ScopedLabel(const char* name, const uint32_t index = Label::no_index) noexcept {
+            if constexpr (compiled_in) {
+                previous = exchange_label({name, index});
+            } else {
+                (void)name; (void)index;
+            }
+        }
+
+        ~ScopedLabel() {
+            if constexpr (compiled_in) exchange_label(previous);
+        }
+
+        ScopedLabel(const ScopedLabel&) = delete;
+        ScopedLabel& operator=(const ScopedLabel&) = delete;
+
+    private:
+        Label previous;
+    };
+
+
+    namespace internal {
+        struct NullSpan {
+            NullSpan(EventKind, Label, size_t = 0, size_t = 0) noexcept {}
+        };
+    }
+
+    // span used by the executor hooks: compiles to nothing unless APRIL_ENABLE_EXECUTOR_TRACE is set
+    using ExecutorSpan = std::conditional_t<compiled_in, Span, internal::NullSpan>;
+
+} // namespace april::exec::trace
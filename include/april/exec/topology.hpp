@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace april::exec {
+
+    struct LogicalCpu {
+        int cpu;     // operating system cpu index (used for pinning)
+        int core;    // physical core id (unique within a package)
+        int package; // socket id
+        int node;    // NUMA node id
+    };
+
+    /**
+     * @brief Processor topology: logical cpus grouped into physical cores, packages and NUMA nodes.
+     *
+     * On Linux the topology is read from /sys/devices/system/cpu and /sys/devices/system/node.
+     * On other platforms, or if sysfs is unavailable, every logical cpu is reported as its own
+     * core on package 0 and node 0.
+     */
+    struct CpuTopology {
+        std::vector<LogicalCpu> cpus; // sorted by cpu index
+
+        [[nodiscard]] size_t num_cpus() const noexcept { return cpus.size(); }
+
+        [[nodiscard]] size_t num_nodes() const {
+            std::vector<int> nodes;
+            for (const auto& c : cpus) nodes.push_back(c.node);
+            std::ranges::sort(nodes);
+            return static_cast<size_t>(std::ranges::distance(nodes.begin(), std::ranges::unique(nodes).begin()));
+        }
+
+        [[nodiscard]] size_t num_cores() const {
+            std::vector<std::pair<int, int>> cores;
+            for (const auto& c : cpus) cores.emplace_back(c.package, c.core);
+            std::ranges::sort(cores);
+            return static_cast<size_t>(std::ranges::distance(cores.begin(), std::ranges::unique(cores).begin()));
+        }
+
+        // NUMA node of an operating system cpu index (0 if unknown)
+        [[nodiscard]] int node_of(const int cpu) const noexcept {
+            for (const auto& c : cpus) {
+                if (c.cpu == cpu) return c.node;
+            }
+            return 0;
+        }
+
+        [[nodiscard]] static CpuTopology discover();
+
+        // topology of the running machine, discovered once
+        [[nodiscard]] static const CpuTopology& system() {
+            static const CpuTopology topology = discover();
+            return topology;
+        }
+    };
+
+
+    /**
+     * @brief Strategy for mapping executor threads (index 0 = calling thread) to logical cpus.
+     */
+    enum class PinningPolicy : uint8_t {
+        None,    ///< Threads are not pinned.
+        Linear,  ///< Thread i runs on logical cpu i.
+        Compact, ///< Fill a NUMA node, including SMT siblings of each core, before moving to the next.
+        Scatter, ///< Distribute threads round-robin over NUMA nodes (physical cores before SMT siblings).
+        SkipSMT  ///< One thread per physical core (node by node) before any SMT sibling is used.
+    };
+
+
+    namespace internal {
+
+        // parses a sysfs cpu list such as "0-3,8,10-11"
+        [[nodiscard]] inline std::vector<int> parse_cpu_list(const std::string& list) {
+            std::vector<int> ret;
+            size_t pos = 0;
+
+            while (pos < list.size()) {
+                size_t end = list.find(',', pos);
+                if (end == std::string::npos) end = list.size();
+
+                const std::string item = list.substr(pos, end - pos);
+                const size_t dash = item.find('-');
+
+                try {
+                    if (dash == std::string::npos) {
+                        if (!item.empty() && item != "\n") ret.push_back(std::stoi(item));
+                    } else {
+                        const int first = std::stoi(item.substr(0, dash));
+                        const int last = std::stoi(item.substr(dash + 1));
+                        for (int c = first; c <= last; ++c) ret.push_back(c);
+                    }
+                } catch (const std::exception&) {
+                    // malformed entries are ignored
+                }
+
+                pos = end + 1;
+            }
+
+            return ret;
+        }
+
+        [[nodiscard]] inline bool read_line(const std::filesystem::path& path, std::string& out) {
+            std::ifstream file(path);
+            return static_cast<bool>(std::getline(file, out));
+        }
+
+        [[nodiscard]] inline int read_int(const std::filesystem::path& path, const int fallback) {
+            std::string line;
+            if (!read_line(path, line)) return fallback;
+            try {
+                return std::stoi(line);
+            } catch (const std::exception&) {
+                return fallback;
+            }
+        }
+
+        [[nodiscard]] inline CpuTopology flat_topology(const size_t n_cpus) {
+            CpuTopology topology;
+            for (size_t i = 0; i < n_cpus; ++i) {
+                const int c = static_cast<int>(i);
+                topology.cpus.push_back({c, c, 0, 0});
+            }
+            return topology;
+        }
+
+        // position of every cpu among the SMT siblings of its physical core (0 for the first sibling)
+        [[nodiscard]] inline std::vector<int> smt_ranks(const CpuTopology& topology) {
+            std::map<std::pair<int, int>, int> seen;
+            std::vector<int> ranks;
+            ranks.reserve(topology.cpus.size());
+            for (const auto& c : topology.cpus) {
+                ranks.push_back(seen[{c.package, c.core}]++);
+            }
+            return ranks;
+        }
+
+        /**
+         * @brief Computes the logical cpu of every executor thread for a pinning policy.
+         *
+         * Returns an empty plan for PinningPolicy::None. Thread counts beyond the number of
+         * logical cpus wrap around.
+         */
+        [[nodiscard]] inline std::vector<int> make_pinning_plan(
+            const CpuTopology& topology,
+            const PinningPolicy policy,
+            const size_t n_threads)
+        {
+            if (policy == PinningPolicy::None || topology.cpus.empty()) return {};
+
+            const auto ranks = smt_ranks(topology);
+            std::vector<size_t> order(topology.cpus.size());
+            for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+
+            auto key_compact = [&](const size_t i) {
+                const auto& c = topology.cpus[i];
+                return std::tuple{c.node, c.package, c.core, ranks[i], c.cpu};
+            };
+            auto key_skip_smt = [&](const size_t i) {
+                const auto& c = topology.cpus[i];
+                return std::tuple{ranks[i], c.node, c.package, c.core, c.cpu};
+            };
+
+            std::vector<int> plan(n_threads);
+
+            switch (policy) {
+                case PinningPolicy::Linear:
+                    break;
+                case PinningPolicy::Compact:
+                    std::ranges::sort(order, {}, key_compact);
+                    break;
+                case PinningPolicy::SkipSMT:
+                    std::ranges::sort(order, {}, key_skip_smt);
+                    break;
+                case PinningPolicy::Scatter: {
+                    // per node lists (physical cores first), visited round-robin
+                    std::ranges::sort(order, {}, key_skip_smt);
+                    std::map<int, std::vector<size_t>> per_node;
+                    for (const size_t i : order) per_node[topology.cpus[i].node].push_back(i);
+
+                    std::vector<size_t> interleaved;
+                    interleaved.reserve(order.size());
+                    for (size_t k = 0; interleaved.size() < order.size(); ++k) {
+                        for (const auto& [node, list] : per_node) {
+                            if (k < list.size()) interleaved.push_back(list[k]);
+                        }
+                    }
+                    order = std::move(interleaved);
+                    break;
+                }
+                case PinningPolicy::None:
+                    return {};
+            }
+
+            for (size_t t = 0; t < n_threads; ++t) {
+                plan[t] = topology.cpus[order[t % order.size()]].cpu;
+            }
+            return plan;
+        }
+    }
+
+
+    inline CpuTopology CpuTopology::discover() {
+        const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+
+    #if defined(__linux__)
+        namespace fs = std::filesystem;
+        const fs::path cpu_root = "/sys/devices/system/cpu";
+        const fs::path node_root = "/sys/devices/system/node";
+
+        std::string online;
+        if (!internal::read_line(cpu_root / "online", online)) {
+            return internal::flat_topology(hw);
+        }
+
+        CpuTopology topology;
+        for (const int cpu : internal::parse_cpu_list(online)) {
+            const fs::path topo = cpu_root / ("cpu" + std::to_string(cpu)) / "topology";
+            topology.cpus.push_back({
+                cpu,
+                internal::read_int(topo / "core_id", cpu),
+                internal::read_int(topo / "physical_package_id", 0),
+                0
+            });
+        }
+
+        // NUMA nodes list their cpus; kernels without NUMA support have no node directory
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(node_root, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (!name.starts_with("node") || name.size() == 4) continue;
+            if (!std::all_of(name.begin() + 4, name.end(), [](const char ch) { return ch >= '0' && ch <= '9'; })) continue;
+
+            const int node = std::stoi(name.substr(4));
+            std::string list;
+            if (!internal::read_line(entry.path() / "cpulist", list)) continue;
+
+            for (const int cpu : internal::parse_cpu_list(list)) {
+                for (auto& c : topology.cpus) {
+                    if (c.cpu == cpu) c.node = node;
+                }
+            }
+        }
+
+        if (topology.cpus.empty()) {
+            return internal::flat_topology(hw);
+        }
+
+        std::ranges::sort(topology.cpus, {}, &LogicalCpu::cpu);
+        return topology;
+    #else
+        return internal::flat_topology(hw);
+    #endif
+    }
+
+} // namespace april::exec
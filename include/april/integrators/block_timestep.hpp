@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "april/integrators/integrator.hpp"
+#include "april/core/system.hpp"
+
+#include "april/monitors/monitor.hpp"
+
+namespace april {
+
+	/**
+	 * @brief Hierarchical block time step integrator (KDK leapfrog with power-of-two time bins).
+	 *
+	 * Every particle is assigned a level l in [0, max_level] and advances with the step dt / 2^l.
+	 * Levels are chosen from the acceleration criterion sqrt(2 eta eps / |a|) (if a length scale
+	 * eps is set) and the jerk criterion eta |a| / |da/dt|, where the jerk is estimated from the
+	 * change of acceleration over the particle's previous step. A particle may move to a finer
+	 * level at the end of any of its steps, and to a coarser level only where that level's step
+	 * boundary coincides with the current time.
+	 *
+	 * On each substep all particles are drifted, but forces are recomputed and kicks applied only
+	 * for particles whose step ends there (System::update_forces_on). All particles are
+	 * synchronized at the end of every outer step dt. Only type-pair interactions are supported,
+	 * and boundaries must not wrap forces (periodic images are not seen by the targeted updates).
+	 */
+	template <core::IsSystem Sys, monitor::internal::IsMonitorPack Monitors>
+	class BlockTimestep : public integrator::Integrator<Sys, Monitors> {
+	public:
+		using State = ParticleState;
+		using Base = integrator::Integrator<Sys, Monitors>;
+		using Base::dt;
+		using Base::sys;
+		using Base::Base;
+
+		static constexpr ParticleField drift_fields =
+			ParticleField::state | ParticleField::velocity | ParticleField::position | ParticleField::old_position;
+
+		static constexpr ParticleField kick_fields =
+			ParticleField::id | ParticleField::state | ParticleField::velocity | ParticleField::force | ParticleField::mass;
+
+		void set_max_level(const size_t levels) {
+			if (levels > 30) {
+				throw std::invalid_argument("block time step hierarchy supports at most 30 levels");
+			}
+			max_level = levels;
+		}
+
+		void set_accuracy(const double eta) {
+			if (eta <= 0) {
+				throw std::invalid_argument("time step accuracy parameter must be positive");
+			}
+			accuracy = eta;
+		}
+
+		void set_length_scale(const double eps) {
+			length_scale = eps;
+		}
+
+		auto&& with_max_level(this auto&& self, const size_t levels) {
+			self.set_max_level(levels);
+			return self;
+		}
+
+		auto&& with_accuracy(this auto&& self, const double eta) {
+			self.set_accuracy(eta);
+			return self;
+		}
+
+		auto&& with_length_scale(this auto&& self, const double eps) {
+			self.set_length_scale(eps);
+			return self;
+		}
+
+		/// Returns the current time bin of a particle (0 = coarsest, step dt).
+		[[nodiscard]] size_t level_of(const ParticleID id) const {
+			return id < levels.size() ? levels[id] : 0;
+		}
+
+		// called by run() before the first step
+		void begin_run() {
+			if (sys.wraps_forces()) {
+				throw std::invalid_argument("block time steps do not support periodic boundaries");
+			}
+		}
+
+		void integration_step() {
+			const size_t n_ticks = size_t{1} << max_level;
+			const double tick = dt / static_cast<double>(n_ticks);
+
+			sys.update_all_components();
+			resize_state();
+
+			// every particle starts a step at the beginning of the outer step
+			std::ranges::fill(active, uint8_t{1});
+			kick_active(0, n_ticks, tick, false);
+
+			size_t t = 0;
+			while (t < n_ticks) {
+				const size_t step = step_ticks(*std::ranges::max_element(levels));
+				const double h = static_cast<double>(step) * tick;
+
+				{
+					const utility::StageScope stage(utility::Stage::Drift);
+					sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<drift_fields, drift_fields>(
+						[&](auto p) {
+							p.old_position = p.position;
+							p.position += h * p.velocity;
+						}
+					), State::MOVABLE);
+				}
+
+				sys.rebuild_structure();
+				sys.apply_boundary_conditions();
+
+				t += step;
+
+				collect_active(t);
+				sys.update_forces_on(targets, schedule);
+				kick_active(t, n_ticks, tick, true);
+			}
+
+			sys.apply_controllers();
+		}
+
+	private:
+		size_t max_level = 6;
+		double accuracy = 0.025;
+		double length_scale = 0; // acceleration criterion disabled if <= 0
+
+		// per particle state, indexed by particle id
+		std::vector<uint8_t> levels;
+		std::vector<uint8_t> active;
+		std::vector<vec3> acc_start; // acceleration at the start of the current step
+		std::vector<double> jerk; // |da/dt| estimated over the previous step (0 if unknown)
+
+		std::vector<size_t> targets;
+		std::vector<math::Range> schedule; // work partition of update_forces_on, reused every substep
+
+		[[nodiscard]] size_t step_ticks(const size_t level) const noexcept {
+			return size_t{1} << (max_level - level);
+		}
+
+		void resize_state() {
+			const size_t n = static_cast<size_t>(sys.max_id()) + 1;
+			if (levels.size() == n) {
+				for (auto& l : levels) l = static_cast<uint8_t>(std::min<size_t>(l, max_level));
+				return;
+			}
+
+			levels.assign(n, 0);
+			active.assign(n, 0);
+			acc_start.assign(n, vec3{});
+			jerk.assign(n, 0.0);
+		}
+
+		// marks every movable particle whose step ends at tick t and collects its current index
+		void collect_active(const size_t t) {
+			targets.clear();
+
+			for (ParticleID id = sys.min_id(); id <= sys.max_id(); ++id) {
+				active[id] = 0;
+				if (!sys.contains_id(id)) continue;
+				if (t % step_ticks(levels[id]) != 0) continue;
+				if (!has_any_of(sys.template view_id<ParticleField::state>(id).state, State::MOVABLE)) continue;
+
+				active[id] = 1;
+				targets.push_back(sys.id_to_index(id));
+			}
+		}
+
+		[[nodiscard]] size_t choose_level(const double acc, const double da, const size_t current, const size_t t) const {
+			double dt_i = std::numeric_limits<double>::infinity();
+			if (length_scale > 0 && acc > 0) dt_i = std::sqrt(2.0 * accuracy * length_scale / acc);
+			if (da > 0) dt_i = std::min(dt_i, accuracy * acc / da);
+
+			size_t level = 0;
+			while (level < max_level && dt / static_cast<double>(size_t{1} << level) > dt_i) {
+				++level;
+			}
+
+			// coarser levels must start on their own step boundary
+			while (level < current && t % step_ticks(level) != 0) {
+				++level;
+			}
+
+			return level;
+		}
+
+		// closes the finished step of every active particle (if closing) and opens its next one
+		void kick_active(const size_t t, const size_t n_ticks, const double tick, const bool closing) {
+			const utility::StageScope stage(utility::Stage::Kick);
+			sys.template for_each_particle<Sys::parallel_policy>(scalar_kernel<kick_fields, ParticleField::velocity>(
+				[&](auto p) {
+					const ParticleID id = p.id;
+					if (!active[id]) return;
+
+					const vec3 a = p.force / p.mass;
+
+					if (closing) {
+						const double h_old = static_cast<double>(step_ticks(levels[id])) * tick;
+						p.velocity += (h_old / 2.0) * a;
+						jerk[id] = (a - acc_start[id]).norm() / h_old;
+					}
+
+					if (t < n_ticks) {
+						const size_t level = choose_level(a.norm(), jerk[id], levels[id], t);
+						const double h_new = static_cast<double>(step_ticks(level)) * tick;
+
+						levels[id] = static_cast<uint8_t>(level);
+						acc_start[id] = a;
+						p.velocity += (h_new / 2.0) * a;
+					}
+				}
+			), State::MOVABLE);
+		}
+	};
+
+	// Deduction guide so user can write BlockTimestep(sys, MonitorPack<M1, M2, M3>)
+	template<core::IsSystem Sys, monitor::IsMonitor... Ms>
+	BlockTimestep(Sys&, monitor::internal::MonitorPack<Ms...>)
+		-> BlockTimestep<Sys, monitor::internal::MonitorPack<Ms...>>;
+
+	// Deduction guide so user can write BlockTimestep(sys, m1, m2, m3)
+	template<core::IsSystem Sys,typename ... Ms>
+	requires (monitor::IsMonitor<std::decay_t<Ms>> && ...)
+	BlockTimestep(Sys&, Ms...)
+		-> BlockTimestep<Sys, monitor::internal::MonitorPack<std::decay_t<Ms>...>>;
+}
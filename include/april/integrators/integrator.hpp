@@ -103,6 +103,11 @@ namespace april::integrator {
 
 			self.sys.update_forces(); // ensure valid force initialization
 
+			// integrators caching state between steps refresh it here, the system may have changed since the last run
+			if constexpr (requires { self.begin_run(); }) {
+				self.begin_run();
+			}
+
 			self.init_monitors();
 			self.dispatch_initialize_monitors();
 
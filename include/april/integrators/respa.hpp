@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "april/integrators/integrator.hpp"
+#include "april/core/system.hpp"
+
+#include "april/monitors/monitor.hpp"
+
+namespace april {
+
+	/**
+	 * @brief Multiple-time-step (r-RESPA) velocity Verlet integrator.
+	 *
+	 * Interactions of ForceGroup::fast are integrated with the inner step dt / inner_steps, while
+	 * ForceGroup::slow interactions and force fields are evaluated once per outer step dt and applied
+	 * as half kicks at its beginning and end. The group of each interaction is chosen when it is
+	 * registered (Environment::add_interaction); by default ID-pair and bonded interactions are fast
+	 * and type-pair interactions slow. The slow force of every particle is cached between steps and
+	 * recomputed at the start of every run. Between steps `force` holds the total force, as with the
+	 * single-step integrators.
+	 */
+	template <core::IsSystem Sys, monitor::internal::IsMonitorPack Monitors>
+	class Respa : public integrator::Integrator<Sys, Monitors> {
+	public:
+		using State = ParticleState;
+		using Base = integrator::Integrator<Sys, Monitors>;
+		using Base::dt;
+		using Base::sys;
+		using Base::Base;
+
+		static constexpr ParticleField drift_fields =
+			ParticleField::state | ParticleField::velocity | ParticleField::position | ParticleField::old_position;
+
+		static constexpr ParticleField kick_fields =
+			ParticleField::state | ParticleField::velocity | ParticleField::force | ParticleField::mass;
+
+		static constexpr ParticleField split_fields =
+			ParticleField::id | ParticleField::state | ParticleField::velocity | ParticleField::force | ParticleField::mass;
+
+		void set_inner_steps(const size_t steps) {
+			if (steps == 0) {
+				throw std::invalid_argument("RESPA requires at least one inner step per outer step");
+			}
+			inner_steps = steps;
+		}
+
+		auto&& with_inner_steps(this auto&& self, const size_t steps) {
+			self.set_inner_steps(steps);
+			return self;
+		}
+
+		// called by run() before the first step: particles, forces or fields may have changed since the last run
+		void begin_run() {
+			initialize_slow_forces();
+		}
+
+		void integration_step() {
+			const double h = dt / static_cast<double>(inner_steps);
+
+			sys.update_all_components();
+
+			// outer half kick with the slow force, inner half kick with the fast force (= total - slow)
+			kick_split(dt, h);
+
+			for (size_t i = 0; i < inner_steps; ++i) {
+				{
+					const utility::StageScope stage(utility::Stage::Drift);
+					sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<drift_fields, drift_fields>(
+						[&](auto p) {
+							p.old_position = p.position;
+							p.position += h * p.velocity;
+						}
+					), State::MOVABLE);
+				}
+
+				sys.rebuild_structure();
+				sys.apply_boundary_conditions();
+				sys.update_forces(ForceGroup::fast);
+
+				// closing half kick of this inner step merged with the opening half kick of the next
+				if (i + 1 < inner_steps) {
+					const utility::StageScope stage(utility::Stage::Kick);
+					sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<kick_fields, kick_fields>(
+						[&](auto p) {
+							p.velocity += h * (p.force / p.mass);
+						}
+					), State::MOVABLE);
+				}
+			}
+
+			// stash the fast force, evaluate the slow force and recombine both into the total force
+			sys.template for_each_particle<Sys::parallel_policy>(scalar_kernel<split_fields, ParticleField::none>(
+				[&](auto p) {
+					slow_force[p.id] = p.force;
+				}
+			));
+
+			sys.update_forces(ForceGroup::slow);
+			sys.apply_force_fields();
+
+			sys.template for_each_particle<Sys::parallel_policy>(scalar_kernel<split_fields, ParticleField::force>(
+				[&](auto p) {
+					const vec3 fast = slow_force[p.id];
+					slow_force[p.id] = p.force;
+					p.force += fast;
+				}
+			));
+
+			kick_split(dt, h);
+
+			sys.apply_controllers();
+		}
+
+	private:
+		size_t inner_steps = 1;
+		std::vector<vec3> slow_force; // indexed by particle id
+
+		void kick_split(const double outer_dt, const double inner_dt) {
+			const utility::StageScope stage(utility::Stage::Kick);
+			sys.template for_each_particle<Sys::parallel_policy>(scalar_kernel<split_fields, ParticleField::velocity>(
+				[&](auto p) {
+					const vec3 slow = slow_force[p.id];
+					const vec3 fast = p.force - slow;
+					p.velocity += ((outer_dt / 2.0) * slow + (inner_dt / 2.0) * fast) / p.mass;
+				}
+			), State::MOVABLE);
+		}
+
+		void initialize_slow_forces() {
+			slow_force.assign(static_cast<size_t>(sys.max_id()) + 1, vec3{});
+
+			sys.update_forces(ForceGroup::slow);
+			sys.apply_force_fields();
+
+			sys.template for_each_particle<Sys::parallel_policy>(scalar_kernel<split_fields, ParticleField::none>(
+				[&](auto p) {
+					slow_force[p.id] = p.force;
+				}
+			));
+
+			sys.update_forces();
+			sys.apply_force_fields();
+		}
+	};
+
+	// Deduction guide so user can write Respa(sys, MonitorPack<M1, M2, M3>)
+	template<core::IsSystem Sys, monitor::IsMonitor... Ms>
+	Respa(Sys&, monitor::internal::MonitorPack<Ms...>)
+		-> Respa<Sys, monitor::internal::MonitorPack<Ms...>>;
+
+	// Deduction guide so user can write Respa(sys, m1, m2, m3)
+	template<core::IsSystem Sys,typename ... Ms>
+	requires (monitor::IsMonitor<std::decay_t<Ms>> && ...)
+	Respa(Sys&, Ms...)
+		-> Respa<Sys, monitor::internal::MonitorPack<std::decay_t<Ms>...>>;
+}
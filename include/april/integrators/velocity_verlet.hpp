@@ -25,24 +25,30 @@ namespace april {
 		void integration_step() const {
 			sys.update_all_components();
 
-			sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<pos_upd_fields, pos_upd_fields>(
-				[&](auto p) {
-					p.old_position = p.position;
-					p.velocity += (dt / 2.0) * (p.force / p.mass);
-					p.position += dt * p.velocity;
-				}
-			), State::MOVABLE);
+			{
+				const utility::StageScope stage(utility::Stage::Drift);
+				sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<pos_upd_fields, pos_upd_fields>(
+					[&](auto p) {
+						p.old_position = p.position;
+						p.velocity += (dt / 2.0) * (p.force / p.mass);
+						p.position += dt * p.velocity;
+					}
+				), State::MOVABLE);
+			}
 
 			sys.rebuild_structure();
 			sys.apply_boundary_conditions();
 			sys.update_forces();
 			sys.apply_force_fields();
 
-			sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<vel_upd_fields, vel_upd_fields>(
-				[&](auto p) {
-					p.velocity += (dt / 2.0) * (p.force / p.mass);
-				}
-			), State::MOVABLE);
+			{
+				const utility::StageScope stage(utility::Stage::Kick);
+				sys.template for_each_particle<Sys::parallel_policy>(universal_kernel<vel_upd_fields, vel_upd_fields>(
+					[&](auto p) {
+						p.velocity += (dt / 2.0) * (p.force / p.mass);
+					}
+				), State::MOVABLE);
+			}
 
 			sys.apply_controllers();
 		}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "april/base/macros.hpp"
+#include "april/base/types.hpp"
+#include "april/exec/policy.hpp"
+#include "april/interactions/force_group.hpp"
+#include "april/math/vec3.hpp"
+
+
+namespace april::interactions {
+
+    /**
+     * @brief Base class for bonded (topology) interactions between a fixed number of particles.
+     *
+     * Bonded forces act on ordered tuples of particle IDs (e.g. angles i-j-k or dihedrals i-j-k-l).
+     * Custom bonded forces derive from BondedForce<Arity> and implement `eval(b1, ..., b_{Arity-1})`
+     * where b_n = x_{n+1} - x_n are the consecutive bond vectors along the tuple. `eval` returns a
+     * std::array holding the force acting on each of the Arity particles (in tuple order).
+     * The same implementation may be used for scalar (vec3) and SIMD (pvec3) bond vectors.
+     * Containers schedule angles (Arity 3) and dihedrals (Arity 4), so only these arities are accepted.
+     */
+    template<std::size_t Arity>
+    struct BondedForce {
+        static_assert(Arity != 2, "[APRIL] BondedForce: pair interactions between ids are regular Forces");
+        static_assert(Arity == 3 || Arity == 4, "[APRIL] BondedForce: only angle (3) and dihedral (4) arities are scheduled");
+
+        static constexpr std::size_t arity = Arity;
+        static constexpr auto vector_mode = exec::ExecutionMode::Scalar | exec::ExecutionMode::Packed;
+
+        APRIL_FORCE_INLINE
+        auto operator()(this const auto& self, const auto& ... bonds) {
+            using V = std::remove_cvref_t<std::tuple_element_t<0, std::tuple<decltype(bonds)...>>>; // Resolves to vec3 or pvec3
+
+            static_assert(sizeof...(bonds) == Arity - 1,
+                "[APRIL] BondedForce: expected Arity - 1 bond vectors");
+            static_assert(requires { { self.eval(bonds...) } -> std::same_as<std::array<V, Arity>>; },
+                "[APRIL] BondedForce: must implement eval(b...) returning std::array<V, Arity> with V the type of the bond vectors");
+
+            return self.eval(bonds...);
+        }
+
+        bool equals(this const auto & self, const auto & other) {
+            using SelfT  = std::remove_cvref_t<decltype(self)>;
+            using OtherT = std::remove_cvref_t<decltype(other)>;
+
+            if constexpr (!std::same_as<SelfT, OtherT>) {
+                return false;
+            } else {
+                return self == other;
+            }
+        }
+
+        bool operator==(const BondedForce&) const = default;
+    };
+
+
+    // define bonded force concept
+    template <class F>
+    concept IsBondedForce = requires { { F::arity } -> std::convertible_to<std::size_t>; } &&
+        std::derived_from<F, BondedForce<F::arity>>;
+
+
+    namespace internal {
+
+        template<class BV> struct BondedInteraction {
+            const std::vector<ParticleID> ids; // ordered tuple, size == arity of the force
+            const BV force;
+            const ForceGroup group;
+
+            BondedInteraction(std::vector<ParticleID> ids, BV f, const ForceGroup group = ForceGroup::fast)
+              : ids(std::move(ids)), force(std::move(f)), group(group)
+            {}
+        };
+
+
+        // internal placeholder only (keeps the bonded variant default constructible & non-empty)
+        struct BondedSentinel {
+            bool operator==(const BondedSentinel&) const = default;
+        };
+
+
+        // check if std::variant of bonded forces
+        template<typename T>
+        struct is_bonded_variant : std::false_type {};
+
+        template<IsBondedForce... Bs>
+        struct is_bonded_variant<std::variant<BondedSentinel, Bs...>> : std::true_type {};
+
+        template<typename T>
+        concept IsBondedVariant = is_bonded_variant<T>::value;
+
+        template<class... Bs>
+        using BondedVariantType_t = std::variant<BondedSentinel, Bs...>;
+    }
+}
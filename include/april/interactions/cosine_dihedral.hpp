@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+
+#include "april/interactions/bonded.hpp"
+
+
+namespace april {
+	// Periodic (cosine) dihedral potential U = k (1 + cos(n phi - phi0)) for the torsion i-j-k-l.
+	// k: barrier height; n: multiplicity; phi0: phase shift in radians.
+	struct CosineDihedral : interactions::BondedForce<4> {
+		double k; // Barrier height
+		double n; // Multiplicity
+		double phi0; // Phase shift
+
+		CosineDihedral(const double strength, const double multiplicity, const double phase)
+		: k(strength), n(multiplicity), phi0(phase) {}
+
+
+		// b1 = x_j - x_i, b2 = x_k - x_j, b3 = x_l - x_k
+		auto eval(const auto& b1, const auto& b2, const auto& b3) const noexcept {
+			using V = std::remove_cvref_t<decltype(b1)>;
+
+			// normals of the planes (i,j,k) and (j,k,l)
+			const V m = b1.cross(b2);
+			const V q = b2.cross(b3);
+
+			const auto b2_norm2 = b2.norm_squared();
+			const auto b2_norm = april::sqrt(b2_norm2);
+			const auto m_norm2 = april::max(m.norm_squared(), 1e-24); // guard collinear bonds
+			const auto q_norm2 = april::max(q.norm_squared(), 1e-24);
+
+			const auto phi = april::atan2(b2_norm * b1.dot(q), m.dot(q));
+			const auto dU_dphi = -k * n * april::sin(n * phi - phi0);
+
+			// outer particles move along the plane normals (Blondel & Karplus)
+			const V f_i = (dU_dphi * b2_norm / m_norm2) * m;
+			const V f_l = (-dU_dphi * b2_norm / q_norm2) * q;
+
+			// inner particles follow from translational and rotational invariance
+			const auto s_ij = b1.dot(b2) / b2_norm2;
+			const auto s_lk = b3.dot(b2) / b2_norm2;
+			const V f_j = s_lk * f_l - (1.0 + s_ij) * f_i;
+			const V f_k = s_ij * f_i - (1.0 + s_lk) * f_l;
+
+			return std::array<V, 4>{f_i, f_j, f_k, f_l};
+		}
+
+		bool operator==(const CosineDihedral&) const = default;
+	};
+}
@@ -7,12 +7,15 @@
 #include <utility>
 #include <variant>
 #include <algorithm>
+#include <tuple>
 
 
 #include "april/base/types.hpp"
 #include "april/particle/access/packed_access.hpp"
 #include "april/particle/properties.hpp"
 #include "april/exec/policy.hpp"
+#include "april/interactions/bonded.hpp"
+#include "april/interactions/force_group.hpp"
 
 namespace april {
     struct NoForce;
@@ -173,14 +176,18 @@ namespace april::interactions {
 
 
     namespace internal {
+        // a force pack may mix pair forces and bonded (multi-body topology) forces
+        template<class F>
+        concept IsPackableForce = IsForce<F> || IsBondedForce<F>;
+
         // define Force pack
-        template<IsForce... Fs> struct ForcePack {};
+        template<IsPackableForce... Fs> struct ForcePack {};
 
         // Concept to check if a type T is a ForcePack
         template<typename T>
         inline constexpr bool is_force_pack_v = false; // Default
 
-        template<IsForce... Fs>
+        template<IsPackableForce... Fs>
         inline constexpr bool is_force_pack_v<ForcePack<Fs...>> = true; // Specialization
 
         template<typename T>
@@ -202,9 +209,10 @@ namespace april::interactions {
             const ParticleType type1;
             const ParticleType type2;
             const FV force;
+            const ForceGroup group;
 
-            TypeInteraction(const ParticleType type1, const ParticleType type2, FV f)
-              : type1(std::min(type1, type2)), type2(std::max(type1, type2)), force(std::move(f))
+            TypeInteraction(const ParticleType type1, const ParticleType type2, FV f, const ForceGroup group = ForceGroup::slow)
+              : type1(std::min(type1, type2)), type2(std::max(type1, type2)), force(std::move(f)), group(group)
             {}
         };
 
@@ -212,9 +220,10 @@ namespace april::interactions {
             const ParticleID id1;
             const ParticleID id2;
             const FV force;
+            const ForceGroup group;
 
-            IdInteraction(const ParticleID id1, const ParticleID id2, FV f)
-              : id1(std::min(id1, id2)), id2(std::max(id1, id2)), force(std::move(f))
+            IdInteraction(const ParticleID id1, const ParticleID id2, FV f, const ForceGroup group = ForceGroup::fast)
+              : id1(std::min(id1, id2)), id2(std::max(id1, id2)), force(std::move(f)), group(group)
             {}
         };
 
@@ -255,6 +264,31 @@ namespace april::interactions {
         // Convenience alias
         template<class... Fs>
         using VariantType_t = VariantType<Fs...>::type;
+
+
+        // split a mixed pack into its pair and bonded parts
+        template<class... Fs>
+        struct SplitForces {
+            template<class F> using pair_tuple = std::conditional_t<IsForce<F>, std::tuple<F>, std::tuple<>>;
+            template<class F> using bonded_tuple = std::conditional_t<IsBondedForce<F>, std::tuple<F>, std::tuple<>>;
+
+            using pairs = decltype(std::tuple_cat(std::declval<pair_tuple<Fs>>()...));
+            using bonded = decltype(std::tuple_cat(std::declval<bonded_tuple<Fs>>()...));
+        };
+
+        template<class Tuple> struct PairVariantOf;
+        template<class... Fs> struct PairVariantOf<std::tuple<Fs...>> { using type = VariantType_t<Fs...>; };
+
+        template<class Tuple> struct BondedVariantOf;
+        template<class... Bs> struct BondedVariantOf<std::tuple<Bs...>> { using type = BondedVariantType_t<Bs...>; };
+
+        // variant over the pair forces of a (possibly mixed) pack
+        template<class... Fs>
+        using PairVariantType_t = PairVariantOf<typename SplitForces<Fs...>::pairs>::type;
+
+        // variant over the bonded forces of a (possibly mixed) pack
+        template<class... Fs>
+        using BondedPackVariantType_t = BondedVariantOf<typename SplitForces<Fs...>::bonded>::type;
     } // namespace internal
 } // namespace april::force
 
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "april/base/bitmask.hpp"
+
+
+namespace april {
+
+	/**
+	 * @brief Rate group of an interaction, selects which interactions System::update_forces() evaluates.
+	 *
+	 * Multiple-time-step integrators evaluate the groups at different rates. Every interaction is assigned
+	 * to one group when it is registered: type-pair interactions default to slow, ID-pair and bonded
+	 * interactions to fast.
+	 */
+	enum class ForceGroup : uint8_t {
+		none = 0u,
+		slow = 1u << 0, ///< Evaluated once per outer step (e.g. soft non-bonded forces).
+		fast = 1u << 1, ///< Evaluated every inner step (e.g. stiff bonds).
+
+		all = slow | fast
+	};
+	APRIL_ENABLE_BITMASK_OPERATORS(ForceGroup)
+}
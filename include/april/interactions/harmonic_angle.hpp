@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+
+#include "april/interactions/bonded.hpp"
+
+
+namespace april {
+	// Harmonic angle potential U = k/2 (theta - theta0)^2 for the angle i-j-k at apex j.
+	// k: angular spring constant; theta0: equilibrium angle in radians.
+	struct HarmonicAngle : interactions::BondedForce<3> {
+		double k; // Angular spring constant
+		double theta0; // Equilibrium angle
+
+		HarmonicAngle(const double strength, const double equilibrium)
+		: k(strength), theta0(equilibrium) {}
+
+
+		// b1 = x_j - x_i, b2 = x_k - x_j
+		auto eval(const auto& b1, const auto& b2) const noexcept {
+			using V = std::remove_cvref_t<decltype(b1)>;
+
+			const auto inv_a = b1.inv_norm();
+			const auto inv_b = b2.inv_norm();
+			const V a_hat = -b1 * inv_a; // unit vector j -> i
+			const V b_hat = b2 * inv_b;  // unit vector j -> k
+
+			const auto cos_theta = april::clamp(a_hat.dot(b_hat), -1.0, 1.0);
+			const auto sin_theta = april::sqrt(april::max(1.0 - cos_theta * cos_theta, 1e-12));
+			const auto theta = april::acos(cos_theta);
+
+			// F_i = -dU/dtheta * dtheta/dx_i, dtheta/dcos = -1/sin
+			const auto magnitude = k * (theta - theta0) / sin_theta;
+			const V f_i = (magnitude * inv_a) * (b_hat - cos_theta * a_hat);
+			const V f_k = (magnitude * inv_b) * (a_hat - cos_theta * b_hat);
+
+			return std::array<V, 3>{f_i, -(f_i + f_k), f_k};
+		}
+
+		bool operator==(const HarmonicAngle&) const = default;
+	};
+}
@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "april/interactions/force.hpp"
+#include "april/interactions/force_group.hpp"
+#include "april/interactions/many_body.hpp"
 #include "april/interactions/no_force.hpp"
 
 
@@ -20,9 +22,10 @@ namespace april::interactions::internal {
     struct InteractionDescriptor {
         double cutoff = 0.0;
         bool is_active = false;
-        size_t arity = 2; // future stub for bonded interactions. Currently unused
+        size_t arity = 2; // number of bodies. pair interactions have arity 2
         std::vector<std::pair<ParticleType, ParticleType>> used_by_types;
         std::vector<std::pair<ParticleID, ParticleID>> used_by_ids;
+        std::vector<ParticleID> used_by_tuples; // bonded interactions only: flattened id tuples of size arity
     };
 
 
@@ -33,25 +36,32 @@ namespace april::interactions::internal {
 
         const std::vector<size_t> type_interaction_matrix; // i * types.size() + j -> index into interactions
         const std::vector<size_t> id_interaction_matrix; // i * id.size() + j -> index into interactions
+
+        const std::vector<InteractionDescriptor> bonded_interactions = {}; // list of bonded (arity > 2) interactions
     };
 
 
-    template<IsForceVariant ForceVariant>
+    template<IsForceVariant ForceVariant, IsBondedVariant BondedVariant = BondedVariantType_t<>>
     class InteractionTable {
         using Type_Interaction = TypeInteraction<ForceVariant>;
         using Id_Interaction = IdInteraction<ForceVariant>;
+        using Bonded_Interaction = BondedInteraction<BondedVariant>;
         using IdMap = std::unordered_map<ParticleID, ParticleID>;
         using TypeMap = std::unordered_map<ParticleType, ParticleType>;
     public:
+        // many-body forces require a density pass (and the scratch field) before the force pass
+        static constexpr bool has_many_body_forces = contains_many_body_v<ForceVariant>;
 
         InteractionTable(
             std::vector<Type_Interaction> type_interactions,
             std::vector<Id_Interaction> id_interactions,
             const TypeMap & usr_types_to_impl_types,
-            const IdMap & usr_ids_to_impl_ids
+            const IdMap & usr_ids_to_impl_ids,
+            std::vector<Bonded_Interaction> bonded_interactions = {}
         ) {
             build_type_forces(type_interactions, usr_types_to_impl_types);
             build_id_forces(id_interactions, usr_ids_to_impl_ids);
+            build_bonded_forces(bonded_interactions, usr_ids_to_impl_ids);
             validate_force_tables();
         }
 
@@ -98,6 +108,12 @@ namespace april::interactions::internal {
             for (const auto & force : type_forces) all_forces.push_back(force);
             for (const auto & force : id_forces) all_forces.push_back(force);
 
+            // forces of different groups are evaluated separately, so they must not be merged
+            std::vector<ForceGroup> all_groups;
+            all_groups.reserve(all_forces.size());
+            all_groups.insert(all_groups.end(), type_groups.begin(), type_groups.end());
+            all_groups.insert(all_groups.end(), id_groups.begin(), id_groups.end());
+
             // and we also create a corresponding properties vector for every force
             std::vector<InteractionDescriptor> all_force_props;
             all_force_props.reserve(type_forces.size() + id_forces.size());
@@ -121,6 +137,7 @@ namespace april::interactions::internal {
             // first we create a vector of unique forces and track which force in all_forces maps a force in unique_forces
             std::vector<size_t> remapping(all_forces.size());
             std::vector<ForceVariant> unique_forces;
+            std::vector<ForceGroup> unique_groups;
             std::vector<InteractionDescriptor> unique_props;
 
             for (size_t i = 0; i < all_forces.size(); i++) {
@@ -132,7 +149,7 @@ namespace april::interactions::internal {
                 size_t found_idx = 0;
 
                 for (size_t j = 0; j < unique_forces.size(); ++j) {
-                    if (is_equal(current_force, unique_forces[j])) {
+                    if (all_groups[i] == unique_groups[j] && is_equal(current_force, unique_forces[j])) {
                         found = true;
                         found_idx = j;
                         break;
@@ -151,6 +168,7 @@ namespace april::interactions::internal {
                     // current force is not in unique_forces -> create new entry
                     const size_t new_idx = unique_forces.size();
                     unique_forces.push_back(current_force);
+                    unique_groups.push_back(all_groups[i]);
                     unique_props.push_back(std::move(all_force_props[i]));
 
                     remapping[i] = new_idx;
@@ -168,12 +186,21 @@ namespace april::interactions::internal {
                 id_interaction_matrix[i] = remapping[n_types * n_types + i];
             }
 
+            // bonded forces are already unique (merged at construction) and map 1:1 onto descriptors
+            std::vector<InteractionDescriptor> bonded_props(bonded_forces.size());
+            for (size_t i = 0; i < bonded_forces.size(); ++i) {
+                bonded_props[i].is_active = true;
+                bonded_props[i].arity = bonded_arity[i];
+                bonded_props[i].used_by_tuples = bonded_tuples[i];
+            }
+
             return InteractionMap {
                 .types = types,
                 .ids = ids,
                 .interactions = unique_props,
                 .type_interaction_matrix = type_interaction_matrix,
                 .id_interaction_matrix = id_interaction_matrix,
+                .bonded_interactions = bonded_props,
             };
         }
 
@@ -198,6 +225,66 @@ namespace april::interactions::internal {
             }, variant);
         }
 
+        // invokes func with the bonded force at `index` (an index into InteractionMap::bonded_interactions)
+        // only bonded forces of the requested arity are instantiated
+        template<size_t Arity, typename Func>
+        void dispatch_bonded(const size_t index, Func && func) const {
+            APRIL_ASSERT(index < bonded_forces.size(), "bonded interaction index out of range");
+            std::visit([&]<typename F>(const F & f) -> void {
+                if constexpr (IsBondedForce<F>) {
+                    if constexpr (F::arity == Arity) {
+                        func(f);
+                    }
+                }
+            }, bonded_forces[index]);
+        }
+
+
+        // number of dense particle types the type-pair table covers
+        [[nodiscard]] size_t num_types() const noexcept {
+            return n_types;
+        }
+
+        // true if any id-pair or bonded interaction is registered
+        [[nodiscard]] bool has_topology_forces() const noexcept {
+            return n_ids > 0 || !bonded_forces.empty();
+        }
+
+        // largest cutoff among all type-pair forces
+        [[nodiscard]] double max_type_cutoff() const {
+            double max = 0.0;
+            for (const auto& v : type_forces) {
+                std::visit([&]<IsForce F>(const F& f) {
+                    if constexpr (!std::same_as<F, ForceSentinel> && !std::same_as<F, NoForce>) {
+                        max = std::max(max, f.cutoff());
+                    }
+                }, v);
+            }
+            return max;
+        }
+
+        // rate groups of the type-pair, id-pair and bonded forces
+        [[nodiscard]] ForceGroup type_group(const ParticleType a, const ParticleType b) const noexcept {
+            return type_groups[type_index(a, b)];
+        }
+
+        [[nodiscard]] ForceGroup id_group(const ParticleID a, const ParticleID b) const noexcept {
+            return id_groups[id_index(a, b)];
+        }
+
+        [[nodiscard]] ForceGroup bonded_group(const size_t index) const noexcept {
+            return bonded_groups[index];
+        }
+
+        // union of the groups of all type-pair forces, update_forces skips the pair traversal if none is selected
+        [[nodiscard]] ForceGroup used_type_groups() const noexcept {
+            return type_group_union;
+        }
+
+        // union of the groups of all id-pair and bonded forces
+        [[nodiscard]] ForceGroup used_topology_groups() const noexcept {
+            return topology_group_union;
+        }
 
         [[nodiscard]] bool has_id_force(const ParticleID a, const ParticleID b) const noexcept{
             return a < n_ids && b < n_ids;
@@ -223,6 +310,14 @@ namespace april::interactions::internal {
     private:
         std::vector<ForceVariant> type_forces; // Forces between different particle types (e.g. type A <-> type B)
         std::vector<ForceVariant> id_forces; // Forces between specific particle instances (by ID e.g. id1 <-> id2)
+        std::vector<BondedVariant> bonded_forces; // unique bonded forces (e.g. angles, dihedrals)
+        std::vector<std::vector<ParticleID>> bonded_tuples; // flattened id tuples per bonded force
+        std::vector<size_t> bonded_arity; // arity per bonded force
+        std::vector<ForceGroup> type_groups; // same layout as type_forces
+        std::vector<ForceGroup> id_groups; // same layout as id_forces
+        std::vector<ForceGroup> bonded_groups; // per bonded force
+        ForceGroup type_group_union = ForceGroup::none;
+        ForceGroup topology_group_union = ForceGroup::none;
         size_t n_types{};
         size_t n_ids{};
 
@@ -249,13 +344,17 @@ namespace april::interactions::internal {
 
             n_types = particle_types.size();
             type_forces.resize(n_types * n_types);
+            type_groups.assign(n_types * n_types, ForceGroup::slow);
 
             // insert type forces into map & apply user mappings
             for (auto& x : type_infos) {
+                validate_group(x.group);
                 const auto a = type_map.at(x.type1);
                 const auto b = type_map.at(x.type2);
                 type_forces[type_index(a, b)] = x.force;
                 type_forces[type_index(b, a)] = x.force;
+                type_groups[type_index(a, b)] = x.group;
+                type_groups[type_index(b, a)] = x.group;
             }
 
             //  mix missing type pairs from diagonals
@@ -277,8 +376,16 @@ namespace april::interactions::internal {
 
                     type_forces[type_index(a, b)] = force;
                     type_forces[type_index(b, a)] = force;
+
+                    // a mixed pair is fast if either of its diagonals is
+                    const auto group = has_any_of(type_groups[type_index(a, a)] | type_groups[type_index(b, b)], ForceGroup::fast)
+                        ? ForceGroup::fast : ForceGroup::slow;
+                    type_groups[type_index(a, b)] = group;
+                    type_groups[type_index(b, a)] = group;
                 }
             }
+
+            for (const auto group : type_groups) type_group_union |= group;
         }
 
 
@@ -293,13 +400,18 @@ namespace april::interactions::internal {
 
             n_ids = ids.size();
             id_forces.resize(n_ids * n_ids);
+            id_groups.assign(n_ids * n_ids, ForceGroup::fast);
 
             // insert id forces into map & apply usr mappings
             for (auto& x : id_infos) {
+                validate_group(x.group);
                 const auto a = id_map.at(x.id1);
                 const auto b = id_map.at(x.id2);
                 id_forces[id_index(a, b)] = x.force;
                 id_forces[id_index(b, a)] = x.force;
+                id_groups[id_index(a, b)] = x.group;
+                id_groups[id_index(b, a)] = x.group;
+                topology_group_union |= x.group;
             }
 
             // Fill undefined id interactions with no forces
@@ -313,6 +425,49 @@ namespace april::interactions::internal {
             }
         }
 
+        void build_bonded_forces(std::vector<Bonded_Interaction>& bonded_infos, const IdMap & id_map)
+        {
+            // helper to check if two variants carry the same bonded force
+            auto is_equal = [](const BondedVariant& a, const BondedVariant& b) {
+                if (a.index() != b.index()) return false;
+                return std::visit([&]<typename B>(const B& val_a) {
+                    if constexpr (IsBondedForce<B>) {
+                        return val_a.equals(std::get<B>(b));
+                    } else {
+                        return true;
+                    }
+                }, a);
+            };
+
+            // merge identical forces of the same group so that each force is dispatched once per batch
+            for (auto& x : bonded_infos) {
+                validate_group(x.group);
+
+                size_t idx = 0;
+                while (idx < bonded_forces.size() &&
+                    (bonded_groups[idx] != x.group || !is_equal(bonded_forces[idx], x.force))) idx++;
+
+                if (idx == bonded_forces.size()) {
+                    bonded_forces.push_back(x.force);
+                    bonded_tuples.emplace_back();
+                    bonded_arity.push_back(x.ids.size());
+                    bonded_groups.push_back(x.group);
+                    topology_group_union |= x.group;
+                }
+
+                APRIL_ASSERT(bonded_arity[idx] == x.ids.size(), "bonded force arity does not match its id tuple");
+                for (const auto id : x.ids) {
+                    bonded_tuples[idx].push_back(id_map.at(id));
+                }
+            }
+        }
+
+        static void validate_group(const ForceGroup group) {
+            if (group != ForceGroup::slow && group != ForceGroup::fast) {
+                throw std::invalid_argument("interactions must be assigned to exactly one force group (slow or fast)");
+            }
+        }
+
         void validate_force_tables() const {
             #ifndef NDEBUG
             for (size_t i = 0; i < n_types; ++i)
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <type_traits>
+#include <variant>
+
+#include "april/base/macros.hpp"
+#include "april/interactions/force.hpp"
+#include "april/math/vec3.hpp"
+
+
+namespace april::interactions {
+
+    /**
+     * @brief Base class for embedded-atom (EAM-type) many-body forces.
+     *
+     * The potential energy takes the form
+     *     U = sum_{i<j} phi(r_ij) + sum_i F(rho_i),   rho_i = sum_{j != i} rho(r_ij).
+     * Evaluation requires two traversals per step: a density pass accumulating rho_i into the
+     * transient `scratch` field, followed (after scratch is replaced by F'(rho_i)) by the regular
+     * pair pass. The pair pass is provided by this base class; derived forces implement
+     * `density(r)`, `density_derivative(r)` and `pair_derivative(r)` (generic over scalar and packed
+     * distances) as well as the scalar embedding terms `embedding(rho)` and `embedding_derivative(rho)`.
+     */
+    struct ManyBodyForce : Force {
+        static constexpr auto fields = ParticleField::scratch;
+
+        using Force::Force;
+
+        APRIL_FORCE_INLINE
+        auto eval(this const auto& self, const auto& p1, const auto& p2, const auto& r) noexcept {
+            const auto dist = r.norm();
+            const auto embedding_sum = p1.scratch + p2.scratch; // F'(rho_i) + F'(rho_j)
+            const auto magnitude = (self.pair_derivative(dist) + embedding_sum * self.density_derivative(dist)) / dist;
+
+            return magnitude * r;
+        }
+
+        bool operator==(const ManyBodyForce&) const = default;
+    };
+
+
+    // define many-body force concept
+    template <class F>
+    concept IsManyBodyForce = std::derived_from<F, ManyBodyForce>;
+
+
+    namespace internal {
+        // check if a force variant holds at least one many-body force
+        template<typename T>
+        inline constexpr bool contains_many_body_v = false;
+
+        template<class... Fs>
+        inline constexpr bool contains_many_body_v<std::variant<Fs...>> = (IsManyBodyForce<Fs> || ...);
+    }
+}
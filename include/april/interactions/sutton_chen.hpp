@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cmath>
+
+#include "april/interactions/many_body.hpp"
+
+
+namespace april {
+	// Sutton-Chen embedded-atom potential for fcc metals:
+	// U = eps * [ sum_{i<j} (a/r_ij)^n - c * sum_i sqrt(rho_i) ],  rho_i = sum_{j != i} (a/r_ij)^m.
+	// epsilon: energy scale; a: lattice constant; c: dimensionless embedding strength; n, m: exponents.
+	struct SuttonChen : interactions::ManyBodyForce {
+		double epsilon; // Energy scale
+		double a; // Lattice constant
+		double c; // Embedding strength
+		double n; // Repulsive pair exponent
+		double m; // Density exponent
+
+		SuttonChen(const double epsilon, const double a, const double c, const double n, const double m, const double cutoff = -1.0)
+		: ManyBodyForce(cutoff < 0.0 ? 2.0 * a : cutoff), epsilon(epsilon), a(a), c(c), n(n), m(m) {}
+
+
+		// pair contribution to the density of a neighbour at distance r
+		auto density(const auto& r) const noexcept {
+			return april::pow(a / r, m);
+		}
+
+		auto density_derivative(const auto& r) const noexcept {
+			return -m * april::pow(a / r, m) / r;
+		}
+
+		auto pair_derivative(const auto& r) const noexcept {
+			return -n * epsilon * april::pow(a / r, n) / r;
+		}
+
+		[[nodiscard]] double embedding(const double rho) const noexcept {
+			return -c * epsilon * std::sqrt(rho);
+		}
+
+		[[nodiscard]] double embedding_derivative(const double rho) const noexcept {
+			return rho > 0.0 ? -0.5 * c * epsilon / std::sqrt(rho) : 0.0;
+		}
+
+		bool operator==(const SuttonChen&) const = default;
+	};
+}
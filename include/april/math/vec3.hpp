@@ -171,6 +171,15 @@ namespace april::math {
             return self.x * rhs.x + self.y * rhs.y + self.z * rhs.z;
         }
 
+        template<IsVectorLike Other>
+        auto cross(this const auto& self, const Other& rhs) noexcept {
+            return Vec3{
+                self.y * rhs.z - self.z * rhs.y,
+                self.z * rhs.x - self.x * rhs.z,
+                self.x * rhs.y - self.y * rhs.x
+            };
+        }
+
         [[nodiscard]] auto norm_squared(this const auto& self) noexcept {
             return self.dot(self);
         }
@@ -1,14 +1,20 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <numeric>
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <memory>
+#include <string>
 #include <vector>
 #include <iostream>
 
+#include "april/exec/hardware.hpp"
 #include "april/monitors/monitor.hpp"
+#include "april/utility/perf_counters.hpp"
+#include "april/utility/stage_profile.hpp"
 
 namespace april {
 
@@ -16,6 +22,17 @@ namespace april {
     class Benchmark : public monitor::Monitor {
     public:
 
+       struct ThreadCounters {
+          int tid;
+          std::string name;
+          utility::PerfCounts counts;
+       };
+
+       struct StageCounters {
+          utility::Stage stage;
+          utility::PerfCounts counts; // summed over all threads
+       };
+
        struct BenchmarkResult {
           size_t steps;
           uint64_t total_updates;
@@ -30,6 +47,15 @@ namespace april {
           double std_dev_sec;
           std::vector<double> timings;
 
+          // hardware counters over the measured steps (only filled if requested)
+          bool hardware_counters = false;
+          std::string counters_error;          // why no counters could be read (empty on success)
+          utility::PerfCounts counters;        // summed over all threads
+          std::vector<ThreadCounters> thread_counters;
+          std::vector<StageCounters> stage_counters; // system stages the step ran through
+          double ipc = 0;
+          double bytes_per_update = 0;         // LLC miss traffic (cache lines) per particle update
+
           void print_report() const {
              std::cout << "\n" << std::string(40, '-') << "\n";
              std::cout << " [APRIL BENCHMARK REPORT] \n";
@@ -54,32 +80,106 @@ namespace april {
              std::cout << "  Min step time:      " << min_step_sec << " s\n";
              std::cout << "  Max step time:      " << max_step_sec << " s\n";
              std::cout << "  Std Deviation:      " << std_dev_sec << " s\n";
-             std::cout << std::string(40, '-') << "\n\n";
+             std::cout << std::string(40, '-') << "\n";
+
+             if (hardware_counters) print_counters();
+             std::cout << "\n";
+          }
+
+          void print_counters() const {
+             if (!counters_error.empty()) {
+                std::cout << "  Hardware counters:  unavailable (" << counters_error << ")\n";
+                std::cout << std::string(40, '-') << "\n";
+                return;
+             }
+
+             auto print_count = [&](const utility::PerfCounts& c, const utility::PerfEvent e) {
+                if (c.has(e)) std::cout << std::setw(14) << c[e];
+                else std::cout << std::setw(14) << "n/a";
+             };
+
+             std::cout << "  Hardware counters (all threads):\n";
+             for (size_t i = 0; i < utility::n_perf_events; ++i) {
+                const auto e = static_cast<utility::PerfEvent>(i);
+                std::cout << "  " << std::left << std::setw(18) << utility::perf_event_name(e) << std::right;
+                print_count(counters, e);
+                std::cout << "\n";
+             }
+
+             std::cout << std::setprecision(2);
+             std::cout << "  IPC:                " << ipc << "\n";
+             std::cout << "  LLC bytes/update:   " << bytes_per_update << "\n";
+             std::cout << std::string(40, '-') << "\n";
+
+             std::cout << "  " << std::left << std::setw(22) << "thread" << std::right << std::setw(6) << "IPC";
+             std::cout << std::setw(14) << "cycles" << std::setw(14) << "LLC misses" << "\n";
+             for (const auto& t : thread_counters) {
+                std::cout << "  " << std::left << std::setw(22) << (std::to_string(t.tid) + " " + t.name).substr(0, 21)
+                          << std::right << std::setw(6) << t.counts.ipc();
+                print_count(t.counts, utility::PerfEvent::Cycles);
+                print_count(t.counts, utility::PerfEvent::LLCMisses);
+                std::cout << "\n";
+             }
+             std::cout << std::string(40, '-') << "\n";
+
+             std::cout << "  " << std::left << std::setw(22) << "stage" << std::right << std::setw(6) << "IPC";
+             std::cout << std::setw(14) << "cycles" << std::setw(14) << "LLC misses" << "\n";
+             for (const auto& s : stage_counters) {
+                std::cout << "  " << std::left << std::setw(22) << utility::stage_name(s.stage)
+                          << std::right << std::setw(6) << s.counts.ipc();
+                print_count(s.counts, utility::PerfEvent::Cycles);
+                print_count(s.counts, utility::PerfEvent::LLCMisses);
+                std::cout << "\n";
+             }
+             std::cout << std::string(40, '-') << "\n";
           }
        };
 
        Benchmark() : Monitor(Trigger::always()) {}
-       explicit Benchmark(BenchmarkResult * res) : Monitor(Trigger::always()), result(res) {}
+
+       // hardware_counters: read perf_event_open counters of every thread, per step and per system stage (Linux)
+       explicit Benchmark(BenchmarkResult * res, const bool hardware_counters = false)
+          : Monitor(Trigger::always()), result(res), use_counters(hardware_counters) {}
+
+       Benchmark(const Benchmark&) = default;
+       Benchmark(Benchmark&&) noexcept = default;
+       Benchmark& operator=(const Benchmark&) = default;
+       Benchmark& operator=(Benchmark&&) noexcept = default;
+
+       ~Benchmark() {
+          // a run that did not finalize must not leave the stage hook pointing at freed counters
+          if (hw && hw.use_count() == 1 && utility::StageProfile::local().stage_hook().context == hw.get()) {
+             utility::StageProfile::local().set_hook({});
+          }
+       }
 
        void initialize() {
+          if (use_counters) open_counters();
           glob_start_time = std::chrono::steady_clock::now();
        }
 
        template<class S>
        void before_step(const core::SystemContext<S> & sys) {
           current_step_updates = sys.size();
+          if (hw) hw->threads.read(hw->step_start);
           start_time = std::chrono::steady_clock::now();
        }
 
        template<class S>
        void record(const core::SystemContext<S> &) {
           end_time = std::chrono::steady_clock::now();
+          if (hw) {
+             hw->threads.read(hw->reading);
+             for (size_t t = 0; t < hw->reading.size(); ++t) hw->per_thread[t] += hw->reading[t] - hw->step_start[t];
+          }
+
           const auto elapsed = std::chrono::duration<double>(end_time - start_time).count();
           timings.push_back(elapsed);
           updates += current_step_updates;
        }
 
        void finalize() {
+          if (hw) utility::StageProfile::local().set_hook({});
           if (timings.empty()) return;
 
           glob_end_time = std::chrono::steady_clock::now();
@@ -94,6 +194,62 @@ namespace april {
        }
 
     private:
+       // counter state, shared so the monitor stays copyable
+       struct HardwareState {
+          utility::ThreadPerfCounters threads;
+          std::vector<utility::PerfCounts> step_start, reading, per_thread;
+          std::array<std::vector<utility::PerfCounts>, utility::n_stages> stage_start; // per thread
+          std::array<utility::PerfCounts, utility::n_stages> per_stage;
+          std::array<bool, utility::n_stages> stage_seen{};
+       };
+
+       void open_counters() {
+          hw = std::make_shared<HardwareState>();
+          hw->threads.open(); // executor threads already exist, the System starts them on construction
+          if (!hw->threads.available()) return;
+
+          hw->per_thread.resize(hw->threads.thread_list().size());
+
+          // system stages do not overlap, so their counter deltas partition the step
+          utility::StageProfile::local().set_hook({hw.get(), [](void* ctx, const utility::Stage stage, const bool entering) {
+             if (!utility::is_system_stage(stage)) return;
+
+             auto& state = *static_cast<HardwareState*>(ctx);
+             const size_t s = static_cast<size_t>(stage);
+             if (entering) {
+                state.threads.read(state.stage_start[s]);
+                return;
+             }
+
+             state.threads.read(state.reading);
+             for (size_t t = 0; t < state.reading.size(); ++t) state.per_stage[s] += state.reading[t] - state.stage_start[s][t];
+             state.stage_seen[s] = true;
+          }});
+       }
+
+       void fill_counters(BenchmarkResult & res) const {
+          res.hardware_counters = true;
+          if (!hw || !hw->threads.available()) {
+             res.counters_error = hw ? hw->threads.error() : "counters were not opened";
+             return;
+          }
+
+          const auto& threads = hw->threads.thread_list();
+          for (size_t t = 0; t < threads.size(); ++t) {
+             res.counters += hw->per_thread[t];
+             res.thread_counters.push_back({threads[t].tid, threads[t].name, hw->per_thread[t]});
+          }
+          for (size_t s = 0; s < utility::n_stages; ++s) {
+             if (hw->stage_seen[s]) res.stage_counters.push_back({static_cast<utility::Stage>(s), hw->per_stage[s]});
+          }
+
+          res.ipc = res.counters.ipc();
+          if (res.counters.has(utility::PerfEvent::LLCMisses) && res.total_updates > 0) {
+             res.bytes_per_update = static_cast<double>(res.counters[utility::PerfEvent::LLCMisses] * exec::assumed_cache_line_size)
+                / static_cast<double>(res.total_updates);
+          }
+       }
+
        BenchmarkResult calculate_results() {
           const double glob_total_s = std::chrono::duration<double>(glob_end_time - glob_start_time).count();
           const double total_integ_s = std::accumulate(timings.begin(), timings.end(), 0.0);
@@ -107,7 +263,7 @@ namespace april {
           double variance = 0.0;
           for (const double t : timings) variance += (t - avg) * (t - avg);
 
-          return BenchmarkResult{
+          BenchmarkResult res{
               .steps = steps,
               .total_updates = updates,
               .wall_time_sec = glob_total_s,
@@ -121,6 +277,9 @@ namespace april {
               .std_dev_sec = std::sqrt(variance / static_cast<double>(steps)),
               .timings = timings
           };
+
+          if (use_counters) fill_counters(res);
+          return res;
        }
 
        using Clock = std::chrono::steady_clock;
@@ -130,6 +289,9 @@ namespace april {
        uint64_t updates = 0;
        size_t current_step_updates = 0;
        BenchmarkResult * result = nullptr;
+
+       bool use_counters = false;
+       std::shared_ptr<HardwareState> hw;
     };
 }
 
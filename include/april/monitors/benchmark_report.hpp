@@ -0,0 +1,592 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <sys/utsname.h>
+	#include <unistd.h>
+#endif
+
+#include "april/base/types.hpp"
+#include "april/monitors/benchmark.hpp"
+#include "april/utility/json.hpp"
+
+/*
+ * Machine-readable Benchmark results and regression checks. A result file holds a list of runs, each with
+ * the run configuration, build and host metadata, the summary statistics and the per-step timings:
+ *
+ *   {"format": "april-benchmark", "version": 1, "runs": [{"name": ..., "config": ..., "build": ..., "host": ...,
+ *    "summary": ..., "timings_s": [...], "hardware_counters": ...}]}
+ *
+ * compare_benchmarks() matches runs by name and tests the per-step timings for a significant shift.
+ */
+
+namespace april {
+
+	struct HostInfo {
+		std::string hostname;
+		std::string cpu_model;
+		unsigned logical_cpus = 0;
+		std::string os;
+		std::string timestamp; // UTC, ISO 8601
+
+		// describes the machine this process runs on
+		static HostInfo current() {
+			HostInfo host;
+			host.logical_cpus = std::thread::hardware_concurrency();
+
+		#if defined(__unix__) || defined(__APPLE__)
+			char name[256] = {};
+			if (gethostname(name, sizeof(name) - 1) == 0) host.hostname = name;
+
+			utsname uts{};
+			if (uname(&uts) == 0) host.os = std::string(uts.sysname) + " " + uts.release + " " + uts.machine;
+		#elif defined(_WIN32)
+			host.os = "Windows";
+		#endif
+
+			std::ifstream cpuinfo("/proc/cpuinfo");
+			for (std::string line; std::getline(cpuinfo, line);) {
+				if (!line.starts_with("model name")) continue;
+				const size_t value = line.find_first_not_of(" \t", line.find(':') + 1);
+				if (line.find(':') != std::string::npos && value != std::string::npos) host.cpu_model = line.substr(value);
+				break;
+			}
+
+			const std::time_t now = std::time(nullptr);
+			char stamp[32] = {};
+			if (const std::tm* utc = std::gmtime(&now)) std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", utc);
+			host.timestamp = stamp;
+
+			return host;
+		}
+	};
+
+
+	// what a run measured and how the binary was built; name identifies the run across result files
+	struct BenchmarkInfo {
+		std::string name;
+
+		// run configuration (filled in by the caller)
+		std::string container;
+		std::string layout;
+		std::string executor;
+		size_t threads = 1;
+
+		// build configuration
+		std::string vec3_type;
+		std::string simd_backend;
+		size_t simd_width = 0;
+		std::string compiler;
+		std::string build_type;
+
+		HostInfo host;
+
+		// build and host fields of this binary; the run configuration is left to the caller
+		static BenchmarkInfo current(std::string name = {}) {
+			BenchmarkInfo info;
+			info.name = std::move(name);
+			info.vec3_type = std::is_same_v<VEC3_TYPE, float> ? "float" : "double";
+			info.simd_width = packed::size();
+
+		#if defined(APRIL_SIMD_BACKEND_XSIMD)
+			info.simd_backend = "xsimd";
+		#elif defined(APRIL_SIMD_BACKEND_STD_SIMD)
+			info.simd_backend = "std_simd";
+		#else
+			info.simd_backend = "scalar";
+		#endif
+
+		#if defined(__clang__)
+			info.compiler = "clang " __clang_version__;
+		#elif defined(__GNUC__)
+			info.compiler = "gcc " __VERSION__;
+		#elif defined(_MSC_VER)
+			info.compiler = "msvc " + std::to_string(_MSC_FULL_VER);
+		#else
+			info.compiler = "unknown";
+		#endif
+
+		#if defined(NDEBUG)
+			info.build_type = "release";
+		#else
+			info.build_type = "debug";
+		#endif
+
+			info.host = HostInfo::current();
+			return info;
+		}
+	};
+
+
+	struct BenchmarkRecord {
+		BenchmarkInfo info;
+		Benchmark::BenchmarkResult result{};
+	};
+
+
+	namespace internal {
+		inline void write_counts_json(utility::JSONWriter & json, const utility::PerfCounts & counts) {
+			json.begin_object();
+			for (size_t i = 0; i < utility::n_perf_events; ++i) {
+				const auto e = static_cast<utility::PerfEvent>(i);
+				json.key(utility::perf_event_name(e));
+				if (counts.has(e)) json.value(counts[e]);
+				else json.value(nullptr);
+			}
+			json.end_object();
+		}
+
+		inline utility::PerfCounts read_counts_json(const utility::JSONValue & v) {
+			utility::PerfCounts counts;
+			for (size_t i = 0; i < utility::n_perf_events; ++i) {
+				const utility::JSONValue * c = v.find(utility::perf_event_name(static_cast<utility::PerfEvent>(i)));
+				if (!c || !c->is_number()) continue;
+				counts.values[i] = static_cast<uint64_t>(c->as_number());
+				counts.valid[i] = true;
+			}
+			return counts;
+		}
+
+		inline void write_run_json(utility::JSONWriter & json, const BenchmarkRecord & record) {
+			const BenchmarkInfo & info = record.info;
+			const Benchmark::BenchmarkResult & res = record.result;
+
+			json.begin_object();
+			json.field("name", info.name);
+
+			json.key("config").begin_object();
+			json.field("container", info.container);
+			json.field("layout", info.layout);
+			json.field("executor", info.executor);
+			json.field("threads", info.threads);
+			json.end_object();
+
+			json.key("build").begin_object();
+			json.field("vec3_type", info.vec3_type);
+			json.field("simd_backend", info.simd_backend);
+			json.field("simd_width", info.simd_width);
+			json.field("compiler", info.compiler);
+			json.field("build_type", info.build_type);
+			json.end_object();
+
+			json.key("host").begin_object();
+			json.field("hostname", info.host.hostname);
+			json.field("cpu_model", info.host.cpu_model);
+			json.field("logical_cpus", info.host.logical_cpus);
+			json.field("os", info.host.os);
+			json.field("timestamp", info.host.timestamp);
+			json.end_object();
+
+			json.key("summary").begin_object();
+			json.field("steps", res.steps);
+			json.field("total_updates", res.total_updates);
+			json.field("wall_time_s", res.wall_time_sec);
+			json.field("integration_time_s", res.integration_time_s);
+			json.field("its_per_sec", res.its_per_sec);
+			json.field("mups", res.mups);
+			json.field("avg_step_s", res.avg_step_sec);
+			json.field("median_step_s", res.median_step_sec);
+			json.field("min_step_s", res.min_step_sec);
+			json.field("max_step_s", res.max_step_sec);
+			json.field("std_dev_s", res.std_dev_sec);
+			json.end_object();
+
+			json.key("timings_s").begin_array(true);
+			for (const double t : res.timings) json.value(t);
+			json.end_array();
+
+			if (res.hardware_counters) {
+				json.key("hardware_counters").begin_object();
+				json.field("error", res.counters_error);
+				json.key("total");
+				write_counts_json(json, res.counters);
+				json.field("ipc", res.ipc);
+				json.field("bytes_per_update", res.bytes_per_update);
+
+				json.key("threads").begin_array();
+				for (const auto & t : res.thread_counters) {
+					json.begin_object();
+					json.field("tid", t.tid);
+					json.field("name", t.name);
+					json.key("counts");
+					write_counts_json(json, t.counts);
+					json.end_object();
+				}
+				json.end_array();
+
+				json.key("stages").begin_array();
+				for (const auto & s : res.stage_counters) {
+					json.begin_object();
+					json.field("stage", utility::stage_name(s.stage));
+					json.key("counts");
+					write_counts_json(json, s.counts);
+					json.end_object();
+				}
+				json.end_array();
+				json.end_object();
+			}
+
+			json.end_object();
+		}
+
+		inline std::string string_or(const utility::JSONValue & v, const std::string_view name) {
+			const utility::JSONValue * member = v.find(name);
+			return member && member->is_string() ? member->as_string() : std::string{};
+		}
+
+		inline BenchmarkRecord read_run_json(const utility::JSONValue & run) {
+			BenchmarkRecord record;
+			BenchmarkInfo & info = record.info;
+			Benchmark::BenchmarkResult & res = record.result;
+
+			info.name = run["name"].as_string();
+
+			if (const utility::JSONValue * config = run.find("config")) {
+				info.container = string_or(*config, "container");
+				info.layout = string_or(*config, "layout");
+				info.executor = string_or(*config, "executor");
+				info.threads = static_cast<size_t>(config->number_or("threads", 1));
+			}
+			if (const utility::JSONValue * build = run.find("build")) {
+				info.vec3_type = string_or(*build, "vec3_type");
+				info.simd_backend = string_or(*build, "simd_backend");
+				info.simd_width = static_cast<size_t>(build->number_or("simd_width", 0));
+				info.compiler = string_or(*build, "compiler");
+				info.build_type = string_or(*build, "build_type");
+			}
+			if (const utility::JSONValue * host = run.find("host")) {
+				info.host.hostname = string_or(*host, "hostname");
+				info.host.cpu_model = string_or(*host, "cpu_model");
+				info.host.logical_cpus = static_cast<unsigned>(host->number_or("logical_cpus", 0));
+				info.host.os = string_or(*host, "os");
+				info.host.timestamp = string_or(*host, "timestamp");
+			}
+
+			const utility::JSONValue & summary = run["summary"];
+			res.steps = static_cast<size_t>(summary.number_or("steps", 0));
+			res.total_updates = static_cast<uint64_t>(summary.number_or("total_updates", 0));
+			res.wall_time_sec = summary.number_or("wall_time_s", 0);
+			res.integration_time_s = summary.number_or("integration_time_s", 0);
+			res.its_per_sec = summary.number_or("its_per_sec", 0);
+			res.mups = summary.number_or("mups", 0);
+			res.avg_step_sec = summary.number_or("avg_step_s", 0);
+			res.median_step_sec = summary.number_or("median_step_s", 0);
+			res.min_step_sec = summary.number_or("min_step_s", 0);
+			res.max_step_sec = summary.number_or("max_step_s", 0);
+			res.std_dev_sec = summary.number_or("std_dev_s", 0);
+
+			if (const utility::JSONValue * timings = run.find("timings_s")) {
+				for (const auto & t : timings->as_array()) res.timings.push_back(t.as_number());
+			}
+
+			if (const utility::JSONValue * hw = run.find("hardware_counters")) {
+				res.hardware_counters = true;
+				res.counters_error = string_or(*hw, "error");
+				if (const utility::JSONValue * total = hw->find("total")) res.counters = read_counts_json(*total);
+				res.ipc = hw->number_or("ipc", 0);
+				res.bytes_per_update = hw->number_or("bytes_per_update", 0);
+
+				if (const utility::JSONValue * threads = hw->find("threads")) {
+					for (const auto & t : threads->as_array()) {
+						res.thread_counters.push_back({
+							static_cast<int>(t.number_or("tid", 0)), string_or(t, "name"), read_counts_json(t["counts"])
+						});
+					}
+				}
+				if (const utility::JSONValue * stages = hw->find("stages")) {
+					for (const auto & s : stages->as_array()) {
+						const std::string name = string_or(s, "stage");
+						for (size_t i = 0; i < utility::n_stages; ++i) {
+							const auto stage = static_cast<utility::Stage>(i);
+							if (utility::stage_name(stage) == name) res.stage_counters.push_back({stage, read_counts_json(s["counts"])});
+						}
+					}
+				}
+			}
+
+			return record;
+		}
+
+		inline void write_csv_field(std::ostream & os, const std::string_view s) {
+			if (s.find_first_of(",\"\n") == std::string_view::npos) {
+				os << s;
+				return;
+			}
+			os << '"';
+			for (const char c : s) {
+				if (c == '"') os << '"';
+				os << c;
+			}
+			os << '"';
+		}
+	}
+
+
+	// writes a result file holding the given runs
+	inline void write_benchmark_json(std::ostream & os, const std::span<const BenchmarkRecord> records) {
+		utility::JSONWriter json(os);
+		json.begin_object();
+		json.field("format", "april-benchmark");
+		json.field("version", 1);
+		json.key("runs").begin_array();
+		for (const auto & record : records) internal::write_run_json(json, record);
+		json.end_array();
+		json.end_object();
+		json.finish();
+	}
+
+	inline void write_benchmark_json(std::ostream & os, const BenchmarkRecord & record) {
+		write_benchmark_json(os, std::span(&record, 1));
+	}
+
+	inline void save_benchmark_json(const std::string & path, const std::span<const BenchmarkRecord> records) {
+		std::ofstream file(path);
+		if (!file) throw std::runtime_error("[APRIL] Could not open benchmark file " + path);
+		write_benchmark_json(file, records);
+	}
+
+	// parses a result file written by write_benchmark_json
+	[[nodiscard]] inline std::vector<BenchmarkRecord> read_benchmark_json(const std::string_view text) {
+		const utility::JSONValue document = utility::parse_json(text);
+		if (internal::string_or(document, "format") != "april-benchmark") {
+			throw std::runtime_error("[APRIL] Not an april benchmark result file");
+		}
+
+		std::vector<BenchmarkRecord> records;
+		for (const auto & run : document["runs"].as_array()) records.push_back(internal::read_run_json(run));
+		return records;
+	}
+
+	[[nodiscard]] inline std::vector<BenchmarkRecord> load_benchmark_json(const std::string & path) {
+		std::ifstream file(path);
+		if (!file) throw std::runtime_error("[APRIL] Could not open benchmark file " + path);
+		const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return read_benchmark_json(text);
+	}
+
+
+	// one summary row per run; counters are left empty when they were not measured
+	inline void write_benchmark_csv_header(std::ostream & os) {
+		os << "name,container,layout,executor,threads,vec3_type,simd_backend,simd_width,compiler,build_type,"
+			  "hostname,cpu_model,timestamp,steps,total_updates,wall_time_s,integration_time_s,its_per_sec,mups,"
+			  "avg_step_s,median_step_s,min_step_s,max_step_s,std_dev_s,cycles,instructions,ipc,bytes_per_update\n";
+	}
+
+	inline void write_benchmark_csv_row(std::ostream & os, const BenchmarkRecord & record) {
+		const BenchmarkInfo & info = record.info;
+		const Benchmark::BenchmarkResult & res = record.result;
+
+		std::ostringstream row;
+		row.precision(17);
+		for (const std::string_view s : {
+				std::string_view(info.name), std::string_view(info.container), std::string_view(info.layout),
+				std::string_view(info.executor)}) {
+			internal::write_csv_field(row, s);
+			row << ',';
+		}
+		row << info.threads << ',';
+		for (const std::string_view s : {std::string_view(info.vec3_type), std::string_view(info.simd_backend)}) {
+			internal::write_csv_field(row, s);
+			row << ',';
+		}
+		row << info.simd_width << ',';
+		for (const std::string_view s : {
+				std::string_view(info.compiler), std::string_view(info.build_type), std::string_view(info.host.hostname),
+				std::string_view(info.host.cpu_model), std::string_view(info.host.timestamp)}) {
+			internal::write_csv_field(row, s);
+			row << ',';
+		}
+
+		row << res.steps << ',' << res.total_updates << ',' << res.wall_time_sec << ',' << res.integration_time_s << ','
+			<< res.its_per_sec << ',' << res.mups << ',' << res.avg_step_sec << ',' << res.median_step_sec << ','
+			<< res.min_step_sec << ',' << res.max_step_sec << ',' << res.std_dev_sec << ',';
+
+		const bool counted = res.hardware_counters && res.counters_error.empty();
+		if (counted && res.counters.has(utility::PerfEvent::Cycles)) row << res.counters[utility::PerfEvent::Cycles];
+		row << ',';
+		if (counted && res.counters.has(utility::PerfEvent::Instructions)) row << res.counters[utility::PerfEvent::Instructions];
+		row << ',';
+		if (counted) row << res.ipc << ',' << res.bytes_per_update;
+		else row << ',';
+
+		os << row.str() << '\n';
+	}
+
+	inline void write_benchmark_csv(std::ostream & os, const std::span<const BenchmarkRecord> records) {
+		write_benchmark_csv_header(os);
+		for (const auto & record : records) write_benchmark_csv_row(os, record);
+	}
+
+	// per-step timings in long format: name,step,time_s
+	inline void write_benchmark_steps_csv(std::ostream & os, const std::span<const BenchmarkRecord> records) {
+		std::ostringstream rows;
+		rows.precision(17);
+		rows << "name,step,time_s\n";
+		for (const auto & record : records) {
+			for (size_t i = 0; i < record.result.timings.size(); ++i) {
+				internal::write_csv_field(rows, record.info.name);
+				rows << ',' << i << ',' << record.result.timings[i] << '\n';
+			}
+		}
+		os << rows.str();
+	}
+
+
+	struct ComparisonOptions {
+		double alpha = 0.01;       // significance level of the one-sided rank test
+		double threshold = 0.05;   // smallest relative change of the median step time that counts
+		size_t warmup_steps = 0;   // leading steps excluded from both runs
+		size_t min_samples = 8;    // fewer steps than this (per run) give an inconclusive verdict
+	};
+
+	enum class Verdict : uint8_t {
+		Unchanged,
+		Regression,
+		Improvement,
+		Inconclusive, // too few step timings to test
+		Missing       // the run is not in the candidate file
+	};
+
+	[[nodiscard]] constexpr std::string_view verdict_name(const Verdict v) noexcept {
+		switch (v) {
+		case Verdict::Unchanged:    return "unchanged";
+		case Verdict::Regression:   return "REGRESSION";
+		case Verdict::Improvement:  return "improvement";
+		case Verdict::Inconclusive: return "inconclusive";
+		case Verdict::Missing:      return "missing";
+		default:                    return "unknown";
+		}
+	}
+
+	struct BenchmarkComparison {
+		std::string name;
+		double baseline_median = 0;
+		double candidate_median = 0;
+		double change = 0;      // relative change of the median step time (> 0: slower)
+		double p_slower = 1;    // p-value of "candidate steps take longer"
+		double p_faster = 1;    // p-value of "candidate steps are shorter"
+		size_t baseline_samples = 0;
+		size_t candidate_samples = 0;
+		Verdict verdict = Verdict::Inconclusive;
+	};
+
+
+	namespace internal {
+		inline double median_of(std::vector<double> v) {
+			if (v.empty()) return 0;
+			std::ranges::sort(v);
+			const size_t n = v.size();
+			return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+		}
+
+		/**
+		 * Mann-Whitney U test with the normal approximation (tie and continuity corrected). Returns the
+		 * one-sided p-values of candidate > baseline and candidate < baseline. Rank based, so single slow
+		 * steps (rebuilds, OS noise) do not dominate the way they would in a t-test.
+		 */
+		inline std::pair<double, double> mann_whitney(const std::span<const double> baseline, const std::span<const double> candidate) {
+			const size_t n_b = baseline.size(), n_c = candidate.size(), n = n_b + n_c;
+
+			std::vector<std::pair<double, bool>> all; // value, is candidate
+			all.reserve(n);
+			for (const double t : baseline) all.emplace_back(t, false);
+			for (const double t : candidate) all.emplace_back(t, true);
+			std::ranges::sort(all, {}, &std::pair<double, bool>::first);
+
+			double rank_sum = 0, tie_term = 0;
+			for (size_t i = 0; i < n;) {
+				size_t j = i;
+				while (j < n && all[j].first == all[i].first) ++j;
+				const double rank = 0.5 * static_cast<double>(i + j + 1); // average of ranks i+1 .. j
+				for (size_t k = i; k < j; ++k) if (all[k].second) rank_sum += rank;
+				const double t = static_cast<double>(j - i);
+				tie_term += t * t * t - t;
+				i = j;
+			}
+
+			const double nb = static_cast<double>(n_b), nc = static_cast<double>(n_c), nn = static_cast<double>(n);
+			const double u = rank_sum - nc * (nc + 1) / 2;
+			const double mean = nb * nc / 2;
+			const double variance = nb * nc / 12 * ((nn + 1) - tie_term / (nn * (nn - 1)));
+			if (variance <= 0) return {1.0, 1.0};
+
+			const double sd = std::sqrt(variance);
+			const auto upper_tail = [](const double z) { return 0.5 * std::erfc(z / std::sqrt(2.0)); };
+			return {upper_tail((u - mean - 0.5) / sd), upper_tail((mean - u - 0.5) / sd)};
+		}
+	}
+
+
+	// compares the per-step timings of two runs of the same benchmark
+	[[nodiscard]] inline BenchmarkComparison compare_benchmarks(
+		const Benchmark::BenchmarkResult & baseline,
+		const Benchmark::BenchmarkResult & candidate,
+		const ComparisonOptions & options = {})
+	{
+		const auto measured = [&](const std::vector<double> & timings) {
+			const size_t skip = std::min(options.warmup_steps, timings.size());
+			return std::span(timings).subspan(skip);
+		};
+		const auto base = measured(baseline.timings);
+		const auto cand = measured(candidate.timings);
+
+		BenchmarkComparison c;
+		c.baseline_samples = base.size();
+		c.candidate_samples = cand.size();
+		c.baseline_median = base.empty() ? baseline.median_step_sec : internal::median_of({base.begin(), base.end()});
+		c.candidate_median = cand.empty() ? candidate.median_step_sec : internal::median_of({cand.begin(), cand.end()});
+		c.change = c.baseline_median > 0 ? c.candidate_median / c.baseline_median - 1 : 0;
+
+		if (base.size() < options.min_samples || cand.size() < options.min_samples) {
+			c.verdict = Verdict::Inconclusive;
+			return c;
+		}
+
+		std::tie(c.p_slower, c.p_faster) = internal::mann_whitney(base, cand);
+		if (c.p_slower < options.alpha && c.change > options.threshold) c.verdict = Verdict::Regression;
+		else if (c.p_faster < options.alpha && c.change < -options.threshold) c.verdict = Verdict::Improvement;
+		else c.verdict = Verdict::Unchanged;
+		return c;
+	}
+
+	// compares every baseline run with the candidate run of the same name (candidate-only runs are ignored)
+	[[nodiscard]] inline std::vector<BenchmarkComparison> compare_benchmarks(
+		const std::span<const BenchmarkRecord> baseline,
+		const std::span<const BenchmarkRecord> candidate,
+		const ComparisonOptions & options = {})
+	{
+		std::vector<BenchmarkComparison> comparisons;
+		for (const auto & base : baseline) {
+			const auto match = std::ranges::find(candidate, base.info.name, [](const BenchmarkRecord & r) -> const std::string & { return r.info.name; });
+			if (match == candidate.end()) {
+				BenchmarkComparison missing;
+				missing.name = base.info.name;
+				missing.baseline_median = base.result.median_step_sec;
+				missing.verdict = Verdict::Missing;
+				comparisons.push_back(std::move(missing));
+				continue;
+			}
+
+			BenchmarkComparison c = compare_benchmarks(base.result, match->result, options);
+			c.name = base.info.name;
+			comparisons.push_back(std::move(c));
+		}
+		return comparisons;
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "april/monitors/monitor.hpp"
+#include "april/utility/interaction_counters.hpp"
+
+namespace april {
+
+	/**
+	 * @brief Reports how much of the pairwise force work is useful.
+	 *
+	 * Enables the System's interaction counters while the run lasts and breaks the counts down per type pair:
+	 * pairs examined vs. pairs inside the cutoff, packed iterations that were fully masked and the average
+	 * lane utilization of the packed iterations that evaluated the force. Low within-cutoff shares point at
+	 * too large cells or skins, low lane utilization at too large clusters (AoSoA chunks) for the density.
+	 * Requires APRIL_ENABLE_INTERACTION_COUNTERS=1, otherwise the result is marked unavailable.
+	 */
+	class InteractionDiagnostics : public monitor::Monitor {
+	public:
+		struct TypePairStats {
+			ParticleType type1;   // dense system types (see BuildInfo::type_map)
+			ParticleType type2;
+			utility::InteractionCounts counts; // both orders of the pair
+		};
+
+		struct InteractionDiagnosticsResult {
+			bool available = false;
+			size_t steps = 0;
+			utility::InteractionCounts total;
+			std::vector<TypePairStats> type_pairs; // pairs that were examined at least once
+
+			void print_report() const {
+				std::cout << "\n" << std::string(86, '-') << "\n";
+				std::cout << " [APRIL INTERACTION DIAGNOSTICS] " << steps << " steps\n";
+				std::cout << std::string(86, '-') << "\n";
+
+				if (!available) {
+					std::cout << "  unavailable (build with APRIL_ENABLE_INTERACTION_COUNTERS=ON)\n";
+					std::cout << std::string(86, '-') << "\n\n";
+					return;
+				}
+
+				std::cout << std::left << std::setw(14) << "  types" << std::right
+						  << std::setw(16) << "examined/step" << std::setw(16) << "within/step"
+						  << std::setw(12) << "% within" << std::setw(14) << "% masked it."
+						  << std::setw(14) << "% lane util." << "\n";
+
+				auto print_row = [&](const std::string& label, const utility::InteractionCounts& c) {
+					const double n = steps ? static_cast<double>(steps) : 1.0;
+					std::cout << std::left << std::setw(14) << "  " + label << std::right << std::fixed
+							  << std::setprecision(0)
+							  << std::setw(16) << static_cast<double>(c.pairs_examined) / n
+							  << std::setw(16) << static_cast<double>(c.pairs_within) / n
+							  << std::setprecision(2)
+							  << std::setw(12) << 100 * c.within_fraction();
+					if (c.packed_iterations == 0) {
+						std::cout << std::setw(14) << "-" << std::setw(14) << "-" << "\n"; // scalar kernel only
+						return;
+					}
+					std::cout << std::setw(14) << 100 * c.masked_fraction()
+							  << std::setw(14) << 100 * c.lane_utilization() << "\n";
+				};
+
+				for (const auto& p : type_pairs) {
+					print_row(std::to_string(p.type1) + "-" + std::to_string(p.type2), p.counts);
+				}
+				print_row("total", total);
+				std::cout << std::string(86, '-') << "\n\n";
+			}
+		};
+
+		InteractionDiagnostics() : Monitor(Trigger::always()) {}
+		explicit InteractionDiagnostics(InteractionDiagnosticsResult * res) : Monitor(Trigger::always()), result(res) {}
+
+		template<class S>
+		void before_step(const core::SystemContext<S> & sys) {
+			if (counters) return;
+
+			// the counters belong to the System; start from zero so earlier runs do not leak in
+			counters = &sys.interaction_counters();
+			counters->reset();
+			counters->enable(true);
+		}
+
+		template<class S>
+		void record(const core::SystemContext<S> &) {
+			steps++;
+		}
+
+		void finalize() {
+			if (!counters) return;
+			counters->enable(false);
+
+			const auto res = calculate_results(counters->snapshot());
+			res.print_report();
+
+			if (result) {
+				*result = res;
+			}
+			counters = nullptr;
+			steps = 0;
+		}
+
+	private:
+		utility::InteractionCounters * counters = nullptr; // of the monitored System, set on the first step
+		size_t steps = 0;
+		InteractionDiagnosticsResult * result = nullptr;
+
+		InteractionDiagnosticsResult calculate_results(const utility::InteractionCountTable & table) const {
+			InteractionDiagnosticsResult res;
+			res.available = utility::interaction_counters_compiled_in;
+			res.steps = steps;
+			res.total = table.total();
+
+			for (size_t t1 = 0; t1 < table.n_types; ++t1) {
+				for (size_t t2 = t1; t2 < table.n_types; ++t2) {
+					const auto c = table.pair(static_cast<ParticleType>(t1), static_cast<ParticleType>(t2));
+					if (c.pairs_examined == 0) continue;
+					res.type_pairs.push_back({static_cast<ParticleType>(t1), static_cast<ParticleType>(t2), c});
+				}
+			}
+			return res;
+		}
+	};
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "april/monitors/monitor.hpp"
+#include "april/containers/skin_tuning.hpp"
+
+namespace april {
+
+	/**
+	 * @brief Reports the decisions of the container's adaptive Verlet skin (see LinkedCells::with_adaptive_skin).
+	 *
+	 * Lists every decision taken during the run with the measured costs it was based on (rebuild time, pair
+	 * traversal time per step, displacement per step, observed rebuild rate), the predicted saving and the grid
+	 * that was chosen. The result is marked unavailable if the container has no adaptive skin.
+	 */
+	class SkinTuningReport : public monitor::Monitor {
+	public:
+		struct SkinTuningResult {
+			bool available = false;
+			size_t steps = 0;
+			double final_skin = 0;
+			uint3 final_cells{};
+			size_t rebuilds = 0; // during the run, regrids not included
+			size_t regrids = 0;
+			std::vector<container::SkinDecision> decisions; // taken during the run
+
+			void print_report() const {
+				std::cout << "\n" << std::string(100, '-') << "\n";
+				std::cout << " [APRIL SKIN TUNING] " << steps << " steps\n";
+				std::cout << std::string(100, '-') << "\n";
+
+				if (!available) {
+					std::cout << "  unavailable (container has no adaptive skin)\n";
+					std::cout << std::string(100, '-') << "\n\n";
+					return;
+				}
+
+				std::cout << std::right << std::setw(10) << "update" << std::setw(11) << "skin"
+						  << std::setw(12) << "disp/step" << std::setw(13) << "rebuild [s]"
+						  << std::setw(13) << "pairs [s]" << std::setw(13) << "rebuilds/st"
+						  << std::setw(10) << "% gain" << "  cells\n";
+
+				auto cells = [](const uint3& c) {
+					return std::to_string(c.x) + "x" + std::to_string(c.y) + "x" + std::to_string(c.z);
+				};
+
+				for (const auto& d : decisions) {
+					std::cout << std::setw(10) << d.update << std::scientific << std::setprecision(3)
+							  << std::setw(11) << d.new_skin << std::setw(12) << d.displacement_rate
+							  << std::setw(13) << d.rebuild_sec << std::setw(13) << d.traversal_sec
+							  << std::fixed << std::setprecision(3) << std::setw(13) << d.rebuilds_per_step
+							  << std::setprecision(1) << std::setw(10) << 100 * d.predicted_gain << "  "
+							  << (d.regridded ? cells(d.old_cells) + " -> " + cells(d.new_cells) : cells(d.new_cells))
+							  << std::defaultfloat << "\n";
+				}
+
+				std::cout << "  final skin " << final_skin << ", " << cells(final_cells) << " cells, "
+						  << rebuilds << " rebuilds, " << regrids << " regrids\n";
+				std::cout << std::string(100, '-') << "\n\n";
+			}
+		};
+
+		SkinTuningReport() : Monitor(Trigger::always()) {}
+		explicit SkinTuningReport(SkinTuningResult * res) : Monitor(Trigger::always()), result(res) {}
+
+		template<class S>
+		void before_step(const core::SystemContext<S> & sys) {
+			if (steps > 0 || log) return;
+
+			// the log belongs to the container and spans all runs; only report what happens in this one
+			log = sys.skin_tuning();
+			if (log) {
+				first_decision = log->decisions.size();
+				first_rebuilds = log->rebuilds;
+				first_regrids = log->regrids;
+			}
+		}
+
+		template<class S>
+		void record(const core::SystemContext<S> &) {
+			steps++;
+		}
+
+		void finalize() {
+			const auto res = calculate_results();
+			res.print_report();
+
+			if (result) {
+				*result = res;
+			}
+			log = nullptr;
+			steps = 0;
+		}
+
+	private:
+		const container::SkinTuningLog * log = nullptr; // of the monitored container, set on the first step
+		size_t first_decision = 0;
+		size_t first_rebuilds = 0;
+		size_t first_regrids = 0;
+		size_t steps = 0;
+		SkinTuningResult * result = nullptr;
+
+		SkinTuningResult calculate_results() const {
+			SkinTuningResult res;
+			res.steps = steps;
+			if (!log) return res;
+
+			res.available = true;
+			res.final_skin = log->skin;
+			res.final_cells = log->cells_per_axis;
+			res.rebuilds = log->rebuilds - first_rebuilds;
+			res.regrids = log->regrids - first_regrids;
+			res.decisions.assign(log->decisions.begin() + static_cast<std::ptrdiff_t>(first_decision), log->decisions.end());
+			return res;
+		}
+	};
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "april/monitors/monitor.hpp"
+#include "april/utility/stage_profile.hpp"
+
+namespace april {
+
+	/**
+	 * @brief Breaks the step time down into System stages and container phases.
+	 *
+	 * Enables the stage timing points of the integrating thread while the run lasts. Container phases
+	 * (colors, wrap and topology phases, reorder sub-steps) are nested inside the System stages, so only the
+	 * System stages add up to the step time. Statistics are taken over the steps in which a stage ran.
+	 */
+	class StageTimer : public monitor::Monitor {
+	public:
+		struct StageStats {
+			utility::Stage stage;
+			uint32_t phase;     // color / phase index for phased stages, 0 otherwise
+			size_t steps;       // number of steps the stage ran in
+			uint64_t calls;
+			double min_sec;     // per step
+			double median_sec;  // per step
+			double max_sec;     // per step
+			double total_sec;
+			double percent;     // of the total step time
+
+			[[nodiscard]] std::string label() const {
+				std::string name(utility::stage_name(stage));
+				if (utility::is_phased_stage(stage)) name += " " + std::to_string(phase);
+				return utility::is_system_stage(stage) ? name : "  " + name;
+			}
+		};
+
+		struct StageTimerResult {
+			size_t steps = 0;
+			double step_time_sec = 0; // summed over all recorded steps
+			std::vector<StageStats> stages; // system stages first, then container phases, both in stage order
+
+			void print_report() const {
+				std::cout << "\n" << std::string(78, '-') << "\n";
+				std::cout << " [APRIL STAGE TIMES] " << steps << " steps, " << std::fixed << std::setprecision(6)
+						  << step_time_sec << " s\n";
+				std::cout << std::string(78, '-') << "\n";
+
+				std::cout << std::left << std::setw(26) << "  stage"
+						  << std::right << std::setw(12) << "min [ms]" << std::setw(12) << "median [ms]"
+						  << std::setw(12) << "max [ms]" << std::setw(10) << "% step" << "\n";
+
+				for (const auto& s : stages) {
+					std::cout << std::left << std::setw(26) << "  " + s.label() << std::right << std::setprecision(4)
+							  << std::setw(12) << s.min_sec * 1e3
+							  << std::setw(12) << s.median_sec * 1e3
+							  << std::setw(12) << s.max_sec * 1e3
+							  << std::setprecision(2) << std::setw(10) << s.percent << "\n";
+				}
+				std::cout << std::string(78, '-') << "\n\n";
+			}
+		};
+
+		StageTimer() : Monitor(Trigger::always()) {}
+		explicit StageTimer(StageTimerResult * res) : Monitor(Trigger::always()), result(res) {}
+
+		void initialize() {
+			utility::StageProfile::local().enable(true);
+		}
+
+		template<class S>
+		void before_step(const core::SystemContext<S> &) {
+			utility::StageProfile::local().reset();
+			start_time = Clock::now();
+		}
+
+		template<class S>
+		void record(const core::SystemContext<S> &) {
+			step_times.push_back(std::chrono::duration<double>(Clock::now() - start_time).count());
+
+			const auto& profile = utility::StageProfile::local();
+			for (size_t s = 0; s < utility::n_stages; ++s) {
+				const auto& entries = profile.entries(static_cast<utility::Stage>(s));
+				auto& stage_samples = samples[s];
+				if (stage_samples.size() < entries.size()) stage_samples.resize(entries.size());
+
+				for (size_t phase = 0; phase < entries.size(); ++phase) {
+					if (entries[phase].calls == 0) continue;
+					stage_samples[phase].per_step.push_back(entries[phase].seconds);
+					stage_samples[phase].calls += entries[phase].calls;
+				}
+			}
+		}
+
+		void finalize() {
+			utility::StageProfile::local().enable(false);
+			if (step_times.empty()) return;
+
+			const auto res = calculate_results();
+			res.print_report();
+
+			if (result) {
+				*result = res;
+			}
+		}
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Samples {
+			std::vector<double> per_step;
+			uint64_t calls = 0;
+		};
+
+		Clock::time_point start_time;
+		std::vector<double> step_times;
+		std::array<std::vector<Samples>, utility::n_stages> samples; // [stage][phase]
+		StageTimerResult * result = nullptr;
+
+		StageTimerResult calculate_results() const {
+			StageTimerResult res;
+			res.steps = step_times.size();
+			for (const double t : step_times) res.step_time_sec += t;
+
+			for (size_t s = 0; s < utility::n_stages; ++s) {
+				for (size_t phase = 0; phase < samples[s].size(); ++phase) {
+					const auto& sample = samples[s][phase];
+					if (sample.per_step.empty()) continue;
+
+					std::vector<double> sorted = sample.per_step;
+					std::ranges::sort(sorted);
+
+					double total = 0;
+					for (const double t : sorted) total += t;
+
+					res.stages.push_back(StageStats{
+						.stage = static_cast<utility::Stage>(s),
+						.phase = static_cast<uint32_t>(phase),
+						.steps = sorted.size(),
+						.calls = sample.calls,
+						.min_sec = sorted.front(),
+						.median_sec = sorted[sorted.size() / 2],
+						.max_sec = sorted.back(),
+						.total_sec = total,
+						.percent = res.step_time_sec > 0 ? 100.0 * total / res.step_time_sec : 0.0
+					});
+				}
+			}
+			return res;
+		}
+	};
+}
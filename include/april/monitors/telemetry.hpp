@@ -0,0 +1,172 @@
+#pragma once
+
+#if defined(__unix__)
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include "april/monitors/monitor.hpp"
+#include "april/utility/stage_profile.hpp"
+#include "april/utility/telemetry_buffer.hpp"
+
+namespace april {
+
+	/**
+	 * @brief Publishes live run statistics into a shared memory ring buffer (see utility/telemetry_buffer.hpp).
+	 *
+	 * Every publish_every steps (and after the last step) one TelemetrySample is written: step rate, MUPS,
+	 * per-stage times, particle counts by state, rebuilds and kinetic energy diagnostics. Per step the monitor
+	 * only takes two timestamps and reads the stage profile; the O(N) pass for counts and energies runs once per
+	 * sample. Read the segment with utility::TelemetryReader or april_telemetry_reader.
+	 *
+	 * The segment is created on initialize and removed when the monitor is destroyed. Like StageTimer, the
+	 * monitor enables the stage timing points of the integrating thread while the run lasts.
+	 */
+	class Telemetry : public monitor::Monitor {
+	public:
+		static constexpr size_t default_publish_every = 100;
+
+		// name follows shm_open rules, e.g. "/april_run"
+		explicit Telemetry(
+			std::string segment_name = default_segment_name(),
+			const size_t publish_every = default_publish_every,
+			const size_t capacity = utility::TelemetryWriter::default_capacity,
+			std::string run_name = {}
+		):
+			Monitor(Trigger::always()),
+			name(std::move(segment_name)),
+			run_label(std::move(run_name)),
+			every(publish_every ? publish_every : 1),
+			ring_capacity(capacity)
+		{}
+
+		// "/april_telemetry_<pid>"
+		[[nodiscard]] static std::string default_segment_name() {
+			return "/april_telemetry_" + std::to_string(getpid());
+		}
+
+		[[nodiscard]] const std::string& segment_name() const noexcept { return name; }
+
+		void initialize() {
+			// a second run of the same integrator keeps publishing into the existing segment
+			if (!writer) writer = std::make_shared<utility::TelemetryWriter>(name, ring_capacity, run_label.empty() ? name : run_label);
+			writer->set_status(utility::TelemetryStatus::Running);
+
+			utility::StageProfile::local().enable(true);
+			run_start = Clock::now();
+			window = {};
+			total_rebuilds = 0;
+		}
+
+		template<class S>
+		void before_step(const core::SystemContext<S> &) {
+			utility::StageProfile::local().reset();
+			step_start = Clock::now();
+		}
+
+		template<class S>
+		void record(const core::SystemContext<S> & sys) {
+			window.integration_sec += std::chrono::duration<double>(Clock::now() - step_start).count();
+			window.steps++;
+			window.updates += sys.size();
+
+			const auto& profile = utility::StageProfile::local();
+			for (size_t s = 0; s < utility::telemetry_stage_slots; ++s) {
+				for (const auto& e : profile.entries(static_cast<utility::Stage>(s))) window.stage_sec[s] += e.seconds;
+			}
+			for (const auto& e : profile.entries(utility::Stage::ReorderCount)) {
+				if (e.calls == 0) continue;
+				window.rebuilds++;
+				break;
+			}
+
+			if (window.steps >= every || sys.step() >= start_step + num_steps) {
+				publish(sys);
+			}
+		}
+
+		void finalize() {
+			utility::StageProfile::local().enable(false);
+			if (writer) writer->set_status(utility::TelemetryStatus::Finished);
+		}
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Window {
+			size_t steps = 0;
+			uint64_t updates = 0;
+			uint64_t rebuilds = 0;
+			double integration_sec = 0;
+			double stage_sec[utility::telemetry_stage_slots] = {};
+		};
+
+		std::string name;
+		std::string run_label;
+		size_t every;
+		size_t ring_capacity;
+
+		std::shared_ptr<utility::TelemetryWriter> writer; // shared so the monitor stays copyable
+		Clock::time_point run_start, step_start;
+		Window window;
+		uint64_t total_rebuilds = 0;
+
+		template<class S>
+		void publish(const core::SystemContext<S> & sys) {
+			const double steps = static_cast<double>(window.steps);
+			total_rebuilds += window.rebuilds;
+
+			utility::TelemetrySample sample;
+			sample.step = sys.step();
+			sample.time = sys.time();
+			sample.wall_time_sec = std::chrono::duration<double>(Clock::now() - run_start).count();
+			sample.window_steps = window.steps;
+			sample.rebuilds = window.rebuilds;
+			sample.total_rebuilds = total_rebuilds;
+			if (window.integration_sec > 0) {
+				sample.steps_per_sec = steps / window.integration_sec;
+				sample.mups = static_cast<double>(window.updates) / window.integration_sec / 1'000'000.0;
+			}
+			sample.step_time_sec = window.integration_sec / steps;
+			for (size_t s = 0; s < utility::telemetry_stage_slots; ++s) sample.stage_sec[s] = window.stage_sec[s] / steps;
+
+			add_particle_statistics(sys, sample);
+			writer->publish(sample);
+			window = {};
+		}
+
+		template<class S>
+		static void add_particle_statistics(const core::SystemContext<S> & sys, utility::TelemetrySample & sample) {
+			constexpr auto fields = ParticleField::state | ParticleField::velocity | ParticleField::mass;
+			using Count = utility::TelemetryCount;
+
+			double kinetic = 0;
+			vec3 momentum{0, 0, 0};
+			sys.for_each_particle_view(scalar_kernel<fields>(
+				[&](const auto & p) {
+					switch (p.state) {
+						case ParticleState::ALIVE:      sample.particles[static_cast<size_t>(Count::Alive)]++; break;
+						case ParticleState::PASSIVE:    sample.particles[static_cast<size_t>(Count::Passive)]++; break;
+						case ParticleState::STATIONARY: sample.particles[static_cast<size_t>(Count::Stationary)]++; break;
+						case ParticleState::DEAD:       sample.particles[static_cast<size_t>(Count::Dead)]++; return;
+						default: return;
+					}
+					if (p.state == ParticleState::STATIONARY) return;
+					kinetic += 0.5 * p.mass * p.velocity.norm_squared();
+					momentum += p.mass * p.velocity;
+				}
+			));
+
+			const uint64_t movable = sample.count(Count::Alive) + sample.count(Count::Passive);
+			sample.kinetic_energy = kinetic;
+			sample.temperature = movable ? 2.0 * kinetic / (3.0 * static_cast<double>(movable)) : 0.0;
+			sample.momentum[0] = momentum.x;
+			sample.momentum[1] = momentum.y;
+			sample.momentum[2] = momentum.z;
+		}
+	};
+}
+
+#endif
@@ -114,6 +114,7 @@ namespace april::particle::internal {
         APRIL_NO_UNIQUE_ADDRESS packed_field_t<ParticleID, ParticleField::id> id;
 
         APRIL_NO_UNIQUE_ADDRESS buffer_field_t<AttributesPack, ParticleField::attributes> attributes;
+        APRIL_NO_UNIQUE_ADDRESS packed_field_t<double, ParticleField::scratch> scratch;
 
         PackedParticleBuffer() {
             bind_masks();
@@ -147,6 +148,8 @@ namespace april::particle::internal {
                 force = source.force;
             if constexpr (has_field_v<ReadMask, ParticleField::mass>)
                 mass = source.mass.load();
+            if constexpr (has_field_v<ReadMask, ParticleField::scratch>)
+                scratch = source.scratch.load();
             if constexpr (has_field_v<ReadMask, ParticleField::state>)
                 state = source.state.load();
             if constexpr (has_field_v<ReadMask, ParticleField::type>)
@@ -168,6 +171,8 @@ namespace april::particle::internal {
                 force = pvec3(0.0);
             if constexpr (has_field_v<WOMask, ParticleField::mass>)
                 mass = 0.0;
+            if constexpr (has_field_v<WOMask, ParticleField::scratch>)
+                scratch = 0.0;
         }
 
         /**
@@ -202,6 +207,13 @@ namespace april::particle::internal {
                 mass = 0.0;
             }
 
+            if constexpr (has_field_v<ReadMask, ParticleField::scratch>) {
+                scratch = scalar.scratch;
+            }
+            else if constexpr (has_field_v<WOMask, ParticleField::scratch>) {
+                scratch = 0.0;
+            }
+
             if constexpr (has_field_v<ReadMask, ParticleField::state>) state = scalar.state;
             if constexpr (has_field_v<ReadMask, ParticleField::type>) type = scalar.type;
             if constexpr (has_field_v<ReadMask, ParticleField::id>) id = scalar.id;
@@ -290,6 +302,7 @@ namespace april::particle::internal {
             if constexpr (has_field_v<WOMask, ParticleField::velocity>) velocity += other.velocity;
             if constexpr (has_field_v<WOMask, ParticleField::force>) force += other.force;
             if constexpr (has_field_v<WOMask, ParticleField::mass>) mass += other.mass;
+            if constexpr (has_field_v<WOMask, ParticleField::scratch>) scratch += other.scratch;
         }
 
         /**
@@ -315,6 +328,9 @@ namespace april::particle::internal {
             if constexpr (has_field_v<WOMask, ParticleField::mass>) {
                 mass += select(mask, other.mass, null);
             }
+            if constexpr (has_field_v<WOMask, ParticleField::scratch>) {
+                scratch += select(mask, other.scratch, null);
+            }
         }
 
         /**
@@ -344,6 +360,7 @@ namespace april::particle::internal {
             update_field.template operator()<ParticleField::velocity>(packed_ref.velocity, velocity);
             update_field.template operator()<ParticleField::force>(packed_ref.force, force);
             update_field.template operator()<ParticleField::mass>(packed_ref.mass, mass);
+            update_field.template operator()<ParticleField::scratch>(packed_ref.scratch, scratch);
 
             if constexpr (has_field_v<RWMask, ParticleField::state>) packed_ref.state = state;
             if constexpr (has_field_v<RWMask, ParticleField::type>) packed_ref.type = type;
@@ -369,6 +386,11 @@ namespace april::particle::internal {
                 packed_ref.mass += select(mask, mass, 0.0);
             else if constexpr (has_field_v<RWMask, ParticleField::mass>)
                 packed_ref.mass = select(mask, mass, packed_ref.mass);
+
+            if constexpr (has_field_v<WOMask, ParticleField::scratch>)
+                packed_ref.scratch += select(mask, scratch, 0.0);
+            else if constexpr (has_field_v<RWMask, ParticleField::scratch>)
+                packed_ref.scratch = select(mask, scratch, packed_ref.scratch);
         }
 
         /**
@@ -390,6 +412,11 @@ namespace april::particle::internal {
                 p.mass += mass.reduce_add();
             else if constexpr (has_field_v<RWMask, ParticleField::mass>)
                 static_assert(sizeof(ScalarAccessor) == 0, "Cannot reduce RW mass.");
+
+            if constexpr (has_field_v<WOMask, ParticleField::scratch>)
+                p.scratch += scratch.reduce_add();
+            else if constexpr (has_field_v<RWMask, ParticleField::scratch>)
+                static_assert(sizeof(ScalarAccessor) == 0, "Cannot reduce RW scratch.");
         }
 
         /**
@@ -408,6 +435,11 @@ namespace april::particle::internal {
                 p.mass += select(mask, mass, 0.0).reduce_add();
             else if constexpr (has_field_v<RWMask, ParticleField::mass>)
                 static_assert(sizeof(ScalarAccessor) == 0, "FATAL: Cannot masked reduce RW mass.");
+
+            if constexpr (has_field_v<WOMask, ParticleField::scratch>)
+                p.scratch += select(mask, scratch, 0.0).reduce_add();
+            else if constexpr (has_field_v<RWMask, ParticleField::scratch>)
+                static_assert(sizeof(ScalarAccessor) == 0, "FATAL: Cannot masked reduce RW scratch.");
         }
 
     private:
@@ -433,6 +465,8 @@ namespace april::particle::internal {
                 bind_vec(force);
             if constexpr (has_field_v<EffectiveWriteMask, ParticleField::mass>)
                 mass.bind_mask(write_mask);
+            if constexpr (has_field_v<EffectiveWriteMask, ParticleField::scratch>)
+                scratch.bind_mask(write_mask);
             if constexpr (has_field_v<EffectiveWriteMask, ParticleField::state>)
                 state.bind_mask(write_mask);
             if constexpr (has_field_v<EffectiveWriteMask, ParticleField::type>)
@@ -491,6 +525,7 @@ namespace april::particle::internal {
             rotate_vec.template operator()<ParticleField::force>(force);
 
             rotate_scalar.template operator()<ParticleField::mass>(mass);
+            rotate_scalar.template operator()<ParticleField::scratch>(scratch);
             rotate_scalar.template operator()<ParticleField::state>(state);
             rotate_scalar.template operator()<ParticleField::type>(type);
             rotate_scalar.template operator()<ParticleField::id>(id);
@@ -64,6 +64,7 @@ namespace april::particle::internal {
         APRIL_NO_UNIQUE_ADDRESS view_ref_t<ParticleField::type, decltype(Buffer::type)> type;
         APRIL_NO_UNIQUE_ADDRESS view_ref_t<ParticleField::id, decltype(Buffer::id)> id;
         APRIL_NO_UNIQUE_ADDRESS view_ref_t<ParticleField::attributes, decltype(Buffer::attributes)> attributes;
+        APRIL_NO_UNIQUE_ADDRESS view_ref_t<ParticleField::scratch, decltype(Buffer::scratch)> scratch;
 
         /**
           * Binds the buffer's registers to the view's references.
@@ -79,6 +80,7 @@ namespace april::particle::internal {
               type(buf.type),
               id(buf.id),
               attributes(buf.attributes),
+              scratch(buf.scratch),
               buffer(&buf)
             {}
 
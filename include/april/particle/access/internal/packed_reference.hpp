@@ -78,6 +78,7 @@ namespace april::particle::internal {
           , type(init_field<ParticleField::type>(source))
           , id(init_field<ParticleField::id>(source))
           , attributes(init_field<ParticleField::attributes>(source))
+          , scratch(init_field<ParticleField::scratch>(source))
         {}
 
         /**
@@ -96,6 +97,7 @@ namespace april::particle::internal {
               , type(r.type)
               , id(r.id)
               , attributes(r.attributes)
+              , scratch(r.scratch)
         {}
 
         /**
@@ -127,6 +129,7 @@ namespace april::particle::internal {
         APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::id> id;
 
         APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::attributes> attributes;
+        APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::scratch> scratch;
     };
 
     template<
@@ -117,6 +117,7 @@ namespace april::particle::internal {
 		  , type        (init_scalar_field<ReadAccess, WriteAccess, ParticleField::type>         (source))
 		  , id          (init_scalar_field<ReadAccess, WriteAccess, ParticleField::id>           (source))
 		  , attributes  (init_scalar_field<ReadAccess, WriteAccess, ParticleField::attributes>   (source))
+		  , scratch     (init_scalar_field<ReadAccess, WriteAccess, ParticleField::scratch>      (source))
 		{}
 
 		/**
@@ -137,6 +138,7 @@ namespace april::particle::internal {
           , type        (r.type)
           , id          (r.id)
           , attributes  (r.attributes)
+          , scratch     (r.scratch)
 		{}
 
 		/**
@@ -167,6 +169,7 @@ namespace april::particle::internal {
 		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleType&,  const ParticleType&,  ParticleField::type>         type;
 		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleID&,    const ParticleID&,    ParticleField::id>           id;
 		APRIL_NO_UNIQUE_ADDRESS field_t<Attributes&,    const Attributes&,    ParticleField::attributes>   attributes;
+		APRIL_NO_UNIQUE_ADDRESS field_t<double&,        const double&,        ParticleField::scratch>      scratch;
     };
 
 
@@ -179,6 +179,7 @@ namespace april::particle::internal {
 			, type(init_field<ParticleField::type>(getter))
 			, id(init_field<ParticleField::id>(getter))
 			, attributes(init_field<ParticleField::attributes>(getter))
+			, scratch(init_field<ParticleField::scratch>(getter))
 		{}
 
 		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::force> force;
@@ -191,6 +192,7 @@ namespace april::particle::internal {
 		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::type> type;
 		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::id> id;
 		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::attributes> attributes;
+		APRIL_NO_UNIQUE_ADDRESS field_t<ParticleField::scratch> scratch;
 
 		template<ParticleField F>
 		constexpr decltype(auto) get() const noexcept {
@@ -204,6 +206,7 @@ namespace april::particle::internal {
 				else if constexpr (F == ParticleField::type) return (type);
 				else if constexpr (F == ParticleField::id) return (id);
 				else if constexpr (F == ParticleField::attributes) return (attributes);
+				else if constexpr (F == ParticleField::scratch) return (scratch);
 			} else {
 				return AccessForbidden<F>{};
 			}
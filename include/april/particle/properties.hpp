@@ -26,6 +26,7 @@ namespace april {
         type         = 1u << 6,
         id           = 1u << 7,
         attributes   = 1u << 8,
+        scratch      = 1u << 9, ///< Transient per-particle scalar used by many-body forces (not part of `all`).
 
         all = position
             | velocity
@@ -35,7 +36,7 @@ namespace april {
             | mass
             | type
             | id
-            | attributes
+            | attributes // scratch is transient and must be requested explicitly
     };
     APRIL_ENABLE_BITMASK_OPERATORS(ParticleField)
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <type_traits>
 
 #include "april/particle/attributes.hpp"
@@ -271,6 +273,17 @@ namespace april::simd {
     GatherLocation(T&, const ByteOffsets<N>&)
         -> GatherLocation<T, N>;
 
+    // builds a gather location from arbitrary per-lane addresses (offsets are relative to lane 0)
+    template<typename T, size_t W>
+    [[nodiscard]] auto make_gather_location(const std::array<T*, W>& ptrs) noexcept {
+        std::array<std::ptrdiff_t, W> offsets{};
+        const auto* base = reinterpret_cast<const std::byte*>(ptrs[0]);
+        for (size_t i = 0; i < W; ++i) {
+            offsets[i] = reinterpret_cast<const std::byte*>(ptrs[i]) - base;
+        }
+        return GatherLocation<T, W>(ptrs[0], ByteOffsets<W>(offsets));
+    }
+
 
     static_assert(IsWritableLocation<ContiguousLocation<double>>);
     static_assert(IsWritableLocation<ContiguousLocation<int>>);
@@ -1,4 +1,7 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
 #include <ranges>
 #include <vector>
 #include <unordered_map>
@@ -18,36 +21,46 @@ namespace april::utility::graph {
     using AdjacencyList = std::vector<std::vector<Node>>;
 
 
-    // @brief Find all connected components in an edge list graph using union-find
-    template <typename Node>
-    std::vector<EdgeList<Node>> find_connected_components(const EdgeList<Node>& edges) {
-        if (edges.empty()) return {};
+    // Hyperedge list representation (ordered node tuples e.g. angles or dihedrals)
+    template <typename Node, std::size_t N>
+    using TupleList = std::vector<std::array<Node, N>>;
 
-        struct {
-            std::unordered_map<Node, Node> parent;
 
-            // find representative of the connected component containing id (i.e. the root parent of id)
-            Node find(const Node i) {
-                if (!parent.contains(i)) { // no parent? set i to be its own parent
-                    parent[i] = i;
-                    return i;
-                }
-                if (parent[i] == i) {
-                    return i;
-                }
-                // path compression for shorter look-ups
-                return parent[i] = find(parent[i]);
+    // disjoint-set-union: standard Union-Find data structure to identify connected components
+    template <typename Node>
+    struct DisjointSets {
+        std::unordered_map<Node, Node> parent;
+
+        // find representative of the connected component containing id (i.e. the root parent of id)
+        Node find(const Node i) {
+            if (!parent.contains(i)) { // no parent? set i to be its own parent
+                parent[i] = i;
+                return i;
+            }
+            if (parent[i] == i) {
+                return i;
             }
+            // path compression for shorter look-ups
+            return parent[i] = find(parent[i]);
+        }
 
-            // unite two connected components containing i and j
-            void unite(const Node i, const Node j) {
-                const Node root_i = find(i);
-                const Node root_j = find(j);
-                if (root_i != root_j) {
-                    parent[root_i] = root_j;
-                }
+        // unite two connected components containing i and j
+        void unite(const Node i, const Node j) {
+            const Node root_i = find(i);
+            const Node root_j = find(j);
+            if (root_i != root_j) {
+                parent[root_i] = root_j;
             }
-        } dsu; // disjoint-set-union: standard Union-Find data structure to identify connected components
+        }
+    };
+
+
+    // @brief Find all connected components in an edge list graph using union-find
+    template <typename Node>
+    std::vector<EdgeList<Node>> find_connected_components(const EdgeList<Node>& edges) {
+        if (edges.empty()) return {};
+
+        DisjointSets<Node> dsu;
 
         // find all connected components
         for (const auto& pair : edges) {
@@ -73,6 +86,35 @@ namespace april::utility::graph {
     }
 
 
+    // @brief Find all connected components in a hypergraph given as a list of node tuples
+    template <typename Node, std::size_t N>
+    std::vector<TupleList<Node, N>> find_connected_components(const TupleList<Node, N>& tuples) {
+        if (tuples.empty()) return {};
+
+        DisjointSets<Node> dsu;
+
+        // all nodes of a tuple belong to the same component
+        for (const auto& tuple : tuples) {
+            for (std::size_t i = 1; i < N; ++i) {
+                dsu.unite(tuple[0], tuple[i]);
+            }
+        }
+
+        std::unordered_map<Node, TupleList<Node, N>> component_map;
+        for (const auto& tuple : tuples) {
+            component_map[dsu.find(tuple[0])].push_back(tuple);
+        }
+
+        std::vector<TupleList<Node, N>> connected_components;
+        connected_components.reserve(component_map.size());
+        for (auto& batch : component_map | std::views::values) {
+            connected_components.push_back(std::move(batch));
+        }
+
+        return connected_components;
+    }
+
+
     // @brief Return all (unique) nodes given an edge-list graph
     template <typename Node>
     std::vector<Node> get_unique_nodes(const EdgeList<Node>& edges) {
@@ -92,6 +134,24 @@ namespace april::utility::graph {
     }
 
 
+    // @brief Return all (unique) nodes given a list of node tuples
+    template <typename Node, std::size_t N>
+    std::vector<Node> get_unique_nodes(const TupleList<Node, N>& tuples) {
+        std::vector<Node> nodes;
+        nodes.reserve(tuples.size() * N);
+
+        for (const auto& tuple : tuples) {
+            nodes.insert(nodes.end(), tuple.begin(), tuple.end());
+        }
+
+        std::ranges::sort(nodes);
+        auto [first, last] = std::ranges::unique(nodes);
+        nodes.erase(first, last);
+
+        return nodes;
+    }
+
+
     // @brief Build an Intersection Graph (Adjacency List) from collections of nodes
     template <typename Node>
     AdjacencyList<size_t> build_intersection_graph(const std::vector<std::vector<Node>>& node_sets) {
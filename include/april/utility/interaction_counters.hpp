@@ -0,0 +1,180 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "april/exec/hardware.hpp"
+#include "april/particle/properties.hpp"
+#include "april/utility/debug.hpp"
+
+/*
+ * Interaction-efficiency counters of the pairwise force kernel: how many pairs the containers hand to the
+ * kernel, how many of them are inside the cutoff and how well the SIMD lanes are used. Counting is only
+ * compiled in with APRIL_ENABLE_INTERACTION_COUNTERS=1 and additionally has to be enabled at runtime.
+ *
+ * Packed iterations are counted per lane, so masked-off lanes of partial tails and the duplicated lanes of
+ * the last rotation of a symmetric block sweep are included: the numbers describe the work executed, which
+ * slightly exceeds the number of unique pairs.
+ */
+
+#ifndef APRIL_ENABLE_INTERACTION_COUNTERS
+	#define APRIL_ENABLE_INTERACTION_COUNTERS 0
+#endif
+
+namespace april::utility {
+
+	inline constexpr bool interaction_counters_compiled_in = APRIL_ENABLE_INTERACTION_COUNTERS;
+
+	struct InteractionCounts {
+		uint64_t pairs_examined = 0;    // pairs (lanes) the cutoff test ran for
+		uint64_t pairs_within = 0;      // of those inside the cutoff
+		uint64_t packed_iterations = 0; // packed kernel calls
+		uint64_t masked_iterations = 0; // packed calls with every lane outside the cutoff (early exit)
+		uint64_t evaluated_lanes = 0;   // lanes of the packed calls that went on to evaluate the force
+		uint64_t evaluated_within = 0;  // lanes of those inside the cutoff
+
+		void add_packed(const uint64_t outside_bits, const size_t width) noexcept {
+			const auto within = static_cast<uint64_t>(width) - static_cast<uint64_t>(std::popcount(outside_bits));
+			pairs_examined += width;
+			pairs_within += within;
+			packed_iterations++;
+			if (within == 0) {
+				masked_iterations++;
+				return;
+			}
+			evaluated_lanes += width;
+			evaluated_within += within;
+		}
+
+		void add_scalar(const bool within) noexcept {
+			pairs_examined++;
+			pairs_within += within;
+		}
+
+		// share of examined pairs inside the cutoff
+		[[nodiscard]] double within_fraction() const noexcept {
+			return pairs_examined ? static_cast<double>(pairs_within) / static_cast<double>(pairs_examined) : 0.0;
+		}
+
+		// share of packed calls that exited early
+		[[nodiscard]] double masked_fraction() const noexcept {
+			return packed_iterations ? static_cast<double>(masked_iterations) / static_cast<double>(packed_iterations) : 0.0;
+		}
+
+		// average share of useful lanes in the packed calls that evaluated the force
+		[[nodiscard]] double lane_utilization() const noexcept {
+			return evaluated_lanes ? static_cast<double>(evaluated_within) / static_cast<double>(evaluated_lanes) : 0.0;
+		}
+
+		InteractionCounts & operator+=(const InteractionCounts & other) noexcept {
+			pairs_examined += other.pairs_examined;
+			pairs_within += other.pairs_within;
+			packed_iterations += other.packed_iterations;
+			masked_iterations += other.masked_iterations;
+			evaluated_lanes += other.evaluated_lanes;
+			evaluated_within += other.evaluated_within;
+			return *this;
+		}
+
+		friend InteractionCounts operator-(const InteractionCounts & after, const InteractionCounts & before) noexcept {
+			return {
+				after.pairs_examined - before.pairs_examined,
+				after.pairs_within - before.pairs_within,
+				after.packed_iterations - before.packed_iterations,
+				after.masked_iterations - before.masked_iterations,
+				after.evaluated_lanes - before.evaluated_lanes,
+				after.evaluated_within - before.evaluated_within
+			};
+		}
+
+		friend bool operator==(const InteractionCounts &, const InteractionCounts &) = default;
+	};
+
+
+	// counts per (dense) type pair, summed over all threads. (t1, t2) and (t2, t1) are kept apart as dispatched
+	struct InteractionCountTable {
+		size_t n_types = 0;
+		std::vector<InteractionCounts> counts; // t1 * n_types + t2
+
+		[[nodiscard]] const InteractionCounts & operator()(const ParticleType t1, const ParticleType t2) const {
+			APRIL_ASSERT(t1 < n_types && t2 < n_types, "type out of range");
+			return counts[t1 * n_types + t2];
+		}
+
+		// both orders of an unordered type pair
+		[[nodiscard]] InteractionCounts pair(const ParticleType t1, const ParticleType t2) const {
+			InteractionCounts c = (*this)(t1, t2);
+			if (t1 != t2) c += (*this)(t2, t1);
+			return c;
+		}
+
+		[[nodiscard]] InteractionCounts total() const noexcept {
+			InteractionCounts sum;
+			for (const auto & c : counts) sum += c;
+			return sum;
+		}
+
+		friend InteractionCountTable operator-(const InteractionCountTable & after, const InteractionCountTable & before) {
+			InteractionCountTable diff = after;
+			if (before.counts.size() != after.counts.size()) return diff;
+			for (size_t i = 0; i < diff.counts.size(); ++i) diff.counts[i] = after.counts[i] - before.counts[i];
+			return diff;
+		}
+	};
+
+
+	/**
+	 * @brief Interaction counters of one System, with one slot per executor thread and type pair.
+	 *
+	 * Every thread only writes its own slot, so recording needs no synchronization. Snapshots and resets
+	 * are meant to be taken between steps, while no force update is running.
+	 */
+	class InteractionCounters {
+	public:
+		InteractionCounters() = default;
+
+		InteractionCounters(const size_t n_threads, const size_t n_types) {
+			resize(n_threads, n_types);
+		}
+
+		void resize(const size_t n_threads, const size_t n_types) {
+			types = n_types;
+			slots.assign(n_threads, {});
+			for (auto & slot : slots) slot.counts.assign(n_types * n_types, {});
+		}
+
+		void enable(const bool on = true) noexcept { active = on; }
+		[[nodiscard]] bool enabled() const noexcept { return interaction_counters_compiled_in && active; }
+
+		// counters written by thread for the pair (t1, t2)
+		[[nodiscard]] InteractionCounts & local(const size_t thread, const ParticleType t1, const ParticleType t2) {
+			APRIL_ASSERT(thread < slots.size(), "thread index out of range");
+			APRIL_ASSERT(t1 < types && t2 < types, "type out of range");
+			return slots[thread].counts[t1 * types + t2];
+		}
+
+		[[nodiscard]] InteractionCountTable snapshot() const {
+			InteractionCountTable table{types, std::vector<InteractionCounts>(types * types)};
+			for (const auto & slot : slots) {
+				for (size_t i = 0; i < slot.counts.size(); ++i) table.counts[i] += slot.counts[i];
+			}
+			return table;
+		}
+
+		void reset() {
+			for (auto & slot : slots) slot.counts.assign(slot.counts.size(), {});
+		}
+
+		[[nodiscard]] size_t n_types() const noexcept { return types; }
+
+	private:
+		struct alignas(exec::assumed_cache_line_size) Slot {
+			std::vector<InteractionCounts> counts;
+		};
+
+		std::vector<Slot> slots;
+		size_t types = 0;
+		bool active = false;
+	};
+}
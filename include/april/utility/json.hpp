@@ -0,0 +1,366 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "april/utility/debug.hpp"
+
+/*
+ * Minimal JSON support for machine-readable reports: a streaming writer and a small DOM parser.
+ * Numbers are written in their shortest round-trip form; non-finite numbers become null.
+ */
+
+namespace april::utility {
+
+	class JSONWriter {
+	public:
+		explicit JSONWriter(std::ostream & output):
+			out(output)
+		{}
+
+		void begin_object() { open('{', false); }
+		void end_object() { close('}'); }
+
+		// inline arrays keep all elements on one line (e.g. long lists of numbers)
+		void begin_array(const bool inline_elements = false) { open('[', inline_elements); }
+		void end_array() { close(']'); }
+
+		// the key of the next value inside an object
+		JSONWriter & key(const std::string_view name) {
+			separate();
+			write_string(name);
+			out << ": ";
+			pending_key = true;
+			return *this;
+		}
+
+		void value(const std::string_view v) { separate(); write_string(v); }
+		void value(const char * v) { value(std::string_view(v)); }
+		void value(const std::string & v) { value(std::string_view(v)); }
+		void value(const bool v) { separate(); out << (v ? "true" : "false"); }
+		void value(std::nullptr_t) { separate(); out << "null"; }
+
+		template<typename T>
+		requires (std::integral<T> && !std::same_as<T, bool>)
+		void value(const T v) { separate(); out << v; }
+
+		template<std::floating_point T>
+		void value(const T v) {
+			separate();
+			if (!std::isfinite(v)) {
+				out << "null";
+				return;
+			}
+			char buffer[32];
+			const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), v);
+			out << std::string_view(buffer, ec == std::errc{} ? end : buffer);
+		}
+
+		template<typename T>
+		void field(const std::string_view name, const T & v) {
+			key(name);
+			value(v);
+		}
+
+		// closes the document with a newline
+		void finish() const {
+			APRIL_ASSERT(scopes.empty(), "JSON Writer: unclosed object or array");
+			out << '\n';
+		}
+
+	private:
+		struct Scope {
+			bool first = true;
+			bool inline_elements = false;
+		};
+
+		void open(const char bracket, const bool inline_elements) {
+			separate();
+			out << bracket;
+			scopes.push_back({true, inline_elements || (!scopes.empty() && scopes.back().inline_elements)});
+		}
+
+		void close(const char bracket) {
+			APRIL_ASSERT(!scopes.empty(), "JSON Writer: nothing to close");
+			const Scope scope = scopes.back();
+			scopes.pop_back();
+			if (!scope.first && !scope.inline_elements) newline();
+			out << bracket;
+		}
+
+		// comma and indentation before a new element (a value directly after its key gets neither)
+		void separate() {
+			if (pending_key) {
+				pending_key = false;
+				return;
+			}
+			if (scopes.empty()) return;
+
+			Scope & scope = scopes.back();
+			if (!scope.first) out << (scope.inline_elements ? ", " : ",");
+			if (!scope.inline_elements) newline();
+			scope.first = false;
+		}
+
+		void newline() const {
+			out << '\n';
+			for (std::size_t i = 0; i < scopes.size(); i++) {
+				out << '\t';
+			}
+		}
+
+		void write_string(const std::string_view s) const {
+			out << '"';
+			for (const char c : s) {
+				switch (c) {
+					case '"': out << "\\\""; break;
+					case '\\': out << "\\\\"; break;
+					case '\n': out << "\\n"; break;
+					case '\t': out << "\\t"; break;
+					case '\r': out << "\\r"; break;
+					default:
+						if (static_cast<unsigned char>(c) < 0x20) {
+							char buffer[8];
+							std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+							out << buffer;
+						} else {
+							out << c;
+						}
+				}
+			}
+			out << '"';
+		}
+
+		std::ostream & out;
+		std::vector<Scope> scopes;
+		bool pending_key = false;
+	};
+
+
+	class JSONValue {
+	public:
+		using Array = std::vector<JSONValue>;
+		using Object = std::vector<std::pair<std::string, JSONValue>>; // in document order
+
+		JSONValue() = default;
+		JSONValue(std::nullptr_t) {}
+		JSONValue(const bool v): data(v) {}
+		JSONValue(const double v): data(v) {}
+		JSONValue(std::string v): data(std::move(v)) {}
+		JSONValue(const char * v): data(std::string(v)) {}
+		JSONValue(Array v): data(std::move(v)) {}
+		JSONValue(Object v): data(std::move(v)) {}
+
+		[[nodiscard]] bool is_null() const noexcept { return std::holds_alternative<std::nullptr_t>(data); }
+		[[nodiscard]] bool is_bool() const noexcept { return std::holds_alternative<bool>(data); }
+		[[nodiscard]] bool is_number() const noexcept { return std::holds_alternative<double>(data); }
+		[[nodiscard]] bool is_string() const noexcept { return std::holds_alternative<std::string>(data); }
+		[[nodiscard]] bool is_array() const noexcept { return std::holds_alternative<Array>(data); }
+		[[nodiscard]] bool is_object() const noexcept { return std::holds_alternative<Object>(data); }
+
+		[[nodiscard]] bool as_bool() const { return get<bool>("a boolean"); }
+		[[nodiscard]] double as_number() const { return get<double>("a number"); }
+		[[nodiscard]] const std::string & as_string() const { return get<std::string>("a string"); }
+		[[nodiscard]] const Array & as_array() const { return get<Array>("an array"); }
+		[[nodiscard]] const Object & as_object() const { return get<Object>("an object"); }
+
+		// member lookup; nullptr if this is not an object or has no such key
+		[[nodiscard]] const JSONValue * find(const std::string_view name) const noexcept {
+			const auto * object = std::get_if<Object>(&data);
+			if (!object) return nullptr;
+			for (const auto & [k, v] : *object) {
+				if (k == name) return &v;
+			}
+			return nullptr;
+		}
+
+		[[nodiscard]] const JSONValue & operator[](const std::string_view name) const {
+			const JSONValue * member = find(name);
+			if (!member) throw std::runtime_error("[APRIL] JSON: missing member \"" + std::string(name) + "\"");
+			return *member;
+		}
+
+		// number of a member or fallback if it is missing or null (null is how non-finite numbers are written)
+		[[nodiscard]] double number_or(const std::string_view name, const double fallback) const {
+			const JSONValue * member = find(name);
+			return member && member->is_number() ? member->as_number() : fallback;
+		}
+
+	private:
+		template<typename T>
+		const T & get(const char * expected) const {
+			const T * v = std::get_if<T>(&data);
+			if (!v) throw std::runtime_error(std::string("[APRIL] JSON: value is not ") + expected);
+			return *v;
+		}
+
+		std::variant<std::nullptr_t, bool, double, std::string, Array, Object> data = nullptr;
+	};
+
+
+	namespace internal {
+		class JSONParser {
+		public:
+			explicit JSONParser(const std::string_view text): text(text) {}
+
+			JSONValue parse_document() {
+				JSONValue v = parse_value(0);
+				skip_whitespace();
+				if (pos != text.size()) fail("trailing characters");
+				return v;
+			}
+
+		private:
+			static constexpr std::size_t max_depth = 256;
+
+			std::string_view text;
+			std::size_t pos = 0;
+
+			[[noreturn]] void fail(const std::string & what) const {
+				throw std::runtime_error("[APRIL] JSON: " + what + " at offset " + std::to_string(pos));
+			}
+
+			void skip_whitespace() {
+				while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) pos++;
+			}
+
+			bool consume(const char c) {
+				skip_whitespace();
+				if (pos < text.size() && text[pos] == c) {
+					pos++;
+					return true;
+				}
+				return false;
+			}
+
+			void expect(const char c) {
+				if (!consume(c)) fail(std::string("expected '") + c + "'");
+			}
+
+			bool consume_word(const std::string_view word) {
+				if (text.substr(pos, word.size()) != word) return false;
+				pos += word.size();
+				return true;
+			}
+
+			JSONValue parse_value(const std::size_t depth) {
+				if (depth > max_depth) fail("nesting too deep");
+				skip_whitespace();
+				if (pos >= text.size()) fail("unexpected end of input");
+
+				switch (text[pos]) {
+					case '{': return parse_object(depth);
+					case '[': return parse_array(depth);
+					case '"': return parse_string();
+					case 't': if (consume_word("true")) return true; break;
+					case 'f': if (consume_word("false")) return false; break;
+					case 'n': if (consume_word("null")) return nullptr; break;
+					default: return parse_number();
+				}
+				fail("invalid literal");
+			}
+
+			JSONValue parse_object(const std::size_t depth) {
+				expect('{');
+				JSONValue::Object object;
+				if (consume('}')) return object;
+				do {
+					skip_whitespace();
+					std::string name = parse_string();
+					expect(':');
+					object.emplace_back(std::move(name), parse_value(depth + 1));
+				} while (consume(','));
+				expect('}');
+				return object;
+			}
+
+			JSONValue parse_array(const std::size_t depth) {
+				expect('[');
+				JSONValue::Array array;
+				if (consume(']')) return array;
+				do {
+					array.push_back(parse_value(depth + 1));
+				} while (consume(','));
+				expect(']');
+				return array;
+			}
+
+			JSONValue parse_number() {
+				// from_chars does not accept a leading '+', neither does JSON
+				double v = 0;
+				const auto [end, ec] = std::from_chars(text.data() + pos, text.data() + text.size(), v);
+				if (ec != std::errc{} || end == text.data() + pos) fail("invalid number");
+				pos = static_cast<std::size_t>(end - text.data());
+				return v;
+			}
+
+			std::string parse_string() {
+				if (pos >= text.size() || text[pos] != '"') fail("expected string");
+				pos++;
+
+				std::string s;
+				while (pos < text.size() && text[pos] != '"') {
+					char c = text[pos++];
+					if (c != '\\') {
+						s += c;
+						continue;
+					}
+					if (pos >= text.size()) break;
+
+					switch (c = text[pos++]) {
+						case '"': case '\\': case '/': s += c; break;
+						case 'b': s += '\b'; break;
+						case 'f': s += '\f'; break;
+						case 'n': s += '\n'; break;
+						case 'r': s += '\r'; break;
+						case 't': s += '\t'; break;
+						case 'u': append_utf8(s, parse_hex4()); break;
+						default: fail("invalid escape");
+					}
+				}
+				if (pos >= text.size()) fail("unterminated string");
+				pos++;
+				return s;
+			}
+
+			unsigned parse_hex4() {
+				if (pos + 4 > text.size()) fail("invalid \\u escape");
+				unsigned code = 0;
+				const auto [end, ec] = std::from_chars(text.data() + pos, text.data() + pos + 4, code, 16);
+				if (ec != std::errc{} || end != text.data() + pos + 4) fail("invalid \\u escape");
+				pos += 4;
+				return code;
+			}
+
+			// surrogate pairs are not combined; reports only contain ASCII
+			static void append_utf8(std::string & s, const unsigned code) {
+				if (code < 0x80) {
+					s += static_cast<char>(code);
+				} else if (code < 0x800) {
+					s += static_cast<char>(0xC0 | (code >> 6));
+					s += static_cast<char>(0x80 | (code & 0x3F));
+				} else {
+					s += static_cast<char>(0xE0 | (code >> 12));
+					s += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					s += static_cast<char>(0x80 | (code & 0x3F));
+				}
+			}
+		};
+	}
+
+
+	// parses a complete JSON document, throws std::runtime_error on malformed input
+	[[nodiscard]] inline JSONValue parse_json(const std::string_view text) {
+		return internal::JSONParser(text).parse_document();
+	}
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+/*
+ * Hardware performance counters through Linux perf_event_open. Each thread gets one counter group so the
+ * events are scheduled (and multiplexed) together. Everything degrades to "unavailable" with a reason when
+ * the kernel refuses (perf_event_paranoid, containers, virtual machines without a PMU) or off Linux.
+ */
+
+namespace april::utility {
+
+	enum class PerfEvent : uint8_t {
+		Cycles,
+		Instructions,
+		LLCMisses,
+		DTLBMisses,
+		BranchMisses,
+		COUNT
+	};
+
+	inline constexpr size_t n_perf_events = static_cast<size_t>(PerfEvent::COUNT);
+
+	[[nodiscard]] constexpr std::string_view perf_event_name(const PerfEvent event) noexcept {
+		switch (event) {
+		case PerfEvent::Cycles:       return "cycles";
+		case PerfEvent::Instructions: return "instructions";
+		case PerfEvent::LLCMisses:    return "LLC misses";
+		case PerfEvent::DTLBMisses:   return "dTLB misses";
+		case PerfEvent::BranchMisses: return "branch misses";
+		default:                      return "unknown";
+		}
+	}
+
+
+	// counter values of one or more threads; events the kernel did not provide are marked invalid
+	struct PerfCounts {
+		std::array<uint64_t, n_perf_events> values{};
+		std::array<bool, n_perf_events> valid{};
+
+		[[nodiscard]] bool has(const PerfEvent e) const noexcept { return valid[static_cast<size_t>(e)]; }
+		[[nodiscard]] uint64_t operator[](const PerfEvent e) const noexcept { return values[static_cast<size_t>(e)]; }
+
+		[[nodiscard]] bool any() const noexcept {
+			for (const bool v : valid) if (v) return true;
+			return false;
+		}
+
+		// instructions per cycle (0 if either event is unavailable)
+		[[nodiscard]] double ipc() const noexcept {
+			if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions) || (*this)[PerfEvent::Cycles] == 0) return 0;
+			return static_cast<double>((*this)[PerfEvent::Instructions]) / static_cast<double>((*this)[PerfEvent::Cycles]);
+		}
+
+		// accumulates (e.g. over threads): an event is valid if any contribution was
+		PerfCounts& operator+=(const PerfCounts& other) noexcept {
+			for (size_t i = 0; i < n_perf_events; ++i) {
+				if (!other.valid[i]) continue;
+				values[i] += other.values[i];
+				valid[i] = true;
+			}
+			return *this;
+		}
+
+		// difference of two readings of the same counters
+		friend PerfCounts operator-(const PerfCounts& after, const PerfCounts& before) noexcept {
+			PerfCounts diff;
+			for (size_t i = 0; i < n_perf_events; ++i) {
+				diff.valid[i] = after.valid[i] && before.valid[i];
+				diff.values[i] = diff.valid[i] && after.values[i] > before.values[i] ? after.values[i] - before.values[i] : 0;
+			}
+			return diff;
+		}
+	};
+
+
+	/**
+	 * @brief Counter group attached to one thread of this process.
+	 *
+	 * The first event that opens becomes the group leader; events that fail to open on their own are left
+	 * invalid. Counting starts on construction and covers user space only. Readings are running totals,
+	 * scaled up if the kernel had to multiplex the group.
+	 */
+	class PerfCounterGroup {
+	public:
+		// tid 0 is the calling thread
+		explicit PerfCounterGroup(const int tid = 0) {
+		#if defined(__linux__)
+			for (size_t i = 0; i < n_perf_events; ++i) {
+				perf_event_attr attr{};
+				attr.size = sizeof(perf_event_attr);
+				set_event(attr, static_cast<PerfEvent>(i));
+				attr.disabled = leader < 0 ? 1 : 0;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+					PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+				const long fd = syscall(SYS_perf_event_open, &attr, tid, -1, leader, 0);
+				if (fd < 0) {
+					if (leader < 0 && reason.empty()) reason = open_error(errno);
+					continue;
+				}
+
+				fds[i] = static_cast<int>(fd);
+				if (leader < 0) leader = fds[i];
+				ioctl(fds[i], PERF_EVENT_IOC_ID, &ids[i]);
+			}
+
+			if (leader >= 0) {
+				reason.clear();
+				ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			}
+		#else
+			(void)tid;
+			reason = "hardware counters require Linux perf_event_open";
+		#endif
+		}
+
+		~PerfCounterGroup() { close_all(); }
+
+		PerfCounterGroup(const PerfCounterGroup&) = delete;
+		PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+		PerfCounterGroup(PerfCounterGroup&& other) noexcept
+			: fds(std::exchange(other.fds, closed())), ids(other.ids),
+			  leader(std::exchange(other.leader, -1)), reason(std::move(other.reason)) {}
+
+		PerfCounterGroup& operator=(PerfCounterGroup&& other) noexcept {
+			if (this != &other) {
+				close_all();
+				fds = std::exchange(other.fds, closed());
+				ids = other.ids;
+				leader = std::exchange(other.leader, -1);
+				reason = std::move(other.reason);
+			}
+			return *this;
+		}
+
+		[[nodiscard]] bool available() const noexcept { return leader >= 0; }
+
+		// why no counter could be opened (empty if available)
+		[[nodiscard]] const std::string& error() const noexcept { return reason; }
+
+		[[nodiscard]] PerfCounts read() const {
+			PerfCounts counts;
+		#if defined(__linux__)
+			if (leader < 0) return counts;
+
+			// layout of a PERF_FORMAT_GROUP read: nr, time_enabled, time_running, {value, id}[nr]
+			std::array<uint64_t, 3 + 2 * n_perf_events> buffer{};
+			if (::read(leader, buffer.data(), sizeof(buffer)) <= 0) return counts;
+
+			const uint64_t nr = std::min<uint64_t>(buffer[0], n_perf_events);
+			const uint64_t enabled = buffer[1];
+			const uint64_t running = buffer[2];
+			const double scale = running > 0 && running < enabled
+				? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+
+			for (uint64_t k = 0; k < nr; ++k) {
+				const uint64_t value = buffer[3 + 2 * k];
+				const uint64_t id = buffer[4 + 2 * k];
+				for (size_t i = 0; i < n_perf_events; ++i) {
+					if (fds[i] < 0 || ids[i] != id) continue;
+					counts.values[i] = static_cast<uint64_t>(static_cast<double>(value) * scale);
+					counts.valid[i] = true; // running == 0: the thread has not been scheduled since counting started
+				}
+			}
+		#endif
+			return counts;
+		}
+
+	private:
+		std::array<int, n_perf_events> fds = closed();
+		std::array<uint64_t, n_perf_events> ids{};
+		int leader = -1;
+		std::string reason;
+
+		static constexpr std::array<int, n_perf_events> closed() noexcept {
+			std::array<int, n_perf_events> a{};
+			a.fill(-1);
+			return a;
+		}
+
+		void close_all() noexcept {
+		#if defined(__linux__)
+			// members first, the leader last
+			for (const int fd : fds) {
+				if (fd >= 0 && fd != leader) ::close(fd);
+			}
+			if (leader >= 0) ::close(leader);
+		#endif
+			fds = closed();
+			leader = -1;
+		}
+
+	#if defined(__linux__)
+		static void set_event(perf_event_attr& attr, const PerfEvent event) noexcept {
+			constexpr auto cache_miss = [](const uint64_t cache) {
+				return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			};
+
+			switch (event) {
+			case PerfEvent::Cycles:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_CPU_CYCLES;
+				break;
+			case PerfEvent::Instructions:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+				break;
+			case PerfEvent::LLCMisses:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_CACHE_MISSES;
+				break;
+			case PerfEvent::DTLBMisses:
+				attr.type = PERF_TYPE_HW_CACHE;
+				attr.config = cache_miss(PERF_COUNT_HW_CACHE_DTLB);
+				break;
+			case PerfEvent::BranchMisses:
+			default:
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+				break;
+			}
+		}
+
+		static std::string open_error(const int err) {
+			switch (err) {
+			case EACCES:
+			case EPERM:
+				return "perf_event_open not permitted (see /proc/sys/kernel/perf_event_paranoid)";
+			case ENOENT:
+			case EOPNOTSUPP:
+			case ENODEV:
+				return "no hardware counters on this machine";
+			case ENOSYS:
+				return "kernel without perf_event support";
+			default:
+				return std::string("perf_event_open failed: ") + std::strerror(err);
+			}
+		}
+	#endif
+	};
+
+
+	// one counter group per thread of the process that exists when the set is opened
+	class ThreadPerfCounters {
+	public:
+		struct Thread {
+			int tid;
+			std::string name;
+			PerfCounterGroup counters;
+		};
+
+		ThreadPerfCounters() = default;
+
+		// opens counters for all current threads (executor threads must already be running)
+		void open() {
+			threads.clear();
+			reason.clear();
+
+		#if defined(__linux__)
+			std::error_code ec;
+			for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+				const std::string tid_str = entry.path().filename().string();
+				const int tid = std::stoi(tid_str);
+
+				PerfCounterGroup group(tid);
+				if (!group.available()) {
+					if (reason.empty()) reason = group.error();
+					continue;
+				}
+
+				std::string name;
+				std::ifstream comm(entry.path() / "comm");
+				std::getline(comm, name);
+				threads.push_back({tid, std::move(name), std::move(group)});
+			}
+			if (ec && reason.empty()) reason = "cannot list /proc/self/task";
+		#else
+			reason = PerfCounterGroup().error();
+		#endif
+			if (!threads.empty()) reason.clear();
+		}
+
+		void close() { threads.clear(); }
+
+		[[nodiscard]] bool available() const noexcept { return !threads.empty(); }
+		[[nodiscard]] const std::string& error() const noexcept { return reason; }
+		[[nodiscard]] const std::vector<Thread>& thread_list() const noexcept { return threads; }
+
+		// current running totals, one per thread (same order as thread_list)
+		void read(std::vector<PerfCounts>& out) const {
+			out.resize(threads.size());
+			for (size_t t = 0; t < threads.size(); ++t) out[t] = threads[t].counters.read();
+		}
+
+	private:
+		std::vector<Thread> threads;
+		std::string reason;
+	};
+}
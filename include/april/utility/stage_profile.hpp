@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "april/exec/threading/trace.hpp"
+
+/*
+ * Scoped timing points around the stages of a step. They cost a thread local flag check while no StageTimer
+ * monitor is active and can be compiled out entirely with APRIL_DISABLE_STAGE_TIMING. With executor tracing
+ * compiled in, they also label the dispatches they enclose (see exec/threading/trace.hpp).
+ */
+
+namespace april::utility {
+
+	enum class Stage : uint8_t {
+		// system stages (a step is made of these)
+		UpdateComponents,
+		Drift,            // position update (including a half kick fused into it)
+		RebuildStructure,
+		BoundaryConditions,
+		UpdateForces,
+		ForceFields,
+		Kick,
+		Controllers,
+
+		// container phases (nested inside the system stages)
+		ReorderCount,     // per bin particle counts
+		ReorderMap,       // bin offsets and destination mapping
+		ReorderGather,    // copy into the reordered storage
+		PairPhase,        // one color of the pair sweep
+		WrapPhase,        // one conflict-free set of wrapped cell pairs
+		InteractionGraph, // pair sweep run as a dependency graph
+		TopologyPhase,    // one conflict-free set of bonded interactions
+
+		COUNT
+	};
+
+	inline constexpr size_t n_stages = static_cast<size_t>(Stage::COUNT);
+
+	[[nodiscard]] constexpr std::string_view stage_name(const Stage stage) noexcept {
+		switch (stage) {
+		case Stage::UpdateComponents:   return "update components";
+		case Stage::Drift:              return "drift";
+		case Stage::RebuildStructure:   return "rebuild structure";
+		case Stage::BoundaryConditions: return "boundary conditions";
+		case Stage::UpdateForces:       return "update forces";
+		case Stage::ForceFields:        return "force fields";
+		case Stage::Kick:               return "kick";
+		case Stage::Controllers:        return "controllers";
+		case Stage::ReorderCount:       return "reorder: count";
+		case Stage::ReorderMap:         return "reorder: map";
+		case Stage::ReorderGather:      return "reorder: gather";
+		case Stage::PairPhase:          return "pair phase";
+		case Stage::WrapPhase:          return "wrap phase";
+		case Stage::InteractionGraph:   return "interaction graph";
+		case Stage::TopologyPhase:      return "topology phase";
+		default:                        return "unknown";
+		}
+	}
+
+	[[nodiscard]] constexpr bool is_system_stage(const Stage stage) noexcept {
+		return stage < Stage::ReorderCount;
+	}
+
+	// stages that are recorded per phase index
+	[[nodiscard]] constexpr bool is_phased_stage(const Stage stage) noexcept {
+		return stage == Stage::PairPhase || stage == Stage::WrapPhase || stage == Stage::TopologyPhase;
+	}
+
+
+	/**
+	 * @brief Per thread accumulated stage times.
+	 *
+	 * Stages that run in several phases (colors, wrap phases, topology phases) are kept per phase index.
+	 * Only the thread driving the step records: container phases are timed around the executor dispatch.
+	 */
+	class StageProfile {
+	public:
+		struct Entry {
+			double seconds = 0;
+			uint32_t calls = 0;
+		};
+
+		[[nodiscard]] static StageProfile& local() noexcept {
+			thread_local StageProfile profile;
+			return profile;
+		}
+
+		// called when a stage is entered and left, e.g. to sample hardware counters (see Benchmark)
+		struct Hook {
+			void* context = nullptr;
+			void (*on_stage)(void* context, Stage stage, bool entering) = nullptr;
+		};
+
+		void enable(const bool on) noexcept { active = on; }
+		[[nodiscard]] bool enabled() const noexcept { return active; }
+
+		void set_hook(const Hook h) noexcept { hook = h; }
+		[[nodiscard]] const Hook& stage_hook() const noexcept { return hook; }
+
+		// whether stage scopes have to do anything
+		[[nodiscard]] bool observed() const noexcept { return active || hook.on_stage; }
+
+		void notify(const Stage stage, const bool entering) const {
+			if (hook.on_stage) hook.on_stage(hook.context, stage, entering);
+		}
+
+		// zeroes all entries (keeps their storage)
+		void reset() noexcept {
+			for (auto& phases : times) {
+				for (auto& e : phases) e = {};
+			}
+		}
+
+		void add(const Stage stage, const uint32_t phase, const double seconds) {
+			auto& phases = times[static_cast<size_t>(stage)];
+			if (phase >= phases.size()) phases.resize(phase + 1);
+
+			phases[phase].seconds += seconds;
+			++phases[phase].calls;
+		}
+
+		[[nodiscard]] const std::vector<Entry>& entries(const Stage stage) const noexcept {
+			return times[static_cast<size_t>(stage)];
+		}
+
+	private:
+		bool active = false;
+		Hook hook;
+		std::array<std::vector<Entry>, n_stages> times;
+	};
+
+
+	// times the enclosing scope (or until next()) as stage if the thread's profile is enabled or hooked
+	class StageScope {
+	public:
+		explicit StageScope(const Stage stage, const uint32_t phase = 0) {
+			if constexpr (exec::trace::compiled_in) previous_label = exec::trace::exchange_label(trace_label(stage, phase));
+		#ifndef APRIL_DISABLE_STAGE_TIMING
+			if (StageProfile& p = StageProfile::local(); p.observed()) {
+				profile = &p;
+				start(stage, phase);
+			}
+		#else
+			(void)stage; (void)phase;
+		#endif
+		}
+
+		~StageScope() {
+			stop();
+			if constexpr (exec::trace::compiled_in) exec::trace::exchange_label(previous_label);
+		}
+
+		StageScope(const StageScope&) = delete;
+		StageScope& operator=(const StageScope&) = delete;
+
+		// ends the current stage and starts the next one
+		void next(const Stage stage, const uint32_t phase = 0) {
+			if constexpr (exec::trace::compiled_in) exec::trace::exchange_label(trace_label(stage, phase));
+			if (!profile) return;
+			stop();
+			start(stage, phase);
+		}
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		StageProfile* profile = nullptr; // null while profiling is off
+		Stage stage = Stage::COUNT;
+		uint32_t phase = 0;
+		Clock::time_point begin;
+		exec::trace::Label previous_label;
+
+		static exec::trace::Label trace_label(const Stage s, const uint32_t p) noexcept {
+			return {stage_name(s).data(), is_phased_stage(s) ? p : exec::trace::Label::no_index}; // names are literals
+		}
+
+		void start(const Stage s, const uint32_t p) {
+			stage = s;
+			phase = p;
+			profile->notify(stage, true);
+			begin = Clock::now();
+		}
+
+		void stop() {
+			if (!profile) return;
+			if (profile->enabled()) {
+				profile->add(stage, phase, std::chrono::duration<double>(Clock::now() - begin).count());
+			}
+			profile->notify(stage, false);
+		}
+	};
+}
@@ -0,0 +1,403 @@
+#pragma once
+
+#if defined(__unix__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "april/exec/hardware.hpp"
+#include "april/utility/stage_profile.hpp"
+
+/*
+ * Live telemetry of a running simulation in a POSIX shared memory segment, so that external tools can watch
+ * many runs without parsing their logs. One process writes (see the Telemetry monitor), any number of
+ * processes read; the writer never waits for readers.
+ *
+ * Segment layout, version 1 (native byte order and alignment of the writing machine):
+ *
+ *   offset 0                                   TelemetryHeader (header_size bytes)
+ *   offset header_size + i * slot_size         TelemetrySlot i, for i in [0, capacity)
+ *
+ * Sample k (counted from 0) goes to slot k % capacity. A slot's sequence is odd while the writer fills it and
+ * 2 * (k + 1) once sample k is complete. Readers copy the sample and keep it only if the sequence had that
+ * value before and after the copy (seqlock). header.published counts the complete samples, readers that fall
+ * more than capacity samples behind lose the oldest ones. header.status is 0 while the segment is set up,
+ * then Running and finally Finished.
+ */
+
+namespace april::utility {
+
+	inline constexpr uint64_t telemetry_magic = 0x4150'5249'4C54'454CULL; // "APRILTEL"
+	inline constexpr uint32_t telemetry_version = 1;
+
+	// the system stages (utility::Stage values below ReorderCount), in enum order
+	inline constexpr size_t telemetry_stage_slots = 8;
+	static_assert(static_cast<size_t>(Stage::ReorderCount) == telemetry_stage_slots,
+		"the telemetry layout holds one time per system stage, bump telemetry_version when they change");
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+		"shared memory telemetry requires address-free (lock-free) atomics");
+
+	enum class TelemetryStatus : uint32_t {
+		Initializing = 0,
+		Running = 1,
+		Finished = 2
+	};
+
+	// particle counts of a sample, indexed by these
+	enum class TelemetryCount : uint32_t {
+		Alive,
+		Passive,
+		Stationary,
+		Dead,
+		COUNT
+	};
+
+	inline constexpr size_t n_telemetry_counts = static_cast<size_t>(TelemetryCount::COUNT);
+
+	// one published record, aggregated over the steps since the previous one
+	struct TelemetrySample {
+		uint64_t step = 0;              // System step at the end of the window
+		double time = 0;                // simulation time at the end of the window
+		double wall_time_sec = 0;       // since the run started
+		uint64_t window_steps = 0;      // steps aggregated into this sample
+		double steps_per_sec = 0;       // over the integration time of the window
+		double mups = 0;                // million particle updates per second over the window
+		double step_time_sec = 0;       // mean over the window
+		double stage_sec[telemetry_stage_slots] = {}; // mean per step, 0 unless stage timing is compiled in
+		uint64_t particles[n_telemetry_counts] = {};  // at the end of the window
+		uint64_t rebuilds = 0;          // steps of the window in which the container reordered its storage
+		uint64_t total_rebuilds = 0;    // since the run started
+		double kinetic_energy = 0;      // of the movable particles
+		double temperature = 0;         // 2 E_kin / (3 N_movable) with k_B = 1
+		double momentum[3] = {};        // total momentum of the movable particles
+
+		[[nodiscard]] double stage_time(const Stage stage) const noexcept {
+			const auto s = static_cast<size_t>(stage);
+			return s < telemetry_stage_slots ? stage_sec[s] : 0.0;
+		}
+
+		[[nodiscard]] uint64_t count(const TelemetryCount c) const noexcept {
+			return particles[static_cast<size_t>(c)];
+		}
+
+		// rebuilds per step over the window
+		[[nodiscard]] double rebuild_frequency() const noexcept {
+			return window_steps ? static_cast<double>(rebuilds) / static_cast<double>(window_steps) : 0.0;
+		}
+	};
+
+	static_assert(std::is_trivially_copyable_v<TelemetrySample>);
+
+	struct alignas(exec::assumed_cache_line_size) TelemetrySlot {
+		std::atomic<uint64_t> sequence;
+		TelemetrySample sample;
+	};
+
+	struct TelemetryHeader {
+		uint64_t magic;
+		uint32_t version;
+		uint32_t header_size;           // offset of the first slot
+		uint32_t slot_size;
+		uint32_t capacity;              // slots in the ring
+		int32_t pid;                    // of the writing process
+		uint32_t padding;
+		char run_name[64];              // null terminated
+		std::atomic<uint32_t> status;   // TelemetryStatus
+		alignas(exec::assumed_cache_line_size) std::atomic<uint64_t> published;
+	};
+
+	inline constexpr size_t telemetry_header_size = 256;
+	static_assert(sizeof(TelemetryHeader) <= telemetry_header_size);
+
+
+	namespace internal {
+		// a mapped POSIX shared memory segment, unlinked on destruction by the process that created it
+		class TelemetrySegment {
+		public:
+			TelemetrySegment() = default;
+
+			static TelemetrySegment create(const std::string& name, const size_t bytes) {
+				const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+				if (fd < 0) throw_errno("shm_open " + name);
+				if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+					const int err = errno;
+					close(fd);
+					shm_unlink(name.c_str());
+					errno = err;
+					throw_errno("ftruncate");
+				}
+				return {name, map(fd, bytes, PROT_READ | PROT_WRITE, name, true), bytes, true};
+			}
+
+			static TelemetrySegment open_read_only(const std::string& name) {
+				const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+				if (fd < 0) throw_errno("shm_open " + name);
+
+				struct stat info{};
+				if (fstat(fd, &info) != 0) {
+					close(fd);
+					throw_errno("fstat");
+				}
+				const auto bytes = static_cast<size_t>(info.st_size);
+				if (bytes < telemetry_header_size) {
+					close(fd);
+					throw std::runtime_error("[APRIL] Telemetry: segment " + name + " is not initialized");
+				}
+				return {name, map(fd, bytes, PROT_READ, name, false), bytes, false};
+			}
+
+			TelemetrySegment(const TelemetrySegment&) = delete;
+			TelemetrySegment& operator=(const TelemetrySegment&) = delete;
+
+			TelemetrySegment(TelemetrySegment&& other) noexcept
+				: name(std::move(other.name)),
+				  base(std::exchange(other.base, nullptr)),
+				  bytes(std::exchange(other.bytes, 0)),
+				  owner(std::exchange(other.owner, false))
+			{}
+
+			TelemetrySegment& operator=(TelemetrySegment&& other) noexcept {
+				if (this != &other) {
+					release();
+					name = std::move(other.name);
+					base = std::exchange(other.base, nullptr);
+					bytes = std::exchange(other.bytes, 0);
+					owner = std::exchange(other.owner, false);
+				}
+				return *this;
+			}
+
+			~TelemetrySegment() { release(); }
+
+			[[nodiscard]] std::byte* data() const noexcept { return base; }
+			[[nodiscard]] size_t size() const noexcept { return bytes; }
+			[[nodiscard]] const std::string& segment_name() const noexcept { return name; }
+
+		private:
+			std::string name;
+			std::byte* base = nullptr;
+			size_t bytes = 0;
+			bool owner = false;
+
+			TelemetrySegment(std::string name, std::byte* base, const size_t bytes, const bool owner)
+				: name(std::move(name)), base(base), bytes(bytes), owner(owner) {}
+
+			[[noreturn]] static void throw_errno(const std::string& what) {
+				throw std::system_error(errno, std::generic_category(), "[APRIL] Telemetry: " + what);
+			}
+
+			static std::byte* map(const int fd, const size_t bytes, const int protection, const std::string& name, const bool unlink_on_error) {
+				void* p = mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+				const int err = errno;
+				close(fd); // the mapping keeps the segment alive
+				if (p == MAP_FAILED) {
+					if (unlink_on_error) shm_unlink(name.c_str());
+					errno = err;
+					throw_errno("mmap");
+				}
+				return static_cast<std::byte*>(p);
+			}
+
+			void release() noexcept {
+				if (base) munmap(base, bytes);
+				if (owner) shm_unlink(name.c_str());
+				base = nullptr;
+				owner = false;
+			}
+		};
+
+		[[nodiscard]] constexpr size_t telemetry_segment_size(const size_t capacity) noexcept {
+			return telemetry_header_size + capacity * sizeof(TelemetrySlot);
+		}
+	}
+
+
+	/**
+	 * @brief Creates a telemetry segment and publishes samples into it.
+	 *
+	 * The segment is unlinked when the writer is destroyed; readers that are attached keep their mapping.
+	 * Publishing is wait-free: two atomic stores and a copy of one sample.
+	 */
+	class TelemetryWriter {
+	public:
+		static constexpr size_t default_capacity = 1024;
+
+		// name follows shm_open rules, e.g. "/april_run"
+		TelemetryWriter(const std::string& name, const size_t capacity = default_capacity, const std::string_view run_name = {}) {
+			if (capacity == 0 || capacity > UINT32_MAX) throw std::invalid_argument("[APRIL] Telemetry: invalid ring capacity");
+
+			segment = internal::TelemetrySegment::create(name, internal::telemetry_segment_size(capacity));
+
+			auto* h = new (segment.data()) TelemetryHeader{};
+			h->magic = telemetry_magic;
+			h->version = telemetry_version;
+			h->header_size = static_cast<uint32_t>(telemetry_header_size);
+			h->slot_size = static_cast<uint32_t>(sizeof(TelemetrySlot));
+			h->capacity = static_cast<uint32_t>(capacity);
+			h->pid = static_cast<int32_t>(getpid());
+			const size_t n = std::min(run_name.size(), sizeof(h->run_name) - 1);
+			std::memcpy(h->run_name, run_name.data(), n);
+
+			for (size_t i = 0; i < capacity; ++i) {
+				new (segment.data() + telemetry_header_size + i * sizeof(TelemetrySlot)) TelemetrySlot{};
+			}
+			h->status.store(static_cast<uint32_t>(TelemetryStatus::Running), std::memory_order_release);
+		}
+
+		void publish(const TelemetrySample& sample) noexcept {
+			TelemetryHeader& h = header();
+			const uint64_t k = h.published.load(std::memory_order_relaxed);
+			TelemetrySlot& s = slot(k % h.capacity);
+
+			s.sequence.store(2 * k + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			std::memcpy(&s.sample, &sample, sizeof(TelemetrySample));
+			s.sequence.store(2 * (k + 1), std::memory_order_release);
+
+			h.published.store(k + 1, std::memory_order_release);
+		}
+
+		void set_status(const TelemetryStatus status) noexcept {
+			header().status.store(static_cast<uint32_t>(status), std::memory_order_release);
+		}
+
+		[[nodiscard]] uint64_t published() const noexcept { return header().published.load(std::memory_order_relaxed); }
+		[[nodiscard]] size_t capacity() const noexcept { return header().capacity; }
+		[[nodiscard]] const std::string& name() const noexcept { return segment.segment_name(); }
+
+	private:
+		internal::TelemetrySegment segment;
+
+		[[nodiscard]] TelemetryHeader& header() const noexcept {
+			return *std::launder(reinterpret_cast<TelemetryHeader*>(segment.data()));
+		}
+
+		[[nodiscard]] TelemetrySlot& slot(const size_t i) const noexcept {
+			return *std::launder(reinterpret_cast<TelemetrySlot*>(segment.data() + telemetry_header_size + i * sizeof(TelemetrySlot)));
+		}
+	};
+
+
+	/**
+	 * @brief Read-only view of a telemetry segment created by another (or the same) process.
+	 *
+	 * Attaching fails if the segment does not exist, is not set up yet or was written with another layout
+	 * version. Reads never block the writer; a sample that is overwritten while it is copied is reported missing.
+	 */
+	class TelemetryReader {
+	public:
+		explicit TelemetryReader(const std::string& name)
+			: segment(internal::TelemetrySegment::open_read_only(name))
+		{
+			const TelemetryHeader& h = header();
+			if (h.status.load(std::memory_order_acquire) == static_cast<uint32_t>(TelemetryStatus::Initializing)) {
+				throw std::runtime_error("[APRIL] Telemetry: segment " + name + " is not initialized");
+			}
+			if (h.magic != telemetry_magic) {
+				throw std::runtime_error("[APRIL] Telemetry: segment " + name + " is not an april telemetry segment");
+			}
+			if (h.version != telemetry_version || h.header_size != telemetry_header_size || h.slot_size != sizeof(TelemetrySlot) ||
+				internal::telemetry_segment_size(h.capacity) != segment.size()) {
+				throw std::runtime_error("[APRIL] Telemetry: segment " + name + " has an incompatible layout (version " +
+					std::to_string(h.version) + ")");
+			}
+		}
+
+		[[nodiscard]] std::string run_name() const {
+			const char* s = header().run_name;
+			return {s, strnlen(s, sizeof(header().run_name))};
+		}
+
+		[[nodiscard]] int writer_pid() const noexcept { return header().pid; }
+		[[nodiscard]] size_t capacity() const noexcept { return header().capacity; }
+		[[nodiscard]] uint64_t published() const noexcept { return header().published.load(std::memory_order_acquire); }
+
+		[[nodiscard]] TelemetryStatus status() const noexcept {
+			return static_cast<TelemetryStatus>(header().status.load(std::memory_order_acquire));
+		}
+
+		// false if the writing process is gone without having finished (e.g. it crashed)
+		[[nodiscard]] bool writer_alive() const noexcept {
+			return status() == TelemetryStatus::Finished || kill(writer_pid(), 0) == 0 || errno == EPERM;
+		}
+
+		// copies sample k into out; false if it is not published yet or was overwritten
+		bool read(const uint64_t k, TelemetrySample& out) const noexcept {
+			const TelemetrySlot& s = slot(k % header().capacity);
+			const uint64_t expected = 2 * (k + 1);
+
+			if (s.sequence.load(std::memory_order_acquire) != expected) return false;
+			std::memcpy(&out, &s.sample, sizeof(TelemetrySample));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return s.sequence.load(std::memory_order_relaxed) == expected;
+		}
+
+		[[nodiscard]] std::optional<TelemetrySample> latest() const noexcept {
+			// a writer that laps the reader during the copy invalidates the slot, retry with the newer sample
+			for (int attempt = 0; attempt < 8; ++attempt) {
+				const uint64_t n = published();
+				if (n == 0) return std::nullopt;
+				TelemetrySample sample;
+				if (read(n - 1, sample)) return sample;
+			}
+			return std::nullopt;
+		}
+
+		/**
+		 * @brief Returns the samples published since cursor and advances it past them.
+		 *
+		 * cursor is the index of the next sample to read (start with 0). Samples that were overwritten before
+		 * they could be copied are skipped; lost counts them if given.
+		 */
+		std::vector<TelemetrySample> poll(uint64_t& cursor, uint64_t* lost = nullptr) const {
+			std::vector<TelemetrySample> samples;
+			const uint64_t n = published();
+			const uint64_t first = n > capacity() ? std::max(cursor, n - capacity()) : cursor;
+			uint64_t missed = first - std::min(cursor, first);
+
+			samples.reserve(n > first ? n - first : 0);
+			for (uint64_t k = first; k < n; ++k) {
+				TelemetrySample sample;
+				if (read(k, sample)) samples.push_back(sample);
+				else missed++;
+			}
+
+			cursor = std::max(cursor, n);
+			if (lost) *lost += missed;
+			return samples;
+		}
+
+	private:
+		internal::TelemetrySegment segment;
+
+		[[nodiscard]] const TelemetryHeader& header() const noexcept {
+			return *std::launder(reinterpret_cast<const TelemetryHeader*>(segment.data()));
+		}
+
+		[[nodiscard]] const TelemetrySlot& slot(const size_t i) const noexcept {
+			return *std::launder(reinterpret_cast<const TelemetrySlot*>(segment.data() + telemetry_header_size + i * sizeof(TelemetrySlot)));
+		}
+	};
+}
+
+#endif
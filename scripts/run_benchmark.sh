@@ -73,27 +73,24 @@ fi
 cd $RUN_DIR
 echo "⚙️  Operating in: $(pwd)"
 
-# --- 3. Modify CMakeLists ---
-# We must do this every time to ensure we ONLY build the benchmark.
-# This makes the script safe to run in a directory without test/ or examples/.
-echo "🔧 Modifying CMakeLists.txt to build only benchmarks..."
-sed -i '/add_subdirectory(examples)/s/^/#/' CMakeLists.txt
-sed -i '/add_subdirectory(test)/s/^/#/' CMakeLists.txt
-
-# --- 4. Configure ---
+# --- 3. Configure ---
 echo "⚙️  Configuring CMake (Build Type: Release)..."
 export CC=$CC_TOOL
 export CXX=$CXX_TOOL
 
 rm -rf build
-cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+cmake -S . -B build -DCMAKE_BUILD_TYPE=Release \
+      -DAPRIL_BUILD_TESTS=OFF -DAPRIL_BUILD_EXAMPLES=OFF -DAPRIL_BUILD_BENCHMARKS=ON
 
-# --- 5. Build ---
+# --- 4. Build ---
 echo "🔨 Building project (using all cores)..."
-cmake --build build -j $(nproc)
+cmake --build build -j $(nproc) --target april_micro_benchmarks april_macro_benchmarks april_compare_benchmarks
 
-# --- 6. Run Benchmark ---
+# --- 5. Run Benchmark ---
 echo ""
-echo "🚀 --- Running Benchmark (cube_benchmarkLL) ---"
-./build/benchmark/cube_benchmarkLL
+echo "🚀 --- Running micro benchmarks ---"
+./build/benchmark/april_micro_benchmarks --benchmark_format=json --benchmark_out=micro_benchmarks.json
+echo "🚀 --- Running macro benchmarks ---"
+./build/benchmark/april_macro_benchmarks --output macro_benchmarks.csv --json macro_benchmarks.json
+echo "Compare against a previous run with: april_compare_benchmarks OLD.json macro_benchmarks.json"
 echo "--- Benchmark complete ---"
\ No newline at end of file
@@ -176,6 +176,39 @@ TYPED_TEST(DirectSumTest, CollectIndicesInRegion) {
 }
 
 
+TYPED_TEST(DirectSumTest, CollectIndicesInRegion_BufferOverload) {
+	auto cuboid = ParticleCuboid{}
+		.at(vec3(0.25))
+		.velocity({0, 0, 0})
+		.count({4, 4, 4})
+		.mass(1.0)
+		.spacing(1)
+		.type(0);
+
+	Environment e(forces<NoForce>);
+	e.set_origin({0, 0, 0});
+	e.set_extent({5, 5, 5});
+	e.add_particles(cuboid);
+	e.add_interaction(NoForce(), to_type(0));
+
+	auto sys = build_system(e, TypeParam());
+
+	const core::Box region({0, 0, 0}, {2.5, 5, 5});
+	auto expected = sys.query_region(region);
+	std::ranges::sort(expected);
+	ASSERT_EQ(expected.size(), 48u);
+
+	// previous contents are replaced and the buffer is reused
+	std::vector<size_t> indices(100, 12345);
+	const size_t* data = indices.data();
+	for (int i = 0; i < 3; ++i) {
+		sys.query_region(region, indices);
+		std::ranges::sort(indices);
+		EXPECT_EQ(indices, expected);
+	}
+	EXPECT_EQ(indices.data(), data);
+}
+
 // does nothing except signaling the container to be periodic
 struct DummyPeriodicBoundary final : boundary::Boundary {
 	static constexpr auto fields = ParticleField::none;
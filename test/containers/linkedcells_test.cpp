@@ -7,6 +7,9 @@ using testing::Eq;
 
 
 #include "april/containers/linked_cells.hpp"
+#include "april/interactions/harmonic_angle.hpp"
+#include "april/interactions/cosine_dihedral.hpp"
+#include "april/interactions/sutton_chen.hpp"
 
 
 #include "orbit_monitor.h"
@@ -183,6 +186,174 @@ TYPED_TEST(LinkedCellsTest, TwoParticles_IdSpecificForce) {
 	);
 }
 
+TYPED_TEST(LinkedCellsTest, HarmonicChain_IdSpecificForce) {
+	// enough bonds to fill several SIMD lane groups plus a remainder
+	constexpr size_t n = 23;
+	constexpr double spacing = 1.5;
+
+	Environment e(forces<NoForce, Harmonic>);
+	for (size_t i = 0; i < n; ++i) {
+		e.add_particle(make_particle(0, {spacing * static_cast<double>(i), 0, 0}, {}, 1, ParticleState::ALIVE, static_cast<ParticleID>(i)));
+	}
+	e.add_interaction(NoForce(), to_type(0));
+	for (size_t i = 0; i + 1 < n; ++i) {
+		e.add_interaction(Harmonic(2.0, 1.0), between_ids(static_cast<ParticleID>(i), static_cast<ParticleID>(i + 1)));
+	}
+	e.set_domain_padding(2);
+
+	auto sys = build_system(e, TypeParam::create_container(), TypeParam::create_exec());
+	sys.update_forces();
+
+	ASSERT_EQ(export_particles(sys).size(), n);
+
+	// every bond is stretched by 0.5 -> interior forces cancel, the ends are pulled inwards with |F| = k * 0.5
+	for (ParticleID id = 1; id + 1 < n; ++id) {
+		const auto p = get_particle_by_id(sys, id);
+		EXPECT_NEAR(p.force.x, 0.0, 1e-12) << "id " << id;
+		EXPECT_NEAR(p.force.y, 0.0, 1e-12) << "id " << id;
+		EXPECT_NEAR(p.force.z, 0.0, 1e-12) << "id " << id;
+	}
+
+	const auto first = get_particle_by_id(sys, 0);
+	const auto last = get_particle_by_id(sys, n - 1);
+	EXPECT_NEAR(std::abs(first.force.x), 1.0, 1e-12);
+	EXPECT_NEAR(first.force.x, -last.force.x, 1e-12);
+}
+
+TYPED_TEST(LinkedCellsTest, HelixAnglesAndDihedrals_BondedForces) {
+	// helix with an angle for every consecutive triple and a dihedral for every quadruple
+	constexpr size_t n = 14;
+	std::vector<vec3> x(n);
+	for (size_t i = 0; i < n; ++i) {
+		const double t = 0.9 * static_cast<double>(i);
+		x[i] = {2.0 + std::cos(t), 2.0 + std::sin(t), 0.4 * static_cast<double>(i)};
+	}
+
+	const HarmonicAngle angle(5.0, 2.0);
+	const CosineDihedral dihedral(1.5, 3.0, 0.2);
+
+	Environment e(forces<NoForce, HarmonicAngle, CosineDihedral>);
+	for (size_t i = 0; i < n; ++i) {
+		e.add_particle(make_particle(0, x[i], {}, 1, ParticleState::ALIVE, static_cast<ParticleID>(i)));
+	}
+	e.add_interaction(NoForce(), to_type(0));
+	for (ParticleID i = 0; i + 2 < n; ++i) e.add_interaction(angle, among_ids(i, i + 1, i + 2));
+	for (ParticleID i = 0; i + 3 < n; ++i) e.add_interaction(dihedral, among_ids(i, i + 1, i + 2, i + 3));
+	e.set_domain_padding(2);
+
+	auto sys = build_system(e, TypeParam::create_container(), TypeParam::create_exec());
+	sys.update_forces();
+
+	// reference: direct summation of every bonded term
+	std::vector<vec3> expected(n);
+	for (size_t i = 0; i + 2 < n; ++i) {
+		const auto f = angle(x[i + 1] - x[i], x[i + 2] - x[i + 1]);
+		for (size_t k = 0; k < 3; ++k) expected[i + k] += f[k];
+	}
+	for (size_t i = 0; i + 3 < n; ++i) {
+		const auto f = dihedral(x[i + 1] - x[i], x[i + 2] - x[i + 1], x[i + 3] - x[i + 2]);
+		for (size_t k = 0; k < 4; ++k) expected[i + k] += f[k];
+	}
+
+	for (ParticleID id = 0; id < n; ++id) {
+		const auto p = get_particle_by_id(sys, id);
+		EXPECT_NEAR(p.force.x, expected[id].x, 1e-10) << "id " << id;
+		EXPECT_NEAR(p.force.y, expected[id].y, 1e-10) << "id " << id;
+		EXPECT_NEAR(p.force.z, expected[id].z, 1e-10) << "id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, SuttonChenCluster_ManyBodyForces) {
+	// jittered cubic cluster; every particle sees a different embedding density
+	std::vector<vec3> x;
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			for (int k = 0; k < 3; ++k) {
+				const double jitter = 0.05 * static_cast<double>((i * 7 + j * 3 + k * 5) % 4);
+				x.push_back({1.0 + 1.1 * i + jitter, 1.0 + 1.1 * j - jitter, 1.0 + 1.1 * k + 0.5 * jitter});
+			}
+	const size_t n = x.size();
+
+	const SuttonChen sc(0.01, 1.1, 40.0, 9.0, 6.0, 2.0);
+
+	Environment e(forces<SuttonChen>);
+	for (size_t i = 0; i < n; ++i) {
+		e.add_particle(make_particle(0, x[i], {}, 1, ParticleState::ALIVE, static_cast<ParticleID>(i)));
+	}
+	e.add_interaction(sc, to_type(0));
+	e.set_domain_padding(2);
+
+	auto sys = build_system(e, TypeParam::create_container(1.0), TypeParam::create_exec());
+	sys.update_forces();
+
+	// reference: direct O(N^2) evaluation of both passes
+	std::vector<double> embedding_derivative(n);
+	for (size_t i = 0; i < n; ++i) {
+		double rho = 0;
+		for (size_t j = 0; j < n; ++j) {
+			const double d = (x[j] - x[i]).norm();
+			if (j != i && d <= sc.cutoff()) rho += sc.density(d);
+		}
+		embedding_derivative[i] = sc.embedding_derivative(rho);
+	}
+
+	std::vector<vec3> expected(n);
+	for (size_t i = 0; i < n; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			const vec3 r = x[j] - x[i];
+			const double d = r.norm();
+			if (j == i || d > sc.cutoff()) continue;
+
+			const double dU = sc.pair_derivative(d) + (embedding_derivative[i] + embedding_derivative[j]) * sc.density_derivative(d);
+			expected[i] += dU / d * r;
+		}
+	}
+
+	for (ParticleID id = 0; id < n; ++id) {
+		const auto p = get_particle_by_id(sys, id);
+		EXPECT_NEAR(p.force.x, expected[id].x, 1e-9) << "id " << id;
+		EXPECT_NEAR(p.force.y, expected[id].y, 1e-9) << "id " << id;
+		EXPECT_NEAR(p.force.z, expected[id].z, 1e-9) << "id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, TargetedForceUpdate_MatchesFullUpdate) {
+	Environment e(forces<LennardJones>);
+	ParticleID id = 0;
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 4; ++j)
+			for (int k = 0; k < 3; ++k) {
+				const double jitter = 0.07 * static_cast<double>((i + 2 * j + 3 * k) % 3);
+				e.add_particle(make_particle(0, {0.5 + 1.1 * i + jitter, 0.5 + 1.1 * j, 0.5 + 1.2 * k - jitter}, {}, 1, ParticleState::ALIVE, id++));
+			}
+	e.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	e.set_extent({5, 5, 4});
+	e.set_origin({0, 0, 0});
+
+	auto sys = build_system(e, TypeParam::create_container(1.0), TypeParam::create_exec());
+	sys.update_forces();
+
+	std::vector<vec3> expected(id);
+	for (ParticleID i = 0; i < id; ++i) expected[i] = get_particle_by_id(sys, i).force;
+
+	sys.for_each_particle(april::scalar_kernel<ParticleField::force, ParticleField::force>(
+		[](auto&& p) { p.force = vec3{}; }
+	));
+
+	// recompute forces for even ids only
+	std::vector<size_t> targets;
+	for (ParticleID i = 0; i < id; i += 2) targets.push_back(sys.id_to_index(i));
+	sys.update_forces_on(targets);
+
+	for (ParticleID i = 0; i < id; ++i) {
+		const vec3 f = get_particle_by_id(sys, i).force;
+		const vec3 ref = i % 2 == 0 ? expected[i] : vec3{};
+		EXPECT_NEAR(f.x, ref.x, 1e-10) << "id " << i;
+		EXPECT_NEAR(f.y, ref.y, 1e-10) << "id " << i;
+		EXPECT_NEAR(f.z, ref.z, 1e-10) << "id " << i;
+	}
+}
+
 TYPED_TEST(LinkedCellsTest, TwoParticles_InverseSquare) {
     Environment e(forces<NoForce, Gravity>);
 
@@ -334,6 +505,93 @@ TYPED_TEST(LinkedCellsTest, CollectIndicesInRegion) {
     }
 }
 
+TYPED_TEST(LinkedCellsTest, CollectIndicesInRegion_BufferOverload) {
+	auto cuboid = ParticleCuboid{}
+		.at(vec3(0.25))
+		.velocity({0, 0, 0})
+		.count({4, 4, 4})
+		.mass(1.0)
+		.spacing(1)
+		.type(0);
+
+	Environment e(forces<NoForce>);
+	e.set_origin({0, 0, 0});
+	e.set_extent({5, 5, 5});
+	e.add_particles(cuboid);
+	e.add_interaction(NoForce(), to_type(0));
+
+	auto sys = build_system(e, TypeParam::create_container(1.0), TypeParam::create_exec());
+
+	const core::Box region({0, 0, 0}, {2.5, 5, 5});
+	auto expected = sys.query_region(region);
+	std::ranges::sort(expected);
+	ASSERT_EQ(expected.size(), 48u);
+
+	// previous contents are replaced
+	std::vector<size_t> indices(100, 12345);
+	sys.query_region(region, indices);
+	std::ranges::sort(indices);
+	EXPECT_EQ(indices, expected);
+
+	// repeated queries reuse the buffer
+	const size_t* data = indices.data();
+	for (int i = 0; i < 5; ++i) {
+		sys.query_region(region, indices);
+		EXPECT_EQ(indices.size(), expected.size());
+	}
+	EXPECT_EQ(indices.data(), data);
+
+	sys.query_region(core::Box({10, 10, 10}, {12, 12, 12}), indices);
+	EXPECT_TRUE(indices.empty());
+}
+
+TYPED_TEST(LinkedCellsTest, HintedQueryRegion_MatchesUnhinted) {
+	Environment e(forces<NoForce>);
+	e.set_origin({0, 0, 0});
+	e.set_extent({8, 8, 8});
+	e.add_interaction(NoForce(), to_type(0));
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 6; ++k) {
+		for (int j = 0; j < 6; ++j) {
+			for (int i = 0; i < 6; ++i) {
+				const vec3 pos = {0.6 + i * 1.2, 0.7 + j * 1.2, 0.8 + k * 1.2};
+				const vec3 vel = {0.3 * ((i + j) % 3 - 1), 0.2 * ((j + k) % 3 - 1), 0.25 * ((i + k) % 3 - 1)};
+				e.add_particle(make_particle(0, pos, vel, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	const Domain region({1.3, 0.5, 2.1}, {4.0, 5.5, 3.2});
+	auto hinted_env = e;
+	hinted_env.add_query_region(region);
+
+	auto plain = build_system(e, TypeParam::create_container(1.0), TypeParam::create_exec());
+	auto hinted = build_system(hinted_env, TypeParam::create_container(1.0), TypeParam::create_exec());
+
+	auto ids_in_region = [&](auto& sys) {
+		std::vector<ParticleID> ids;
+		for (const size_t idx : sys.query_region(region)) {
+			ids.push_back(get_particle(sys, idx).id);
+		}
+		std::ranges::sort(ids);
+		return ids;
+	};
+
+	VelocityVerlet plain_integrator(plain);
+	VelocityVerlet hinted_integrator(hinted);
+
+	// particles migrate between cells, so the hinted slices are refreshed by several rebuilds
+	for (int step = 0; step < 8; ++step) {
+		const auto expected = ids_in_region(plain);
+		EXPECT_FALSE(expected.empty());
+		EXPECT_EQ(ids_in_region(hinted), expected) << "step " << step;
+
+		plain_integrator.run_for_steps(0.5, 1);
+		hinted_integrator.run_for_steps(0.5, 1);
+	}
+}
+
 // does nothing except signaling the container to be periodic
 struct DummyPeriodicBoundary final : boundary::Boundary {
 	static constexpr ParticleField fields = ParticleField::none;
@@ -745,3 +1003,516 @@ TYPED_TEST(LinkedCellsTest, LinkedCells_vs_DirectSum_Parity_Open) {
 
 
 
+
+TYPED_TEST(LinkedCellsTest, TaskGraphSchedule_MatchesPhaseSchedule) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({9,9,9});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 8; ++k) {
+		for (int j = 0; j < 8; ++j) {
+			for (int i = 0; i < 8; ++i) {
+				const vec3 pos = {0.5 + i * 1.1 + jitter(gen), 0.5 + j * 1.1 + jitter(gen), 0.5 + k * 1.1 + jitter(gen)};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	BuildInfo phase_info, graph_info;
+	auto phase_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &phase_info);
+	auto graph_sys = build_system(env, TypeParam::create_container(2.5).with_task_graph(), TypeParam::create_exec(), &graph_info);
+
+	phase_sys.update_forces();
+	graph_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(phase_sys, phase_info.id_map[id]);
+		const auto q = get_particle_by_id(graph_sys, graph_info.id_map[id]);
+
+		ASSERT_NEAR((p.position - q.position).norm(), 0.0, 1e-12);
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-9) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, FullShellTraversal_MatchesHalfShell) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({9,9,9});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.add_interaction(LennardJones(0.5, 1.2, 2.5), to_type(1));
+	env.add_interaction(LennardJones(0.8, 1.1, 2.5), between_types(0, 1));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	// mixed types exercise both owner-only sides of the asymmetric neighbor batches
+	ParticleID user_id = 0;
+	for (int k = 0; k < 8; ++k) {
+		for (int j = 0; j < 8; ++j) {
+			for (int i = 0; i < 8; ++i) {
+				const vec3 pos = {0.5 + i * 1.1 + jitter(gen), 0.5 + j * 1.1 + jitter(gen), 0.5 + k * 1.1 + jitter(gen)};
+				const ParticleType type = static_cast<ParticleType>((i + j + k) % 2);
+				env.add_particle(make_particle(type, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	BuildInfo half_info, full_info;
+	auto half_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &half_info);
+	auto full_sys = build_system(env,
+		TypeParam::create_container(2.5).with_traversal(container::Traversal::FullShell),
+		TypeParam::create_exec(), &full_info);
+
+	half_sys.update_forces();
+	full_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(half_sys, half_info.id_map[id]);
+		const auto q = get_particle_by_id(full_sys, full_info.id_map[id]);
+
+		ASSERT_NEAR((p.position - q.position).norm(), 0.0, 1e-12);
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-9) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, FullShellTraversal_ManyBody_MatchesHalfShell) {
+	// owner-only batches read the other side through a shadow copy, which must carry F'(rho) in scratch
+	Environment env(forces<SuttonChen>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({9,9,9});
+	env.add_interaction(SuttonChen(0.01, 1.1, 40.0, 9.0, 6.0), to_type(0));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(13);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 8; ++k) {
+		for (int j = 0; j < 8; ++j) {
+			for (int i = 0; i < 8; ++i) {
+				const vec3 pos = {0.5 + i * 1.1 + jitter(gen), 0.5 + j * 1.1 + jitter(gen), 0.5 + k * 1.1 + jitter(gen)};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	// the shadow copies only exist on the scalar path
+	const auto scalar_exec = CustomExecConfig<TypeParam::ExecConfig::parallel_policy, VectorPolicy::Scalar>{};
+
+	BuildInfo half_info, full_info;
+	auto half_sys = build_system(env, TypeParam::create_container(2.5), scalar_exec, &half_info);
+	auto full_sys = build_system(env,
+		TypeParam::create_container(2.5).with_traversal(container::Traversal::FullShell),
+		scalar_exec, &full_info);
+
+	half_sys.update_forces();
+	full_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(half_sys, half_info.id_map[id]);
+		const auto q = get_particle_by_id(full_sys, full_info.id_map[id]);
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-9 * std::max(1.0, p.force.norm())) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, HaloPeriodicHandling_MatchesWrapPhases) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({9,9,9});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.add_interaction(LennardJones(0.5, 1.2, 2.5), to_type(1));
+	env.add_interaction(LennardJones(0.8, 1.1, 2.5), between_types(0, 1));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 8; ++k) {
+		for (int j = 0; j < 8; ++j) {
+			for (int i = 0; i < 8; ++i) {
+				const vec3 pos = {0.5 + i * 1.1 + jitter(gen), 0.5 + j * 1.1 + jitter(gen), 0.5 + k * 1.1 + jitter(gen)};
+				const ParticleType type = static_cast<ParticleType>((i * 3 + j + k) % 2);
+				env.add_particle(make_particle(type, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	BuildInfo wrap_info, halo_info, graph_info;
+	auto wrap_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &wrap_info);
+	auto halo_sys = build_system(env,
+		TypeParam::create_container(2.5).with_periodic_handling(container::PeriodicHandling::Halo),
+		TypeParam::create_exec(), &halo_info);
+	auto graph_sys = build_system(env,
+		TypeParam::create_container(2.5).with_periodic_handling(container::PeriodicHandling::Halo).with_task_graph(),
+		TypeParam::create_exec(), &graph_info);
+
+	wrap_sys.update_forces();
+	halo_sys.update_forces();
+	graph_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(wrap_sys, wrap_info.id_map[id]);
+		const auto q = get_particle_by_id(halo_sys, halo_info.id_map[id]);
+		const auto r = get_particle_by_id(graph_sys, graph_info.id_map[id]);
+
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-9) << "user id " << id;
+		EXPECT_NEAR((p.force - r.force).norm(), 0.0, 1e-9) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, HaloPeriodicHandling_ManyBody_MatchesWrapPhases) {
+	// the image side of an owned wrapped pair is a shadow copy and has to carry F'(rho) across the faces
+	Environment env(forces<SuttonChen>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({9,9,9});
+	env.add_interaction(SuttonChen(0.01, 1.1, 40.0, 9.0, 6.0), to_type(0));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 8; ++k) {
+		for (int j = 0; j < 8; ++j) {
+			for (int i = 0; i < 8; ++i) {
+				const vec3 pos = {0.5 + i * 1.1 + jitter(gen), 0.5 + j * 1.1 + jitter(gen), 0.5 + k * 1.1 + jitter(gen)};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	BuildInfo wrap_info, halo_info;
+	auto wrap_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &wrap_info);
+	auto halo_sys = build_system(env,
+		TypeParam::create_container(2.5).with_periodic_handling(container::PeriodicHandling::Halo),
+		TypeParam::create_exec(), &halo_info);
+
+	wrap_sys.update_forces();
+	halo_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(wrap_sys, wrap_info.id_map[id]);
+		const auto q = get_particle_by_id(halo_sys, halo_info.id_map[id]);
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-9 * std::max(1.0, p.force.norm())) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, LoadBalancing_MatchesStatic) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({12,12,12});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	// dense droplet in one corner and a dilute gas elsewhere: a few blocks hold most of the pairs
+	ParticleID user_id = 0;
+	for (int k = 0; k < 12; ++k) {
+		for (int j = 0; j < 12; ++j) {
+			for (int i = 0; i < 12; ++i) {
+				const bool droplet = i < 5 && j < 5 && k < 5;
+				if (!droplet && (i + j + k) % 5 != 0) continue;
+
+				const double spacing = droplet ? 0.9 : 1.0;
+				const vec3 pos = {0.5 + i * spacing + jitter(gen), 0.5 + j * spacing + jitter(gen), 0.5 + k * spacing + jitter(gen)};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	BuildInfo static_info, count_info, timing_info;
+	auto static_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &static_info);
+	auto count_sys = build_system(env,
+		TypeParam::create_container(2.5).with_load_balancing(container::LoadBalancing::PairCount),
+		TypeParam::create_exec(), &count_info);
+	auto timing_sys = build_system(env,
+		TypeParam::create_container(2.5).with_load_balancing(container::LoadBalancing::Timing),
+		TypeParam::create_exec(), &timing_info);
+
+	// the blocks of a phase write disjoint cells, so reordering them must not change a single bit
+	for (int sweep = 0; sweep < 3; ++sweep) {
+		static_sys.update_forces();
+		count_sys.update_forces();
+		timing_sys.update_forces();
+
+		for (ParticleID id = 0; id < user_id; ++id) {
+			const auto p = get_particle_by_id(static_sys, static_info.id_map[id]);
+			const auto q = get_particle_by_id(count_sys, count_info.id_map[id]);
+			const auto r = get_particle_by_id(timing_sys, timing_info.id_map[id]);
+
+			EXPECT_EQ(p.force, q.force) << "user id " << id << " sweep " << sweep;
+			EXPECT_EQ(p.force, r.force) << "user id " << id << " sweep " << sweep;
+		}
+
+		// applies the measured costs to the next sweep
+		static_sys.rebuild_structure();
+		count_sys.rebuild_structure();
+		timing_sys.rebuild_structure();
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, HugePageStorage_MatchesDefault) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({6,6,6});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 5; ++k) {
+		for (int j = 0; j < 5; ++j) {
+			for (int i = 0; i < 5; ++i) {
+				const vec3 pos = {0.5 + i * 1.1, 0.6 + j * 1.1, 0.7 + k * 1.1};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	// a zero threshold routes every buffer (storage and rebuild scratch) through the huge page mapping
+	const container::AllocatorConfig huge {
+		.alignment = 128,
+		.huge_pages = container::HugePages::Explicit,
+		.huge_page_threshold = 0
+	};
+
+	BuildInfo default_info, huge_info;
+	auto default_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &default_info);
+	auto huge_sys = build_system(env, TypeParam::create_container(2.5).with_allocator(huge), TypeParam::create_exec(), &huge_info);
+
+	default_sys.update_forces();
+	huge_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(default_sys, default_info.id_map[id]);
+		const auto q = get_particle_by_id(huge_sys, huge_info.id_map[id]);
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-12) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, AdaptiveSkin_RegridMatchesFixedGrid) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({24,24,24});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 8; ++k) {
+		for (int j = 0; j < 8; ++j) {
+			for (int i = 0; i < 8; ++i) {
+				const vec3 pos = {1.5 + i * 3.0 + jitter(gen), 1.5 + j * 3.0 + jitter(gen), 1.5 + k * 3.0 + jitter(gen)};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	// skin 2.5 yields 4 cells of width 6 per axis. The particles rest, so the first decision trades the
+	// unused skin for the finest grid within max_change (5 cells of width 4.8)
+	BuildInfo fixed_info, adaptive_info;
+	auto fixed_sys = build_system(env, TypeParam::create_container(2.5), TypeParam::create_exec(), &fixed_info);
+	auto adaptive_sys = build_system(env,
+		TypeParam::create_container(2.5).with_skin_factor(1.0).with_adaptive_skin({.interval = 2}),
+		TypeParam::create_exec(), &adaptive_info);
+
+	EXPECT_EQ(fixed_sys.skin_tuning(), nullptr);
+	ASSERT_NE(adaptive_sys.skin_tuning(), nullptr);
+	EXPECT_EQ(adaptive_sys.skin_tuning()->cells_per_axis, (uint3{4,4,4}));
+	EXPECT_DOUBLE_EQ(adaptive_sys.skin_tuning()->skin, 3.5);
+
+	for (int sweep = 0; sweep < 3; ++sweep) {
+		fixed_sys.update_forces();
+		adaptive_sys.update_forces();
+
+		for (ParticleID id = 0; id < user_id; ++id) {
+			const auto p = get_particle_by_id(fixed_sys, fixed_info.id_map[id]);
+			const auto q = get_particle_by_id(adaptive_sys, adaptive_info.id_map[id]);
+			EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-10) << "user id " << id << " sweep " << sweep;
+		}
+
+		fixed_sys.rebuild_structure();
+		adaptive_sys.rebuild_structure();
+	}
+
+	const auto& log = *adaptive_sys.skin_tuning();
+	ASSERT_EQ(log.decisions.size(), 1u);
+	EXPECT_TRUE(log.decisions[0].regridded);
+	EXPECT_EQ(log.regrids, 1u);
+	EXPECT_EQ(log.rebuilds, 0u);
+	EXPECT_EQ(log.cells_per_axis, (uint3{5,5,5}));
+	EXPECT_NEAR(log.skin, 2.3, 1e-12);
+}
+
+TYPED_TEST(LinkedCellsTest, AdaptiveSkin_FlatDomain_KeepsUnchangedGrid) {
+	Environment env(forces<LennardJones>, boundaries<OpenBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({24,24,0});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+
+	ParticleID user_id = 0;
+	for (int j = 0; j < 8; ++j) {
+		for (int i = 0; i < 8; ++i) {
+			const vec3 pos = {1.5 + i * 3.0 + jitter(gen), 1.5 + j * 3.0 + jitter(gen), 0};
+			env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+		}
+	}
+
+	// skin 2.5 yields 4 cells of width 6 in the plane. Every skin within max_change keeps these cells,
+	// so the decision must keep the grid, including the unused z axis
+	auto sys = build_system(env,
+		TypeParam::create_container(2.5).with_skin_factor(1.0).with_adaptive_skin({.interval = 2, .max_change = 1.01, .min_gain = 0.0}),
+		TypeParam::create_exec());
+
+	ASSERT_NE(sys.skin_tuning(), nullptr);
+	const uint3 initial_cells = sys.skin_tuning()->cells_per_axis;
+	EXPECT_EQ(initial_cells.x, 4u);
+	EXPECT_EQ(initial_cells.y, 4u);
+
+	for (int sweep = 0; sweep < 3; ++sweep) {
+		sys.update_forces();
+		sys.rebuild_structure();
+	}
+
+	const auto& log = *sys.skin_tuning();
+	ASSERT_EQ(log.decisions.size(), 1u);
+	EXPECT_FALSE(log.decisions[0].regridded);
+	EXPECT_EQ(log.decisions[0].new_cells, log.decisions[0].old_cells);
+	EXPECT_EQ(log.regrids, 0u);
+	EXPECT_EQ(log.cells_per_axis, initial_cells);
+}
+
+TYPED_TEST(LinkedCellsTest, PairStencils_MixedCutoffs_MatchDirectSum) {
+	// solvent (type 0) with a short cutoff and a few colloids (type 1) whose cutoff is five times larger
+	Environment env(forces<LennardJones>, boundaries<OpenBoundary>);
+	env.add_interaction(LennardJones(1.0, 0.5, 1.2), to_type(0));
+	env.add_interaction(LennardJones(1.0, 1.0, 3.0), between_types(0, 1));
+	env.add_interaction(LennardJones(1.0, 2.0, 6.0), to_type(1));
+
+	std::mt19937 gen(23);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+
+	ParticleID user_id = 0;
+	for (int k = 0; k < 12; ++k) {
+		for (int j = 0; j < 12; ++j) {
+			for (int i = 0; i < 12; ++i) {
+				const vec3 pos = {0.5 + i * 0.8 + jitter(gen), 0.5 + j * 0.8 + jitter(gen), 0.5 + k * 0.8 + jitter(gen)};
+				env.add_particle(make_particle(0, pos, {}, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+	for (int k = 0; k < 2; ++k) {
+		for (int j = 0; j < 2; ++j) {
+			for (int i = 0; i < 2; ++i) {
+				const vec3 pos = {3.3 + i * 4.0, 3.3 + j * 4.0, 3.3 + k * 4.0}; // between solvent lattice sites
+				env.add_particle(make_particle(1, pos, {}, 10.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	// cells sized by the solvent cutoff: the colloid stencils reach several cells, so use the owner-computes sweep
+	BuildInfo ds_info, lc_info;
+	auto ds_sys = build_system(env, DirectSum<Layout::AoS>{}, CustomExecConfig<ParallelPolicy::Serial>{}, &ds_info);
+	auto lc_sys = build_system(env,
+		TypeParam::create_container()
+			.with_cell_size(container::CellSize::SmallestCutoff)
+			.with_traversal(container::Traversal::FullShell),
+		TypeParam::create_exec(), &lc_info);
+
+	ds_sys.update_forces();
+	lc_sys.update_forces();
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(ds_sys, ds_info.id_map[id]);
+		const auto q = get_particle_by_id(lc_sys, lc_info.id_map[id]);
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-9 * std::max(1.0, p.force.norm())) << "user id " << id;
+	}
+}
+
+TYPED_TEST(LinkedCellsTest, PairStencils_SmallestCutoffRejectsColoring) {
+	// a cutoff ratio of five gives a stencil five cells deep, the default C08 coloring only separates
+	// blocks of the same color by two blocks (four cells)
+	Environment env(forces<LennardJones>, boundaries<OpenBoundary>);
+	env.add_interaction(LennardJones(1.0, 0.5, 1.2), to_type(0));
+	env.add_interaction(LennardJones(1.0, 2.0, 6.0), to_type(1));
+	env.set_origin({0, 0, 0});
+	env.set_extent({24, 24, 24});
+	env.add_particle(make_particle(0, {1, 1, 1}, {}, 1.0, ParticleState::ALIVE, 0));
+	env.add_particle(make_particle(1, {12, 12, 12}, {}, 10.0, ParticleState::ALIVE, 1));
+
+	const auto build = [&](auto c) {
+		return build_system(env, c.with_cell_size(container::CellSize::SmallestCutoff), TypeParam::create_exec());
+	};
+
+	if constexpr (TypeParam::ExecConfig::parallel_policy == ParallelPolicy::Threaded) {
+		EXPECT_THROW(build(TypeParam::create_container()), std::invalid_argument);
+	} else {
+		EXPECT_NO_THROW(build(TypeParam::create_container())); // blocks run one after another
+	}
+
+	// the owner-computes sweep and the task graph order blocks by the cells they write
+	EXPECT_NO_THROW(build(TypeParam::create_container().with_traversal(container::Traversal::FullShell)));
+	EXPECT_NO_THROW(build(TypeParam::create_container().with_task_graph()));
+}
+
+TYPED_TEST(LinkedCellsTest, SortedSweep_MatchesUnsorted) {
+	Environment env(forces<LennardJones>, boundaries<DummyPeriodicBoundary>);
+	env.set_origin({0,0,0});
+	env.set_extent({13,13,13});
+	env.add_interaction(LennardJones(1.0, 1.0, 2.5), to_type(0));
+	env.add_interaction(LennardJones(0.5, 1.0, 2.0), to_type(1));
+	env.add_interaction(LennardJones(0.8, 1.0, 2.2), between_types(0, 1));
+	env.set_boundaries(DummyPeriodicBoundary(), all_faces);
+
+	std::mt19937 gen(31);
+	std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+	std::uniform_real_distribution<double> speed(-0.5, 0.5);
+
+	// dense enough for several SIMD blocks per bin, so whole blocks get pruned
+	ParticleID user_id = 0;
+	for (int k = 0; k < 12; ++k) {
+		for (int j = 0; j < 12; ++j) {
+			for (int i = 0; i < 12; ++i) {
+				const vec3 pos = {0.5 + i * 1.08 + jitter(gen), 0.5 + j * 1.08 + jitter(gen), 0.5 + k * 1.08 + jitter(gen)};
+				const vec3 vel = {speed(gen), speed(gen), speed(gen)};
+				const ParticleType type = static_cast<ParticleType>((i + 2 * j + k) % 2);
+				env.add_particle(make_particle(type, pos, vel, 1.0, ParticleState::ALIVE, user_id++));
+			}
+		}
+	}
+
+	// the particles move up to skin / 2 between rebuilds (and trigger several), the pruning has to account for it
+	BuildInfo plain_info, sorted_info;
+	auto plain_sys = build_system(env,
+		TypeParam::create_container(2.5).with_skin_factor(0.1), TypeParam::create_exec(), &plain_info);
+	auto sorted_sys = build_system(env,
+		TypeParam::create_container(2.5).with_skin_factor(0.1).with_sorted_sweep(),
+		TypeParam::create_exec(), &sorted_info);
+
+	VelocityVerlet plain_integrator(plain_sys);
+	VelocityVerlet sorted_integrator(sorted_sys);
+	plain_integrator.run_for_steps(0.005, 100);
+	sorted_integrator.run_for_steps(0.005, 100);
+
+	for (ParticleID id = 0; id < user_id; ++id) {
+		const auto p = get_particle_by_id(plain_sys, plain_info.id_map[id]);
+		const auto q = get_particle_by_id(sorted_sys, sorted_info.id_map[id]);
+
+		ASSERT_NEAR((p.position - q.position).norm(), 0.0, 1e-9) << "user id " << id;
+		EXPECT_NEAR((p.force - q.force).norm(), 0.0, 1e-7 * std::max(1.0, p.force.norm())) << "user id " << id;
+	}
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+
+#include "april/containers/layout/internal/memory.hpp"
+
+using namespace april;
+using namespace april::container;
+using namespace april::container::layout;
+
+
+namespace {
+    bool is_aligned(const void* p, const size_t alignment) {
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    }
+}
+
+
+TEST(MemoryTest, PageVector_HonoursAlignment) {
+    PageVector<double> v(PageAllocator<double>({.alignment = 256, .huge_pages = HugePages::None}));
+    v.resize(1000);
+    EXPECT_TRUE(is_aligned(v.data(), 256));
+
+    std::iota(v.begin(), v.end(), 0.0);
+    EXPECT_EQ(v[999], 999.0);
+}
+
+TEST(MemoryTest, PageVector_LargeBuffersAreHugePageAligned) {
+    const AllocatorConfig config{.huge_pages = HugePages::Transparent, .huge_page_threshold = 1 << 16};
+    PageVector<double> v(PageAllocator<double>{config});
+    v.resize(1 << 20); // 8 MiB
+
+#if defined(__linux__)
+    EXPECT_TRUE(is_aligned(v.data(), internal::huge_page_size));
+#endif
+    v.back() = 1.0;
+    EXPECT_EQ(v.back(), 1.0);
+
+    // explicit huge pages fall back to transparent ones if none are reserved
+    PageVector<double> w(PageAllocator<double>{AllocatorConfig{.huge_pages = HugePages::Explicit, .huge_page_threshold = 0}});
+    w.assign(100, 2.0);
+    EXPECT_EQ(w[99], 2.0);
+}
+
+TEST(MemoryTest, PageVector_SwapKeepsAllocators) {
+    const AllocatorConfig config{.alignment = 128, .huge_pages = HugePages::None};
+    PageVector<int> a(PageAllocator<int>{config}), b(PageAllocator<int>{config});
+    a.assign(10, 1);
+    b.assign(20, 2);
+
+    const int* a_data = a.data();
+    std::swap(a, b);
+    EXPECT_EQ(b.data(), a_data); // ping pong swap exchanges buffers, no copy
+    EXPECT_EQ(a.get_allocator().settings(), config);
+}
+
+TEST(MemoryTest, ScratchArena_StopsAllocatingAfterWarmUp) {
+    ScratchArena arena({.huge_pages = HugePages::None});
+
+    auto cycle = [&] {
+        arena.reset();
+        auto a = arena.take<size_t>(1000);
+        auto b = arena.take<double>(5000);
+        auto c = arena.take<uint32_t>(3);
+
+        a.back() = 1; b.back() = 2.0; c.back() = 3;
+        EXPECT_TRUE(is_aligned(a.data(), 64));
+        EXPECT_TRUE(is_aligned(b.data(), 64));
+        EXPECT_TRUE(is_aligned(c.data(), 64));
+        return a.data();
+    };
+
+    cycle();
+    EXPECT_GT(arena.overflow_blocks(), 0u); // cold arena
+
+    const size_t* first = cycle();
+    EXPECT_EQ(arena.overflow_blocks(), 0u);
+    const size_t capacity = arena.capacity();
+    EXPECT_GE(capacity, arena.peak_usage());
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(cycle(), first);
+        EXPECT_EQ(arena.overflow_blocks(), 0u);
+        EXPECT_EQ(arena.capacity(), capacity);
+    }
+}
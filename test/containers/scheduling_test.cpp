@@ -342,4 +342,72 @@ TEST(TopologyScheduling, MixedParallelAndSequential) {
     EXPECT_EQ(phases[1].size(), 1); // Flattened to exactly 1 batch
     EXPECT_EQ(phases[1][0].size(), 2); // Containing the 2 leftover conflicting pairs ({0,2} and {0,3})
     EXPECT_EQ(count_total_pairs(phases), 6);
-}
\ No newline at end of file
+}
+
+TEST(TopologyLanePacking, ChainGroupsAreConflictFree) {
+    // a linear chain 0-1-2-...-40: every node is shared by at most two bonds
+    std::vector<std::array<Node, 2>> interactions;
+    for (Node i = 0; i < 40; ++i) interactions.push_back({i, i + 1});
+    const auto original = interactions;
+
+    constexpr size_t width = 4;
+    const size_t groups = build_conflict_free_lanes(interactions, width);
+
+    // a chain can always be split into conflict-free groups (every other bond)
+    EXPECT_EQ(groups, 10);
+
+    // no interaction may be lost or duplicated
+    ASSERT_EQ(interactions.size(), original.size());
+    std::multiset<std::array<Node, 2>> before(original.begin(), original.end());
+    std::multiset<std::array<Node, 2>> after(interactions.begin(), interactions.end());
+    EXPECT_EQ(before, after);
+
+    // every lane group touches each particle at most once
+    for (size_t g = 0; g < groups; ++g) {
+        std::unordered_set<Node> seen;
+        for (size_t lane = 0; lane < width; ++lane) {
+            for (const Node n : interactions[g * width + lane]) {
+                ASSERT_TRUE(seen.insert(n).second)
+                    << "Lane conflict detected on Node " << n << " in group " << g;
+            }
+        }
+    }
+}
+
+TEST(TopologyLanePacking, HubIsLeftToRemainder) {
+    // every bond shares node 0 -> no two bonds may share a lane group
+    std::vector<std::array<Node, 2>> interactions;
+    for (Node i = 1; i <= 8; ++i) interactions.push_back({0, i});
+
+    const size_t groups = build_conflict_free_lanes(interactions, 4);
+
+    EXPECT_EQ(groups, 0);
+    EXPECT_EQ(interactions.size(), 8);
+}
+
+TEST(TopologyScheduling, AngleTuplesAreIndependent) {
+    // angles of two separate chains 0..9 and 10..19 (i, i+1, i+2)
+    using Angles = april::utility::graph::TupleList<Node, 3>;
+    Angles angles;
+    for (Node start : {Node{0}, Node{10}}) {
+        for (Node i = start; i + 2 < start + 10; ++i) angles.push_back({i, i + 1, i + 2});
+    }
+
+    const auto phases = build_concurrent_phases(std::vector<Angles>{angles}, 10, 1);
+
+    // each chain is one connected component -> both fit into a single phase
+    ASSERT_EQ(phases.size(), 1);
+    ASSERT_EQ(phases[0].size(), 2);
+
+    std::unordered_set<Node> seen;
+    size_t total = 0;
+    for (const auto& batch : phases[0]) {
+        std::unordered_set<Node> nodes;
+        for (const auto& tuple : batch) nodes.insert(tuple.begin(), tuple.end());
+        for (const Node n : nodes) {
+            ASSERT_TRUE(seen.insert(n).second) << "Cross-batch race condition detected on Node " << n;
+        }
+        total += batch.size();
+    }
+    EXPECT_EQ(total, angles.size());
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "april/containers/skin_tuning.hpp"
+
+using namespace april;
+using container::AdaptiveSkin;
+using container::internal::SkinTuner;
+
+
+namespace {
+	// 24^3 domain, cutoff and base cell width 2.5
+	SkinTuner make_tuner(const AdaptiveSkin& settings, const double skin, const uint3 cells) {
+		SkinTuner tuner(settings, skin);
+		tuner.set_geometry({24, 24, 24}, 2.5, 2.5);
+		tuner.grid_changed(skin, cells);
+		return tuner;
+	}
+
+	void run_window(SkinTuner& tuner, const size_t updates, const double displacement_per_step, const double traversal_sec) {
+		for (size_t i = 1; i <= updates; ++i) {
+			tuner.record_traversal(traversal_sec);
+			tuner.record_update(displacement_per_step * static_cast<double>(i), i);
+		}
+	}
+}
+
+
+TEST(SkinTunerTest, NoDecisionWithoutMeasurements) {
+	SkinTuner tuner = make_tuner({.interval = 2}, 3.5, {4, 4, 4});
+
+	run_window(tuner, 1, 0.0, 0.0);
+	EXPECT_FALSE(tuner.decision_due());
+	run_window(tuner, 1, 0.0, 0.0);
+	ASSERT_TRUE(tuner.decision_due());
+
+	// no traversal or rebuild cost measured yet: keep the grid but log the decision
+	EXPECT_FALSE(tuner.decide().has_value());
+	EXPECT_FALSE(tuner.decision_due());
+	ASSERT_EQ(tuner.history().decisions.size(), 1u);
+	EXPECT_FALSE(tuner.history().decisions[0].regridded);
+	EXPECT_EQ(tuner.history().regrids, 0u);
+}
+
+
+TEST(SkinTunerTest, RestingParticlesShrinkTheSkin) {
+	SkinTuner tuner = make_tuner({.interval = 4}, 3.5, {4, 4, 4});
+	tuner.seed_rebuild_cost(1e-3);
+	run_window(tuner, 4, 0.0, 1e-3);
+
+	// nothing moves, so only the traversal counts: the finest grid within max_change (skin >= 1.75) wins
+	const auto skin = tuner.decide();
+	ASSERT_TRUE(skin.has_value());
+	EXPECT_NEAR(*skin, 2.3, 1e-12); // 5 cells of width 4.8
+	EXPECT_DOUBLE_EQ(tuner.target_skin(), *skin);
+
+	const auto& d = tuner.history().decisions.back();
+	EXPECT_TRUE(d.regridded);
+	EXPECT_EQ(d.old_cells, (uint3{4, 4, 4}));
+	EXPECT_EQ(d.new_cells, (uint3{5, 5, 5}));
+	EXPECT_DOUBLE_EQ(d.displacement_rate, 0.0);
+	EXPECT_DOUBLE_EQ(d.traversal_sec, 1e-3);
+	EXPECT_GT(d.predicted_gain, 0.4);
+	EXPECT_EQ(tuner.history().regrids, 1u);
+}
+
+
+TEST(SkinTunerTest, FastParticlesGrowTheSkin) {
+	SkinTuner tuner = make_tuner({.interval = 10}, 0.5, {8, 8, 8});
+	for (int i = 0; i < 5; ++i) tuner.record_rebuild(1e-2);
+	run_window(tuner, 10, 0.2, 1e-3);
+
+	// rebuilding almost every step costs more than the wider cells
+	const auto skin = tuner.decide();
+	ASSERT_TRUE(skin.has_value());
+	EXPECT_GT(*skin, 0.5);
+
+	const auto& d = tuner.history().decisions.back();
+	EXPECT_DOUBLE_EQ(d.displacement_rate, 0.2);
+	EXPECT_DOUBLE_EQ(d.rebuilds_per_step, 0.5);
+	EXPECT_EQ(d.new_cells, (uint3{6, 6, 6}));
+	EXPECT_EQ(tuner.history().rebuilds, 5u);
+}
+
+
+TEST(SkinTunerTest, MinGainKeepsTheGrid) {
+	SkinTuner tuner = make_tuner({.interval = 4, .min_gain = 0.9}, 3.5, {4, 4, 4});
+	tuner.seed_rebuild_cost(1e-3);
+	run_window(tuner, 4, 0.0, 1e-3);
+
+	EXPECT_FALSE(tuner.decide().has_value());
+	EXPECT_DOUBLE_EQ(tuner.target_skin(), 3.5);
+
+	const auto& d = tuner.history().decisions.back();
+	EXPECT_FALSE(d.regridded);
+	EXPECT_GT(d.predicted_gain, 0.4);
+	EXPECT_EQ(d.new_cells, d.old_cells);
+}
+
+
+TEST(SkinTunerTest, UsableSkinIgnoresFlatAxes) {
+	SkinTuner tuner({}, 0.5);
+	tuner.set_geometry({12, 12, 0}, 2.5, 2.5);
+
+	EXPECT_DOUBLE_EQ(tuner.usable_skin({3, 4, 0}, 0.5), 0.5);
+	EXPECT_DOUBLE_EQ(tuner.usable_skin({3.5, 4, 0}, 0.5), 1.0);
+}
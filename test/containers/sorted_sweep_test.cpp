@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "april/containers/batching/sorted_sweep.hpp"
+#include "april/containers/layout/internal/bin_sort.hpp"
+
+using namespace april;
+using container::batching::SortedSweep;
+
+
+namespace {
+	// pairs (o, i) visited by the sweep
+	std::vector<std::pair<size_t, size_t>> sweep_pairs(const SortedSweep& sweep, const math::Range& outer, const math::Range& inner) {
+		std::vector<std::pair<size_t, size_t>> pairs;
+		sweep.for_each_window(outer, inner, [&](const size_t o, const math::Range& window) {
+			for (const size_t i : window) pairs.emplace_back(o, i);
+		});
+		return pairs;
+	}
+
+	// pairs within reach by brute force
+	std::vector<std::pair<size_t, size_t>> close_pairs(const SortedSweep& sweep, const math::Range& outer, const math::Range& inner) {
+		std::vector<std::pair<size_t, size_t>> pairs;
+		for (const size_t o : outer) {
+			for (const size_t i : inner) {
+				if (std::abs(sweep.keys[o] - sweep.keys[i]) <= sweep.reach) pairs.emplace_back(o, i);
+			}
+		}
+		return pairs;
+	}
+}
+
+
+TEST(SortedSweepTest, WindowsCoverExactlyThePairsInReach) {
+	// two sorted ranges, interleaved along the axis
+	const std::vector<double> keys = {0.0, 0.4, 1.1, 2.5, 2.6, 4.0,   0.3, 0.9, 2.0, 3.9, 5.5, 7.0};
+	const SortedSweep sweep{keys.data(), 1.0};
+	const math::Range r1 = {0, 6};
+	const math::Range r2 = {6, 12};
+
+	EXPECT_EQ(sweep_pairs(sweep, r1, r2), close_pairs(sweep, r1, r2));
+	EXPECT_EQ(sweep_pairs(sweep, r2, r1), close_pairs(sweep, r2, r1));
+	EXPECT_EQ(sweep_pairs(sweep, r1, r1), close_pairs(sweep, r1, r1));
+}
+
+TEST(SortedSweepTest, BlocksApart) {
+	const std::vector<double> keys = {0.0, 0.5, 1.0, 1.5,   2.4, 3.0, 3.5, 4.0};
+	const SortedSweep sweep{keys.data(), 1.0};
+
+	EXPECT_TRUE(sweep.apart(0, 1, 4, 7));  // 0.5 vs 2.4
+	EXPECT_FALSE(sweep.apart(0, 3, 4, 7)); // 1.5 vs 2.4
+	EXPECT_TRUE(sweep.apart(4, 7, 0, 1));  // symmetric
+	EXPECT_FALSE(sweep.apart(2, 2, 3, 3));
+	EXPECT_FALSE(SortedSweep{}.active());
+}
+
+TEST(SortedSweepTest, SortBinByKey) {
+	// keys by source index, the bin lists sources in destination order
+	const std::vector<double> source_keys = {3.0, 1.0, 2.0, 0.5, 1.0};
+	std::vector<size_t> bin = {0, 1, 2, 3, 4};
+	container::layout::internal::sort_bin_by_key(bin, source_keys);
+
+	EXPECT_EQ(bin, (std::vector<size_t>{3, 1, 4, 2, 0})); // equal keys keep their order
+
+	std::vector<size_t> large(1000);
+	std::vector<double> large_keys(1000);
+	for (size_t i = 0; i < large.size(); ++i) {
+		large[i] = i;
+		large_keys[i] = static_cast<double>((i * 7919) % 1000);
+	}
+	container::layout::internal::sort_bin_by_key(large, large_keys);
+	for (size_t i = 1; i < large.size(); ++i) EXPECT_LE(large_keys[large[i - 1]], large_keys[large[i]]);
+}
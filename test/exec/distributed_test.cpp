@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "april/containers/linked_cells.hpp"
+#include "april/exec/distributed/in_process_communicator.hpp"
+#include "april/exec/distributed/shm_communicator.hpp"
+#include "april/exec/distributed/domain_decomposition.hpp"
+
+#include "utils.h"
+
+using namespace april;
+using namespace april::exec;
+
+
+namespace {
+    struct DistributedParticle {
+        vec3 position;
+        ParticleID id;
+        ParticleType type;
+    };
+
+    std::vector<DistributedParticle> random_particles(const core::Box& box, const size_t n, const unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+
+        std::vector<DistributedParticle> particles;
+        for (size_t i = 0; i < n; ++i) {
+            const vec3 pos = {
+                box.min.x + u(gen) * box.extent.x,
+                box.min.y + u(gen) * box.extent.y,
+                box.min.z + u(gen) * box.extent.z
+            };
+            particles.push_back({pos, static_cast<ParticleID>(i), static_cast<ParticleType>(i % 2)});
+        }
+        return particles;
+    }
+}
+
+
+TEST(DistributedTest, InProcess_RingSendRecvAndAllreduce) {
+    constexpr int n_ranks = 4;
+
+    run_in_process(n_ranks, [](InProcessCommunicator& comm) {
+        const int right = (comm.rank() + 1) % comm.size();
+        const int left = (comm.rank() + comm.size() - 1) % comm.size();
+
+        const std::vector<int> payload(100 + comm.rank(), comm.rank());
+        std::vector<std::byte> buffer;
+        std::vector<int> received;
+
+        comm.sendrecv(right, as_message(payload), left, buffer, 1);
+        append_message(buffer, received);
+
+        EXPECT_EQ(received.size(), 100u + left);
+        EXPECT_EQ(received.front(), left);
+        EXPECT_DOUBLE_EQ(comm.allreduce_sum(comm.rank() + 1.0), 10.0);
+    });
+}
+
+TEST(DistributedTest, InProcess_TagMismatchThrows) {
+    EXPECT_THROW(run_in_process(2, [](InProcessCommunicator& comm) {
+        std::vector<std::byte> buffer;
+        if (comm.rank() == 0) comm.send(1, 1, {});
+        else comm.recv(0, 2, buffer);
+    }), std::logic_error);
+}
+
+TEST(DistributedTest, BalancedGrid_MinimizesInterfaces) {
+    EXPECT_EQ(DomainDecomposition::balanced_grid(8, {1, 1, 1}), uint3(2, 2, 2));
+    EXPECT_EQ(DomainDecomposition::balanced_grid(4, {10, 10, 1}), uint3(2, 2, 1));
+    EXPECT_EQ(DomainDecomposition::balanced_grid(3, {9, 1, 1}), uint3(3, 1, 1));
+}
+
+TEST(DistributedTest, Migrate_DeliversParticlesToOwners) {
+    constexpr int n_ranks = 4;
+    const core::Box box({0, 0, 0}, {8, 6, 4});
+    const auto particles = random_particles(box, 400, 3);
+
+    std::mutex mutex;
+    size_t total = 0;
+
+    run_in_process(n_ranks, [&](InProcessCommunicator& comm) {
+        DomainDecomposition decomposition(box, n_ranks, comm.rank());
+
+        // start from the correct owners, then push everything by a bit less than a subdomain
+        std::vector<DistributedParticle> owned;
+        for (const auto& p : particles) {
+            if (decomposition.owner_of(p.position) == comm.rank()) owned.push_back(p);
+        }
+        for (auto& p : owned) p.position += vec3{1.5, -1.5, 0.5};
+
+        decomposition.migrate(comm, owned);
+
+        for (const auto& p : owned) {
+            EXPECT_TRUE(decomposition.local_box().contains(p.position)) << "rank " << comm.rank() << " id " << p.id;
+        }
+
+        std::scoped_lock lock(mutex);
+        total += owned.size();
+    });
+
+    EXPECT_EQ(total, particles.size());
+}
+
+TEST(DistributedTest, HaloExchange_SubdomainForcesMatchSingleSystem) {
+    constexpr int n_ranks = 4;
+    constexpr double cutoff = 2.5;
+    const core::Box box({0, 0, 0}, {9, 9, 9});
+    const auto particles = random_particles(box, 300, 11);
+
+    auto add_interactions = [](auto& env) {
+        env.add_interaction(LennardJones(1.0, 0.8, cutoff), to_type(0));
+        env.add_interaction(LennardJones(0.5, 0.9, cutoff), to_type(1));
+        env.add_interaction(LennardJones(0.8, 0.85, cutoff), between_types(0, 1));
+    };
+
+    auto container = [] {
+        return LinkedCells<Layout::SoA>{}.with_abs_cell_size(cutoff).with_skin_factor(0.0);
+    };
+
+    // reference: one periodic system over the whole box
+    std::vector<vec3> reference(particles.size());
+    {
+        Environment env(forces<LennardJones>, boundaries<PeriodicBoundary>);
+        env.set_origin(box.min);
+        env.set_extent(box.extent);
+        env.set_boundaries(PeriodicBoundary(), all_faces);
+        add_interactions(env);
+        for (const auto& p : particles) {
+            env.add_particle(make_particle(p.type, p.position, {}, 1.0, ParticleState::ALIVE, p.id));
+        }
+
+        BuildInfo info;
+        auto sys = build_system(env, container(), &info);
+        sys.update_forces();
+        for (const auto& p : particles) {
+            reference[p.id] = get_particle_by_id(sys, info.id_map[p.id]).force;
+        }
+    }
+
+    run_in_process(n_ranks, [&](InProcessCommunicator& comm) {
+        DomainDecomposition decomposition(box, n_ranks, comm.rank(), {true, true, true}, uint3{2, 2, 1});
+
+        std::vector<DistributedParticle> owned, ghosts;
+        for (const auto& p : particles) {
+            if (decomposition.owner_of(p.position) == comm.rank()) owned.push_back(p);
+        }
+        decomposition.exchange_halo(comm, owned, ghosts, cutoff);
+
+        // local system over the subdomain grown by the halo, owned particles first
+        const core::Box& local = decomposition.local_box();
+        Environment env(forces<LennardJones>);
+        env.set_origin(local.min - vec3d(cutoff));
+        env.set_extent(local.extent + vec3d(2 * cutoff));
+        add_interactions(env);
+
+        ParticleID local_id = 0;
+        for (const auto& p : owned) {
+            env.add_particle(make_particle(p.type, p.position, {}, 1.0, ParticleState::ALIVE, local_id++));
+        }
+        for (const auto& p : ghosts) {
+            env.add_particle(make_particle(p.type, p.position, {}, 1.0, ParticleState::STATIONARY, local_id++));
+        }
+
+        BuildInfo info;
+        auto sys = build_system(env, container(), &info);
+        sys.update_forces();
+
+        for (size_t i = 0; i < owned.size(); ++i) {
+            const vec3 force = get_particle_by_id(sys, info.id_map[static_cast<ParticleID>(i)]).force;
+            const vec3& expected = reference[owned[i].id];
+            const double tolerance = 1e-9 * std::max(1.0, static_cast<double>(expected.norm())); // random overlaps give large forces
+            EXPECT_NEAR((force - expected).norm(), 0.0, tolerance) << "rank " << comm.rank() << " id " << owned[i].id;
+        }
+    });
+}
+
+#if defined(__unix__)
+TEST(DistributedTest, SharedMemory_ForkedRanksExchangeMessages) {
+    constexpr int n_ranks = 3;
+    const auto world = SharedMemoryWorld::create("/april_test_" + std::to_string(getpid()), n_ranks, 256);
+
+    // payloads are larger than the rings, so messages are streamed in pieces
+    const bool ok = run_forked(world, [](SharedMemoryCommunicator& comm) {
+        const int right = (comm.rank() + 1) % comm.size();
+        const int left = (comm.rank() + comm.size() - 1) % comm.size();
+
+        std::vector<std::byte> buffer;
+        std::vector<double> received;
+        for (int round = 0; round < 5; ++round) {
+            const std::vector<double> payload(1000 + round, comm.rank());
+            received.clear();
+            comm.sendrecv(right, as_message(payload), left, buffer, round);
+            append_message(buffer, received);
+
+            if (received.size() != payload.size() || received.back() != left) return false;
+            if (comm.allreduce_sum(comm.rank()) != 3.0) return false;
+        }
+        return true;
+    });
+
+    EXPECT_TRUE(ok);
+}
+#endif
@@ -2,10 +2,12 @@
 #include <atomic>
 #include <set>
 #include <mutex>
+#include <sstream>
 
 #include "april/exec/threading/threading_context.hpp"
 #include "april/exec/threading/backends/native_barrier_executor.hpp"
 #include "april/exec/threading/backends/native_spin_executor.hpp"
+#include "april/exec/threading/trace.hpp"
 
 using namespace april;
 using namespace april::exec;
@@ -107,4 +109,94 @@ TYPED_TEST(ExecutorTest, HandlesZeroBatchCount) {
     bool called = false;
     executor.execute(0, [&](size_t) { called = true; });
     EXPECT_FALSE(called);
-}
\ No newline at end of file
+}
+
+// 5. Traced chunks cover every task exactly once and carry the caller's label
+TYPED_TEST(ExecutorTest, TraceRecordsLabelledChunks) {
+    if constexpr (!trace::compiled_in) {
+        GTEST_SKIP() << "executor tracing is compiled out (APRIL_ENABLE_EXECUTOR_TRACE)";
+    } else {
+        TypeParam executor(this->config);
+        constexpr size_t num_tasks = 1000;
+
+        trace::clear();
+        trace::enable();
+        {
+            const trace::ScopedLabel label("test phase", 3);
+            executor.execute(num_tasks, [](size_t) {});
+        }
+        trace::enable(false);
+
+        std::ostringstream json;
+        trace::write_chrome_json(json);
+        EXPECT_NE(json.str().find("\"test phase 3\""), std::string::npos);
+        EXPECT_NE(json.str().find("\"cat\":\"execute\""), std::string::npos);
+
+        // every task index appears in exactly one chunk
+        size_t covered = 0;
+        for (size_t pos = 0; (pos = json.str().find("\"first\":", pos)) != std::string::npos; ++pos) {
+            size_t first = 0, last = 0;
+            std::sscanf(json.str().c_str() + pos, "\"first\":%zu,\"last\":%zu", &first, &last);
+            covered += last - first;
+        }
+        EXPECT_EQ(covered, num_tasks);
+        trace::clear();
+    }
+}
+
+// 6. Spin-then-park: idle workers go to sleep and wake up for the next batch
+TEST(NativeSpinExecutorTest, IdleWorkersParkAndWakeUp) {
+    NativeSpinExecutor executor({.n_threads = 4, .pin_threads = false, .spin_iterations = 16});
+    EXPECT_EQ(executor.spin_iterations(), 16u);
+
+    const size_t workers = executor.num_threads() - 1;
+    for (int round = 0; round < 3; ++round) {
+        // wait until every worker has given up spinning
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (executor.parked_threads() != workers && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(executor.parked_threads(), workers);
+
+        std::atomic<size_t> counter{0};
+        executor.execute(64, [&](size_t) { counter.fetch_add(1); });
+        EXPECT_EQ(counter.load(), 64u);
+    }
+}
+
+TEST(NativeSpinExecutorTest, CalibratesSpinIterations) {
+    const NativeSpinExecutor executor({.n_threads = 2, .pin_threads = false});
+    EXPECT_GE(executor.spin_iterations(), 16u);
+}
+
+TEST(TraceTest, ExportsRecordedEventsAsChromeJson) {
+    trace::clear();
+    trace::enable(true, 4);
+
+    std::thread([] {
+        for (uint32_t i = 0; i < 6; ++i) {
+            trace::record({.begin_ns = 1000 * i, .end_ns = 1000 * i + 500, .label = {"block \"a\"", i},
+                           .first = i, .last = i + 1, .kind = trace::EventKind::Chunk});
+        }
+    }).join();
+    trace::enable(false);
+    trace::record({.label = {"ignored"}}); // disabled: not recorded
+
+    std::ostringstream os;
+    trace::write_chrome_json(os);
+    const std::string json = os.str();
+
+    // the ring holds the four newest events
+    EXPECT_EQ(trace::dropped_events(), 2u);
+    EXPECT_EQ(json.find("block \\\"a\\\" 1"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"block \\\"a\\\" 5\",\"cat\":\"chunk\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\":5.000,\"dur\":0.500"), std::string::npos);
+    EXPECT_NE(json.find("thread (no executor)"), std::string::npos);
+    EXPECT_EQ(json.find("ignored"), std::string::npos);
+
+    // the ring of the exited thread is released
+    trace::clear();
+    std::ostringstream empty;
+    trace::write_chrome_json(empty);
+    EXPECT_EQ(empty.str().find("block"), std::string::npos);
+}
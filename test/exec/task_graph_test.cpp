@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+#include "april/exec/threading/task_graph.hpp"
+#include "april/exec/threading/backends/native_spin_executor.hpp"
+
+using namespace april;
+using namespace april::exec;
+
+
+TEST(TaskGraphTest, DerivesDependenciesFromAccesses) {
+    TaskGraph graph;
+
+    const size_t s0 = graph.add_stage(2);
+    graph.writes(s0, 0, 1);
+    graph.writes(s0, 1, 2);
+
+    const size_t s1 = graph.add_stage(3);
+    graph.reads(s1, 0, 1);  // read after write -> depends on (s0, 0)
+    graph.reads(s1, 1, 1);  // read after write -> depends on (s0, 0)
+    graph.writes(s1, 2, 3); // untouched resource -> independent
+
+    const size_t s2 = graph.add_stage(1);
+    graph.writes(s2, 0, 1); // write after the two reads -> depends on both readers
+
+    graph.compile();
+
+    EXPECT_EQ(graph.num_stages(), 3u);
+    EXPECT_EQ(graph.num_tasks(), 6u);
+    EXPECT_EQ(graph.num_edges(), 5u); // (s0,0) -> (s1,0), (s1,1), (s2,0) and (s1,0), (s1,1) -> (s2,0)
+}
+
+TEST(TaskGraphTest, DisjointStagesHaveNoEdges) {
+    TaskGraph graph;
+    for (size_t s = 0; s < 4; ++s) {
+        const size_t stage = graph.add_stage(8);
+        for (size_t t = 0; t < 8; ++t) graph.writes(stage, t, s * 8 + t);
+    }
+    graph.compile();
+
+    EXPECT_EQ(graph.num_edges(), 0u);
+}
+
+TEST(TaskGraphTest, RunBeforeCompileThrows) {
+    TaskGraph graph;
+    graph.add_stage(1);
+
+    NativeSpinExecutor executor({.n_threads = 2, .pin_threads = false});
+    EXPECT_THROW(graph.run(executor, [](size_t, size_t) {}), std::logic_error);
+}
+
+// every stage increments the same per-resource counters, so any ordering violation shows up in the values
+TEST(TaskGraphTest, RespectsDependenciesUnderThreading) {
+    constexpr size_t n_resources = 16;
+    constexpr size_t n_stages = 6;
+    constexpr size_t tasks_per_stage = 24;
+
+    TaskGraph graph;
+    for (size_t s = 0; s < n_stages; ++s) {
+        const size_t stage = graph.add_stage(tasks_per_stage);
+        for (size_t t = 0; t < tasks_per_stage; ++t) {
+            graph.writes(stage, t, (t + s) % n_resources);
+            graph.reads(stage, t, (t + 3 * s + 1) % n_resources);
+        }
+    }
+    graph.compile();
+
+    // expected final values from a sequential run
+    std::vector<long> expected(n_resources, 0);
+    auto body = [](std::vector<long>& values, const size_t s, const size_t t) {
+        const size_t w = (t + s) % n_resources;
+        const size_t r = (t + 3 * s + 1) % n_resources;
+        values[w] = values[w] * 3 + values[r] % 7 + 1;
+    };
+    graph.run<ParallelPolicy::Serial>(NativeSpinExecutor({.n_threads = 1, .pin_threads = false}), [&](size_t s, size_t t) {
+        body(expected, s, t);
+    });
+
+    NativeSpinExecutor executor({.n_threads = 4, .pin_threads = false});
+    for (int repeat = 0; repeat < 20; ++repeat) {
+        std::vector<long> values(n_resources, 0);
+        std::atomic<size_t> executed{0};
+
+        graph.run(executor, [&](size_t s, size_t t) {
+            body(values, s, t);
+            executed.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        EXPECT_EQ(executed.load(), n_stages * tasks_per_stage);
+        EXPECT_EQ(values, expected);
+    }
+}
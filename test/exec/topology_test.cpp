@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+#include "april/exec/topology.hpp"
+#include "april/exec/threading/backends/native_spin_executor.hpp"
+#include "april/exec/threading/backends/native_barrier_executor.hpp"
+#include "april/containers/layout/internal/first_touch_buffer.hpp"
+
+using namespace april;
+using namespace april::exec;
+
+
+namespace {
+    // 2 nodes x 2 cores x 2 SMT siblings, numbered like Linux does: siblings are cpu and cpu + 4
+    CpuTopology two_node_smt() {
+        CpuTopology t;
+        t.cpus = {
+            {0, 0, 0, 0}, {1, 1, 0, 0}, {2, 0, 1, 1}, {3, 1, 1, 1},
+            {4, 0, 0, 0}, {5, 1, 0, 0}, {6, 0, 1, 1}, {7, 1, 1, 1},
+        };
+        return t;
+    }
+}
+
+
+TEST(TopologyTest, ParseCpuList) {
+    EXPECT_EQ(internal::parse_cpu_list("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(internal::parse_cpu_list("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(internal::parse_cpu_list("").empty());
+}
+
+TEST(TopologyTest, Counts) {
+    const auto t = two_node_smt();
+    EXPECT_EQ(t.num_cpus(), 8u);
+    EXPECT_EQ(t.num_cores(), 4u);
+    EXPECT_EQ(t.num_nodes(), 2u);
+    EXPECT_EQ(t.node_of(6), 1);
+}
+
+TEST(TopologyTest, PinningPlans) {
+    const auto t = two_node_smt();
+
+    EXPECT_TRUE(internal::make_pinning_plan(t, PinningPolicy::None, 4).empty());
+    EXPECT_EQ(internal::make_pinning_plan(t, PinningPolicy::Linear, 3), (std::vector<int>{0, 1, 2}));
+
+    // fill node 0 (including siblings) first
+    EXPECT_EQ(internal::make_pinning_plan(t, PinningPolicy::Compact, 8), (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7}));
+
+    // all physical cores before any sibling
+    EXPECT_EQ(internal::make_pinning_plan(t, PinningPolicy::SkipSMT, 8), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+    // alternate between nodes
+    EXPECT_EQ(internal::make_pinning_plan(t, PinningPolicy::Scatter, 4), (std::vector<int>{0, 2, 1, 3}));
+
+    // oversubscription wraps around
+    EXPECT_EQ(internal::make_pinning_plan(t, PinningPolicy::SkipSMT, 10)[8], 0);
+}
+
+TEST(TopologyTest, DiscoverSystem) {
+    const auto& t = CpuTopology::system();
+    ASSERT_GE(t.num_cpus(), 1u);
+    EXPECT_GE(t.num_nodes(), 1u);
+    EXPECT_LE(t.num_cores(), t.num_cpus());
+
+    std::set<int> ids;
+    for (const auto& c : t.cpus) ids.insert(c.cpu);
+    EXPECT_EQ(ids.size(), t.num_cpus());
+}
+
+TEST(TopologyTest, ExecutorReportsPinnedCpus) {
+    NativeSpinExecutor pinned({.n_threads = 2, .pin_threads = true, .pinning = PinningPolicy::Compact});
+    const auto plan = internal::make_pinning_plan(CpuTopology::system(), PinningPolicy::Compact, 2);
+    EXPECT_EQ(pinned.pinned_cpu(0), plan[0]);
+    EXPECT_EQ(pinned.pinned_cpu(1), plan[1]);
+
+    NativeBarrierExecutor unpinned({.n_threads = 2, .pin_threads = false});
+    EXPECT_EQ(unpinned.pinned_cpu(0), -1);
+}
+
+TEST(TopologyTest, FirstTouchBuffer_ResizePreservesElements) {
+    NativeSpinExecutor executor({.n_threads = 4, .pin_threads = false});
+    const BlockConfig config(executor.num_threads(), 2, 16);
+
+    container::layout::FirstTouchBuffer<double> buffer;
+    buffer.resize(100, executor, config);
+    ASSERT_EQ(buffer.size(), 100u);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], 0.0);
+        buffer[i] = static_cast<double>(i);
+    }
+
+    buffer.resize(1000, executor, config);
+    ASSERT_EQ(buffer.size(), 1000u);
+    for (size_t i = 0; i < 100; ++i) EXPECT_EQ(buffer[i], static_cast<double>(i));
+    for (size_t i = 100; i < 1000; ++i) EXPECT_EQ(buffer[i], 0.0);
+
+    buffer.resize(10, executor, config);
+    EXPECT_EQ(buffer.size(), 10u);
+    EXPECT_EQ(buffer[9], 9.0);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#include "april/base/types.hpp"
+#include "april/interactions/bonded.hpp"
+#include "april/interactions/harmonic_angle.hpp"
+#include "april/interactions/cosine_dihedral.hpp"
+
+using namespace april;
+
+
+namespace {
+    // evaluates a bonded force on absolute positions x_0..x_{N-1}
+    template<std::size_t N, typename F>
+    std::array<vec3, N> forces_at(const F& force, const std::array<vec3, N>& x) {
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return force((x[I + 1] - x[I])...);
+        }(std::make_index_sequence<N - 1>{});
+    }
+
+    double harmonic_angle_energy(const HarmonicAngle& f, const std::array<vec3, 3>& x) {
+        const vec3 a = x[0] - x[1];
+        const vec3 b = x[2] - x[1];
+        const double theta = std::acos(a.dot(b) / (a.norm() * b.norm()));
+        return 0.5 * f.k * (theta - f.theta0) * (theta - f.theta0);
+    }
+
+    double cosine_dihedral_energy(const CosineDihedral& f, const std::array<vec3, 4>& x) {
+        const vec3 b1 = x[1] - x[0];
+        const vec3 b2 = x[2] - x[1];
+        const vec3 b3 = x[3] - x[2];
+        const vec3 m = b1.cross(b2);
+        const vec3 q = b2.cross(b3);
+        const double phi = std::atan2(b2.norm() * b1.dot(q), m.dot(q));
+        return f.k * (1.0 + std::cos(f.n * phi - f.phi0));
+    }
+
+    // checks F_i = -dU/dx_i via central differences
+    template<std::size_t N, typename F, typename Energy>
+    void expect_matches_gradient(const F& force, std::array<vec3, N> x, Energy&& energy) {
+        constexpr double h = 1e-6;
+        const auto f = forces_at<N>(force, x);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            for (int ax = 0; ax < 3; ++ax) {
+                auto xp = x, xm = x;
+                xp[i][ax] += h;
+                xm[i][ax] -= h;
+                const double numeric = -(energy(force, xp) - energy(force, xm)) / (2 * h);
+                EXPECT_NEAR(f[i][ax], numeric, 1e-5) << "particle " << i << " axis " << ax;
+            }
+        }
+    }
+
+    template<std::size_t N>
+    void expect_zero_net_force(const std::array<vec3, N>& f) {
+        vec3 sum{};
+        for (const auto& fi : f) sum += fi;
+        EXPECT_NEAR(sum.x, 0.0, 1e-12);
+        EXPECT_NEAR(sum.y, 0.0, 1e-12);
+        EXPECT_NEAR(sum.z, 0.0, 1e-12);
+    }
+}
+
+
+static_assert(interactions::IsBondedForce<HarmonicAngle>);
+static_assert(interactions::IsBondedForce<CosineDihedral>);
+static_assert(!interactions::IsForce<HarmonicAngle>);
+static_assert(HarmonicAngle::arity == 3 && CosineDihedral::arity == 4);
+
+
+TEST(BondedForceTest, HarmonicAngle_EquilibriumIsForceFree) {
+    const HarmonicAngle angle(10.0, std::numbers::pi / 2);
+    const auto f = forces_at<3>(angle, {vec3{1, 0, 0}, vec3{0, 0, 0}, vec3{0, 2, 0}});
+
+    for (const auto& fi : f) {
+        EXPECT_NEAR(fi.norm(), 0.0, 1e-12);
+    }
+}
+
+TEST(BondedForceTest, HarmonicAngle_MatchesEnergyGradient) {
+    const HarmonicAngle angle(3.0, 1.9);
+    const std::array<vec3, 3> x = {vec3{1.1, 0.2, -0.3}, vec3{0.0, 0.1, 0.0}, vec3{-0.4, 1.3, 0.5}};
+
+    expect_matches_gradient<3>(angle, x, harmonic_angle_energy);
+    expect_zero_net_force(forces_at<3>(angle, x));
+}
+
+TEST(BondedForceTest, HarmonicAngle_OpensClosedAngle) {
+    // 60 degree angle with 90 degree equilibrium -> end particles are pushed apart
+    const HarmonicAngle angle(1.0, std::numbers::pi / 2);
+    const std::array<vec3, 3> x = {vec3{1, 0, 0}, vec3{0, 0, 0}, vec3{0.5, std::sqrt(3.0) / 2, 0}};
+    const auto f = forces_at<3>(angle, x);
+
+    EXPECT_LT(f[0].dot(x[2] - x[0]), 0.0);
+    EXPECT_LT(f[2].dot(x[0] - x[2]), 0.0);
+}
+
+TEST(BondedForceTest, CosineDihedral_MatchesEnergyGradient) {
+    const CosineDihedral dihedral(2.5, 3.0, 0.4);
+    const std::array<vec3, 4> x = {
+        vec3{1.0, 0.3, 0.1}, vec3{0.0, 0.0, 0.0}, vec3{0.2, 1.4, 0.0}, vec3{-0.7, 1.9, 0.8}
+    };
+
+    expect_matches_gradient<4>(dihedral, x, cosine_dihedral_energy);
+    expect_zero_net_force(forces_at<4>(dihedral, x));
+}
+
+TEST(BondedForceTest, CosineDihedral_NoTorque) {
+    const CosineDihedral dihedral(1.0, 1.0, 0.0);
+    const std::array<vec3, 4> x = {
+        vec3{1.0, 0.0, 0.0}, vec3{0.0, 0.0, 0.0}, vec3{0.0, 1.0, 0.0}, vec3{0.3, 1.2, 0.9}
+    };
+    const auto f = forces_at<4>(dihedral, x);
+
+    vec3 torque{};
+    for (std::size_t i = 0; i < 4; ++i) torque += x[i].cross(f[i]);
+
+    EXPECT_NEAR(torque.x, 0.0, 1e-12);
+    EXPECT_NEAR(torque.y, 0.0, 1e-12);
+    EXPECT_NEAR(torque.z, 0.0, 1e-12);
+}
+
+TEST(BondedForceTest, Equality) {
+    EXPECT_TRUE(HarmonicAngle(1.0, 2.0).equals(HarmonicAngle(1.0, 2.0)));
+    EXPECT_FALSE(HarmonicAngle(1.0, 2.0).equals(HarmonicAngle(1.0, 2.1)));
+    EXPECT_FALSE(HarmonicAngle(1.0, 2.0).equals(CosineDihedral(1.0, 2.0, 0.0)));
+}
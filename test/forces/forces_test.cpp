@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 // #include "april/april.hpp"
 
 #include "april/base/types.hpp"
@@ -8,6 +10,7 @@
 #include "april/interactions/gravity.hpp"
 #include "april/interactions/harmonic.hpp"
 #include "april/interactions/lennard_jones.hpp"
+#include "april/interactions/sutton_chen.hpp"
 #include "april/interactions/interaction_table.hpp"
 
 using namespace april::interactions;
@@ -139,6 +142,29 @@ TEST_F(ForceTest, LennardJonesTest) {
 }
 
 
+// Checks the Sutton-Chen radial terms against central differences of the density and pair energy
+// and the embedding derivative against the embedding energy.
+TEST_F(ForceTest, SuttonChenTest) {
+    const SuttonChen sc(0.5, 1.2, 30.0, 10.0, 6.0);
+    static_assert(IsManyBodyForce<SuttonChen>);
+    EXPECT_DOUBLE_EQ(sc.cutoff(), 2.4);
+
+    auto pair_energy = [&](const double r) { return sc.epsilon * std::pow(sc.a / r, sc.n); };
+    constexpr double h = 1e-6;
+
+    for (const double r : {0.9, 1.2, 1.7, 2.3}) {
+        EXPECT_NEAR(sc.density(r), std::pow(1.2 / r, 6.0), 1e-12);
+        EXPECT_NEAR(sc.density_derivative(r), (sc.density(r + h) - sc.density(r - h)) / (2 * h), 1e-6);
+        EXPECT_NEAR(sc.pair_derivative(r), (pair_energy(r + h) - pair_energy(r - h)) / (2 * h), 1e-6);
+    }
+
+    for (const double rho : {0.3, 1.0, 12.0}) {
+        const double numeric = (sc.embedding(rho + h) - sc.embedding(rho - h)) / (2 * h);
+        EXPECT_NEAR(sc.embedding_derivative(rho), numeric, 1e-6);
+    }
+    EXPECT_EQ(sc.embedding_derivative(0.0), 0.0);
+}
+
 
 // Test Fixture not strictly needed for logic tests, but good for organization
 class ForceMixingTest : public testing::Test {};
@@ -0,0 +1,100 @@
+#include <utils.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "april/integrators/block_timestep.hpp"
+#include "april/integrators/velocity_verlet.hpp"
+#include "april/boundaries/periodic.hpp"
+#include "april/containers/direct_sum.hpp"
+
+using namespace april;
+
+
+namespace {
+	// tight equal-mass binary (ids 0, 1) on a circular orbit plus a light distant particle (id 2)
+	auto make_binary_with_satellite() {
+		constexpr double d = 0.2;
+		const double v = std::sqrt(1.0 / (2.0 * d));
+
+		Environment env (forces<Gravity>);
+		env.add_particle({-d / 2, 0, 0}, {0, -v, 0}, 1.0, 0, 0);
+		env.add_particle({ d / 2, 0, 0}, {0,  v, 0}, 1.0, 0, 1);
+		env.add_particle({10, 0, 0}, {0, 0.4, 0}, 1e-3, 0, 2);
+		env.add_interaction(Gravity(1.0), to_type(0));
+		env.set_extent({40, 40, 40});
+		env.set_origin({-20, -20, -20});
+
+		return build_system(env, DirectSum());
+	}
+}
+
+
+TEST(BlockTimestepTest, InvalidParameters) {
+	auto system = make_binary_with_satellite();
+	BlockTimestep integrator(system);
+	EXPECT_THROW(integrator.set_max_level(31), std::invalid_argument);
+	EXPECT_THROW(integrator.set_accuracy(0.0), std::invalid_argument);
+}
+
+// targeted force updates do not see periodic images, so wrapping boundaries are rejected up front
+TEST(BlockTimestepTest, PeriodicBoundaries_Throw) {
+	Environment env (forces<Gravity>, boundaries<PeriodicBoundary>);
+	env.add_particle({-0.1, 0, 0}, {0, 0, 0}, 1.0, 0, 0);
+	env.add_particle({ 0.1, 0, 0}, {0, 0, 0}, 1.0, 0, 1);
+	env.add_interaction(Gravity(1.0), to_type(0));
+	env.set_extent({4, 4, 4});
+	env.set_origin({-2, -2, -2});
+	env.set_boundaries(PeriodicBoundary(), all_faces);
+
+	auto system = build_system(env, DirectSum());
+	EXPECT_TRUE(system.wraps_forces());
+	EXPECT_THROW(BlockTimestep(system).run_for_steps(1e-3, 1), std::invalid_argument);
+}
+
+// a single level hierarchy is plain KDK leapfrog, i.e. velocity Verlet
+TEST(BlockTimestepTest, SingleLevel_MatchesVelocityVerlet) {
+	auto block_system = make_binary_with_satellite();
+	auto verlet_system = make_binary_with_satellite();
+
+	BlockTimestep(block_system).with_max_level(0).run_for_steps(1e-3, 100);
+	VelocityVerlet(verlet_system).run_for_steps(1e-3, 100);
+
+	for (ParticleID id = 0; id < 3; ++id) {
+		const auto a = get_particle_by_id(block_system, id);
+		const auto b = get_particle_by_id(verlet_system, id);
+		for (int ax = 0; ax < 3; ++ax) {
+			EXPECT_NEAR(a.position[ax], b.position[ax], 1e-9) << "id " << id;
+			EXPECT_NEAR(a.velocity[ax], b.velocity[ax], 1e-9) << "id " << id;
+		}
+	}
+}
+
+// the binary is placed in a fine bin, the satellite in the coarsest one, and both stay close to
+// a velocity Verlet reference that uses the finest step for everything
+TEST(BlockTimestepTest, Binary_UsesFinerBinsAndTracksReference) {
+	constexpr double dt = 0.1;
+	constexpr size_t levels = 6;
+
+	auto block_system = make_binary_with_satellite();
+	auto verlet_system = make_binary_with_satellite();
+
+	auto integrator = BlockTimestep(block_system)
+		.with_max_level(levels)
+		.with_length_scale(0.01)
+		.run_for_steps(dt, 20);
+
+	VelocityVerlet(verlet_system).run_for_steps(dt / (1 << levels), 20 * (1 << levels));
+
+	EXPECT_GE(integrator.level_of(0), 4u);
+	EXPECT_EQ(integrator.level_of(2), 0u);
+
+	for (ParticleID id = 0; id < 3; ++id) {
+		const auto a = get_particle_by_id(block_system, id);
+		const auto b = get_particle_by_id(verlet_system, id);
+		for (int ax = 0; ax < 3; ++ax) {
+			EXPECT_NEAR(a.position[ax], b.position[ax], 1e-2) << "id " << id;
+		}
+	}
+}
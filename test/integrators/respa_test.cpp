@@ -0,0 +1,137 @@
+#include <utils.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "april/integrators/respa.hpp"
+#include "april/integrators/velocity_verlet.hpp"
+#include "april/containers/direct_sum.hpp"
+
+using namespace april;
+
+
+namespace {
+	// bead-spring chain: stiff harmonic bonds between consecutive ids plus a soft type-pair force
+	template<typename TypeForce>
+	auto make_chain(
+		const TypeForce& type_force,
+		const ForceGroup type_group = ForceGroup::slow,
+		const ForceGroup bond_group = ForceGroup::fast
+	) {
+		Environment env (forces<Harmonic, TypeForce>);
+		env.add_particle({0.0, 0.0, 0.0}, {0.1, 0.0, 0.0}, 1.0, 0, 0);
+		env.add_particle({1.1, 0.1, 0.0}, {0.0, -0.2, 0.0}, 2.0, 0, 1);
+		env.add_particle({2.0, 0.9, 0.1}, {0.0, 0.0, 0.3}, 1.0, 0, 2);
+		env.add_particle({2.6, 1.8, 0.4}, {-0.1, 0.0, 0.0}, 1.5, 0, 3);
+
+		for (ParticleID i = 0; i < 3; ++i) {
+			env.add_interaction(Harmonic(200.0, 1.0), between_ids(i, i + 1), bond_group);
+		}
+		env.add_interaction(type_force, to_type(0), type_group);
+		env.set_extent({20, 20, 20});
+		env.set_origin({-10, -10, -10});
+
+		return build_system(env, DirectSum());
+	}
+
+	template<typename Sys1, typename Sys2>
+	void expect_same_state(Sys1& a, Sys2& b, const double tol) {
+		for (ParticleID id = 0; id < 4; ++id) {
+			const auto pa = get_particle_by_id(a, id);
+			const auto pb = get_particle_by_id(b, id);
+			for (int ax = 0; ax < 3; ++ax) {
+				EXPECT_NEAR(pa.position[ax], pb.position[ax], tol) << "id " << id << " axis " << ax;
+				EXPECT_NEAR(pa.velocity[ax], pb.velocity[ax], tol) << "id " << id << " axis " << ax;
+				EXPECT_NEAR(pa.force[ax], pb.force[ax], tol) << "id " << id << " axis " << ax;
+			}
+		}
+	}
+}
+
+
+TEST(RespaTest, InvalidInnerSteps) {
+	auto system = make_chain(NoForce());
+	Respa integrator(system);
+	EXPECT_THROW(integrator.set_inner_steps(0), std::invalid_argument);
+}
+
+// with a single inner step RESPA reduces to velocity Verlet
+TEST(RespaTest, SingleInnerStep_MatchesVelocityVerlet) {
+	auto respa_system = make_chain(LennardJones(0.5, 0.9));
+	auto verlet_system = make_chain(LennardJones(0.5, 0.9));
+
+	Respa(respa_system).with_inner_steps(1).run_for_steps(1e-3, 200);
+	VelocityVerlet(verlet_system).run_for_steps(1e-3, 200);
+
+	expect_same_state(respa_system, verlet_system, 1e-10);
+}
+
+// without slow forces the outer step is just k velocity Verlet steps of size dt / k
+TEST(RespaTest, FastForcesOnly_MatchesFineVelocityVerlet) {
+	auto respa_system = make_chain(NoForce());
+	auto verlet_system = make_chain(NoForce());
+
+	Respa(respa_system).with_inner_steps(4).run_for_steps(4e-3, 50);
+	VelocityVerlet(verlet_system).run_for_steps(1e-3, 200);
+
+	expect_same_state(respa_system, verlet_system, 1e-10);
+}
+
+// slow forces are applied as outer impulses; the trajectory stays close to a fine reference
+TEST(RespaTest, MixedForces_TracksFineVelocityVerlet) {
+	auto respa_system = make_chain(LennardJones(0.5, 0.9));
+	auto verlet_system = make_chain(LennardJones(0.5, 0.9));
+
+	Respa(respa_system).with_inner_steps(4).run_for_steps(2e-3, 100);
+	VelocityVerlet(verlet_system).run_for_steps(5e-4, 400);
+
+	expect_same_state(respa_system, verlet_system, 1e-3);
+}
+
+// a type-pair force moved to the fast group is integrated with the inner step like the bonds
+TEST(RespaTest, FastTypeForce_MatchesFineVelocityVerlet) {
+	auto respa_system = make_chain(LennardJones(0.5, 0.9), ForceGroup::fast);
+	auto verlet_system = make_chain(LennardJones(0.5, 0.9));
+
+	Respa(respa_system).with_inner_steps(4).run_for_steps(4e-3, 50);
+	VelocityVerlet(verlet_system).run_for_steps(1e-3, 200);
+
+	expect_same_state(respa_system, verlet_system, 1e-10);
+}
+
+// with the bonds moved to the slow group nothing is left for the inner loop: one velocity Verlet step per outer step
+TEST(RespaTest, SlowBonds_MatchCoarseVelocityVerlet) {
+	auto respa_system = make_chain(LennardJones(0.5, 0.9), ForceGroup::slow, ForceGroup::slow);
+	auto verlet_system = make_chain(LennardJones(0.5, 0.9));
+
+	Respa(respa_system).with_inner_steps(4).run_for_steps(1e-3, 200);
+	VelocityVerlet(verlet_system).run_for_steps(1e-3, 200);
+
+	expect_same_state(respa_system, verlet_system, 1e-10);
+}
+
+TEST(RespaTest, InvalidForceGroup) {
+	EXPECT_THROW(make_chain(LennardJones(0.5, 0.9), ForceGroup::all), std::invalid_argument);
+}
+
+// a second run() must not start from the slow force cached at the end of the first one
+TEST(RespaTest, RerunAfterEdit_MatchesFreshIntegrator) {
+	auto reused_system = make_chain(LennardJones(0.5, 0.9));
+	auto fresh_system = make_chain(LennardJones(0.5, 0.9));
+
+	Respa reused(reused_system);
+	reused.set_inner_steps(4);
+	reused.run_for_steps(2e-3, 50);
+	Respa(fresh_system).with_inner_steps(4).run_for_steps(2e-3, 50);
+
+	for (auto* sys : {&reused_system, &fresh_system}) {
+		auto p = sys->at_id<ParticleField::position>(2);
+		p.position = p.position + vec3{0.05, -0.05, 0.0};
+		sys->notify_moved_id({2});
+	}
+
+	reused.run_for_steps(2e-3, 50);
+	Respa(fresh_system).with_inner_steps(4).run_for_steps(2e-3, 50);
+
+	expect_same_state(reused_system, fresh_system, 1e-12);
+}
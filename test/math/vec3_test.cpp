@@ -119,6 +119,19 @@ TYPED_TEST(Vec3Test, Geometry) {
     // We allow a looser tolerance for the hardware approximation
     T inv = v.inv_norm();
     this->ExpectEq(inv, 0.2, 1e-3);
+
+    // Cross product (right-handed)
+    Vec3T ex(1.0, 0.0, 0.0);
+    Vec3T ey(0.0, 1.0, 0.0);
+    Vec3T ez = ex.cross(ey);
+    this->ExpectEq(ez.x, 0.0);
+    this->ExpectEq(ez.y, 0.0);
+    this->ExpectEq(ez.z, 1.0);
+
+    Vec3T w = v.cross(ex); // (0,3,4) x (1,0,0) = (0,4,-3)
+    this->ExpectEq(w.x, 0.0);
+    this->ExpectEq(w.y, 4.0);
+    this->ExpectEq(w.z, -3.0);
 }
 
 // Compound Assignment
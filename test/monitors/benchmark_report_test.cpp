@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "april/april.hpp"
+
+using namespace april;
+
+
+namespace {
+	// step timings drawn around median_s with a few percent of noise (deterministic)
+	BenchmarkRecord make_record(const std::string & name, const double median_s, const unsigned seed, const size_t steps = 200) {
+		std::mt19937 rng(seed);
+		std::lognormal_distribution<double> noise(0.0, 0.03);
+
+		BenchmarkRecord record{BenchmarkInfo::current(name)};
+		record.info.container = "LinkedCells";
+		record.info.layout = "SoA";
+		record.info.executor = "native_spin";
+		record.info.threads = 4;
+
+		auto & res = record.result;
+		for (size_t i = 0; i < steps; ++i) res.timings.push_back(median_s * noise(rng));
+		res.steps = steps;
+		res.total_updates = steps * 1000;
+		res.integration_time_s = 0;
+		for (const double t : res.timings) res.integration_time_s += t;
+		res.wall_time_sec = res.integration_time_s * 1.1;
+		res.avg_step_sec = res.integration_time_s / static_cast<double>(steps);
+		res.its_per_sec = 1.0 / res.avg_step_sec;
+		res.mups = static_cast<double>(res.total_updates) / res.integration_time_s / 1e6;
+
+		std::vector<double> sorted = res.timings;
+		std::ranges::sort(sorted);
+		res.median_step_sec = sorted[steps / 2];
+		res.min_step_sec = sorted.front();
+		res.max_step_sec = sorted.back();
+		res.std_dev_sec = 0.03 * median_s;
+		return record;
+	}
+}
+
+
+TEST(BenchmarkReportTest, Json_RoundTripsResultAndMetadata) {
+	BenchmarkRecord record = make_record("lj_cube/LinkedCells/SoA/native_spin", 1e-3, 1);
+	record.result.hardware_counters = true;
+	record.result.counters.values[0] = 12345;
+	record.result.counters.valid[0] = true;
+	record.result.stage_counters.push_back({utility::Stage::UpdateForces, record.result.counters});
+
+	std::ostringstream out;
+	write_benchmark_json(out, record);
+	const auto records = read_benchmark_json(out.str());
+
+	ASSERT_EQ(records.size(), 1u);
+	const BenchmarkInfo & info = records[0].info;
+	EXPECT_EQ(info.name, record.info.name);
+	EXPECT_EQ(info.container, "LinkedCells");
+	EXPECT_EQ(info.layout, "SoA");
+	EXPECT_EQ(info.executor, "native_spin");
+	EXPECT_EQ(info.threads, 4u);
+	EXPECT_EQ(info.vec3_type, record.info.vec3_type);
+	EXPECT_EQ(info.simd_backend, record.info.simd_backend);
+	EXPECT_EQ(info.simd_width, packed::size());
+	EXPECT_EQ(info.compiler, record.info.compiler);
+	EXPECT_EQ(info.host.hostname, record.info.host.hostname);
+	EXPECT_FALSE(info.host.timestamp.empty());
+
+	const auto & res = records[0].result;
+	EXPECT_EQ(res.steps, record.result.steps);
+	EXPECT_EQ(res.total_updates, record.result.total_updates);
+	EXPECT_EQ(res.median_step_sec, record.result.median_step_sec);
+	EXPECT_EQ(res.mups, record.result.mups);
+	EXPECT_EQ(res.timings, record.result.timings);
+
+	ASSERT_TRUE(res.hardware_counters);
+	EXPECT_TRUE(res.counters.valid[0]);
+	EXPECT_EQ(res.counters.values[0], 12345u);
+	EXPECT_FALSE(res.counters.valid[1]);
+	ASSERT_EQ(res.stage_counters.size(), 1u);
+	EXPECT_EQ(res.stage_counters[0].stage, utility::Stage::UpdateForces);
+}
+
+
+TEST(BenchmarkReportTest, Json_RejectsForeignDocuments) {
+	EXPECT_THROW((void)read_benchmark_json(R"({"runs": []})"), std::runtime_error);
+	EXPECT_THROW((void)read_benchmark_json("not json"), std::runtime_error);
+}
+
+
+TEST(BenchmarkReportTest, Csv_OneRowPerRunAndStep) {
+	const std::vector records = {make_record("a", 1e-3, 1, 10), make_record("b, quoted", 1e-3, 2, 10)};
+
+	std::ostringstream summary, steps;
+	write_benchmark_csv(summary, records);
+	write_benchmark_steps_csv(steps, records);
+
+	const std::string s = summary.str();
+	EXPECT_EQ(std::ranges::count(s, '\n'), 3);
+	EXPECT_NE(s.find("\"b, quoted\",LinkedCells,SoA,native_spin,4,"), std::string::npos);
+
+	// header line has as many columns as the data rows (the quoted comma aside)
+	const std::string header = s.substr(0, s.find('\n'));
+	const std::string row = s.substr(header.size() + 1, s.find('\n', header.size() + 1) - header.size() - 1);
+	EXPECT_EQ(std::ranges::count(header, ','), std::ranges::count(row, ','));
+
+	EXPECT_EQ(std::ranges::count(steps.str(), '\n'), 21);
+}
+
+
+TEST(BenchmarkReportTest, Compare_FlagsSlowdownButNotNoise) {
+	const std::vector baseline = {make_record("same", 1e-3, 1), make_record("slower", 1e-3, 2), make_record("gone", 1e-3, 3)};
+	const std::vector candidate = {make_record("same", 1e-3, 11), make_record("slower", 1.15e-3, 12)};
+
+	const auto comparisons = compare_benchmarks(baseline, candidate);
+	ASSERT_EQ(comparisons.size(), 3u);
+
+	EXPECT_EQ(comparisons[0].name, "same");
+	EXPECT_EQ(comparisons[0].verdict, Verdict::Unchanged);
+
+	EXPECT_EQ(comparisons[1].name, "slower");
+	EXPECT_EQ(comparisons[1].verdict, Verdict::Regression);
+	EXPECT_NEAR(comparisons[1].change, 0.15, 0.03);
+	EXPECT_LT(comparisons[1].p_slower, 1e-6);
+
+	EXPECT_EQ(comparisons[2].verdict, Verdict::Missing);
+}
+
+
+TEST(BenchmarkReportTest, Compare_ReportsImprovementsAndThinData) {
+	const auto base = make_record("x", 1e-3, 1);
+
+	const auto faster = compare_benchmarks(base.result, make_record("x", 0.8e-3, 2).result);
+	EXPECT_EQ(faster.verdict, Verdict::Improvement);
+	EXPECT_LT(faster.change, 0);
+
+	// a significant but small shift stays below the threshold
+	ComparisonOptions strict;
+	strict.threshold = 0.5;
+	EXPECT_EQ(compare_benchmarks(base.result, make_record("x", 1.15e-3, 2).result, strict).verdict, Verdict::Unchanged);
+
+	// everything but the warmup steps is dropped
+	ComparisonOptions warmup;
+	warmup.warmup_steps = 195;
+	EXPECT_EQ(compare_benchmarks(base.result, make_record("x", 2e-3, 2).result, warmup).verdict, Verdict::Inconclusive);
+}
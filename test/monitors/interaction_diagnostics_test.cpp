@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "april/april.hpp"
+#include "utils.h"
+
+using namespace april;
+using testing::HasSubstr;
+
+
+namespace {
+	struct ScalarConfig : RuntimeConfig<exec::SequentialExecutor>,
+						  CompileTimeConfig<ParallelPolicy::Serial, VectorPolicy::Scalar> {};
+
+	// two interleaved types on a grid, every type pair interacts
+	auto make_env() {
+		auto env = Environment(forces<LennardJones>, boundaries<ReflectiveBoundary>)
+			.with_extent(12, 12, 12)
+			.with_interaction(LennardJones(1, 1, 2.5), to_type(0))
+			.with_interaction(LennardJones(1, 1, 2.5), to_type(1))
+			.with_interaction(LennardJones(1, 1, 2.5), between_types(0, 1));
+
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				env.add_particle(make_particle(static_cast<ParticleType>((i + j) % 2), {1.0 + 2.5 * i, 1.0 + 2.5 * j, 6}, {}, 1.0));
+			}
+		}
+		return env;
+	}
+}
+
+
+TEST(InteractionCountsTest, PackedAndScalarAccounting) {
+	utility::InteractionCounts c;
+
+	c.add_packed(0b0000, 4); // all lanes inside
+	c.add_packed(0b0110, 4); // two lanes inside
+	c.add_packed(0b1111, 4); // fully masked, exits early
+	c.add_scalar(true);
+	c.add_scalar(false);
+
+	EXPECT_EQ(c.pairs_examined, 14u);
+	EXPECT_EQ(c.pairs_within, 7u);
+	EXPECT_EQ(c.packed_iterations, 3u);
+	EXPECT_EQ(c.masked_iterations, 1u);
+	EXPECT_EQ(c.evaluated_lanes, 8u);
+	EXPECT_EQ(c.evaluated_within, 6u);
+
+	EXPECT_DOUBLE_EQ(c.within_fraction(), 0.5);
+	EXPECT_DOUBLE_EQ(c.masked_fraction(), 1.0 / 3.0);
+	EXPECT_DOUBLE_EQ(c.lane_utilization(), 0.75);
+
+	EXPECT_EQ(c - c, utility::InteractionCounts{});
+}
+
+
+TEST(InteractionCountersTest, SnapshotSumsThreadSlots) {
+	utility::InteractionCounters counters(3, 2);
+
+	counters.local(0, 0, 1).add_scalar(true);
+	counters.local(2, 0, 1).add_scalar(false);
+	counters.local(1, 1, 1).add_packed(0b01, 2);
+
+	const auto table = counters.snapshot();
+	ASSERT_EQ(table.n_types, 2u);
+	EXPECT_EQ(table(0, 1).pairs_examined, 2u);
+	EXPECT_EQ(table(0, 1).pairs_within, 1u);
+	EXPECT_EQ(table.pair(1, 0).pairs_examined, 2u);
+	EXPECT_EQ(table(1, 1).evaluated_within, 1u);
+	EXPECT_EQ(table.total().pairs_examined, 4u);
+
+	counters.reset();
+	EXPECT_EQ(counters.snapshot().total(), utility::InteractionCounts{});
+
+	counters.enable(true);
+	EXPECT_EQ(counters.enabled(), utility::interaction_counters_compiled_in);
+}
+
+
+TEST(InteractionDiagnosticsTest, Integration_CountsEveryDirectSumPair) {
+	auto system = build_system(make_env(), DirectSum<Layout::AoS>(), ScalarConfig{});
+	InteractionDiagnostics::InteractionDiagnosticsResult res;
+
+	testing::internal::CaptureStdout();
+	VelocityVerlet(system, monitors<InteractionDiagnostics>)
+		.with_monitor(InteractionDiagnostics(&res))
+		.run_for_steps(0.0001, 3);
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_THAT(output, HasSubstr("[APRIL INTERACTION DIAGNOSTICS]"));
+	EXPECT_EQ(res.steps, 3u);
+	EXPECT_FALSE(system.interaction_counters().enabled());
+
+	if (!utility::interaction_counters_compiled_in) {
+		EXPECT_FALSE(res.available);
+		GTEST_SKIP() << "interaction counters are not compiled in (APRIL_ENABLE_INTERACTION_COUNTERS=0)";
+	}
+
+	// the scalar direct sum examines every unordered pair once per step: 16 * 15 / 2
+	ASSERT_TRUE(res.available);
+	EXPECT_EQ(res.total.pairs_examined, 3u * 120u);
+	EXPECT_GT(res.total.pairs_within, 0u);
+	EXPECT_LT(res.total.pairs_within, res.total.pairs_examined);
+	EXPECT_EQ(res.total.packed_iterations, 0u);
+
+	// 8 particles per type: 28 pairs within each type and 64 between the types
+	ASSERT_EQ(res.type_pairs.size(), 3u);
+	uint64_t examined = 0;
+	for (const auto& p : res.type_pairs) {
+		examined += p.counts.pairs_examined;
+		EXPECT_EQ(p.counts.pairs_examined, 3u * (p.type1 == p.type2 ? 28u : 64u));
+	}
+	EXPECT_EQ(examined, res.total.pairs_examined);
+}
+
+
+TEST(InteractionDiagnosticsTest, Integration_PackedKernelReportsLaneUtilization) {
+	auto system = build_system(make_env(), LinkedCells<Layout::AoSoA<>>());
+	InteractionDiagnostics::InteractionDiagnosticsResult res;
+
+	testing::internal::CaptureStdout();
+	VelocityVerlet(system, monitors<InteractionDiagnostics>)
+		.with_monitor(InteractionDiagnostics(&res))
+		.run_for_steps(0.0001, 2);
+	testing::internal::GetCapturedStdout();
+
+	if (!utility::interaction_counters_compiled_in) GTEST_SKIP() << "interaction counters are not compiled in";
+
+	EXPECT_GT(res.total.pairs_examined, 0u);
+	EXPECT_LE(res.total.pairs_within, res.total.pairs_examined);
+	EXPECT_LE(res.total.masked_iterations, res.total.packed_iterations);
+	EXPECT_GE(res.total.lane_utilization(), 0.0);
+	EXPECT_LE(res.total.lane_utilization(), 1.0);
+}
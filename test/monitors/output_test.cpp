@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <vector>
@@ -295,6 +296,45 @@ TEST(BenchmarkTest, Integration_CapturesStatistics) {
 }
 
 
+TEST(BenchmarkTest, HardwareCounters_ReadOrReportUnavailable) {
+	auto p1 = make_particle(0, {0,0,0}, {0,0,0}, 1.0);
+	auto p2 = make_particle(0, {1.5,0,0}, {0,0,0}, 1.0);
+
+	auto env = Environment(forces<LennardJones>, boundaries<ReflectiveBoundary>)
+	   .with_particles({p1, p2})
+	   .with_extent(10, 10, 10)
+	   .with_interaction(LennardJones(1, 1), to_type(0));
+
+	auto system = build_system(env, LinkedCells());
+	Benchmark::BenchmarkResult res;
+
+	testing::internal::CaptureStdout();
+	VelocityVerlet(system, monitors<Benchmark>)
+	   .with_monitor(Benchmark(&res, true))
+	   .run_for_steps(0.001, 5);
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_TRUE(res.hardware_counters);
+	if (res.counters_error.empty()) {
+		// counters are permitted: every thread and the force stage are covered
+		EXPECT_FALSE(res.thread_counters.empty());
+		EXPECT_TRUE(res.counters.any());
+		EXPECT_TRUE(std::ranges::any_of(res.stage_counters, [](const auto& s) {
+			return s.stage == utility::Stage::UpdateForces;
+		}));
+		EXPECT_THAT(output, HasSubstr("Hardware counters (all threads):"));
+	} else {
+		// e.g. perf_event_paranoid or no PMU in a virtual machine: the run still completes
+		EXPECT_TRUE(res.thread_counters.empty());
+		EXPECT_THAT(output, HasSubstr("Hardware counters:  unavailable"));
+	}
+	EXPECT_EQ(res.steps, 5u);
+
+	// the stage hook does not outlive the run
+	EXPECT_EQ(utility::StageProfile::local().stage_hook().on_stage, nullptr);
+}
+
+
 TEST(TerminalOutputTest, terminal_test) {
 	auto p1 = make_particle(0, {0,0,0}, {0,0,0}, 1.0);
 	auto p2 = make_particle(0, {1.5,0,0}, {0,0,0}, 1.0);
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "april/april.hpp"
+#include "utils.h"
+
+using namespace april;
+using testing::HasSubstr;
+
+
+namespace {
+	auto make_env() {
+		auto env = Environment(forces<LennardJones>, boundaries<ReflectiveBoundary>)
+			.with_extent(24, 24, 24)
+			.with_interaction(LennardJones(1, 1, 2.5), to_type(0));
+
+		for (int i = 0; i < 6; ++i) {
+			for (int j = 0; j < 6; ++j) {
+				env.add_particle(make_particle(0, {2.0 + 4.0 * i, 2.0 + 4.0 * j, 12}, {}, 1.0));
+			}
+		}
+		return env;
+	}
+}
+
+
+TEST(SkinTuningReportTest, ReportsDecisionsOfTheRun) {
+	auto container = LinkedCells<Layout::SoA>()
+		.with_abs_cell_size(2.5)
+		.with_skin_factor(1.0)
+		.with_adaptive_skin({.interval = 2});
+	auto system = build_system(make_env(), container);
+	SkinTuningReport::SkinTuningResult res;
+
+	testing::internal::CaptureStdout();
+	VelocityVerlet(system, monitors<SkinTuningReport>)
+		.with_monitor(SkinTuningReport(&res))
+		.run_for_steps(0.0001, 6);
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_THAT(output, HasSubstr("[APRIL SKIN TUNING]"));
+	ASSERT_TRUE(res.available);
+	EXPECT_EQ(res.steps, 6u);
+	ASSERT_FALSE(res.decisions.empty());
+
+	// the report covers the whole history of this (first) run
+	const auto* log = system.skin_tuning();
+	ASSERT_NE(log, nullptr);
+	EXPECT_EQ(res.decisions.size(), log->decisions.size());
+	EXPECT_EQ(res.regrids, log->regrids);
+	EXPECT_EQ(res.final_cells, log->cells_per_axis);
+	EXPECT_DOUBLE_EQ(res.final_skin, log->skin);
+	for (const auto& d : res.decisions) {
+		EXPECT_EQ(d.regridded, !(d.old_cells == d.new_cells));
+	}
+}
+
+
+TEST(SkinTuningReportTest, UnavailableWithoutAdaptiveSkin) {
+	auto system = build_system(make_env(), DirectSum<Layout::AoS>());
+	SkinTuningReport::SkinTuningResult res;
+
+	testing::internal::CaptureStdout();
+	VelocityVerlet(system, monitors<SkinTuningReport>)
+		.with_monitor(SkinTuningReport(&res))
+		.run_for_steps(0.0001, 2);
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_THAT(output, HasSubstr("unavailable"));
+	EXPECT_FALSE(res.available);
+	EXPECT_EQ(res.steps, 2u);
+	EXPECT_EQ(system.skin_tuning(), nullptr);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+
+#include "april/april.hpp"
+#include "utils.h"
+
+using namespace april;
+using testing::HasSubstr;
+
+
+namespace {
+	using StageStats = StageTimer::StageStats;
+
+	const StageStats* find_stage(const StageTimer::StageTimerResult& res, const utility::Stage stage) {
+		const auto it = std::ranges::find_if(res.stages, [&](const StageStats& s) { return s.stage == stage; });
+		return it == res.stages.end() ? nullptr : &*it;
+	}
+}
+
+
+TEST(StageTimerTest, Integration_RecordsSystemStagesAndPhases) {
+	auto env = Environment(forces<LennardJones>, boundaries<ReflectiveBoundary>)
+		.with_extent(10, 10, 10)
+		.with_interaction(LennardJones(1, 1), to_type(0));
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			env.add_particle(make_particle(0, {1.0 + 2 * i, 1.0 + 2 * j, 5}, {}, 1.0));
+		}
+	}
+
+	auto system = build_system(env, LinkedCells());
+	StageTimer::StageTimerResult res;
+
+	testing::internal::CaptureStdout();
+	VelocityVerlet(system, monitors<StageTimer>)
+		.with_monitor(StageTimer(&res))
+		.run_for_steps(0.001, 5);
+	const std::string output = testing::internal::GetCapturedStdout();
+
+	EXPECT_THAT(output, HasSubstr("[APRIL STAGE TIMES]"));
+	EXPECT_EQ(res.steps, 5u);
+
+	for (const auto stage : {utility::Stage::Drift, utility::Stage::RebuildStructure,
+							 utility::Stage::UpdateForces, utility::Stage::Kick}) {
+		const StageStats* s = find_stage(res, stage);
+		ASSERT_NE(s, nullptr) << utility::stage_name(stage);
+		EXPECT_EQ(s->steps, 5u) << utility::stage_name(stage);
+		EXPECT_LE(s->min_sec, s->median_sec);
+		EXPECT_LE(s->median_sec, s->max_sec);
+	}
+
+	EXPECT_NE(find_stage(res, utility::Stage::PairPhase), nullptr);
+
+	// system stages do not overlap, so together they cannot exceed the step time
+	double system_total = 0;
+	for (const auto& s : res.stages) {
+		if (utility::is_system_stage(s.stage)) system_total += s.total_sec;
+	}
+	EXPECT_LE(system_total, res.step_time_sec * (1 + 1e-9));
+
+	EXPECT_FALSE(utility::StageProfile::local().enabled());
+}
+
+TEST(StageTimerTest, StageScope_NoOpWhileDisabled) {
+	auto& profile = utility::StageProfile::local();
+	profile.enable(false);
+	profile.reset();
+
+	{ const utility::StageScope stage(utility::Stage::UpdateForces); }
+	for (const auto& e : profile.entries(utility::Stage::UpdateForces)) {
+		EXPECT_EQ(e.calls, 0u);
+	}
+
+	profile.enable(true);
+	{
+		utility::StageScope stage(utility::Stage::ReorderCount);
+		stage.next(utility::Stage::PairPhase, 2);
+	}
+	profile.enable(false);
+
+	ASSERT_EQ(profile.entries(utility::Stage::ReorderCount).size(), 1u);
+	EXPECT_EQ(profile.entries(utility::Stage::ReorderCount)[0].calls, 1u);
+	ASSERT_EQ(profile.entries(utility::Stage::PairPhase).size(), 3u);
+	EXPECT_EQ(profile.entries(utility::Stage::PairPhase)[2].calls, 1u);
+	EXPECT_EQ(profile.entries(utility::Stage::PairPhase)[0].calls, 0u);
+	profile.reset();
+}
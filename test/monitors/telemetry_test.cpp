@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <unistd.h>
+
+#include "april/april.hpp"
+#include "utils.h"
+
+#if defined(__unix__)
+
+using namespace april;
+
+
+TEST(TelemetryTest, Integration_PublishesWindowsOfTheRun) {
+	auto env = Environment(forces<LennardJones>, boundaries<ReflectiveBoundary>)
+		.with_extent(10, 10, 10)
+		.with_interaction(LennardJones(1, 1), to_type(0));
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			env.add_particle(make_particle(0, {1.0 + 2 * i, 1.0 + 2 * j, 5}, {0.5, 0, 0}, 1.0));
+		}
+	}
+	env.add_particle(make_particle(0, {9, 9, 9}, {}, 1.0, ParticleState::STATIONARY));
+
+	auto system = build_system(env, LinkedCells());
+	const std::string name = "/april_telemetry_monitor_test_" + std::to_string(getpid());
+
+	// the segment lives as long as the monitor, i.e. the integrator
+	auto integrator = VelocityVerlet(system, monitors<Telemetry>).with_monitor(Telemetry(name, 2, 16, "telemetry test"));
+	integrator.run_for_steps(0.001, 5);
+
+	const utility::TelemetryReader reader(name);
+	EXPECT_EQ(reader.run_name(), "telemetry test");
+	EXPECT_EQ(reader.status(), utility::TelemetryStatus::Finished);
+
+	uint64_t cursor = 0;
+	const auto samples = reader.poll(cursor);
+
+	// windows of 2, 2 and the remaining step
+	ASSERT_EQ(samples.size(), 3u);
+	EXPECT_EQ(samples[0].step, 2u);
+	EXPECT_EQ(samples[1].step, 4u);
+	EXPECT_EQ(samples[2].step, 5u);
+	EXPECT_EQ(samples[2].window_steps, 1u);
+
+	for (const auto& s : samples) {
+		EXPECT_EQ(s.count(utility::TelemetryCount::Alive), 16u);
+		EXPECT_EQ(s.count(utility::TelemetryCount::Stationary), 1u);
+		EXPECT_EQ(s.count(utility::TelemetryCount::Dead), 0u);
+		EXPECT_GT(s.steps_per_sec, 0);
+		EXPECT_GT(s.mups, 0);
+		EXPECT_GE(s.wall_time_sec, s.step_time_sec);
+		EXPECT_LE(s.rebuilds, s.window_steps);
+		EXPECT_GT(s.kinetic_energy, 0);
+		EXPECT_NEAR(s.temperature, 2.0 * s.kinetic_energy / (3.0 * 16), 1e-12);
+		EXPECT_GT(s.momentum[0], 0); // every alive particle starts moving along +x
+
+		// system stages do not overlap
+		double stages = 0;
+		for (const double t : s.stage_sec) stages += t;
+		EXPECT_LE(stages, s.step_time_sec * (1 + 1e-9));
+	}
+	EXPECT_NEAR(samples[2].time, 0.005, 1e-12);
+	EXPECT_EQ(samples[2].total_rebuilds, samples[0].rebuilds + samples[1].rebuilds + samples[2].rebuilds);
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "april/utility/json.hpp"
+
+
+using namespace april::utility;
+
+
+TEST(JSONWriterTest, WritesNestedDocument) {
+	std::ostringstream out;
+	JSONWriter json(out);
+
+	json.begin_object();
+	json.field("name", "run \"a\"");
+	json.field("count", 3);
+	json.key("values").begin_array(true);
+	json.value(0.5);
+	json.value(2.0);
+	json.end_array();
+	json.key("empty").begin_array();
+	json.end_array();
+	json.end_object();
+	json.finish();
+
+	EXPECT_EQ(
+		out.str(),
+		"{\n"
+		"\t\"name\": \"run \\\"a\\\"\",\n"
+		"\t\"count\": 3,\n"
+		"\t\"values\": [0.5, 2],\n"
+		"\t\"empty\": []\n"
+		"}\n"
+	);
+}
+
+
+TEST(JSONWriterTest, NonFiniteNumbersBecomeNull) {
+	std::ostringstream out;
+	JSONWriter json(out);
+
+	json.begin_array(true);
+	json.value(std::numeric_limits<double>::infinity());
+	json.value(std::nan(""));
+	json.end_array();
+
+	EXPECT_EQ(out.str(), "[null, null]");
+}
+
+
+TEST(JSONParserTest, ParsesAllValueKinds) {
+	const JSONValue v = parse_json(R"( {"a": [1, -2.5e3, true, false, null], "s": "x\tyA", "o": {}} )");
+
+	ASSERT_TRUE(v.is_object());
+	const auto & a = v["a"].as_array();
+	ASSERT_EQ(a.size(), 5u);
+	EXPECT_DOUBLE_EQ(a[0].as_number(), 1.0);
+	EXPECT_DOUBLE_EQ(a[1].as_number(), -2500.0);
+	EXPECT_TRUE(a[2].as_bool());
+	EXPECT_FALSE(a[3].as_bool());
+	EXPECT_TRUE(a[4].is_null());
+	EXPECT_EQ(v["s"].as_string(), "x\tyA");
+	EXPECT_TRUE(v["o"].as_object().empty());
+
+	EXPECT_EQ(v.find("missing"), nullptr);
+	EXPECT_DOUBLE_EQ(v.number_or("missing", 7.0), 7.0);
+}
+
+
+TEST(JSONParserTest, RoundTripsWrittenNumbersExactly) {
+	const double x = 0.1 + 0.2;
+
+	std::ostringstream out;
+	JSONWriter json(out);
+	json.begin_array();
+	json.value(x);
+	json.end_array();
+
+	EXPECT_EQ(parse_json(out.str()).as_array()[0].as_number(), x);
+}
+
+
+TEST(JSONParserTest, RejectsMalformedInput) {
+	EXPECT_THROW((void)parse_json("{\"a\": }"), std::runtime_error);
+	EXPECT_THROW((void)parse_json("[1, 2"), std::runtime_error);
+	EXPECT_THROW((void)parse_json("\"unterminated"), std::runtime_error);
+	EXPECT_THROW((void)parse_json("[1] 2"), std::runtime_error);
+	EXPECT_THROW((void)parse_json("{\"a\": 1}")["b"], std::runtime_error);
+	EXPECT_THROW((void)parse_json("1").as_string(), std::runtime_error);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+#include "april/utility/telemetry_buffer.hpp"
+
+#if defined(__unix__)
+
+using namespace april::utility;
+
+
+namespace {
+	std::string segment_name(const std::string& test) {
+		return "/april_telemetry_test_" + test + "_" + std::to_string(getpid());
+	}
+
+	TelemetrySample sample_at(const uint64_t step) {
+		TelemetrySample s;
+		s.step = step;
+		s.window_steps = 4;
+		s.rebuilds = 1;
+		s.particles[static_cast<size_t>(TelemetryCount::Alive)] = 10 * step;
+		s.stage_sec[static_cast<size_t>(Stage::UpdateForces)] = 0.5;
+		return s;
+	}
+}
+
+
+TEST(TelemetryBufferTest, ReaderSeesHeaderAndPublishedSamples) {
+	TelemetryWriter writer(segment_name("basic"), 8, "lj run");
+	const TelemetryReader reader(segment_name("basic"));
+
+	EXPECT_EQ(reader.run_name(), "lj run");
+	EXPECT_EQ(reader.writer_pid(), getpid());
+	EXPECT_EQ(reader.capacity(), 8u);
+	EXPECT_EQ(reader.status(), TelemetryStatus::Running);
+	EXPECT_TRUE(reader.writer_alive());
+	EXPECT_FALSE(reader.latest().has_value());
+
+	writer.publish(sample_at(1));
+	writer.publish(sample_at(2));
+
+	uint64_t cursor = 0;
+	const auto samples = reader.poll(cursor);
+	ASSERT_EQ(samples.size(), 2u);
+	EXPECT_EQ(cursor, 2u);
+	EXPECT_EQ(samples[0].step, 1u);
+	EXPECT_EQ(samples[1].count(TelemetryCount::Alive), 20u);
+	EXPECT_DOUBLE_EQ(samples[1].stage_time(Stage::UpdateForces), 0.5);
+	EXPECT_DOUBLE_EQ(samples[1].rebuild_frequency(), 0.25);
+
+	EXPECT_TRUE(reader.poll(cursor).empty());
+	EXPECT_EQ(reader.latest()->step, 2u);
+
+	writer.set_status(TelemetryStatus::Finished);
+	EXPECT_EQ(reader.status(), TelemetryStatus::Finished);
+}
+
+
+TEST(TelemetryBufferTest, SlowReaderSkipsOverwrittenSamples) {
+	TelemetryWriter writer(segment_name("wrap"), 4);
+	const TelemetryReader reader(segment_name("wrap"));
+
+	for (uint64_t step = 0; step < 10; ++step) writer.publish(sample_at(step));
+
+	uint64_t cursor = 0;
+	uint64_t lost = 0;
+	const auto samples = reader.poll(cursor, &lost);
+
+	// only the last capacity samples survive
+	ASSERT_EQ(samples.size(), 4u);
+	EXPECT_EQ(samples.front().step, 6u);
+	EXPECT_EQ(samples.back().step, 9u);
+	EXPECT_EQ(lost, 6u);
+	EXPECT_EQ(cursor, 10u);
+
+	TelemetrySample s;
+	EXPECT_FALSE(reader.read(2, s));  // overwritten
+	EXPECT_FALSE(reader.read(10, s)); // not published yet
+	EXPECT_TRUE(reader.read(7, s));
+	EXPECT_EQ(s.step, 7u);
+}
+
+
+TEST(TelemetryBufferTest, SegmentLifetime) {
+	const std::string name = segment_name("lifetime");
+	EXPECT_THROW(TelemetryReader{name}, std::system_error);
+
+	{
+		TelemetryWriter writer(name, 2);
+		EXPECT_THROW(TelemetryWriter(name, 2), std::system_error); // names are exclusive
+	}
+
+	// the writer removes the segment
+	EXPECT_THROW(TelemetryReader{name}, std::system_error);
+	EXPECT_THROW(TelemetryWriter(name, 0), std::invalid_argument);
+}
+
+#endif